@@ -0,0 +1,124 @@
+/**
+ * @file TileMandelCalculator.cc
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that uses SIMD parallelization over 2D tiles processed
+ *        by multiple threads
+ * @date 2022-11-16
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <cstdlib>
+
+// A tile row is as wide as a batch of BatchMandelCalculator, the whole tile (zR, zI, cR, cI and the results)
+// takes 20 kB and fits into L1
+constexpr uint32_t TILE_WIDTH = 64;
+constexpr uint32_t TILE_HEIGHT = 16;
+constexpr uint32_t TILE_SIZE = TILE_WIDTH * TILE_HEIGHT;
+
+#include "TileMandelCalculator.h"
+
+TileMandelCalculator::TileMandelCalculator(unsigned matrixBaseSize, unsigned limit) :
+        BaseMandelCalculator(matrixBaseSize, limit, "TileMandelCalculator") {
+    data = static_cast<uint32_t *>(aligned_alloc(64, height * width * sizeof(uint32_t)));
+}
+
+TileMandelCalculator::~TileMandelCalculator() {
+    free(data);
+    data = nullptr;
+}
+
+int *TileMandelCalculator::calculateMandelbrot() {
+    uint32_t *const pdata = data;
+
+    const auto x_start = static_cast<float>(this->x_start);
+    const auto y_start = static_cast<float>(this->y_start);
+    const auto dx = static_cast<float>(this->dx);
+    const auto dy = static_cast<float>(this->dy);
+
+    const uint32_t limit = this->limit;
+    const uint32_t width = this->width;
+    const uint32_t height = this->height;
+    const uint32_t half_height = height >> 1;
+
+    const uint32_t tiles_x = (width + TILE_WIDTH - 1) / TILE_WIDTH;
+    const uint32_t tiles_y = (half_height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+    const uint32_t tiles = tiles_x * tiles_y;
+
+    // The tiles inside the set take the full number of iterations while the ones outside finish almost
+    // immediately, so they are handed out one by one. The nonmonotonic schedule lets the runtime steal
+    // the remaining tiles of a busy thread instead of following a fixed order.
+#pragma omp parallel for schedule(nonmonotonic:dynamic, 1)
+    for (uint32_t tile = 0; tile < tiles; tile++) {
+        alignas(64) float zR[TILE_SIZE];
+        alignas(64) float zI[TILE_SIZE];
+        alignas(64) float cR[TILE_SIZE];
+        alignas(64) float cI[TILE_SIZE];
+        alignas(64) uint32_t result[TILE_SIZE];
+
+        const uint32_t x_base = (tile % tiles_x) * TILE_WIDTH;
+        const uint32_t y_base = (tile / tiles_x) * TILE_HEIGHT;
+        const uint32_t tile_width = std::min(TILE_WIDTH, width - x_base);
+        const uint32_t tile_height = std::min(TILE_HEIGHT, half_height - y_base);
+
+        // Prepare data for this tile; the points outside of the image (in the last column or row of tiles)
+        // are marked as done right away
+        uint32_t iters_done = 0;
+        for (uint32_t y_local = 0; y_local < TILE_HEIGHT; y_local++) {
+            const bool row_valid = y_local < tile_height;
+            const float row_cI = y_start + (y_base + y_local) * dy;
+
+            for (uint32_t x_local = 0; x_local < TILE_WIDTH; x_local++) {
+                const uint32_t i = y_local * TILE_WIDTH + x_local;
+                const bool valid = row_valid && x_local < tile_width;
+
+                cR[i] = x_start + (x_base + x_local) * dx;
+                cI[i] = row_cI;
+                zR[i] = cR[i];
+                zI[i] = cI[i];
+                result[i] = valid ? limit : 0;
+                iters_done += valid ? 0 : 1;
+            }
+        }
+
+        // The early exit: the whole tile stops iterating as soon as all of its points have escaped
+        for (uint32_t iter = 0; iters_done < TILE_SIZE && iter < limit; iter++) {
+#pragma omp simd reduction(+:iters_done)
+            for (uint32_t i = 0; i < TILE_SIZE; i++) {
+                float zRi = zR[i];
+                float zIi = zI[i];
+
+                float zRSq = zRi * zRi;
+                float zISq = zIi * zIi;
+
+                const bool cond = (zRSq + zISq) > 4.0f && result[i] == limit;
+                if (cond) {
+                    result[i] = iter;
+                    iters_done += 1;
+                }
+
+                zI[i] = 2.0f * zRi * zIi + cI[i];
+                zR[i] = zRSq - zISq + cR[i];
+            }
+        }
+
+        for (uint32_t y_local = 0; y_local < tile_height; y_local++) {
+            std::copy(result + y_local * TILE_WIDTH, result + y_local * TILE_WIDTH + tile_width,
+                      pdata + (y_base + y_local) * width + x_base);
+        }
+    }
+
+    // Copy upper half to lower half
+#pragma omp parallel for schedule(static) default(none) shared(pdata, width, height, half_height)
+    for (uint32_t y = half_height; y < height; y++) {
+#pragma omp simd aligned(pdata:64)
+        for (uint32_t x = 0; x < width; x++) {
+            pdata[y * width + x] = pdata[(height - y - 1) * width + x];
+        }
+    }
+
+    return reinterpret_cast<int *>(data);
+}
@@ -0,0 +1,24 @@
+/**
+ * @file TileMandelCalculator.h
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that uses SIMD parallelization over 2D tiles processed
+ *        by multiple threads
+ * @date 2022-11-16
+ */
+#ifndef TILEMANDELCALCULATOR_H
+#define TILEMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+
+class TileMandelCalculator : public BaseMandelCalculator {
+public:
+    TileMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+
+    ~TileMandelCalculator();
+
+    int *calculateMandelbrot();
+private:
+    uint32_t *data;
+};
+
+#endif
@@ -0,0 +1,316 @@
+/**
+ * @file block_codec.cpp
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The implementation of the block (streaming) mode of the LDPC encoder/decoder.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "block_codec.h"
+#include "decoder.h"
+#include "matrices_generator.h"
+#include "matrices_io.h"
+
+// The size of the buffer used for reading the standard input
+constexpr size_t readBufferSize = 1 << 16;
+
+/**
+ * Reads the standard input in large chunks and passes the accepted characters to a callback.
+ * @param accept A predicate that selects the characters to pass.
+ * @param consume The callback.
+ */
+template<typename Accept, typename Consume>
+static void readInput(Accept accept, Consume consume) {
+    std::vector<char> buffer(readBufferSize);
+
+    while (std::cin.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || std::cin.gcount() > 0) {
+        const auto count = static_cast<size_t>(std::cin.gcount());
+        for (size_t i = 0; i < count; ++i) {
+            if (accept(buffer[i])) {
+                consume(buffer[i]);
+            }
+        }
+    }
+}
+
+void runEncodeBlocks(const std::string &matrixPath, int blockBytes) {
+    const int blockBits = blockBytes * 8;
+    const int nCode = blockBits * 2;
+
+    GF2Matrix H;
+
+    // Read the parity check matrix from a file if provided, otherwise generate a new one and save
+    if (matrixPath.empty()) {
+        cv::Mat generated = parityCheckMatrix(nCode, randomSeed());
+        saveMatrix(generated, "matica.csv");
+        H = GF2Matrix::fromMat(generated);
+    } else {
+        H = toGF2Matrix(readSparseMatrix(matrixPath));
+
+        if (H.cols() != nCode) {
+            std::cerr << "Error: Block size does not match the size of the provided parity check matrix.\n";
+            return;
+        }
+    }
+
+    // The coding matrix is computed only once for all the blocks
+    GF2Matrix G = codingMatrix(H);
+
+    if (G.cols() != blockBits) {
+        std::cerr << "Error: The parity check matrix does not encode " << blockBits << " bits.\n";
+        return;
+    }
+
+    std::vector<uint64_t> packed(G.stride(), 0);
+    std::string line(G.rows(), '0');
+    int filled = 0;
+
+    auto encodeBlock = [&]() {
+        std::vector<uint64_t> encoded = G.multiplyVector(packed);
+        for (int i = 0; i < G.rows(); i++) {
+            line[i] = static_cast<char>('0' + ((encoded[i >> 6] >> (i & 63)) & 1));
+        }
+
+        std::cout << line << '\n';
+        std::fill(packed.begin(), packed.end(), 0);
+        filled = 0;
+    };
+
+    auto isInputChar = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+    };
+
+    readInput(isInputChar, [&](char c) {
+        // The bits of a byte go from the most significant one
+        for (int bit = 7; bit >= 0; --bit) {
+            const int i = filled * 8 + (7 - bit);
+            packed[i >> 6] |= static_cast<uint64_t>((c >> bit) & 1) << (i & 63);
+        }
+
+        if (++filled == blockBytes) {
+            encodeBlock();
+        }
+    });
+
+    // The last block is padded with zero bytes
+    if (filled > 0) {
+        encodeBlock();
+    }
+
+    std::cout.flush();
+}
+
+namespace {
+    struct CodewordBlock {
+        size_t index;
+        std::vector<int> bits;
+    };
+
+    /**
+     * The shared state of the decoding pipeline.
+     * The reader takes a slot before it reads a block and the writer returns it when the block is written,
+     * so the number of blocks in the input queue, being decoded and waiting for the writer is bounded.
+     */
+    class DecodePipeline {
+    public:
+        explicit DecodePipeline(size_t maxBlocks) : freeSlots(maxBlocks) {}
+
+        void acquireSlot() {
+            std::unique_lock lock(mutex);
+            slotAvailable.wait(lock, [this] { return freeSlots > 0; });
+            freeSlots--;
+        }
+
+        void releaseSlot() {
+            {
+                std::lock_guard lock(mutex);
+                freeSlots++;
+            }
+            slotAvailable.notify_one();
+        }
+
+        void pushInput(CodewordBlock block) {
+            {
+                std::lock_guard lock(mutex);
+                input.push_back(std::move(block));
+            }
+            inputAvailable.notify_one();
+        }
+
+        void closeInput(size_t totalBlocks) {
+            {
+                std::lock_guard lock(mutex);
+                inputClosed = true;
+                blockCount = totalBlocks;
+            }
+            inputAvailable.notify_all();
+            outputAvailable.notify_all();
+        }
+
+        /**
+         * Takes a block to decode.
+         * @return False if there are no more blocks.
+         */
+        bool popInput(CodewordBlock &block) {
+            std::unique_lock lock(mutex);
+            inputAvailable.wait(lock, [this] { return !input.empty() || inputClosed; });
+            if (input.empty()) {
+                return false;
+            }
+
+            block = std::move(input.front());
+            input.pop_front();
+            return true;
+        }
+
+        void pushOutput(size_t index, std::string message) {
+            {
+                std::lock_guard lock(mutex);
+                output.emplace(index, std::move(message));
+            }
+            outputAvailable.notify_one();
+        }
+
+        /**
+         * Waits for the message of the next block in order.
+         * @return False if all the blocks have been written.
+         */
+        bool popOutput(std::string &message) {
+            std::unique_lock lock(mutex);
+            outputAvailable.wait(lock, [this] {
+                return (!output.empty() && output.begin()->first == nextOutput) ||
+                       (inputClosed && nextOutput == blockCount);
+            });
+
+            if (inputClosed && nextOutput == blockCount) {
+                return false;
+            }
+
+            message = std::move(output.begin()->second);
+            output.erase(output.begin());
+            nextOutput++;
+            return true;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable slotAvailable;
+        std::condition_variable inputAvailable;
+        std::condition_variable outputAvailable;
+
+        size_t freeSlots;
+        std::deque<CodewordBlock> input;
+        bool inputClosed = false;
+        size_t blockCount = 0;
+
+        std::map<size_t, std::string> output;
+        size_t nextOutput = 0;
+    };
+}
+
+/**
+ * Composes the bits of a message into bytes, the zero bytes (padding) are left out.
+ */
+static std::string messageToText(const std::vector<int> &bits) {
+    std::string text;
+    text.reserve(bits.size() / 8);
+
+    for (size_t i = 0; i + 8 <= bits.size(); i += 8) {
+        char c = 0;
+        for (size_t j = 0; j < 8; ++j) {
+            c = static_cast<char>((c << 1) | bits[i + j]);
+        }
+
+        if (c != '\0') {
+            text.push_back(c);
+        }
+    }
+
+    return text;
+}
+
+void runDecodeBlocks(const std::string &matrixPath, int blockBytes, BPAlgorithm algorithm, unsigned threads) {
+    const int nCode = blockBytes * 16;
+
+    // The matrix and everything derived from it is loaded once and shared by all the decoder threads
+    const SparseParityCheck sparseH = readSparseMatrix(matrixPath);
+
+    if (sparseH.cols != nCode) {
+        std::cerr << "Error: Block size does not match the size of the provided parity check matrix.\n";
+        return;
+    }
+
+    const MessageExtractor extractor(codingMatrix(toGF2Matrix(sparseH)));
+
+    if (extractor.messageBits() % 8 != 0) {
+        std::cerr << "The number of decoded bits is not a multiple of 8." << std::endl;
+    }
+
+    threads = std::max(threads, 1u);
+    DecodePipeline pipeline(4 * static_cast<size_t>(threads));
+
+    std::thread reader([&]() {
+        CodewordBlock block{0, {}};
+        block.bits.reserve(nCode);
+        bool hasSlot = false;
+
+        readInput([](char c) { return c == '0' || c == '1'; }, [&](char c) {
+            if (!hasSlot) {
+                pipeline.acquireSlot();
+                hasSlot = true;
+            }
+
+            block.bits.push_back(c - '0');
+
+            if (block.bits.size() == static_cast<size_t>(nCode)) {
+                size_t next = block.index + 1;
+                pipeline.pushInput(std::move(block));
+
+                block = CodewordBlock{next, {}};
+                block.bits.reserve(nCode);
+                hasSlot = false;
+            }
+        });
+
+        if (!block.bits.empty()) {
+            std::cerr << "Error: The input ends with an incomplete block, it is ignored.\n";
+        }
+        if (hasSlot) {
+            pipeline.releaseSlot();
+        }
+
+        pipeline.closeInput(block.index);
+    });
+
+    std::vector<std::thread> decoders;
+    for (unsigned t = 0; t < threads; ++t) {
+        decoders.emplace_back([&]() {
+            CodewordBlock block;
+            while (pipeline.popInput(block)) {
+                auto decoded = decodeSparse(sparseH, block.bits, algorithm);
+                pipeline.pushOutput(block.index, messageToText(extractor.getMessage(decoded)));
+            }
+        });
+    }
+
+    // The ordered writer
+    std::string message;
+    while (pipeline.popOutput(message)) {
+        std::cout << message;
+        pipeline.releaseSlot();
+    }
+
+    std::cout << std::endl;
+
+    reader.join();
+    for (auto &decoder: decoders) {
+        decoder.join();
+    }
+}
@@ -0,0 +1,39 @@
+/**
+ * @file block_codec.h
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The interface of the block (streaming) mode of the LDPC encoder/decoder.
+ *
+ * In the block mode, the code has a fixed size chosen once for the whole run. The input message is split into
+ * blocks of a given number of bytes, the last block is padded with zero bytes. Every block is encoded into one
+ * codeword which is printed on a separate line. The decoder reads the codewords, decodes them in parallel and
+ * prints the messages in the original order, with the padding removed.
+ */
+
+#ifndef BMS_BLOCK_CODEC_H
+#define BMS_BLOCK_CODEC_H
+
+#include <string>
+
+#include "sparse_decoder.h"
+
+/**
+ * Runs the encoder in the block mode.
+ * @param matrixPath A path to the parity check matrix. If empty, a new matrix is generated and saved.
+ * @param blockBytes The number of message bytes in a block; the codewords have blockBytes * 16 bits.
+ */
+void runEncodeBlocks(const std::string &matrixPath, int blockBytes);
+
+/**
+ * Runs the decoder in the block mode.
+ * A reader thread splits the input into codewords, a pool of threads decodes them and the calling thread writes
+ * the messages in order. At most a fixed number of blocks (proportional to the number of threads) is held
+ * in memory at any time.
+ * @param matrixPath A path to the parity check matrix.
+ * @param blockBytes The number of message bytes in a block.
+ * @param algorithm The check node update rule of the belief propagation decoder.
+ * @param threads The number of decoder threads.
+ */
+void runDecodeBlocks(const std::string &matrixPath, int blockBytes, BPAlgorithm algorithm, unsigned threads);
+
+#endif //BMS_BLOCK_CODEC_H
@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
 #include <bitset>
 
 #include "decoder.h"
@@ -240,64 +241,90 @@ cv::Mat decode(const cv::Mat &Hi, const cv::Mat &yi, double bitFlipProbability,
     return x32S;
 }
 
-cv::Mat getMessageFromCodeword(const cv::Mat &tG, const cv::Mat &x) {
+MessageExtractor::MessageExtractor(const GF2Matrix &tG) {
     // Implements pyldpc'S get_message:
     // https://github.com/hichamjanati/pyldpc/blob/a821ccd1eb3a13b8a0f66ebba8d9923ce2f528ef/pyldpc/decoder.py#L186
+    // The elimination of [tG | x] is replaced by an elimination of [tG | I] which records the row operations.
 
-    int k = tG.cols;
+    int n = tG.rows(), k = tG.cols();
 
-    cv::Mat rtG = tG.clone();
-    cv::Mat rx = x.clone();
+    GF2Matrix augmented(n, k + n);
+    for (int i = 0; i < n; ++i) {
+        std::copy(tG.row(i), tG.row(i) + tG.stride(), augmented.row(i));
+        augmented.set(i, k + i, true);
+    }
+
+    reduceRowEchelon(augmented, std::min(n, k));
+
+    // Only the first k rows take part in the back substitution
+    GF2Matrix top = augmented.rowRange(0, std::min(n, k));
+    reduced = top.colRange(0, k);
+    transform = top.colRange(k, k + n);
+}
 
-    gaussElimination(rtG, rx);
+std::vector<int> MessageExtractor::getMessage(const std::vector<int> &x) const {
+    int k = reduced.cols();
 
-    cv::Mat message = cv::Mat::zeros(1, k, CV_32S);
+    std::vector<uint64_t> rx = transform.multiplyVector(packBits(x, transform.stride()));
+    rx.resize(reduced.stride(), 0);
 
-    message.at<int>(0, k - 1) = rx.at<int>(k - 1);
+    // Back substitution; the bits of the message are filled from the end, so the parity of a row ANDed
+    // with the (packed) message only sums the bits right of the diagonal
+    std::vector<uint64_t> message(reduced.stride(), 0);
 
-    for (int i = k - 2; i >= 0; --i) {
-        message.at<int>(0, i) = rx.at<int>(i);
+    for (int i = std::min(reduced.rows(), k) - 1; i >= 0; --i) {
+        const uint64_t *row = reduced.row(i);
+        uint64_t acc = 0;
+        for (size_t w = 0; w < reduced.stride(); ++w) {
+            acc ^= row[w] & message[w];
+        }
 
-        auto rtGRow = rtG.row(i).colRange(i + 1, k);
-        auto msgCol = message.colRange(i + 1, k).t();
-        cv::Mat product = binaryProduct(rtGRow, msgCol);
+        uint64_t bit = ((rx[i >> 6] >> (i & 63)) ^ __builtin_popcountll(acc)) & 1;
+        message[i >> 6] |= bit << (i & 63);
+    }
 
-        message.at<int>(0, i) -= product.at<int>(0, 0);
+    std::vector<int> result(k);
+    for (int i = 0; i < k; ++i) {
+        result[i] = static_cast<int>((message[i >> 6] >> (i & 63)) & 1);
     }
 
-    return abs(message);
+    return result;
+}
+
+std::vector<int> getMessageFromCodeword(const GF2Matrix &tG, const std::vector<int> &x) {
+    return MessageExtractor(tG).getMessage(x);
 }
 
-void runDecode(const std::string &matrixPath) {
+void runDecode(const std::string &matrixPath, BPAlgorithm algorithm) {
     auto input = readInputToEnd();
     auto inputBits = static_cast<int>(input.size());
-    cv::Mat H = readMatrix(matrixPath);
+    SparseParityCheck H = readSparseMatrix(matrixPath);
 
     if (H.cols != inputBits) {
         std::cerr << "Error: Input size does not match the size of the provided parity check matrix.\n";
         return;
     }
 
-    cv::Mat G = codingMatrix(H);
-    auto inputMat = cv::Mat(input);
-    // Run the belief propagation algorithm
-    cv::Mat d = decode(H, inputMat);
+    GF2Matrix G = codingMatrix(toGF2Matrix(H));
+    // Run the belief propagation algorithm on the Tanner graph of H
+    auto decoded = decodeSparse(H, input, algorithm);
     // Decode the resulting codeword
-    cv::Mat y = getMessageFromCodeword(G, d);
+    std::vector<int> y = getMessageFromCodeword(G, decoded);
+    const int yBits = static_cast<int>(y.size());
 
-    if (y.cols % 8 != 0) {
+    if (yBits % 8 != 0) {
         std::cerr << "The number of decoded bits is not a multiple of 8." << std::endl;
     }
 
     // Compose the bits into bytes and print as characters
-    for (int i = 0; i < y.cols; i += 8) {
-        if (i + 8 > y.cols) {
+    for (int i = 0; i < yBits; i += 8) {
+        if (i + 8 > yBits) {
             break;
         }
 
         std::bitset<8> byte;
         for (int j = 0; j < 8; ++j) {
-            byte[7 - j] = y.at<int>(0, i + j);
+            byte[7 - j] = y[i + j];
         }
         char c = static_cast<char>(byte.to_ulong());
         std::cout << c;
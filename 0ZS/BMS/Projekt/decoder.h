@@ -11,6 +11,9 @@
 #include <opencv2/core/mat.hpp>
 #include <opencv2/core.hpp>
 
+#include "gf2_matrix.h"
+#include "sparse_decoder.h"
+
 /**
  * Runs a belief-propagation decoding algorithm for a given input, using a given parity check matrix.
  * Assumes a binary symmetric channel (BSC) with a given bit flip probability.
@@ -22,18 +25,50 @@
  */
 cv::Mat decode(const cv::Mat &Hi, const cv::Mat &yi, double bitFlipProbability = 0.15, int maxIterations = 500);
 
+/**
+ * Computes the input messages corresponding to the codewords of a single code.
+ * The Gaussian elimination of the transposed coding matrix does not depend on the codeword, so it is performed
+ * once in the constructor and every message then costs a matrix-vector product and a back substitution.
+ */
+class MessageExtractor {
+public:
+    /**
+     * @param tG A transposed coding matrix.
+     */
+    explicit MessageExtractor(const GF2Matrix &tG);
+
+    /**
+     * Computes the input message corresponding to a codeword.
+     * @param x A codeword.
+     * @return The input message.
+     */
+    std::vector<int> getMessage(const std::vector<int> &x) const;
+
+    /**
+     * The number of bits of a message.
+     */
+    int messageBits() const { return reduced.cols(); }
+
+private:
+    // The first k rows of tG in the reduced row echelon form
+    GF2Matrix reduced;
+    // The first k rows of the transformation that brings tG to the reduced row echelon form
+    GF2Matrix transform;
+};
+
 /**
  * Computes the input message corresponding to a codeword.
  * @param tG A transposed coding matrix.
  * @param x A codeword.
  * @return The input message.
  */
-cv::Mat getMessageFromCodeword(const cv::Mat &tG, const cv::Mat &x);
+std::vector<int> getMessageFromCodeword(const GF2Matrix &tG, const std::vector<int> &x);
 
 /**
  * Runs the decoder with a given parity check matrix.
  * @param matrixPath A path to the parity check matrix.
+ * @param algorithm The check node update rule of the (sparse) belief propagation decoder.
  */
-void runDecode(const std::string &matrixPath);
+void runDecode(const std::string &matrixPath, BPAlgorithm algorithm = BPAlgorithm::SumProduct);
 
 #endif //BMS_DECODER_H
@@ -7,7 +7,6 @@
 
 #include <opencv2/core/mat.hpp>
 #include <iostream>
-#include <random>
 
 #include "maths.h"
 #include "matrices_generator.h"
@@ -31,50 +30,40 @@ void runEncode(const std::string &matrixPath) {
     auto inputLen = static_cast<int>(input.size());
     auto inputBits = inputLen * 8;
 
-    cv::Mat H;
+    GF2Matrix H;
 
     // Read the parity check matrix from a file if provided, otherwise generate a new one and save
     if (matrixPath.empty()) {
-        // Make the seed random
-        unsigned int randomSeed;
-        try {
-            std::random_device randomDevice;
-            randomSeed = randomDevice();
-        } catch (const std::exception &e) {
-            // Not doing cryptography here...
-            randomSeed = static_cast<unsigned int>(time(nullptr));
-        }
-
-        H = parityCheckMatrix(inputBits * 2, randomSeed);
-        saveMatrix(H, "matica.csv");
+        cv::Mat generated = parityCheckMatrix(inputBits * 2, randomSeed());
+        saveMatrix(generated, "matica.csv");
+        H = GF2Matrix::fromMat(generated);
     } else {
-        H = readMatrix(matrixPath);
+        H = toGF2Matrix(readSparseMatrix(matrixPath));
 
-        if (H.cols != inputBits * 2) {
+        if (H.cols() != inputBits * 2) {
             std::cerr << "Error: Input size does not match the size of the provided parity check matrix.\n";
             return;
         }
     }
 
     // Calculate the coding matrix
-    cv::Mat G = codingMatrix(H);
+    GF2Matrix G = codingMatrix(H);
 
     // Create a vector of 0s and 1s from the input
-    cv::Mat inputMatrix = cv::Mat::zeros(inputBits, 1, CV_32S);
+    std::vector<int> inputVector(inputBits);
     for (int i = 0; i < inputBits; ++i) {
         const int byte = i / 8;
         const int bit = 7 - i % 8;
 
-        const int inputBit = (input[byte] & (1 << (bit))) >> bit;
-        inputMatrix.at<int>(i, 0) = inputBit;
+        inputVector[i] = (input[byte] & (1 << (bit))) >> bit;
     }
 
     // Encode the input bits by multiplying by the coding matrix
-    cv::Mat encoded = binaryProduct(G, inputMatrix);
+    std::vector<uint64_t> encoded = G.multiplyVector(packBits(inputVector, G.stride()));
 
-    // The result is a column vector (n_output_bits x 1 matrix), print it
-    for (int i = 0; i < encoded.rows; i++) {
-        std::cout << encoded.at<int>(i, 0);
+    // The result is a packed column vector of G.rows() bits, print it
+    for (int i = 0; i < G.rows(); i++) {
+        std::cout << ((encoded[i >> 6] >> (i & 63)) & 1);
     }
 
     std::cout << std::endl;
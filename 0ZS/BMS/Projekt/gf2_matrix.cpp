@@ -0,0 +1,195 @@
+/**
+ * @file gf2_matrix.cpp
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The implementation of a bit-packed matrix over the binary field GF(2).
+ */
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BMS_HAS_AVX2_PATH 1
+#endif
+
+#include "gf2_matrix.h"
+
+// Rows are padded to this number of words (one AVX2 register)
+constexpr size_t wordsPerVector = 4;
+
+static size_t strideFor(int cols) {
+    size_t words = (static_cast<size_t>(cols) + 63) / 64;
+    return (words + wordsPerVector - 1) / wordsPerVector * wordsPerVector;
+}
+
+static void xorWordsScalar(uint64_t *dst, const uint64_t *src, size_t words) {
+    for (size_t i = 0; i < words; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+#ifdef BMS_HAS_AVX2_PATH
+__attribute__((target("avx2")))
+static void xorWordsAvx2(uint64_t *dst, const uint64_t *src, size_t words) {
+    size_t i = 0;
+    for (; i + wordsPerVector <= words; i += wordsPerVector) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(a, b));
+    }
+    xorWordsScalar(dst + i, src + i, words - i);
+}
+#endif
+
+void xorWords(uint64_t *dst, const uint64_t *src, size_t words) {
+#ifdef BMS_HAS_AVX2_PATH
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        xorWordsAvx2(dst, src, words);
+        return;
+    }
+#endif
+    xorWordsScalar(dst, src, words);
+}
+
+/**
+ * Transposes a 64x64 bit block in place (bit j of a[i] <-> bit i of a[j]).
+ */
+static void transpose64(uint64_t a[64]) {
+    uint64_t mask = 0x00000000FFFFFFFFull;
+    for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+GF2Matrix::GF2Matrix(int rows, int cols)
+        : rowCount(rows), colCount(cols), rowStride(strideFor(cols)),
+          data(static_cast<size_t>(rows) * strideFor(cols), 0) {
+}
+
+GF2Matrix GF2Matrix::identity(int n) {
+    GF2Matrix result(n, n);
+    for (int i = 0; i < n; ++i) {
+        result.set(i, i, true);
+    }
+    return result;
+}
+
+GF2Matrix GF2Matrix::fromMat(const cv::Mat &matrix) {
+    GF2Matrix result(matrix.rows, matrix.cols);
+    for (int i = 0; i < matrix.rows; ++i) {
+        const int *src = matrix.ptr<int>(i);
+        uint64_t *dst = result.row(i);
+        for (int j = 0; j < matrix.cols; ++j) {
+            dst[j >> 6] |= static_cast<uint64_t>(src[j] & 1) << (j & 63);
+        }
+    }
+    return result;
+}
+
+cv::Mat GF2Matrix::toMat() const {
+    cv::Mat result = cv::Mat::zeros(rowCount, colCount, CV_32S);
+    for (int i = 0; i < rowCount; ++i) {
+        int *dst = result.ptr<int>(i);
+        for (int j = 0; j < colCount; ++j) {
+            dst[j] = get(i, j);
+        }
+    }
+    return result;
+}
+
+void GF2Matrix::addRow(int dst, int src) {
+    xorWords(row(dst), row(src), rowStride);
+}
+
+void GF2Matrix::swapRows(int a, int b) {
+    std::swap_ranges(row(a), row(a) + rowStride, row(b));
+}
+
+size_t GF2Matrix::countOnes() const {
+    size_t result = 0;
+    for (uint64_t word: data) {
+        result += __builtin_popcountll(word);
+    }
+    return result;
+}
+
+GF2Matrix GF2Matrix::transposed() const {
+    GF2Matrix result(colCount, rowCount);
+    uint64_t block[64];
+
+    // Transpose 64x64 blocks: block (bi, bj) of this matrix becomes block (bj, bi) of the result
+    for (int bi = 0; bi < rowCount; bi += 64) {
+        for (int bj = 0; bj < colCount; bj += 64) {
+            for (int r = 0; r < 64; ++r) {
+                block[r] = bi + r < rowCount ? row(bi + r)[bj >> 6] : 0;
+            }
+
+            transpose64(block);
+
+            for (int c = 0; c < 64 && bj + c < colCount; ++c) {
+                result.row(bj + c)[bi >> 6] = block[c];
+            }
+        }
+    }
+
+    return result;
+}
+
+GF2Matrix GF2Matrix::rowRange(int begin, int end) const {
+    GF2Matrix result(end - begin, colCount);
+    std::copy(row(begin), row(begin) + (end - begin) * rowStride, result.data.begin());
+    return result;
+}
+
+GF2Matrix GF2Matrix::colRange(int begin, int end) const {
+    GF2Matrix result(rowCount, end - begin);
+    const size_t words = (static_cast<size_t>(end - begin) + 63) / 64;
+    const size_t shift = begin & 63;
+
+    for (int i = 0; i < rowCount; ++i) {
+        const uint64_t *src = row(i) + (begin >> 6);
+        uint64_t *dst = result.row(i);
+        for (size_t w = 0; w < words; ++w) {
+            dst[w] = src[w] >> shift;
+            if (shift != 0 && (begin >> 6) + w + 1 < rowStride) {
+                dst[w] |= src[w + 1] << (64 - shift);
+            }
+        }
+
+        // Clear the bits beyond the new width
+        if ((end - begin) & 63) {
+            dst[words - 1] &= (uint64_t(1) << ((end - begin) & 63)) - 1;
+        }
+    }
+
+    return result;
+}
+
+std::vector<uint64_t> GF2Matrix::multiplyVector(const std::vector<uint64_t> &x) const {
+    std::vector<uint64_t> result((static_cast<size_t>(rowCount) + 63) / 64, 0);
+
+    for (int i = 0; i < rowCount; ++i) {
+        const uint64_t *r = row(i);
+        uint64_t acc = 0;
+        for (size_t w = 0; w < rowStride; ++w) {
+            acc ^= r[w] & x[w];
+        }
+
+        result[i >> 6] |= static_cast<uint64_t>(__builtin_popcountll(acc) & 1) << (i & 63);
+    }
+
+    return result;
+}
+
+std::vector<uint64_t> packBits(const std::vector<int> &bits, size_t words) {
+    std::vector<uint64_t> result(std::max(words, (bits.size() + 63) / 64), 0);
+    for (size_t j = 0; j < bits.size(); ++j) {
+        result[j >> 6] |= static_cast<uint64_t>(bits[j] & 1) << (j & 63);
+    }
+    return result;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file gf2_matrix.h
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The interface of a bit-packed matrix over the binary field GF(2).
+ */
+
+#ifndef BMS_GF2_MATRIX_H
+#define BMS_GF2_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core/mat.hpp>
+
+/**
+ * A matrix over GF(2) with every row packed into 64-bit words.
+ * Bit j of a row is stored in word j / 64 at position j % 64. The rows are padded to a multiple of
+ * four words (256 bits) so that a whole row can be processed with AVX2 instructions; the padding bits
+ * are always zero.
+ */
+class GF2Matrix {
+public:
+    GF2Matrix() = default;
+
+    /**
+     * Creates a zero matrix.
+     */
+    GF2Matrix(int rows, int cols);
+
+    static GF2Matrix identity(int n);
+
+    /**
+     * Packs a matrix of 0s and 1s (of type CV_32S).
+     */
+    static GF2Matrix fromMat(const cv::Mat &matrix);
+
+    /**
+     * Unpacks the matrix into a CV_32S matrix of 0s and 1s.
+     */
+    cv::Mat toMat() const;
+
+    int rows() const { return rowCount; }
+
+    int cols() const { return colCount; }
+
+    /**
+     * The number of words of a single (padded) row.
+     */
+    size_t stride() const { return rowStride; }
+
+    uint64_t *row(int i) { return data.data() + i * rowStride; }
+
+    const uint64_t *row(int i) const { return data.data() + i * rowStride; }
+
+    bool get(int i, int j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+
+    void set(int i, int j, bool value) {
+        uint64_t mask = uint64_t(1) << (j & 63);
+        if (value)
+            row(i)[j >> 6] |= mask;
+        else
+            row(i)[j >> 6] &= ~mask;
+    }
+
+    /**
+     * Row dst := row dst + row src.
+     */
+    void addRow(int dst, int src);
+
+    void swapRows(int a, int b);
+
+    /**
+     * The number of 1s in the matrix.
+     */
+    size_t countOnes() const;
+
+    GF2Matrix transposed() const;
+
+    /**
+     * Copies the rows [begin, end).
+     */
+    GF2Matrix rowRange(int begin, int end) const;
+
+    /**
+     * Copies the columns [begin, end).
+     */
+    GF2Matrix colRange(int begin, int end) const;
+
+    /**
+     * Computes the product of this matrix and a column vector.
+     * Every output bit is the parity of a row ANDed with the vector, computed word by word.
+     * @param x The vector, packed the same way as the rows (at least stride() words).
+     * @return The product, packed.
+     */
+    std::vector<uint64_t> multiplyVector(const std::vector<uint64_t> &x) const;
+
+private:
+    int rowCount = 0;
+    int colCount = 0;
+    size_t rowStride = 0;
+    std::vector<uint64_t> data;
+};
+
+/**
+ * dst[i] ^= src[i] for i in [0, words), uses AVX2 when the CPU supports it.
+ */
+void xorWords(uint64_t *dst, const uint64_t *src, size_t words);
+
+/**
+ * Packs a vector of 0s and 1s into 64-bit words.
+ * @param bits The bits.
+ * @param words The minimum number of words of the result.
+ */
+std::vector<uint64_t> packBits(const std::vector<int> &bits, size_t words = 0);
+
+#endif //BMS_GF2_MATRIX_H
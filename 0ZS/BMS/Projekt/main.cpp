@@ -10,14 +10,23 @@
  * In the encode mode, the parity check matrix can optionally be specified with -m. If not specified,
  * a new random LDPC matrix is generated and saved to matica.csv.
  *
- * In the decode mode, the parity check matrix must be specified with -m.
+ * In the decode mode, the parity check matrix must be specified with -m. The belief propagation variant
+ * can be selected with -a: sp (sum-product, default), ms (min-sum) or oms (offset min-sum).
  *
- * The provided matrix file must exist and contain a valid matrix stored in CSV format.
- * Neither of these requirements is checked.
+ * With -b <bytes>, both modes work on a stream of blocks of the given size instead of the whole input
+ * (see block_codec.h). The number of decoder threads can then be set with -t (defaults to the number of CPUs).
+ *
+ * The provided matrix file must exist and contain a valid matrix stored in CSV format or in the binary format
+ * (see matrices_io.h). Neither of these requirements is checked. A matrix can be converted between the two
+ * formats with -c <input> <output>.
  */
 
 #include <iostream>
+#include <thread>
+
+#include "block_codec.h"
 #include "decoder.h"
+#include "matrices_io.h"
 
 void runEncode(const std::string &matrixPath);
 
@@ -25,6 +34,9 @@ int main(int argc, char *argv[]) {
     bool encode = false;
     bool decode = false;
     std::string path;
+    BPAlgorithm algorithm = BPAlgorithm::SumProduct;
+    int blockBytes = 0;
+    unsigned threads = std::thread::hardware_concurrency();
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
@@ -42,11 +54,46 @@ int main(int argc, char *argv[]) {
                 return 1;
             }
             decode = true;
+        } else if (arg == "-c" && i + 2 < argc) {
+            convertMatrix(argv[i + 1], argv[i + 2]);
+            return 0;
         } else if (arg == "-m" && i + 1 < argc) {
             i++;
             path = argv[i];
+        } else if (arg == "-a" && i + 1 < argc) {
+            i++;
+            std::string value = argv[i];
+            if (value == "sp") {
+                algorithm = BPAlgorithm::SumProduct;
+            } else if (value == "ms") {
+                algorithm = BPAlgorithm::MinSum;
+            } else if (value == "oms") {
+                algorithm = BPAlgorithm::OffsetMinSum;
+            } else {
+                std::cerr << "Error: Unknown decoding algorithm, use sp, ms or oms.\n";
+                return 1;
+            }
+        } else if ((arg == "-b" || arg == "-t") && i + 1 < argc) {
+            i++;
+            int value;
+            try {
+                value = std::stoi(argv[i]);
+            } catch (const std::exception &e) {
+                value = 0;
+            }
+
+            if (value <= 0) {
+                std::cerr << "Error: The value of " << arg << " must be a positive number.\n";
+                return 1;
+            }
+
+            if (arg == "-b") {
+                blockBytes = value;
+            } else {
+                threads = static_cast<unsigned>(value);
+            }
         } else {
-            std::cerr << "Error: Unknown argument or missing value for -m.\n";
+            std::cerr << "Error: Unknown argument or missing value for -m, -a, -b, -t or -c.\n";
             return 1;
         }
     }
@@ -56,10 +103,16 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    if (encode) {
+    if (blockBytes > 0) {
+        if (encode) {
+            runEncodeBlocks(path, blockBytes);
+        } else {
+            runDecodeBlocks(path, blockBytes, algorithm, threads);
+        }
+    } else if (encode) {
         runEncode(path);
     } else {
-        runDecode(path);
+        runDecode(path, algorithm);
     }
 
     return 0;
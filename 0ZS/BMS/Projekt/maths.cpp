@@ -8,6 +8,8 @@
  * https://github.com/hichamjanati/pyldpc/blob/master/pyldpc/utils.py.
  */
 
+#include <algorithm>
+
 #include "maths.h"
 
 cv::Mat binaryProductFloat(const cv::Mat &X, const cv::Mat &Y) {
@@ -35,88 +37,192 @@ cv::Mat binaryProduct(const cv::Mat &X, const cv::Mat &Y) {
     return result32S;
 }
 
-std::pair<cv::Mat, cv::Mat> gaussJordan(const cv::Mat &X) {
-    cv::Mat A = X.clone(); // Make a working matrix
-    int m = A.rows, n = A.cols;
-    cv::Mat P = cv::Mat::eye(m, m, CV_32S);
-
-    int pivot_old = -1;
-    // Iterate over each column of the working matrix
-    for (int j = 0; j < n; ++j) {
-        // Find pivot (the first row with a 1 in the current column)
-        int pivot = pivot_old + 1;
-        for (int i = pivot; i < m; ++i) {
-            if (A.at<int>(i, j) == 1) {
-                pivot = i;
-                break;
+
+// The number of columns covered by a single lookup table of reduceRowEchelon(), the table has 2^tableBits rows
+constexpr int tableBits = 8;
+// The number of lookup tables, reduceRowEchelon() eliminates up to tableBits * tableCount columns in a single pass
+constexpr int tableCount = 4;
+constexpr int blockSize = tableBits * tableCount;
+
+/**
+ * Extracts the bits [begin, begin + 64) of a row.
+ */
+static uint64_t rowWindow(const GF2Matrix &A, int i, int begin) {
+    const uint64_t *row = A.row(i) + begin / 64;
+    const int shift = begin % 64;
+    uint64_t window = row[0] >> shift;
+    if (shift != 0 && static_cast<size_t>(begin / 64 + 1) < A.stride()) {
+        window |= row[1] << (64 - shift);
+    }
+    return window;
+}
+
+int reduceRowEchelon(GF2Matrix &A, int columns) {
+    const int m = A.rows();
+    const size_t stride = A.stride();
+    const size_t tableSize = (size_t(1) << tableBits) * stride;
+
+    std::vector<uint64_t> tables(tableCount * tableSize);
+    int pivotColumns[blockSize];
+    int rank = 0;
+
+    // The state of the candidate rows during the pivot search, see below
+    std::vector<uint64_t> windows(m);
+    std::vector<uint32_t> combinations(m);
+    std::vector<int> reducedBy(m);
+    uint64_t pivotWindows[blockSize];
+
+    for (int blockStart = 0; blockStart < columns && rank < m; blockStart += blockSize) {
+        const int blockEnd = std::min(blockStart + blockSize, columns);
+        const int firstPivot = rank;
+        int pivots = 0;
+
+        // Find the pivots of the block. A candidate row is first reduced by the pivots of the block found so far,
+        // this way the pivot rows are the same as if the block columns were eliminated one by one.
+        // Only the block columns of a candidate are reduced (windows[i]); the pivots added to it are recorded
+        // in combinations[i] and applied to the whole row only when it becomes a pivot.
+        // reducedBy[i] is the number of the block pivots the row i has already been reduced by, -1 if it hasn't
+        // been visited in this block yet.
+        std::fill(reducedBy.begin() + rank, reducedBy.end(), -1);
+
+        for (int j = blockStart; j < blockEnd && rank < m; ++j) {
+            int pivot = -1;
+            for (int i = rank; i < m; ++i) {
+                if (reducedBy[i] == -1) {
+                    windows[i] = rowWindow(A, i, blockStart);
+                    combinations[i] = 0;
+                    reducedBy[i] = 0;
+                }
+
+                for (int p = reducedBy[i]; p < pivots; ++p) {
+                    if ((windows[i] >> (pivotColumns[p] - blockStart)) & 1) {
+                        windows[i] ^= pivotWindows[p];
+                        combinations[i] ^= uint32_t(1) << p;
+                    }
+                }
+                reducedBy[i] = pivots;
+
+                if ((windows[i] >> (j - blockStart)) & 1) {
+                    pivot = i;
+                    break;
+                }
+            }
+
+            if (pivot == -1) {
+                continue;
             }
-        }
 
-        if (A.at<int>(pivot, j)) {
-            // Swap the rows to bring the pivot to the diagonal position
-            pivot_old++;
-            if (pivot_old != pivot) {
-                cv::Mat temp = A.row(pivot).clone();
-                A.row(pivot) = A.row(pivot_old) + 0;
-                A.row(pivot_old) = temp + 0;
-
-                // Apply the same on the permutation matrix P
-                temp = P.row(pivot).clone();
-                P.row(pivot) = P.row(pivot_old) + 0;
-                P.row(pivot_old) = temp + 0;
+            if (pivot != rank) {
+                A.swapRows(pivot, rank);
+                std::swap(windows[pivot], windows[rank]);
+                std::swap(combinations[pivot], combinations[rank]);
+                std::swap(reducedBy[pivot], reducedBy[rank]);
             }
 
-            // Clear all row in the column using the pivot row
-            for (int i = 0; i < m; ++i) {
-                if (i != pivot_old && A.at<int>(i, j) == 1) {
-                    A.row(i) = abs(A.row(i) - A.row(pivot_old));
-                    // Apply the same on the permutation matrix P
-                    P.row(i) = abs(P.row(i) - P.row(pivot_old));
+            for (int p = 0; p < pivots; ++p) {
+                if ((combinations[rank] >> p) & 1) {
+                    A.addRow(rank, firstPivot + p);
                 }
             }
-        }
 
-        if (pivot_old == m - 1) {
-            break;
+            pivotWindows[pivots] = windows[rank];
+            pivotColumns[pivots++] = j;
+            rank++;
         }
-    }
 
-    return {A, P};
-}
+        if (pivots == 0) {
+            continue;
+        }
 
-void gaussElimination(cv::Mat &A, cv::Mat &b) {
-    int n = A.rows;
-    for (int i = 0; i < n; ++i) {
-        // Find pivot
-        int pivot = -1;
-        for (int row = i; row < n; ++row) {
-            if (A.at<int>(row, i) == 1) {
-                pivot = row;
-                break;
+        // Clear the block columns above the diagonal of the pivot rows (below it, they're already clear)
+        for (int p = pivots - 1; p > 0; --p) {
+            for (int q = 0; q < p; ++q) {
+                if (A.get(firstPivot + q, pivotColumns[p])) {
+                    A.addRow(firstPivot + q, firstPivot + p);
+                }
             }
         }
-        if (pivot == -1) continue; // No pivot, skip column
-
-        // Swap rows
-        if (pivot != i) {
-            cv::Mat temp;
-            A.row(i).copyTo(temp);
-            A.row(pivot).copyTo(A.row(i));
-            temp.copyTo(A.row(pivot));
-
-            uchar tempVal = b.at<int>(i);
-            b.at<int>(i) = b.at<int>(pivot);
-            b.at<int>(pivot) = tempVal;
+
+        // All the rows from firstPivot on are zero in the columns left of the block, so only the words
+        // from the block on need to be processed
+        const size_t firstWord = blockStart / 64;
+        const size_t words = stride - firstWord;
+        const int usedTables = (pivots + tableBits - 1) / tableBits;
+
+        // Build a table of all linear combinations for every group of tableBits pivot rows. The pivot rows are
+        // zero in the pivot columns of each other, so the tables can be applied independently.
+        for (int t = 0; t < usedTables; ++t) {
+            const int groupPivots = std::min(tableBits, pivots - t * tableBits);
+            uint64_t *table = tables.data() + t * tableSize;
+
+            for (size_t mask = 1; mask < (size_t(1) << groupPivots); ++mask) {
+                const int lowest = __builtin_ctzll(mask);
+                uint64_t *entry = table + mask * stride;
+                const uint64_t *previous = table + (mask & (mask - 1)) * stride;
+                const uint64_t *pivotRow = A.row(firstPivot + t * tableBits + lowest);
+
+                std::copy(previous + firstWord, previous + stride, entry + firstWord);
+                xorWords(entry + firstWord, pivotRow + firstWord, words);
+            }
         }
 
-        // Eliminate
-        for (int row = 0; row < n; ++row) {
-            if (row != i && A.at<int>(row, i) == 1) {
-                for (int col = 0; col < A.cols; ++col) {
-                    A.at<int>(row, col) ^= A.at<int>(i, col);
+        // Reduce all the other rows with a single lookup into each table. The pivot rows are the identity
+        // in the pivot columns, so the bits of a row in the pivot columns directly select its combination.
+        for (int i = 0; i < m; ++i) {
+            if (i >= firstPivot && i < firstPivot + pivots) {
+                continue;
+            }
+
+            const uint64_t window = rowWindow(A, i, blockStart);
+            size_t masks[tableCount] = {};
+            for (int p = 0; p < pivots; ++p) {
+                masks[p / tableBits] |= ((window >> (pivotColumns[p] - blockStart)) & 1) << (p % tableBits);
+            }
+
+            for (int t = 0; t < usedTables; ++t) {
+                if (masks[t] != 0) {
+                    xorWords(A.row(i) + firstWord, tables.data() + t * tableSize + masks[t] * stride + firstWord, words);
                 }
-                b.at<int>(row) ^= b.at<int>(i);
             }
         }
     }
-}
\ No newline at end of file
+
+    return rank;
+}
+
+std::pair<GF2Matrix, GF2Matrix> gaussJordan(const GF2Matrix &X) {
+    int m = X.rows(), n = X.cols();
+
+    // Eliminate the augmented matrix [X | I], the right part then holds the transformation P
+    GF2Matrix augmented(m, n + m);
+    for (int i = 0; i < m; ++i) {
+        std::copy(X.row(i), X.row(i) + X.stride(), augmented.row(i));
+        augmented.set(i, n + i, true);
+    }
+
+    reduceRowEchelon(augmented, n);
+
+    return {augmented.colRange(0, n), augmented.colRange(n, n + m)};
+}
+
+void gaussElimination(GF2Matrix &A, std::vector<uint64_t> &b) {
+    int n = A.rows(), k = A.cols();
+
+    // Append b as the last column
+    GF2Matrix augmented(n, k + 1);
+    for (int i = 0; i < n; ++i) {
+        std::copy(A.row(i), A.row(i) + A.stride(), augmented.row(i));
+        augmented.set(i, k, (b[i >> 6] >> (i & 63)) & 1);
+    }
+
+    reduceRowEchelon(augmented, std::min(n, k));
+
+    A = augmented.colRange(0, k);
+    for (int i = 0; i < n; ++i) {
+        const uint64_t mask = uint64_t(1) << (i & 63);
+        if (augmented.get(i, k))
+            b[i >> 6] |= mask;
+        else
+            b[i >> 6] &= ~mask;
+    }
+}
@@ -11,6 +11,8 @@
 #include <opencv2/core/mat.hpp>
 #include <opencv2/core.hpp>
 
+#include "gf2_matrix.h"
+
 /**
  * Calculate a matrix product in the binary field Z/2Z.
  * This method can be used on matrices of any type.
@@ -30,19 +32,31 @@ cv::Mat binaryProduct(const cv::Mat &X, const cv::Mat &Y);
  */
 cv::Mat binaryProductFloat(const cv::Mat &X, const cv::Mat &Y);
 
+/**
+ * Bring the first columns of a binary matrix to the reduced row echelon form, in-place.
+ * Uses the "method of Four Russians" (M4RI): the pivots of a block of up to 32 columns are found first,
+ * then every other row is reduced by all of them at once with lookups into four tables of the 2^8 linear
+ * combinations of eight pivot rows each. The pivots are chosen exactly as in the classic Gauss-Jordan
+ * elimination (the first row with a 1 in the column), so the result is identical.
+ * @param A The matrix.
+ * @param columns The number of leading columns to eliminate; the remaining columns are only transformed.
+ * @return The rank of the eliminated part of the matrix.
+ */
+int reduceRowEchelon(GF2Matrix &A, int columns);
+
 /**
  * Perform the Gauss-Jordan elimination on a binary matrix.
  * @param X The matrix to perform Gauss-Jordan elimination on.
  * @return A pair of matrices (A, P) where A is the reduced row echelon form of X; and P is the permutation matrix.
  */
-std::pair<cv::Mat, cv::Mat> gaussJordan(const cv::Mat &X);
+std::pair<GF2Matrix, GF2Matrix> gaussJordan(const GF2Matrix &X);
 
 /**
  * Solve a linear system in the binary field Z/2Z using Gaussian elimination.
  * The elimination is performed in-place on the input matrices.
  * @param A The matrix of coefficients.
- * @param b The vector of constants.
+ * @param b The vector of constants, packed (see packBits()).
  */
-void gaussElimination(cv::Mat &A, cv::Mat &b);
+void gaussElimination(GF2Matrix &A, std::vector<uint64_t> &b);
 
 #endif //BMS_MATHS_H
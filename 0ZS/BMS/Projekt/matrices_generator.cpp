@@ -6,35 +6,43 @@
  *
  * The functions are heavily inspired by code from
  * https://github.com/hichamjanati/pyldpc/blob/master/pyldpc/code.py.
- * They were simplified in line with the assignment and adapted to use OpenCV matrices.
+ * They were simplified in line with the assignment and adapted to use OpenCV matrices and bit-packed GF(2)
+ * matrices.
  */
 
+#include <algorithm>
+#include <ctime>
 #include <random>
 #include "matrices_generator.h"
 
-cv::Mat codingMatrix(const cv::Mat &H) {
-    int nCode = H.cols;
+GF2Matrix codingMatrix(const cv::Mat &H) {
+    return codingMatrix(GF2Matrix::fromMat(H));
+}
+
+GF2Matrix codingMatrix(const GF2Matrix &H) {
+    int nCode = H.cols();
 
     // Transpose of H
-    cv::Mat H_transposed;
-    cv::transpose(H, H_transposed);
+    GF2Matrix H_transposed = H.transposed();
 
     auto [Href_colonnes, tQ] = gaussJordan(H_transposed);
 
-    cv::Mat Href_diag;
-    cv::transpose(Href_colonnes, Href_diag);
-    Href_diag = gaussJordan(Href_diag).first;
-
-    int nBits = nCode - (int) cv::sum(Href_diag)[0];
-
-    cv::Mat Y = cv::Mat::zeros(nCode, nBits, CV_32S);
-    cv::Mat identity = cv::Mat::eye(nBits, nBits, CV_32S);
-    identity.copyTo(Y(cv::Rect(0, nCode - nBits, nBits, nBits)));
+    // pyldpc reduces the transpose of Href_colonnes once more and counts its ones; that is the rank of H,
+    // which is the number of the non-zero rows of Href_colonnes
+    int rank = 0;
+    while (rank < Href_colonnes.rows()) {
+        const uint64_t *row = Href_colonnes.row(rank);
+        if (std::none_of(row, row + Href_colonnes.stride(), [](uint64_t word) { return word != 0; })) {
+            break;
+        }
+        rank++;
+    }
 
-    cv::Mat Q;
-    cv::transpose(tQ, Q);
+    int nBits = nCode - rank;
 
-    cv::Mat tG = binaryProduct(Q, Y);
+    // tG = Q * Y where Q is the transpose of tQ and Y is zero except for an identity in its last nBits rows,
+    // so tG consists of the last nBits columns of Q
+    GF2Matrix tG = tQ.rowRange(nCode - nBits, nCode).transposed();
     return tG;
 }
 
@@ -69,3 +77,13 @@ cv::Mat parityCheckMatrix(int nCode, unsigned int seed) {
 
     return H;
 }
+
+unsigned int randomSeed() {
+    try {
+        std::random_device randomDevice;
+        return randomDevice();
+    } catch (const std::exception &e) {
+        // Not doing cryptography here...
+        return static_cast<unsigned int>(time(nullptr));
+    }
+}
@@ -16,7 +16,14 @@
  * @param H The parity check matrix.
  * @return A transposed coding matrix G.
  */
-cv::Mat codingMatrix(const cv::Mat &H);
+GF2Matrix codingMatrix(const cv::Mat &H);
+
+/**
+ * Generate a (non-systematic) coding matrix G from a parity check matrix H using Gauss-Jordan elimination.
+ * @param H The parity check matrix, bit-packed.
+ * @return A transposed coding matrix G.
+ */
+GF2Matrix codingMatrix(const GF2Matrix &H);
 
 /**
  * Generate a parity check matrix with the given number of codeword bits.
@@ -26,4 +33,10 @@ cv::Mat codingMatrix(const cv::Mat &H);
  */
 cv::Mat parityCheckMatrix(int nCode, unsigned int seed = 0);
 
+/**
+ * Generate a random seed for parityCheckMatrix().
+ * @return A seed from the system's random device; or the current time if the device is not available.
+ */
+unsigned int randomSeed();
+
 #endif //BMS_MATRICES_GENERATOR_H
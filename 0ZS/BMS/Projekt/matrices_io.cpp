@@ -5,10 +5,17 @@
  * @brief The implementation of binary matrix reading and writing functions.
  */
 
+#include <climits>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "matrices_io.h"
 
 cv::Mat readMatrix(const std::string &filename) {
@@ -67,4 +74,254 @@ void saveMatrix(const cv::Mat &matrix, const std::string &filename) {
 
     file.flush();
     file.close();
-}
\ No newline at end of file
+}
+
+// The magic bytes at the beginning of a binary matrix file
+static const char binaryMagic[4] = {'L', 'D', 'P', 'C'};
+constexpr uint32_t binaryVersion = 1;
+
+/**
+ * The layout of the data following the header of a binary matrix file.
+ */
+enum class BinaryLayout : uint32_t {
+    // (rows + 1) uint32 row offsets followed by ones uint32 column indices
+    IndexLists = 0,
+    // rows * ceil(cols / 64) uint64 words, bit j of a row is at position j % 64 of word j / 64
+    PackedRows = 1
+};
+
+/**
+ * The header of a binary matrix file. It is 32 bytes long, so the data that follows is aligned for any
+ * of its element types.
+ */
+struct BinaryMatrixHeader {
+    char magic[4];
+    uint32_t version;
+    BinaryLayout layout;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t reserved;
+    uint64_t ones;
+};
+
+static_assert(sizeof(BinaryMatrixHeader) == 32);
+
+/**
+ * A read-only memory mapping of a whole file, unmapped on destruction.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &filename) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                address = static_cast<const char *>(mapping);
+                length = static_cast<size_t>(info.st_size);
+            }
+        }
+
+        close(fd);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if (address != nullptr) {
+            munmap(const_cast<char *>(address), length);
+        }
+    }
+
+    const char *data() const { return address; }
+
+    size_t size() const { return length; }
+
+private:
+    const char *address = nullptr;
+    size_t length = 0;
+};
+
+static bool hasBinaryHeader(const char *data, size_t size) {
+    return size >= sizeof(BinaryMatrixHeader) && std::memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+bool isBinaryMatrix(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(binaryMagic)] = {};
+    file.read(magic, sizeof(magic));
+
+    return file.gcount() == sizeof(magic) && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+}
+
+SparseParityCheck readSparseMatrix(const std::string &filename) {
+    MappedFile file(filename);
+
+    if (file.data() == nullptr || !hasBinaryHeader(file.data(), file.size())) {
+        return toSparseParityCheck(readMatrix(filename));
+    }
+
+    BinaryMatrixHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    const char *payload = file.data() + sizeof(header);
+    const size_t payloadSize = file.size() - sizeof(header);
+
+    if (header.version != binaryVersion) {
+        std::cerr << "Error: Unsupported version of the binary matrix file " << filename << ".\n";
+        return {};
+    }
+
+    if (header.rows > INT_MAX || header.cols > INT_MAX || header.ones > INT_MAX) {
+        std::cerr << "Error: The dimensions in the binary matrix file " << filename << " are too large.\n";
+        return {};
+    }
+    if (header.layout != BinaryLayout::IndexLists && header.layout != BinaryLayout::PackedRows) {
+        std::cerr << "Error: Unknown layout of the binary matrix file " << filename << ".\n";
+        return {};
+    }
+
+    SparseParityCheck result;
+    result.rows = static_cast<int>(header.rows);
+    result.cols = static_cast<int>(header.cols);
+
+    if (header.layout == BinaryLayout::IndexLists) {
+        const size_t offsetsSize = (header.rows + size_t(1)) * sizeof(uint32_t);
+        if (payloadSize < offsetsSize + header.ones * sizeof(uint32_t)) {
+            std::cerr << "Error: The binary matrix file " << filename << " is truncated.\n";
+            return {};
+        }
+
+        // The lists are stored exactly as in SparseParityCheck
+        static_assert(sizeof(int) == sizeof(uint32_t));
+        result.checkOffsets.resize(header.rows + 1);
+        result.edgeBits.resize(header.ones);
+        std::memcpy(result.checkOffsets.data(), payload, offsetsSize);
+        std::memcpy(result.edgeBits.data(), payload + offsetsSize, header.ones * sizeof(uint32_t));
+
+        // The offsets have to delimit the column indices, which have to be valid, as buildBitEdges() relies on both
+        if (result.checkOffsets.front() != 0 || result.checkOffsets.back() != static_cast<int>(header.ones)) {
+            std::cerr << "Error: The row offsets in the binary matrix file " << filename
+                      << " do not span its " << header.ones << " ones.\n";
+            return {};
+        }
+        for (size_t i = 0; i < header.rows; ++i) {
+            if (result.checkOffsets[i] > result.checkOffsets[i + 1]) {
+                std::cerr << "Error: The row offsets in the binary matrix file " << filename
+                          << " decrease at row " << i << ".\n";
+                return {};
+            }
+        }
+        for (int bit: result.edgeBits) {
+            if (static_cast<uint32_t>(bit) >= header.cols) {
+                std::cerr << "Error: The binary matrix file " << filename << " contains the column index " << bit
+                          << " out of " << header.cols << " columns.\n";
+                return {};
+            }
+        }
+    } else {
+        const size_t words = (header.cols + size_t(63)) / 64;
+        if (payloadSize < header.rows * words * sizeof(uint64_t)) {
+            std::cerr << "Error: The binary matrix file " << filename << " is truncated.\n";
+            return {};
+        }
+
+        const auto *rows = reinterpret_cast<const uint64_t *>(payload);
+
+        // The bits past the last column have to be zero, otherwise they would be read as columns
+        const uint64_t padding = header.cols % 64 == 0 ? 0 : ~uint64_t(0) << (header.cols % 64);
+        for (size_t i = 0; padding != 0 && i < header.rows; ++i) {
+            if (rows[i * words + words - 1] & padding) {
+                std::cerr << "Error: The padding bits of row " << i << " in the binary matrix file " << filename
+                          << " are not zero.\n";
+                return {};
+            }
+        }
+
+        result.checkOffsets.reserve(header.rows + 1);
+        result.checkOffsets.push_back(0);
+        result.edgeBits.reserve(header.ones);
+
+        for (size_t i = 0; i < header.rows; ++i) {
+            for (size_t w = 0; w < words; ++w) {
+                for (uint64_t word = rows[i * words + w]; word != 0; word &= word - 1) {
+                    result.edgeBits.push_back(static_cast<int>(w * 64 + __builtin_ctzll(word)));
+                }
+            }
+            result.checkOffsets.push_back(result.edges());
+        }
+
+        if (result.edgeBits.size() != header.ones) {
+            std::cerr << "Error: The binary matrix file " << filename << " contains " << result.edges()
+                      << " ones instead of " << header.ones << ".\n";
+            return {};
+        }
+    }
+
+    buildBitEdges(result);
+    return result;
+}
+
+void saveBinaryMatrix(const SparseParityCheck &H, const std::string &filename) {
+    const size_t words = (H.cols + size_t(63)) / 64;
+    const size_t indexListsSize = (H.rows + size_t(1) + H.edges()) * sizeof(uint32_t);
+    const size_t packedRowsSize = H.rows * words * sizeof(uint64_t);
+
+    BinaryMatrixHeader header{};
+    std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+    header.version = binaryVersion;
+    header.layout = indexListsSize <= packedRowsSize ? BinaryLayout::IndexLists : BinaryLayout::PackedRows;
+    header.rows = static_cast<uint32_t>(H.rows);
+    header.cols = static_cast<uint32_t>(H.cols);
+    header.ones = static_cast<uint64_t>(H.edges());
+
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (header.layout == BinaryLayout::IndexLists) {
+        file.write(reinterpret_cast<const char *>(H.checkOffsets.data()),
+                   static_cast<std::streamsize>(H.checkOffsets.size() * sizeof(int)));
+        file.write(reinterpret_cast<const char *>(H.edgeBits.data()),
+                   static_cast<std::streamsize>(H.edgeBits.size() * sizeof(int)));
+    } else {
+        std::vector<uint64_t> row(words);
+        for (int i = 0; i < H.rows; ++i) {
+            std::fill(row.begin(), row.end(), 0);
+            for (int e = H.checkOffsets[i]; e < H.checkOffsets[i + 1]; ++e) {
+                row[H.edgeBits[e] >> 6] |= uint64_t(1) << (H.edgeBits[e] & 63);
+            }
+            file.write(reinterpret_cast<const char *>(row.data()),
+                       static_cast<std::streamsize>(words * sizeof(uint64_t)));
+        }
+    }
+}
+
+void convertMatrix(const std::string &inputPath, const std::string &outputPath) {
+    if (!isBinaryMatrix(inputPath)) {
+        saveBinaryMatrix(toSparseParityCheck(readMatrix(inputPath)), outputPath);
+        return;
+    }
+
+    SparseParityCheck H = readSparseMatrix(inputPath);
+
+    // Write the CSV row by row
+    std::ofstream file(outputPath);
+    std::string line;
+
+    for (int i = 0; i < H.rows; ++i) {
+        line.assign(2 * static_cast<size_t>(H.cols), ',');
+        for (int j = 0; j < H.cols; ++j) {
+            line[2 * j] = '0';
+        }
+        for (int e = H.checkOffsets[i]; e < H.checkOffsets[i + 1]; ++e) {
+            line[2 * static_cast<size_t>(H.edgeBits[e])] = '1';
+        }
+        line.back() = '\n';
+        file << line;
+    }
+}
@@ -10,6 +10,8 @@
 
 #include <opencv2/core/mat.hpp>
 
+#include "sparse_decoder.h"
+
 /**
  * Prints a matrix to the standard output.
  * @tparam T The type of the matrix elements.
@@ -43,4 +45,35 @@ cv::Mat readMatrix(const std::string &filename);
  */
 void saveMatrix(const cv::Mat &matrix, const std::string &filename);
 
+/**
+ * Checks if a file contains a matrix in the binary format (see saveBinaryMatrix()).
+ * @param filename A path to the file.
+ */
+bool isBinaryMatrix(const std::string &filename);
+
+/**
+ * Reads a parity check matrix from a file in the binary format or in the CSV format.
+ * A binary file is memory-mapped and its index lists are copied directly into the resulting structure.
+ * @param filename A path to the file.
+ * @return The sparse form of the matrix.
+ */
+SparseParityCheck readSparseMatrix(const std::string &filename);
+
+/**
+ * Saves a matrix to a file in the binary format.
+ * The file starts with a fixed-size header (see matrices_io.cpp). Depending on which is smaller, it is followed either by the row
+ * offsets and the column indices of the 1s (as in SparseParityCheck), or by the rows packed into 64-bit words.
+ * @param H The matrix.
+ * @param filename A path to the file.
+ */
+void saveBinaryMatrix(const SparseParityCheck &H, const std::string &filename);
+
+/**
+ * Converts a matrix file from the CSV format to the binary format or vice versa, the input format is detected
+ * automatically.
+ * @param inputPath A path to the input file.
+ * @param outputPath A path to the output file.
+ */
+void convertMatrix(const std::string &inputPath, const std::string &outputPath);
+
 #endif //BMS_MATRICES_IO_H
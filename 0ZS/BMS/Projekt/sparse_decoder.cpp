@@ -0,0 +1,217 @@
+/**
+ * @file sparse_decoder.cpp
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The implementation of a sparse LDPC belief propagation decoder.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "sparse_decoder.h"
+
+SparseParityCheck toSparseParityCheck(const cv::Mat &H) {
+    SparseParityCheck result;
+    result.rows = H.rows;
+    result.cols = H.cols;
+    result.checkOffsets.reserve(H.rows + 1);
+    result.checkOffsets.push_back(0);
+
+    for (int i = 0; i < H.rows; ++i) {
+        const int *row = H.ptr<int>(i);
+        for (int j = 0; j < H.cols; ++j) {
+            if (row[j] != 0) {
+                result.edgeBits.push_back(j);
+            }
+        }
+        result.checkOffsets.push_back(result.edges());
+    }
+
+    buildBitEdges(result);
+    return result;
+}
+
+GF2Matrix toGF2Matrix(const SparseParityCheck &H) {
+    GF2Matrix result(H.rows, H.cols);
+    for (int i = 0; i < H.rows; ++i) {
+        for (int e = H.checkOffsets[i]; e < H.checkOffsets[i + 1]; ++e) {
+            result.set(i, H.edgeBits[e], true);
+        }
+    }
+    return result;
+}
+
+void buildBitEdges(SparseParityCheck &H) {
+    H.bitOffsets.assign(H.cols + 1, 0);
+    H.bitEdges.resize(H.edgeBits.size());
+
+    // Counting sort of the edges by their bit, stable, so the edges of a bit stay ordered by checks
+    for (int bit: H.edgeBits) {
+        H.bitOffsets[bit + 1]++;
+    }
+    for (int j = 0; j < H.cols; ++j) {
+        H.bitOffsets[j + 1] += H.bitOffsets[j];
+    }
+
+    std::vector<int> fill(H.bitOffsets.begin(), H.bitOffsets.end() - 1);
+    for (int e = 0; e < H.edges(); ++e) {
+        H.bitEdges[fill[H.edgeBits[e]]++] = e;
+    }
+}
+
+bool isCodeWordPacked(const SparseParityCheck &H, const std::vector<uint64_t> &packedX) {
+    for (int i = 0; i < H.rows; ++i) {
+        uint64_t parity = 0;
+        for (int e = H.checkOffsets[i]; e < H.checkOffsets[i + 1]; ++e) {
+            const int j = H.edgeBits[e];
+            parity ^= packedX[j >> 6] >> (j & 63);
+        }
+
+        if (parity & 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Check node update of the sum-product algorithm for a single check.
+ * The product of the other edges is computed from prefix and suffix products, so a check of degree d
+ * costs O(d) instead of O(d^2).
+ */
+static void sumProductCheck(const double *Lq, double *Lr, int degree, std::vector<double> &scratch) {
+    scratch.resize(2 * static_cast<size_t>(degree));
+    double *t = scratch.data();
+    double *suffix = scratch.data() + degree;
+
+    double product = 1;
+    for (int k = degree - 1; k >= 0; --k) {
+        t[k] = std::tanh(0.5 * Lq[k]);
+        suffix[k] = product;
+        product *= t[k];
+    }
+
+    double prefix = 1;
+    for (int k = 0; k < degree; ++k) {
+        double x = prefix * suffix[k];
+        prefix *= t[k];
+
+        double num = 1 + x;
+        double denom = 1 - x;
+
+        if (num < 1e-9)
+            Lr[k] = -1;
+        else if (denom < 1e-9)
+            Lr[k] = 1;
+        else
+            Lr[k] = std::log(num) - std::log(denom);
+    }
+}
+
+/**
+ * Check node update of the (offset) min-sum algorithm for a single check.
+ * Only the two smallest magnitudes and the parity of the signs are needed.
+ */
+static void minSumCheck(const double *Lq, double *Lr, int degree, double offset) {
+    double min1 = std::numeric_limits<double>::infinity();
+    double min2 = min1;
+    int minIndex = -1;
+    bool negative = false;
+
+    for (int k = 0; k < degree; ++k) {
+        double magnitude = std::abs(Lq[k]);
+        negative ^= Lq[k] < 0;
+
+        if (magnitude < min1) {
+            min2 = min1;
+            min1 = magnitude;
+            minIndex = k;
+        } else if (magnitude < min2) {
+            min2 = magnitude;
+        }
+    }
+
+    for (int k = 0; k < degree; ++k) {
+        double minimum = k == minIndex ? min2 : min1;
+        // A check with a single edge carries no information
+        double magnitude = std::isinf(minimum) ? 0.0 : std::max(minimum - offset, 0.0);
+        bool sign = negative ^ (Lq[k] < 0);
+        Lr[k] = sign ? -magnitude : magnitude;
+    }
+}
+
+std::vector<int> decodeSparse(const SparseParityCheck &H, const std::vector<int> &y,
+                              BPAlgorithm algorithm, double bitFlipProbability, int maxIterations, double offset) {
+    const int n = H.cols;
+    const int edges = H.edges();
+
+    // Assuming a BSC channel, the apriori LLRs are log((1-p)/p) for a received 0 and log(p/(1-p)) for a 1.
+    double var = -std::log(bitFlipProbability / (1 - bitFlipProbability));
+    std::vector<double> Lc(n);
+    for (int j = 0; j < n; ++j) {
+        Lc[j] = y[j] ? -var : var;
+    }
+
+    if (algorithm != BPAlgorithm::OffsetMinSum) {
+        offset = 0;
+    }
+
+    // Messages from bits to checks (Lq) and from checks to bits (Lr), one per edge, in the CSR order.
+    // In the first iteration, the checks read the apriori LLRs.
+    std::vector<double> Lq(edges), Lr(edges, 0.0);
+    for (int e = 0; e < edges; ++e) {
+        Lq[e] = Lc[H.edgeBits[e]];
+    }
+
+    std::vector<double> scratch;
+    std::vector<uint64_t> x((n + 63) / 64);
+    bool converged = false;
+
+    for (int iteration = 0; iteration < maxIterations && !converged; ++iteration) {
+        // Horizontal step
+        for (int i = 0; i < H.rows; ++i) {
+            const int begin = H.checkOffsets[i];
+            const int degree = H.checkOffsets[i + 1] - begin;
+
+            if (algorithm == BPAlgorithm::SumProduct) {
+                sumProductCheck(Lq.data() + begin, Lr.data() + begin, degree, scratch);
+            } else {
+                minSumCheck(Lq.data() + begin, Lr.data() + begin, degree, offset);
+            }
+        }
+
+        // Vertical step and the LLR a posteriori
+        std::fill(x.begin(), x.end(), 0);
+        for (int j = 0; j < n; ++j) {
+            double posteriori = Lc[j];
+            for (int k = H.bitOffsets[j]; k < H.bitOffsets[j + 1]; ++k) {
+                posteriori += Lr[H.bitEdges[k]];
+            }
+
+            for (int k = H.bitOffsets[j]; k < H.bitOffsets[j + 1]; ++k) {
+                const int e = H.bitEdges[k];
+                Lq[e] = posteriori - Lr[e];
+            }
+
+            if (posteriori <= 0) {
+                x[j >> 6] |= uint64_t(1) << (j & 63);
+            }
+        }
+
+        converged = isCodeWordPacked(H, x);
+    }
+
+    if (!converged) {
+        std::cerr << "Decoding stopped before convergence." << std::endl;
+    }
+
+    std::vector<int> result(n);
+    for (int j = 0; j < n; ++j) {
+        result[j] = static_cast<int>((x[j >> 6] >> (j & 63)) & 1);
+    }
+
+    return result;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file sparse_decoder.h
+ * @author Ondřej Ondryáš <xondry02@stud.fit.vut.cz>
+ * @date 2023-12-10
+ * @brief The interface of a sparse LDPC belief propagation decoder.
+ */
+
+#ifndef BMS_SPARSE_DECODER_H
+#define BMS_SPARSE_DECODER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core/mat.hpp>
+
+#include "gf2_matrix.h"
+
+/**
+ * A parity check matrix stored as a list of edges of its Tanner graph.
+ * The edges are ordered by checks (CSR): the edges of check i are [checkOffsets[i], checkOffsets[i + 1])
+ * and edgeBits[e] is the bit (column) of the edge e. For every bit j, [bitOffsets[j], bitOffsets[j + 1])
+ * is a range in bitEdges which lists the edges of bit j in the order of checks (CSC).
+ */
+struct SparseParityCheck {
+    int rows = 0;
+    int cols = 0;
+
+    std::vector<int> checkOffsets;
+    std::vector<int> edgeBits;
+
+    std::vector<int> bitOffsets;
+    std::vector<int> bitEdges;
+
+    int edges() const { return static_cast<int>(edgeBits.size()); }
+};
+
+/**
+ * The check node update rule used by the decoder.
+ */
+enum class BPAlgorithm {
+    SumProduct,    ///< Exact log-domain belief propagation (the same as decode()).
+    MinSum,        ///< Min-sum approximation of the check node update.
+    OffsetMinSum   ///< Min-sum with the magnitudes reduced by a constant offset.
+};
+
+/**
+ * Extracts the Tanner graph from a dense parity check matrix.
+ * @param H The parity check matrix (CV_32S).
+ * @return The sparse form of H.
+ */
+SparseParityCheck toSparseParityCheck(const cv::Mat &H);
+
+/**
+ * Expands a parity check matrix into a bit-packed dense matrix.
+ * @param H The sparse parity check matrix.
+ * @return H as a dense matrix.
+ */
+GF2Matrix toGF2Matrix(const SparseParityCheck &H);
+
+/**
+ * Builds the CSC part (bitOffsets, bitEdges) of a parity check whose CSR part is filled in.
+ * @param H The parity check.
+ */
+void buildBitEdges(SparseParityCheck &H);
+
+/**
+ * Checks if x is a codeword. The syndrome is evaluated on x packed into 64-bit words.
+ * @param H The parity check.
+ * @param packedX The bits of x, bit j is stored in packedX[j / 64] at position j % 64.
+ */
+bool isCodeWordPacked(const SparseParityCheck &H, const std::vector<uint64_t> &packedX);
+
+/**
+ * Runs a belief-propagation decoding algorithm with the messages stored per edge of the Tanner graph,
+ * so the memory usage is O(edges) instead of O(m * n).
+ * Assumes a binary symmetric channel (BSC) with a given bit flip probability.
+ * @param H The parity check matrix.
+ * @param y The received bits.
+ * @param algorithm The check node update rule.
+ * @param bitFlipProbability The bit flip probability.
+ * @param maxIterations The maximum number of iterations for the algorithm.
+ * @param offset The offset used by BPAlgorithm::OffsetMinSum.
+ * @return The decoded codeword.
+ */
+std::vector<int> decodeSparse(const SparseParityCheck &H, const std::vector<int> &y,
+                              BPAlgorithm algorithm = BPAlgorithm::SumProduct,
+                              double bitFlipProbability = 0.15, int maxIterations = 500, double offset = 0.5);
+
+#endif //BMS_SPARSE_DECODER_H
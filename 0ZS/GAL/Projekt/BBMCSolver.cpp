@@ -0,0 +1,223 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#include "BBMCSolver.h"
+
+#include <algorithm>
+
+//how many expand() calls are made between two clock reads
+constexpr size_t timeCheckInterval = 1024;
+
+MISSolver::node_set BBMCSolver::solve(const CompactGraph& graph)
+{
+    const size_t n = graph.node_count();
+
+    m_current.clear();
+    m_best.clear();
+    m_steps = 0;
+    m_timed_out = false;
+    m_deadline = std::chrono::steady_clock::now() + m_time_limit;
+
+    if (n == 0)
+    {
+        m_optimal = true;
+        return node_set(node_comparator);
+    }
+
+    build_order(graph);
+    initial_solution();
+
+    //the depth of the recursion is bounded by the size of the clique
+    m_levels.resize(m_upper_bound + 1);
+    for (auto& level: m_levels)
+    {
+        level.candidates = NodeBitset(n);
+        level.uncolored = NodeBitset(n);
+        level.color_class = NodeBitset(n);
+    }
+
+    auto& root = m_levels[0];
+    root.candidates = NodeBitset(n, true);
+
+    //the number of colors of the whole graph is an upper bound as well
+    color_sort(root, root.candidates, 1);
+    m_upper_bound = std::min(m_upper_bound, root.colors.back());
+
+    if (m_best.size() < m_upper_bound)
+        expand(0);
+
+    m_optimal = !m_timed_out;
+
+    NodeBitset result = graph.empty_set();
+    for (auto v: m_best)
+        result.set(m_order[v]);
+
+    return to_node_set(graph, result);
+}
+
+void BBMCSolver::build_order(const CompactGraph& graph)
+{
+    const size_t n = graph.node_count();
+
+    //degrees in the complement graph
+    std::vector<size_t> degrees(n);
+    for (vertex v = 0; v < n; v++)
+        degrees[v] = n - 1 - graph.degree(v);
+
+    //smallest-last ordering: repeatedly remove the vertex with the smallest degree and place it
+    //at the end, so that the vertices of the densest core get the lowest numbers
+    std::vector<bool> removed(n, false);
+    m_order.assign(n, 0);
+    size_t degeneracy = 0;
+
+    for (size_t k = 0; k < n; k++)
+    {
+        vertex min_v = 0;
+        size_t min_degree = n;
+        for (vertex v = 0; v < n; v++)
+        {
+            if (!removed[v] && degrees[v] < min_degree)
+            {
+                min_v = v;
+                min_degree = degrees[v];
+            }
+        }
+
+        degeneracy = std::max(degeneracy, min_degree);
+        removed[min_v] = true;
+        m_order[n - 1 - k] = min_v;
+
+        for (vertex u = 0; u < n; u++)
+        {
+            if (!removed[u] && !graph.adjacent(u, min_v))
+                degrees[u]--;
+        }
+    }
+
+    //a clique can't be larger than the degeneracy + 1
+    m_upper_bound = degeneracy + 1;
+
+    std::vector<vertex> position(n);
+    for (vertex i = 0; i < n; i++)
+        position[m_order[i]] = i;
+
+    //complement rows in the new order: everything except the vertex itself and its neighbours in G
+    m_row_words = NodeBitset::word_count(n);
+    m_matrix.assign(n * m_row_words, ~NodeBitset::word(0));
+
+    for (vertex i = 0; i < n; i++)
+    {
+        auto* i_row = m_matrix.data() + i * m_row_words;
+        auto clear = [&](vertex j)
+        {
+            i_row[j / NodeBitset::word_bits] &= ~(NodeBitset::word(1) << (j % NodeBitset::word_bits));
+        };
+
+        clear(i);
+        for (auto it = graph.neighbors_begin(m_order[i]); it != graph.neighbors_end(m_order[i]); it++)
+            clear(position[*it]);
+
+        if (n % NodeBitset::word_bits)
+            i_row[m_row_words - 1] &= (NodeBitset::word(1) << (n % NodeBitset::word_bits)) - 1;
+    }
+}
+
+void BBMCSolver::initial_solution()
+{
+    //greedy clique in the BBMC order gives the first incumbent
+    NodeBitset candidates(m_order.size(), true);
+
+    for (auto v = candidates.first(); v < candidates.capacity(); v = candidates.next(v + 1))
+    {
+        m_best.push_back(v);
+        candidates.intersect_with(row(v));
+    }
+}
+
+size_t BBMCSolver::color_sort(Level& level, const NodeBitset& candidates, size_t min_color)
+{
+    level.uncolored = candidates;
+    level.vertices.clear();
+    level.colors.clear();
+
+    //color classes are independent sets of the complement, built greedily in the BBMC order;
+    //vertices with a color lower than min_color can't improve the incumbent and aren't stored
+    size_t color = 0;
+    while (!level.uncolored.empty())
+    {
+        color++;
+        level.color_class = level.uncolored;
+
+        auto& color_class = level.color_class;
+        for (auto v = color_class.first(); v < color_class.capacity(); v = color_class.next(v + 1))
+        {
+            level.uncolored.reset(v);
+            color_class.subtract(row(v));
+
+            if (color >= min_color)
+            {
+                level.vertices.push_back(v);
+                level.colors.push_back(color);
+            }
+        }
+    }
+
+    return level.vertices.size();
+}
+
+void BBMCSolver::expand(size_t depth)
+{
+    auto& level = m_levels[depth];
+
+    const size_t min_color = m_best.size() >= m_current.size() ? m_best.size() - m_current.size() + 1 : 1;
+    size_t count = color_sort(level, level.candidates, min_color);
+
+    //branch on the vertices with the highest colors first
+    for (size_t i = count; i-- > 0;)
+    {
+        //the bound only gets tighter as the incumbent grows
+        if (m_current.size() + level.colors[i] <= m_best.size())
+            return;
+
+        if (m_best.size() >= m_upper_bound || out_of_time())
+            return;
+
+        auto v = level.vertices[i];
+        m_current.push_back(v);
+
+        auto& next = m_levels[depth + 1];
+        next.candidates = level.candidates;
+        next.candidates.intersect_with(row(v));
+
+        if (next.candidates.empty())
+        {
+            if (m_current.size() > m_best.size())
+                m_best = m_current;
+        }
+        else
+        {
+            expand(depth + 1);
+        }
+
+        m_current.pop_back();
+        level.candidates.reset(v);
+    }
+}
+
+bool BBMCSolver::out_of_time()
+{
+    if (m_timed_out)
+        return true;
+
+    if (m_time_limit == std::chrono::milliseconds::zero() || ++m_steps % timeCheckInterval)
+        return false;
+
+    m_timed_out = std::chrono::steady_clock::now() >= m_deadline;
+    return m_timed_out;
+}
@@ -0,0 +1,89 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#pragma once
+
+#include "MISSolver.h"
+
+#include <chrono>
+
+/**
+ * Exact solver: a maximum independent set of G is a maximum clique of the complement of G,
+ * which is searched for with the bit-parallel branch and bound algorithm BBMC (San Segundo et al.).
+ *
+ * The vertices are renumbered by a degeneracy (smallest-last) ordering of the complement,
+ * every subproblem is bounded by a greedy coloring computed on bitsets and only the vertices
+ * whose color can still improve the incumbent are branched on.
+ *
+ * When a time limit is set and the search does not finish in time, the best set found so far
+ * is returned and is_optimal() reports false.
+ */
+class BBMCSolver : public MISSolver {
+public:
+
+    explicit BBMCSolver(std::chrono::milliseconds time_limit = std::chrono::milliseconds::zero())
+            : m_time_limit(time_limit)
+    {
+
+    }
+
+    const char* name() override
+    {
+        return "Exact Branch and Bound (BBMC) Solver";
+    }
+
+    using MISSolver::solve;
+    node_set solve(const CompactGraph& graph) override;
+
+    //true if the last solve() finished the search, i.e. the returned set is maximum
+    bool is_optimal() const
+    { return m_optimal; }
+
+private:
+
+    using vertex = CompactGraph::vertex;
+
+    std::chrono::milliseconds m_time_limit;
+    std::chrono::steady_clock::time_point m_deadline;
+    size_t m_steps { 0 };
+    bool m_timed_out { false };
+    bool m_optimal { false };
+
+    //adjacency rows of the complement graph, in the BBMC vertex order
+    size_t m_row_words { 0 };
+    std::vector<NodeBitset::word> m_matrix;
+
+    //BBMC order -> dense id of the CompactGraph
+    std::vector<vertex> m_order;
+
+    //upper bound for the whole search, the search stops once the incumbent reaches it
+    size_t m_upper_bound { 0 };
+
+    std::vector<vertex> m_current;
+    std::vector<vertex> m_best;
+
+    //buffers reused by every level of the recursion
+    struct Level {
+        NodeBitset candidates;
+        NodeBitset uncolored;
+        NodeBitset color_class;
+        std::vector<vertex> vertices;
+        std::vector<size_t> colors;
+    };
+    std::vector<Level> m_levels;
+
+    const NodeBitset::word* row(vertex v) const
+    { return m_matrix.data() + v * m_row_words; }
+
+    void build_order(const CompactGraph& graph);
+    void initial_solution();
+    size_t color_sort(Level& level, const NodeBitset& candidates, size_t min_color);
+    void expand(size_t depth);
+    bool out_of_time();
+};
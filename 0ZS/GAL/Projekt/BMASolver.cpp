@@ -9,6 +9,8 @@
 
 #include "BMASolver.h"
 
+#include <algorithm>
+
 using namespace ogdf;
 
 constexpr int costInfinity = std::numeric_limits<int>::max();
@@ -80,7 +82,36 @@ BMASolver::getIncludedTargetVertices(int sourceNodeIndex, RoundContainer& curren
 }
 
 
-std::set<ogdf::node, decltype(MISSolver::node_comparator)> BMASolver::solve(const ogdf::Graph& graph)
+MISSolver::node_set BMASolver::solve(const CompactGraph& compactGraph)
+{
+    if (engine == BMAEngine::Dense)
+        return solveDense(compactGraph);
+
+    // The algorithm works over an ogdf::Graph whose node indices are the dense ids of the snapshot
+    ogdf::Graph graph;
+    ogdf::Array<node> graphNodes;
+    graph.newNodes(static_cast<int>(compactGraph.node_count()), &graphNodes);
+    graph.reserveEdges(static_cast<int>(compactGraph.edge_count()));
+
+    for (CompactGraph::vertex u = 0; u < compactGraph.node_count(); u++)
+    {
+        for (auto v = compactGraph.neighbors_begin(u); v != compactGraph.neighbors_end(u); v++)
+        {
+            if (u < *v)
+                graph.newEdge(graphNodes[u], graphNodes[*v]);
+        }
+    }
+
+    node_set ret(node_comparator);
+    for (const auto& v: solveGraph(graph))
+    {
+        ret.insert(compactGraph.original(v->index()));
+    }
+
+    return ret;
+}
+
+std::set<ogdf::node, decltype(MISSolver::node_comparator)> BMASolver::solveGraph(const ogdf::Graph& graph)
 {
     const int roundCount = graph.numberOfNodes() + 1;
 
@@ -111,10 +142,7 @@ std::set<ogdf::node, decltype(MISSolver::node_comparator)> BMASolver::solve(cons
         for (const auto& edge: neighbours)
         {
             // Exclude[u, 0] <- Exclude[u, 0] U { v }
-            if (edge->source() != u)
-                continue;
-
-            int inIndex = edge->target()->index();
+            int inIndex = edge->opposite(u)->index();
             auto inserted = excludeU.insert(inIndex);
 
             if (inserted.second)
@@ -277,6 +305,186 @@ BMASolver::getResult(RoundContainer* rounds, int lastRoundIndex, std::unordered_
     return ret;
 }
 
+// Target vertices are relaxed in chunks of this size, every chunk is one task of the pool
+constexpr size_t denseChunkSize = 32;
+
+MISSolver::node_set BMASolver::solveDense(const CompactGraph& graph)
+{
+    using vertex = CompactGraph::vertex;
+    using word = NodeBitset::word;
+
+    const size_t n = graph.node_count();
+    const size_t words = NodeBitset::word_count(n);
+    if (n == 0)
+        return node_set(node_comparator);
+
+    // Only Round[round] and Round[round + 1] are kept
+    DenseRound currentRound { std::vector<word>(n * words, 0), std::vector<int>(n, costInfinity) };
+    DenseRound nextRound = currentRound;
+
+    // Previous[v, round] of the vertices with a finite cost, sorted by v,
+    // the entries of a round are trailVertices[trailRounds[round] .. trailRounds[round + 1]]
+    std::vector<vertex> trailVertices;
+    std::vector<vertex> trailPrevious;
+    std::vector<size_t> trailRounds { 0, 0 };
+
+    // Initialization
+    for (vertex u = 0; u < n; u++)
+    {
+        // Exclude[u, 0] <- { u } U N(u), Cost[u, 0] <- |Exclude[u, 0]|
+        word* excludeU = currentRound.exclude.data() + u * words;
+        excludeU[u / NodeBitset::word_bits] |= word(1) << (u % NodeBitset::word_bits);
+        for (auto v = graph.neighbors_begin(u); v != graph.neighbors_end(u); v++)
+        {
+            excludeU[*v / NodeBitset::word_bits] |= word(1) << (*v % NodeBitset::word_bits);
+        }
+        currentRound.cost[u] = graph.degree(u) + 1;
+    }
+
+    // |N(v) \ exclude|
+    auto uncoveredNeighbours = [&](vertex v, const word* exclude) {
+        int count = 0;
+        if (graph.has_matrix())
+        {
+            const word* neighbours = graph.row(v);
+            for (size_t w = 0; w < words; w++)
+                count += __builtin_popcountll(neighbours[w] & ~exclude[w]);
+        }
+        else
+        {
+            for (auto j = graph.neighbors_begin(v); j != graph.neighbors_end(v); j++)
+                count += !((exclude[*j / NodeBitset::word_bits] >> (*j % NodeBitset::word_bits)) & 1u);
+        }
+        return count;
+    };
+
+    std::vector<vertex> activeSources;
+    std::vector<vertex> previous(n);
+
+    // Computes Round[round + 1] for the target vertices [begin, end).
+    // Every target only reads the current round, so the chunks are independent. Ties are broken
+    // by the lowest u, which is the order in which the sequential algorithm accepts improvements.
+    auto relax = [&](vertex begin, vertex end) {
+        for (vertex v = begin; v < end; v++)
+        {
+            int bestCost = costInfinity;
+            vertex bestU = 0;
+            for (auto u: activeSources)
+            {
+                // v in V \ Exclude[u, round]
+                const word* excludeU = currentRound.exclude.data() + u * words;
+                if ((excludeU[v / NodeBitset::word_bits] >> (v % NodeBitset::word_bits)) & 1u)
+                    continue;
+
+                // vCost <- Cost[u, round] + 1 + |N(v) \ Exclude[u, round]|
+                int vCost = currentRound.cost[u] + 1 + uncoveredNeighbours(v, excludeU);
+                if (vCost < bestCost)
+                {
+                    bestCost = vCost;
+                    bestU = u;
+                }
+            }
+
+            nextRound.cost[v] = bestCost;
+            previous[v] = bestU;
+            if (bestCost == costInfinity)
+                continue;
+
+            // Exclude[v, round + 1] <- Exclude[u, round] U { v } U N(v)
+            const word* excludeU = currentRound.exclude.data() + bestU * words;
+            word* excludeV = nextRound.exclude.data() + v * words;
+            for (size_t w = 0; w < words; w++)
+                excludeV[w] = excludeU[w];
+            excludeV[v / NodeBitset::word_bits] |= word(1) << (v % NodeBitset::word_bits);
+            for (auto j = graph.neighbors_begin(v); j != graph.neighbors_end(v); j++)
+                excludeV[*j / NodeBitset::word_bits] |= word(1) << (*j % NodeBitset::word_bits);
+        }
+    };
+
+    WorkStealingPool pool(numThreads);
+    size_t lastRoundI = 0;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Relaxation
+    // for 0 <= round <= (|V| - 1)
+    for (size_t roundI = 0; roundI < n; roundI++)
+    {
+        BMA_LOG std::cout << "\n--- ROUND " << roundI << "---\n";
+
+        activeSources.clear();
+        for (vertex u = 0; u < n; u++)
+        {
+            if (currentRound.cost[u] != costInfinity)
+                activeSources.push_back(u);
+        }
+
+        if (pool.size() > 1)
+        {
+            pool.run([&] {
+                for (vertex begin = 0; begin < n; begin += denseChunkSize)
+                {
+                    vertex end = std::min<size_t>(begin + denseChunkSize, n);
+                    pool.spawn([&relax, begin, end] { relax(begin, end); });
+                }
+            });
+        }
+        else
+        {
+            relax(0, n);
+        }
+
+        bool hasCostChange = false;
+        for (vertex v = 0; v < n; v++)
+        {
+            if (nextRound.cost[v] != costInfinity)
+            {
+                trailVertices.push_back(v);
+                trailPrevious.push_back(previous[v]);
+                hasCostChange = true;
+            }
+        }
+        trailRounds.push_back(trailVertices.size());
+
+        if (!hasCostChange)
+            break;
+
+        std::swap(currentRound, nextRound);
+        lastRoundI = roundI + 1;
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    BMA_LOG std::cout << "Time: " << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count()
+                      << " ms\n";
+
+    BMA_LOG std::cout << "Last round: " << lastRoundI << '\n';
+
+    // Select a vertex that ended with non-inf cost
+    // Every one of such vertices can be selected, the resulting MIS will be the same size
+    vertex vertexId = 0;
+    while (currentRound.cost[vertexId] == costInfinity)
+    {
+        vertexId++;
+    }
+
+    // Construct the set by following the Previous entries through rounds
+    NodeBitset ret = graph.empty_set();
+    for (size_t roundI = lastRoundI; ; roundI--)
+    {
+        ret.set(vertexId);
+        if (roundI == 0)
+            break;
+
+        auto roundBegin = trailVertices.begin() + trailRounds[roundI];
+        auto roundEnd = trailVertices.begin() + trailRounds[roundI + 1];
+        auto entry = std::lower_bound(roundBegin, roundEnd, vertexId);
+        vertexId = trailPrevious[entry - trailVertices.begin()];
+    }
+
+    return to_node_set(graph, ret);
+}
+
 const char* BMASolver::name()
 {
     return "Bellman-Ford based MIS Algorithm Solver";
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "MISSolver.h"
+#include "WorkStealingPool.h"
 #include <ogdf/basic/NodeSet.h>
 #include <unordered_set>
 
@@ -23,13 +24,40 @@ struct RoundContainer {
     std::unordered_map<int, int> cost;
 };
 
+// One round of the dense engine: Exclude[*, round] as packed rows and Cost[*, round]
+struct DenseRound {
+    std::vector<NodeBitset::word> exclude;
+    std::vector<int> cost;
+};
+
+enum class BMAEngine {
+    // Original implementation, keeps all the rounds in node-based containers
+    Legacy,
+    // Keeps only the current and the next round in dense arrays, O(n^2 / 64) memory
+    // plus the Previous entries of finite costs
+    Dense
+};
+
 class BMASolver : public MISSolver {
 public:
-    std::set<ogdf::node, decltype(node_comparator)> solve(const ogdf::Graph& graph) override;
+    explicit BMASolver(BMAEngine engine = BMAEngine::Dense, unsigned numThreads = 1)
+            : engine(engine), numThreads(numThreads)
+    {
+    }
+
+    using MISSolver::solve;
+    node_set solve(const CompactGraph& graph) override;
 
     const char* name() override;
 
 private:
+    BMAEngine engine;
+    unsigned numThreads;
+
+    node_set solveDense(const CompactGraph& graph);
+
+    std::set<ogdf::node, decltype(node_comparator)> solveGraph(const ogdf::Graph& graph);
+
     static std::pair<std::vector<int>::iterator, std::vector<int>::iterator>
     getIncludedTargetVertices(int sourceNodeIndex, RoundContainer& currentRound, int currentRoundIndex,
             std::vector<int>& nodeIndices, std::vector<int>& tmpVector);
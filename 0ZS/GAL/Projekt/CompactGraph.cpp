@@ -0,0 +1,251 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#include "CompactGraph.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+static constexpr char fileMagic[4] = { 'G', 'A', 'L', 'C' };
+static constexpr uint32_t fileVersion = 1;
+
+CompactGraph::CompactGraph(const ogdf::Graph& graph, size_t dense_limit)
+{
+    const size_t n = graph.numberOfNodes();
+
+    //assign dense ids
+    m_nodes.reserve(n);
+    m_ids.assign(graph.maxNodeIndex() + 1, 0);
+    for (auto node: graph.nodes)
+    {
+        m_ids[node->index()] = m_nodes.size();
+        m_nodes.push_back(node);
+    }
+
+    //count both directions of every edge
+    std::vector<size_t> offsets(n + 1, 0);
+    for (auto edge: graph.edges)
+    {
+        if (edge->isSelfLoop())
+            continue;
+
+        offsets[id(edge->source()) + 1]++;
+        offsets[id(edge->target()) + 1]++;
+    }
+
+    for (size_t v = 0; v < n; v++)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<vertex> targets(offsets[n]);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (auto edge: graph.edges)
+    {
+        if (edge->isSelfLoop())
+            continue;
+
+        auto u = id(edge->source());
+        auto v = id(edge->target());
+        targets[fill[u]++] = v;
+        targets[fill[v]++] = u;
+    }
+
+    //sort every adjacency list and squeeze out parallel edges
+    m_offsets.assign(n + 1, 0);
+    m_targets.reserve(targets.size());
+    for (size_t v = 0; v < n; v++)
+    {
+        auto begin = targets.begin() + offsets[v];
+        auto end = targets.begin() + offsets[v + 1];
+        std::sort(begin, end);
+        end = std::unique(begin, end);
+
+        m_targets.insert(m_targets.end(), begin, end);
+        m_offsets[v + 1] = m_targets.size();
+    }
+
+    build_matrix(dense_limit);
+}
+
+void CompactGraph::build_matrix(size_t dense_limit)
+{
+    const size_t n = node_count();
+    if (n > dense_limit)
+        return;
+
+    m_row_words = NodeBitset::word_count(n);
+    m_matrix.assign(n * m_row_words, 0);
+    for (size_t v = 0; v < n; v++)
+    {
+        auto* v_row = m_matrix.data() + v * m_row_words;
+        for (auto it = neighbors_begin(v); it != neighbors_end(v); it++)
+            v_row[*it / NodeBitset::word_bits] |= NodeBitset::word(1) << (*it % NodeBitset::word_bits);
+    }
+}
+
+CompactGraph CompactGraph::complement(size_t dense_limit) const
+{
+    const size_t n = node_count();
+
+    CompactGraph result;
+    result.m_nodes = m_nodes;
+    result.m_ids = m_ids;
+    result.m_offsets.assign(n + 1, 0);
+    result.m_targets.reserve(n * (n - 1) - m_targets.size());
+
+    NodeBitset missing(n);
+    for (vertex v = 0; v < n; v++)
+    {
+        //non-neighbours of v, without v itself
+        if (has_matrix())
+        {
+            std::memcpy(missing.data(), row(v), m_row_words * sizeof(NodeBitset::word));
+            missing.flip();
+        }
+        else
+        {
+            missing.clear();
+            missing.flip();
+            for (auto it = neighbors_begin(v); it != neighbors_end(v); it++)
+                missing.reset(*it);
+        }
+        missing.reset(v);
+
+        //the bits come out sorted, so the complement CSR is sorted as well
+        missing.for_each([&](size_t u)
+        {
+            result.m_targets.push_back(u);
+        });
+        result.m_offsets[v + 1] = result.m_targets.size();
+    }
+
+    result.build_matrix(dense_limit);
+    return result;
+}
+
+void CompactGraph::save(std::ostream& out) const
+{
+    const uint64_t n = node_count();
+    const uint64_t targets = m_targets.size();
+    std::vector<uint64_t> offsets(m_offsets.begin(), m_offsets.end());
+
+    out.write(fileMagic, sizeof(fileMagic));
+    out.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(&targets), sizeof(targets));
+    out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(m_targets.data()), m_targets.size() * sizeof(vertex));
+}
+
+std::optional<CompactGraph> CompactGraph::load(std::istream& in, const ogdf::Graph& graph, size_t dense_limit)
+{
+    char magic[sizeof(fileMagic)];
+    uint32_t version;
+    uint64_t n, targets;
+
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&n), sizeof(n));
+    in.read(reinterpret_cast<char*>(&targets), sizeof(targets));
+
+    if (!in || std::memcmp(magic, fileMagic, sizeof(magic)) != 0 || version != fileVersion ||
+        n != static_cast<uint64_t>(graph.numberOfNodes()))
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint64_t> offsets(n + 1);
+    CompactGraph result;
+    result.m_targets.resize(targets);
+
+    in.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    in.read(reinterpret_cast<char*>(result.m_targets.data()), targets * sizeof(vertex));
+    if (!in || offsets[0] != 0 || offsets[n] != targets)
+        return std::nullopt;
+
+    for (uint64_t v = 0; v < n; v++)
+    {
+        if (offsets[v] > offsets[v + 1])
+            return std::nullopt;
+    }
+
+    for (auto target: result.m_targets)
+    {
+        if (target >= n)
+            return std::nullopt;
+    }
+
+    result.m_offsets.assign(offsets.begin(), offsets.end());
+    result.m_nodes.reserve(n);
+    result.m_ids.assign(graph.maxNodeIndex() + 1, 0);
+    for (auto node: graph.nodes)
+    {
+        result.m_ids[node->index()] = result.m_nodes.size();
+        result.m_nodes.push_back(node);
+    }
+
+    result.build_matrix(dense_limit);
+    return result;
+}
+
+bool CompactGraph::adjacent(vertex u, vertex v) const
+{
+    if (has_matrix())
+        return (row(u)[v / NodeBitset::word_bits] >> (v % NodeBitset::word_bits)) & 1u;
+
+    //search the shorter adjacency list
+    if (degree(u) > degree(v))
+        std::swap(u, v);
+
+    return std::binary_search(neighbors_begin(u), neighbors_end(u), v);
+}
+
+void CompactGraph::keep_neighbors(NodeBitset& set, vertex v) const
+{
+    if (has_matrix())
+    {
+        set.intersect_with(row(v));
+        return;
+    }
+
+    NodeBitset result(set.capacity());
+    for (auto it = neighbors_begin(v); it != neighbors_end(v); it++)
+    {
+        if (set.test(*it))
+            result.set(*it);
+    }
+    set = std::move(result);
+}
+
+void CompactGraph::remove_neighbors(NodeBitset& set, vertex v) const
+{
+    if (has_matrix())
+    {
+        set.subtract(row(v));
+        return;
+    }
+
+    for (auto it = neighbors_begin(v); it != neighbors_end(v); it++)
+        set.reset(*it);
+}
+
+bool CompactGraph::is_independent(const NodeBitset& set) const
+{
+    bool independent = true;
+    set.for_each([&](size_t v)
+    {
+        for (auto it = neighbors_begin(v); independent && it != neighbors_end(v); it++)
+        {
+            if (set.test(*it))
+                independent = false;
+        }
+    });
+    return independent;
+}
@@ -0,0 +1,117 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#pragma once
+
+#include "NodeBitset.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+/**
+ * Read-only snapshot of an undirected simple graph used by the solvers.
+ * Vertices get dense ids 0..n-1 (in the order of graph.nodes), the adjacency is stored
+ * in CSR form (sorted, without self-loops and parallel edges) and, for graphs that are
+ * not too large, also as a matrix of word-packed adjacency rows usable with NodeBitset.
+ */
+class CompactGraph {
+public:
+
+    using vertex = uint32_t;
+
+    //graphs with more vertices only keep the CSR adjacency (the matrix would take n^2 / 8 bytes)
+    static constexpr size_t default_dense_limit = 1 << 15;
+
+    explicit CompactGraph(const ogdf::Graph& graph, size_t dense_limit = default_dense_limit);
+
+    /**
+     * Builds the complement directly from the adjacency rows (or the sorted CSR when there is no matrix)
+     * in O(n^2 / 64 + n + m') where m' is the number of edges of the complement.
+     * The vertices keep their ids and their mapping to the original nodes.
+     */
+    CompactGraph complement(size_t dense_limit = default_dense_limit) const;
+
+    /**
+     * Binary serialization of the adjacency (the node mapping is not stored).
+     * Format, native endianness: "GALC", uint32 version, uint64 n, uint64 number of targets,
+     * (n + 1) x uint64 offsets, targets x uint32 targets.
+     */
+    void save(std::ostream& out) const;
+
+    //loads a snapshot stored by save() and maps its vertices to graph.nodes (in their order),
+    //returns nothing when the data is malformed or doesn't match the graph
+    static std::optional<CompactGraph> load(std::istream& in, const ogdf::Graph& graph,
+                                            size_t dense_limit = default_dense_limit);
+
+    size_t node_count() const
+    { return m_nodes.size(); }
+
+    //number of undirected edges after removing self-loops and parallel edges
+    size_t edge_count() const
+    { return m_targets.size() / 2; }
+
+    ogdf::node original(vertex v) const
+    { return m_nodes[v]; }
+
+    vertex id(ogdf::node node) const
+    { return m_ids[node->index()]; }
+
+    size_t degree(vertex v) const
+    { return m_offsets[v + 1] - m_offsets[v]; }
+
+    const vertex* neighbors_begin(vertex v) const
+    { return m_targets.data() + m_offsets[v]; }
+
+    const vertex* neighbors_end(vertex v) const
+    { return m_targets.data() + m_offsets[v + 1]; }
+
+    bool has_matrix() const
+    { return !m_matrix.empty(); }
+
+    //packed adjacency row of v, only available when has_matrix()
+    const NodeBitset::word* row(vertex v) const
+    { return m_matrix.data() + v * m_row_words; }
+
+    bool adjacent(vertex u, vertex v) const;
+
+    //empty set sized for this graph
+    NodeBitset empty_set() const
+    { return NodeBitset(node_count()); }
+
+    //set of all the vertices
+    NodeBitset full_set() const
+    { return NodeBitset(node_count(), true); }
+
+    //set = set ∩ N(v)
+    void keep_neighbors(NodeBitset& set, vertex v) const;
+
+    //set = set \ N(v)
+    void remove_neighbors(NodeBitset& set, vertex v) const;
+
+    //checks that no two vertices of the set are adjacent in O(k + sum of their degrees)
+    bool is_independent(const NodeBitset& set) const;
+
+private:
+
+    CompactGraph() = default;
+
+    void build_matrix(size_t dense_limit);
+
+    std::vector<ogdf::node> m_nodes;
+    std::vector<vertex> m_ids;
+    std::vector<size_t> m_offsets;
+    std::vector<vertex> m_targets;
+
+    size_t m_row_words { 0 };
+    std::vector<NodeBitset::word> m_matrix;
+};
@@ -9,81 +9,56 @@
 
 #include "Greedy2Solver.h"
 
-#include <queue>
+#include <algorithm>
 
-MISSolver::node_set Greedy2Solver::greedy2_independent_set(const ogdf::Graph& input_graph)
+MISSolver::node_set Greedy2Solver::greedy2_independent_set(const CompactGraph& graph)
 {
-    auto degree_comparator = [](const std::pair<ogdf::node, ogdf::node>& a, const std::pair<ogdf::node, ogdf::node>& b) {
-        return ((a.first->degree() + a.second->degree()) / 2) >
-               ((b.first->degree() + b.second->degree()) / 2);
+    using vertex = CompactGraph::vertex;
+    
+    auto pair_density = [&](const std::pair<vertex, vertex>& p) {
+        return (graph.degree(p.first) + graph.degree(p.second)) / 2;
     };
     
-    std::priority_queue<std::pair<ogdf::node, ogdf::node>, 
-                        std::vector<std::pair<ogdf::node, ogdf::node>>,
-                        decltype(degree_comparator)> original_queue(degree_comparator);
-    node_set working_set(node_comparator);
-    node_set output_set(node_comparator);        
+    std::vector<std::pair<vertex, vertex>> original_queue;
+    NodeBitset working_set = graph.full_set();
+    NodeBitset output_set = graph.empty_set();
     
     //enumerate pairs of 2 independent nodes
-    for(auto first_node = input_graph.firstNode(); first_node; first_node = first_node->succ())
+    for(vertex first_node = 0; first_node < graph.node_count(); first_node++)
     {
-        for(auto second_node = first_node->succ(); second_node; second_node = second_node->succ())
+        for(vertex second_node = first_node + 1; second_node < graph.node_count(); second_node++)
         {
-            ogdf::List<ogdf::edge> neighbors;
-            second_node->adjEdges(neighbors);
-            
-            //check if pair of nodes are independent
-            bool independent = true;
-            for(auto edge: neighbors)
-            {
-                if(edge->nodes()[0] == first_node || 
-                   edge->nodes()[1] == first_node) 
-                { 
-                    independent = false; 
-                    break; 
-                }
-            }
-            
             //if they are independent, sort them by their degree density
-            if(independent)
-                original_queue.push(std::make_pair(first_node, second_node));
+            if(!graph.adjacent(first_node, second_node))
+                original_queue.emplace_back(first_node, second_node);
         }
-        
-        working_set.insert(first_node);
     }
     
-    while(!original_queue.empty())
+    //the densities don't change so a sorted array replaces the priority queue
+    std::stable_sort(original_queue.begin(), original_queue.end(), [&](const auto& a, const auto& b) {
+        return pair_density(a) < pair_density(b);
+    });
+    
+    //process both nodes
+    auto process_node = [&](vertex node)
     {
-        //get pair of independent nodes with smallest degree density
-        auto independent_node_pair = original_queue.top();
-        original_queue.pop();
+        if(!working_set.test(node))
+            return;
         
-        auto first_node = independent_node_pair.first;
-        auto second_node = independent_node_pair.second;
-        
-        //process both nodes
-        auto process_node = [&](ogdf::node node)
-        {
-            if(working_set.find(node) == working_set.end())
-                return;
-            
-            //add node into the solution
-            output_set.insert(node);
-            
-            ogdf::List<ogdf::edge> neighbors;
-            node->adjEdges(neighbors);
+        //add node into the solution
+        output_set.set(node);
         
-            //remove node and its' neighbors from explorable set
-            for(auto edge: neighbors)
-            {
-                working_set.erase(edge->nodes()[0]);
-                working_set.erase(edge->nodes()[1]);
-            }
-        };
-        
-        process_node(first_node);
-        process_node(second_node);
+        //remove node and its' neighbors from explorable set
+        working_set.reset(node);
+        graph.remove_neighbors(working_set, node);
+    };
+    
+    //take pairs of independent nodes starting with the smallest degree density
+    for(const auto& independent_node_pair : original_queue)
+    {
+        process_node(independent_node_pair.first);
+        process_node(independent_node_pair.second);
     }
     
-    return output_set;
-}
\ No newline at end of file
+    return to_node_set(graph, output_set);
+}
@@ -25,12 +25,13 @@ public:
         return "Greedy2 Solver";
     }
     
-    virtual node_set solve(const ogdf::Graph& graph) override
+    using MISSolver::solve;
+    virtual node_set solve(const CompactGraph& graph) override
     {
         return greedy2_independent_set(graph);
     }
     
 private:
 
-    node_set greedy2_independent_set(const ogdf::Graph& input_graph);
+    node_set greedy2_independent_set(const CompactGraph& graph);
 };
\ No newline at end of file
@@ -9,51 +9,33 @@
 
 #include "GreedySolver.h"
 
-#include <queue>
-
-MISSolver::node_set GreedySolver::greedy_independent_set(const ogdf::Graph& input_graph)
+MISSolver::node_set GreedySolver::greedy_independent_set(const CompactGraph& graph)
 {
-    //collect input nodes into a set 
-    auto degree_comparator = [](const ogdf::node& a, const ogdf::node& b)
+    //sort nodes by their degree, the degrees don't change so a sorted array replaces the priority queue
+    std::vector<CompactGraph::vertex> original_queue(graph.node_count());
+    std::iota(original_queue.begin(), original_queue.end(), 0);
+    std::stable_sort(original_queue.begin(), original_queue.end(), [&](auto a, auto b)
     {
-        return a->degree() > b->degree();
-    };
+        return graph.degree(a) < graph.degree(b);
+    });
     
-    std::priority_queue<ogdf::node, std::vector<ogdf::node>, decltype(degree_comparator)> original_queue(degree_comparator);
-    node_set working_set(MISSolver::node_comparator);
-    node_set output_set(MISSolver::node_comparator);
+    //set containing explorable nodes
+    NodeBitset working_set = graph.full_set();
+    NodeBitset output_set = graph.empty_set();
     
-    for(auto node : input_graph.nodes)
+    //take nodes starting with the smallest degree
+    for(auto node : original_queue)
     {
-        //sort nodes by they degree
-        original_queue.push(node);
-        
-        //set containing explorable nodes
-        working_set.insert(node);
-    }
-    
-    while(!original_queue.empty())
-    {
-        //get node with the smallest degree
-        auto node = original_queue.top();
-        original_queue.pop();
-        
-        if(working_set.find(node) == working_set.end())
+        if(!working_set.test(node))
             continue;
         
         //add node into the solution
-        output_set.insert(node);
-        
-        ogdf::List<ogdf::edge> neighbors;
-        node->adjEdges(neighbors);
+        output_set.set(node);
         
         //remove node and its' neigbors from explorable set
-        for(auto edge: neighbors)
-        {
-            working_set.erase(edge->nodes()[0]);
-            working_set.erase(edge->nodes()[1]);
-        }
+        working_set.reset(node);
+        graph.remove_neighbors(working_set, node);
     }
     
-    return output_set;
-}
\ No newline at end of file
+    return to_node_set(graph, output_set);
+}
@@ -12,6 +12,7 @@
 #include "MISSolver.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 
 class GreedySolver : public MISSolver {
@@ -28,12 +29,13 @@ public:
         return "Greedy Solver";
     }
 
-    virtual node_set solve(const ogdf::Graph& input) override
+    using MISSolver::solve;
+    virtual node_set solve(const CompactGraph& input) override
     {
         return greedy_independent_set(input);
     };
     
 private:
     
-    node_set greedy_independent_set(const ogdf::Graph& input_graph);
+    node_set greedy_independent_set(const CompactGraph& graph);
 };
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "CompactGraph.h"
+
 #include <ogdf/basic/graph_generators.h>
 #include <set>
 
@@ -22,6 +24,25 @@ public:
     
     using node_set = std::set<ogdf::node, decltype(node_comparator)>;
 
-    virtual node_set solve(const ogdf::Graph&) = 0;
+    node_set solve(const ogdf::Graph& graph)
+    {
+        return solve(CompactGraph(graph));
+    }
+
+    //the returned nodes are the original nodes of the snapshot
+    virtual node_set solve(const CompactGraph&) = 0;
     virtual const char* name() = 0;
+
+protected:
+
+    //converts a set of dense ids back to the nodes of the original graph
+    node_set to_node_set(const CompactGraph& graph, const NodeBitset& set) const
+    {
+        node_set result(node_comparator);
+        set.for_each([&](size_t v)
+        {
+            result.insert(result.end(), graph.original(v));
+        });
+        return result;
+    }
 };
\ No newline at end of file
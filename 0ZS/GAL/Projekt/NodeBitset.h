@@ -0,0 +1,205 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Set of dense vertex ids (see CompactGraph) packed into 64-bit words.
+ * All the set operations work word by word on contiguous memory, so the compiler
+ * is free to vectorize them.
+ */
+class NodeBitset {
+public:
+
+    using word = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    NodeBitset() = default;
+
+    explicit NodeBitset(size_t capacity, bool full = false)
+            : m_words(word_count(capacity), full ? ~word(0) : word(0)), m_capacity(capacity)
+    {
+        if (full)
+            clear_tail();
+    }
+
+    static size_t word_count(size_t capacity)
+    {
+        return (capacity + word_bits - 1) / word_bits;
+    }
+
+    size_t capacity() const
+    { return m_capacity; }
+
+    size_t words() const
+    { return m_words.size(); }
+
+    word* data()
+    { return m_words.data(); }
+
+    const word* data() const
+    { return m_words.data(); }
+
+    bool test(size_t i) const
+    {
+        return (m_words[i / word_bits] >> (i % word_bits)) & 1u;
+    }
+
+    void set(size_t i)
+    {
+        m_words[i / word_bits] |= word(1) << (i % word_bits);
+    }
+
+    void reset(size_t i)
+    {
+        m_words[i / word_bits] &= ~(word(1) << (i % word_bits));
+    }
+
+    void clear()
+    {
+        for (auto& w: m_words)
+            w = 0;
+    }
+
+    //number of ids in the set
+    size_t count() const
+    {
+        size_t result = 0;
+        for (auto w: m_words)
+            result += __builtin_popcountll(w);
+        return result;
+    }
+
+    bool empty() const
+    {
+        for (auto w: m_words)
+        {
+            if (w)
+                return false;
+        }
+        return true;
+    }
+
+    //this = this ∩ other
+    NodeBitset& operator&=(const NodeBitset& other)
+    {
+        intersect_with(other.data());
+        return *this;
+    }
+
+    //this = this ∪ other
+    NodeBitset& operator|=(const NodeBitset& other)
+    {
+        const word* src = other.data();
+        for (size_t i = 0; i < m_words.size(); i++)
+            m_words[i] |= src[i];
+        return *this;
+    }
+
+    //this = this \ other
+    NodeBitset& operator-=(const NodeBitset& other)
+    {
+        subtract(other.data());
+        return *this;
+    }
+
+    //raw variants used with adjacency rows of CompactGraph
+    void intersect_with(const word* other)
+    {
+        for (size_t i = 0; i < m_words.size(); i++)
+            m_words[i] &= other[i];
+    }
+
+    void subtract(const word* other)
+    {
+        for (size_t i = 0; i < m_words.size(); i++)
+            m_words[i] &= ~other[i];
+    }
+
+    //complement within [0, capacity)
+    void flip()
+    {
+        for (auto& w: m_words)
+            w = ~w;
+        clear_tail();
+    }
+
+    //first id in the set or capacity() when the set is empty
+    size_t first() const
+    {
+        return next(0);
+    }
+
+    //first id >= from in the set or capacity() when there is none
+    size_t next(size_t from) const
+    {
+        if (from >= m_capacity)
+            return m_capacity;
+
+        size_t wi = from / word_bits;
+        word w = m_words[wi] & (~word(0) << (from % word_bits));
+
+        while (true)
+        {
+            if (w)
+                return wi * word_bits + __builtin_ctzll(w);
+            if (++wi == m_words.size())
+                return m_capacity;
+            w = m_words[wi];
+        }
+    }
+
+    //k-th id in the set (counted from zero), k must be lower than count()
+    size_t nth(size_t k) const
+    {
+        for (size_t wi = 0; wi < m_words.size(); wi++)
+        {
+            word w = m_words[wi];
+            size_t c = __builtin_popcountll(w);
+            if (k < c)
+            {
+                for (; k > 0; k--)
+                    w &= w - 1;
+                return wi * word_bits + __builtin_ctzll(w);
+            }
+            k -= c;
+        }
+        return m_capacity;
+    }
+
+    template<class Func>
+    void for_each(Func&& f) const
+    {
+        for (size_t wi = 0; wi < m_words.size(); wi++)
+        {
+            word w = m_words[wi];
+            while (w)
+            {
+                f(wi * word_bits + __builtin_ctzll(w));
+                w &= w - 1;
+            }
+        }
+    }
+
+private:
+
+    std::vector<word> m_words;
+    size_t m_capacity { 0 };
+
+    //keeps the bits beyond capacity zeroed so that count() and first() stay valid
+    void clear_tail()
+    {
+        if (m_capacity % word_bits)
+            m_words.back() &= (word(1) << (m_capacity % word_bits)) - 1;
+    }
+};
@@ -33,8 +33,10 @@
 
 #include <ogdf/basic/basic.h>
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 
 namespace ogdf {
@@ -86,4 +88,82 @@ public:
 
 };
 
+//! Representation of a barrier that avoids locks for short waits.
+/**
+ * @ingroup threads
+ *
+ * An epoch barrier has the same semantics as Barrier, but a thread reaching it only
+ * increments an atomic counter. The last thread of the group advances the epoch, which
+ * the others observe by spinning for a short while and then by yielding. Only threads
+ * that wait for long are put to sleep on a condition variable, so the barrier is cheap
+ * when the threads of the group reach it at about the same time, e.g., in every phase
+ * of an iterative algorithm. If there are more threads than processors, the threads
+ * yield right away instead of spinning.
+ */
+class EpochBarrier {
+
+	static constexpr int NumSpins = 4096; //!< the number of spins before a waiting thread yields
+	static constexpr int NumYields = 64; //!< the number of yields before a waiting thread sleeps
+
+	std::atomic<uint32_t> m_numThreadsReachedSync; //!< number of threads that reached current synchronization point.
+	std::atomic<uint32_t> m_epoch; //!< number of current synchronization point.
+	std::atomic<uint32_t> m_numSleepingThreads; //!< number of threads waiting on the condition variable.
+
+	std::condition_variable m_epochChanged;
+	std::mutex m_epochChangedLock;
+
+	uint32_t m_threadCount; //!< the number of threads in the group.
+	bool m_spin; //!< whether waiting threads spin before they yield.
+
+public:
+
+	//! Creates a barrier for a group of \p numThreads threads.
+	explicit EpochBarrier(uint32_t numThreads)
+		: m_numThreadsReachedSync(0)
+		, m_epoch(0)
+		, m_numSleepingThreads(0)
+		, m_threadCount(numThreads)
+		, m_spin(numThreads <= std::thread::hardware_concurrency()) { }
+
+	//! Synchronizes the threads in the group.
+	/**
+	 * Each thread proceeds only after all threads in the group have reached the barrier.
+	 * A barrier may be used for several synchronization points.
+	 */
+	void threadSync() {
+		const uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+
+		if (m_numThreadsReachedSync.fetch_add(1, std::memory_order_acq_rel) + 1 == m_threadCount) {
+			// the counter is reset before any thread may reach the next synchronization point
+			m_numThreadsReachedSync.store(0, std::memory_order_relaxed);
+			m_epoch.store(epoch + 1);
+
+			if (m_numSleepingThreads.load() > 0) {
+				std::lock_guard<std::mutex> lk(m_epochChangedLock);
+				m_epochChanged.notify_all();
+			}
+			return;
+		}
+
+		for (int i = 0; m_spin && i < NumSpins; ++i) {
+			if (m_epoch.load(std::memory_order_acquire) != epoch) {
+				return;
+			}
+		}
+
+		for (int i = 0; i < NumYields; ++i) {
+			if (m_epoch.load(std::memory_order_acquire) != epoch) {
+				return;
+			}
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lk(m_epochChangedLock);
+		m_numSleepingThreads++;
+		m_epochChanged.wait(lk, [epoch,this]{ return m_epoch.load() != epoch; });
+		m_numSleepingThreads--;
+	}
+
+};
+
 }
@@ -0,0 +1,222 @@
+/** \file
+ * \brief Declaration of ogdf::CompactGraph, an immutable CSR snapshot of a graph
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/NodeArray.h>
+#include <ogdf/basic/EdgeArray.h>
+
+namespace ogdf {
+
+//! Immutable compressed sparse row (CSR) snapshot of a graph.
+/**
+ * @ingroup graphs
+ *
+ * The nodes and edges of the graph are numbered densely from 0 in the order of
+ * Graph::nodes and Graph::edges. The adjacency entries of node \a v occupy the
+ * contiguous range [offset(\a v), offset(\a v + 1)) of the entry arrays; the
+ * outgoing entries come first (up to outEnd(\a v)), followed by the incoming
+ * ones, each group in the order of \a v->adjEntries. For every entry, the
+ * snapshot stores the dense id of the adjacent node, the dense id of the edge
+ * and the position of the reverse entry (the one at the other end of the edge).
+ *
+ * A snapshot is built in time O(n + m) and does not observe the graph; it
+ * becomes stale when the graph is modified. Since a GraphCopy is a Graph, a
+ * snapshot of a copy refers to the nodes and edges of the copy, which can be
+ * mapped further by GraphCopy::original().
+ *
+ * Read-only algorithms that have overloads working on a CompactGraph take and
+ * return values in arrays indexed by the dense ids; see gatherNodes(),
+ * gatherEdges() and scatterNodes() for converting from and to the usual
+ * NodeArray and EdgeArray.
+ */
+class OGDF_EXPORT CompactGraph {
+public:
+	//! Creates an empty snapshot.
+	CompactGraph() : m_graph(nullptr) { }
+
+	//! Creates a snapshot of \p G.
+	explicit CompactGraph(const Graph &G) {
+		init(G);
+	}
+
+	//! Reinitializes the snapshot with the current state of \p G.
+	void init(const Graph &G);
+
+	//! Returns the graph the snapshot has been built from.
+	const Graph *graph() const { return m_graph; }
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_nodes.size(); }
+
+	//! Returns the number of edges.
+	int numberOfEdges() const { return m_edges.size(); }
+
+	//! Returns the number of adjacency entries (twice the number of edges).
+	int numberOfEntries() const { return m_entryTarget.size(); }
+
+	/**
+	 * @name Dense ids and handles
+	 */
+	//! @{
+
+	//! Returns the dense id of node \p v.
+	int id(node v) const {
+		OGDF_ASSERT(v->graphOf() == m_graph);
+		return m_nodeId[v->index()];
+	}
+
+	//! Returns the dense id of edge \p e.
+	int id(edge e) const {
+		OGDF_ASSERT(e->graphOf() == m_graph);
+		return m_edgeId[e->index()];
+	}
+
+	//! Returns the node with dense id \p v.
+	node toNode(int v) const { return m_nodes[v]; }
+
+	//! Returns the edge with dense id \p e.
+	edge toEdge(int e) const { return m_edges[e]; }
+
+	//! Returns the dense id of the source of edge \p e.
+	int edgeSource(int e) const { return m_entryTarget[targetEntry(e)]; }
+
+	//! Returns the dense id of the target of edge \p e.
+	int edgeTarget(int e) const { return m_entryTarget[m_edgeEntry[e]]; }
+
+	//! @}
+	/**
+	 * @name Adjacency entries
+	 */
+	//! @{
+
+	//! Returns the position of the first adjacency entry of node \p v.
+	/**
+	 * offset(numberOfNodes()) equals numberOfEntries(), so the entries of
+	 * \p v are always [offset(\p v), offset(\p v + 1)).
+	 */
+	int offset(int v) const { return m_offset[v]; }
+
+	//! Returns the position after the last outgoing adjacency entry of node \p v.
+	int outEnd(int v) const { return m_outEnd[v]; }
+
+	//! Returns the degree of node \p v.
+	int degree(int v) const { return m_offset[v + 1] - m_offset[v]; }
+
+	//! Returns the number of outgoing edges of node \p v.
+	int outdeg(int v) const { return m_outEnd[v] - m_offset[v]; }
+
+	//! Returns the number of incoming edges of node \p v.
+	int indeg(int v) const { return m_offset[v + 1] - m_outEnd[v]; }
+
+	//! Returns the dense id of the node adjacent via entry \p i.
+	int target(int i) const { return m_entryTarget[i]; }
+
+	//! Returns the dense id of the edge of entry \p i.
+	int edgeOf(int i) const { return m_entryEdge[i]; }
+
+	//! Returns the position of the reverse entry of entry \p i.
+	int twin(int i) const { return m_entryTwin[i]; }
+
+	//! Returns the position of the outgoing entry of edge \p e (the one at its source).
+	int sourceEntry(int e) const { return m_edgeEntry[e]; }
+
+	//! Returns the position of the incoming entry of edge \p e (the one at its target).
+	int targetEntry(int e) const { return m_entryTwin[m_edgeEntry[e]]; }
+
+	//! Returns the contiguous array of the offsets (numberOfNodes() + 1 elements).
+	const int *offsets() const { return m_offset.begin(); }
+
+	//! Returns the contiguous array of the adjacent nodes of all entries.
+	const int *targets() const { return m_entryTarget.begin(); }
+
+	//! Returns the contiguous array of the edges of all entries.
+	const int *entryEdges() const { return m_entryEdge.begin(); }
+
+	//! @}
+	/**
+	 * @name Conversion of values
+	 */
+	//! @{
+
+	//! Copies the values of \p values into \p dense, indexed by dense node ids.
+	template<typename T>
+	void gatherNodes(const NodeArray<T> &values, Array<T> &dense) const {
+		dense.init(numberOfNodes());
+		for (int v = 0; v < numberOfNodes(); ++v) {
+			dense[v] = values[m_nodes[v]];
+		}
+	}
+
+	//! Copies the values of \p values into \p dense, indexed by dense edge ids.
+	template<typename T>
+	void gatherEdges(const EdgeArray<T> &values, Array<T> &dense) const {
+		dense.init(numberOfEdges());
+		for (int e = 0; e < numberOfEdges(); ++e) {
+			dense[e] = values[m_edges[e]];
+		}
+	}
+
+	//! Copies the values of \p dense, indexed by dense node ids, into \p values.
+	/**
+	 * \p values is (re)initialized for the graph of the snapshot if necessary.
+	 */
+	template<typename T>
+	void scatterNodes(const Array<T> &dense, NodeArray<T> &values) const {
+		if (values.graphOf() != m_graph) {
+			values.init(*m_graph);
+		}
+		for (int v = 0; v < numberOfNodes(); ++v) {
+			values[m_nodes[v]] = dense[v];
+		}
+	}
+
+	//! @}
+
+private:
+	const Graph *m_graph; //!< The graph of the snapshot.
+
+	Array<node> m_nodes; //!< The node with each dense id.
+	Array<edge> m_edges; //!< The edge with each dense id.
+	Array<int> m_nodeId; //!< The dense id of each node, indexed by node::index().
+	Array<int> m_edgeId; //!< The dense id of each edge, indexed by edge::index().
+
+	Array<int> m_offset; //!< The first entry of each node (plus a sentinel).
+	Array<int> m_outEnd; //!< The end of the outgoing entries of each node.
+
+	Array<int> m_entryTarget; //!< The adjacent node of each entry.
+	Array<int> m_entryEdge; //!< The edge of each entry.
+	Array<int> m_entryTwin; //!< The reverse entry of each entry.
+	Array<int> m_edgeEntry; //!< The outgoing entry of each edge.
+};
+
+}
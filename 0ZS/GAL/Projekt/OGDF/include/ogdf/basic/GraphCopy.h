@@ -69,10 +69,13 @@ public:
 	//! Constructs a GraphCopySimple associated with no graph.
 	GraphCopySimple();
 
-	//! Constructs a copy of graph \p G.
-	explicit GraphCopySimple(const Graph &G);
+	//! Constructs a GraphCopySimple associated with no graph whose elements are allocated as specified by \p allocation.
+	explicit GraphCopySimple(ElementAllocation allocation);
 
-	//! Copy constructor.
+	//! Constructs a copy of graph \p G whose elements are allocated as specified by \p allocation.
+	explicit GraphCopySimple(const Graph &G, ElementAllocation allocation = ElementAllocation::pool);
+
+	//! Copy constructor, the copy allocates its elements in the same way as \p GC.
 	GraphCopySimple(const GraphCopySimple &GC);
 
 	virtual ~GraphCopySimple() { }
@@ -264,19 +267,23 @@ protected:
 	EdgeArray<List<edge> > m_eCopy; //!< The corresponding list of edges in the graph copy.
 
 public:
-	//! Creates a graph copy of \p G.
+	//! Creates a graph copy of \p G whose elements are allocated as specified by \p allocation.
 	/**
 	 * See #init for details.
 	 */
-	explicit GraphCopy(const Graph &G);
+	explicit GraphCopy(const Graph &G, ElementAllocation allocation = ElementAllocation::pool);
 
 	//! Default constructor (does nothing!).
 	GraphCopy() : Graph(), m_pGraph(nullptr) { }
 
+	//! Constructs an empty graph copy whose elements are allocated as specified by \p allocation.
+	explicit GraphCopy(ElementAllocation allocation) : Graph(allocation), m_pGraph(nullptr) { }
+
 	//! Copy constructor.
 	/**
 	 * Creates a graph copy that is a copy of \p GC and represents a graph
-	 * copy of the original graph of \p GC.
+	 * copy of the original graph of \p GC. It allocates its elements in the
+	 * same way as \p GC.
 	 */
 	GraphCopy(const GraphCopy &GC);
 
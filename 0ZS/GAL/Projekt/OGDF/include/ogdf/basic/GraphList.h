@@ -361,6 +361,12 @@ public:
 		}
 	}
 
+	//! Removes all elements from the list without deleting them.
+	void clearPure() {
+		m_head = m_tail = nullptr;
+		m_size = 0;
+	}
+
 	//! Sorts all elements according to \p newOrder.
 	template<class T_LIST>
 	void sort(const T_LIST &newOrder) {
@@ -36,6 +36,7 @@
 
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/internal/graph_iterators.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
 #include <array>
 #include <mutex>
 
@@ -514,6 +515,8 @@ private:
 
 	List<HiddenEdgeSet*> m_hiddenEdgeSets; //!< The list of hidden edges.
 
+	ArenaMemoryAllocator *m_arena; //!< The arena of the elements, or nullptr if they are allocated by OGDF_ALLOCATOR.
+
 public:
 
 	/**
@@ -555,6 +558,12 @@ public:
 		associationClass = 6
 	};
 
+	//! Where the nodes, edges and adjacency entries of a graph are allocated.
+	enum class ElementAllocation {
+		pool = 0,  //!< By the global memory manager (OGDF_ALLOCATOR), shared by all graphs.
+		arena = 1  //!< In an arena owned by the graph, placed in creation order and freed at once with the graph.
+	};
+
 	//@}
 
 
@@ -576,11 +585,18 @@ public:
 	//! Constructs an empty graph.
 	Graph();
 
+	//! Constructs an empty graph whose elements are allocated as specified by \p allocation.
+	/**
+	 * See setElementAllocation().
+	 */
+	explicit Graph(ElementAllocation allocation);
+
 	//! Constructs a graph that is a copy of \p G.
 	/**
 	 * The constructor assures that the adjacency lists of nodes in the
 	 * constructed graph are in the same order as the adjacency lists in \p G.
 	 * This is in particular important when dealing with embedded graphs.
+	 * The copy allocates its elements in the same way as \p G.
 	 *
 	 * @param G is the graph that will be copied.
 	 */
@@ -617,6 +633,32 @@ public:
 	//! Returns the table size of adjEntry arrays associated with this graph.
 	int adjEntryArrayTableSize() const { return m_edgeArrayTableSize << 1; }
 
+	//! Returns how the elements of the graph are allocated.
+	ElementAllocation elementAllocation() const {
+		return m_arena == nullptr ? ElementAllocation::pool : ElementAllocation::arena;
+	}
+
+	//! Sets how the elements of the graph are allocated.
+	/**
+	 * With ElementAllocation::arena, the nodes, edges and adjacency entries of the
+	 * graph are allocated in an arena of their own instead of the memory pool shared
+	 * by all graphs and lists. Elements created one after another (e.g., when copying
+	 * a graph or by newNodes() and newEdges()) are placed next to each other in memory,
+	 * and clearing or destroying the graph frees all of them at once instead of
+	 * returning every single element to the pool. This is a good fit for temporary
+	 * graphs such as the GraphCopy instances created during an algorithm.
+	 *
+	 * \pre The graph is empty and has no hidden edges.
+	 */
+	void setElementAllocation(ElementAllocation allocation);
+
+	//! Returns the memory (in bytes) occupied by the nodes, edges and adjacency entries of this graph.
+	/**
+	 * With ElementAllocation::arena, this is the memory the arena allocated from the system,
+	 * otherwise the memory taken from the pool by the elements that currently belong to the graph.
+	 */
+	size_t elementMemory() const;
+
 	//! Returns the first node in the list of all nodes.
 	node firstNode() const { return nodes.head(); }
 	//! Returns the last node in the list of all nodes.
@@ -750,6 +792,44 @@ public:
 	 */
 	edge newEdge(adjEntry adjSrc, node w);
 
+	//! Prepares the graph for the creation of \p n further nodes.
+	/**
+	 * Enlarges the tables of all registered node arrays at once, so that creating
+	 * the nodes does not resize them again, and preallocates the memory of the
+	 * node elements in one go.
+	 *
+	 * @param n is the number of nodes that will be created.
+	 */
+	void reserveNodes(int n);
+
+	//! Prepares the graph for the creation of \p m further edges.
+	/**
+	 * Enlarges the tables of all registered edge and adjacency entry arrays at
+	 * once, so that creating the edges does not resize them again, and preallocates
+	 * the memory of the edge and adjacency elements in one go.
+	 *
+	 * @param m is the number of edges that will be created.
+	 */
+	void reserveEdges(int m);
+
+	//! Creates \p n new nodes.
+	/**
+	 * Equivalent to calling newNode() \p n times after reserveNodes(\p n).
+	 *
+	 * @param n        is the number of nodes to create.
+	 * @param newNodes is assigned the created nodes in the order of creation (if not null).
+	 */
+	void newNodes(int n, Array<node> *newNodes = nullptr);
+
+	//! Creates an edge (\a v,\a w) for every pair (\a v,\a w) in \p edgeList.
+	/**
+	 * Equivalent to calling newEdge() for every pair after reserveEdges().
+	 *
+	 * @param edgeList is the list of the source and target nodes of the new edges.
+	 * @param newEdges is assigned the created edges in the order of \p edgeList (if not null).
+	 */
+	void newEdges(const Array<std::pair<node, node>> &edgeList, Array<edge> *newEdges = nullptr);
+
 
 	//@}
 	/**
@@ -1402,6 +1482,29 @@ private:
 	edge createEdgeElement(node v, node w, adjEntry adjSrc, adjEntry adjTgt);
 	node pureNewNode();
 
+	//! Allocates and constructs a node, edge or adjacency element according to the element allocation.
+	template<class T, class... Args>
+	T *newElement(Args&&... args) {
+		if (m_arena != nullptr) {
+			return ::new (m_arena->allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		}
+		return new T(std::forward<Args>(args)...);
+	}
+
+	//! Frees an element allocated by #newElement().
+	template<class T>
+	void deleteElement(T *pX) {
+		if (m_arena != nullptr) {
+			pX->~T();
+			m_arena->deallocate(sizeof(T), pX);
+		} else {
+			delete pX;
+		}
+	}
+
+	//! Frees all nodes, edges and adjacency entries at once.
+	void deleteAllElements();
+
 	// moves adjacency entry to node w
 	void moveAdj(adjEntry adj, node w);
 
@@ -33,7 +33,10 @@
 
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/memory.h>
+#include <ogdf/basic/System.h>
+#include <functional>
 #include <thread>
+#include <vector>
 
 
 namespace ogdf {
@@ -79,4 +82,56 @@ public:
 	}
 };
 
+//! Returns \p numberOfThreads, or the number of processors (at least 1) if \p numberOfThreads is 0.
+/**
+ * @ingroup threads
+ */
+inline unsigned int resolveNumberOfThreads(unsigned int numberOfThreads)
+{
+	return numberOfThreads == 0 ? unsigned(max(System::numberOfProcessors(), 1)) : numberOfThreads;
+}
+
+//! Runs \p body(\a t) for \a t = 0, ..., \p numberOfThreads - 1, each in its own thread, and waits for all of them.
+/**
+ * @ingroup threads
+ *
+ * The calling thread runs \p body(0) itself, so no thread is started if \p numberOfThreads is 1.
+ */
+template<class Body>
+void runThreads(unsigned int numberOfThreads, Body body)
+{
+	// Thread refers to its function while it runs, so the functions have to outlive the threads
+	std::vector<std::function<void()>> functions;
+	functions.reserve(numberOfThreads);
+	for (unsigned int t = 1; t < numberOfThreads; ++t) {
+		functions.emplace_back([&body, t] { body(t); });
+	}
+
+	std::vector<Thread> threads;
+	threads.reserve(functions.size());
+	for (std::function<void()> &function : functions) {
+		threads.emplace_back(function);
+	}
+	body(0);
+	for (Thread &thread : threads) {
+		thread.join();
+	}
+}
+
+//! Splits [\p begin, \p end) into \p numberOfThreads contiguous ranges and runs \p body(\a from, \a to, \a t) for range \a t in parallel.
+/**
+ * @ingroup threads
+ *
+ * The ranges differ in size by at most one.
+ */
+template<class Body>
+void parallelFor(int begin, int end, unsigned int numberOfThreads, Body body)
+{
+	OGDF_ASSERT(numberOfThreads > 0);
+	const long long size = end - begin;
+	runThreads(numberOfThreads, [&](unsigned int t) {
+		body(begin + int(size * t / numberOfThreads), begin + int(size * (t + 1) / numberOfThreads), t);
+	});
+}
+
 }
@@ -0,0 +1,145 @@
+/** \file
+ * \brief Declaration of a memory manager that allocates from chunks
+ *        owned by a single object
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+
+namespace ogdf {
+
+//! Allocates memory from chunks owned by a single object (an arena)
+/**
+ * In contrast to PoolMemoryAllocator, an arena is not shared: it is owned
+ * by a single data structure (e.g., a Graph) and must only be used by one
+ * thread at a time. Memory is handed out by advancing a pointer within the
+ * current chunk, so consecutive allocations are placed next to each other
+ * in memory. Deallocated pieces of memory are kept in free lists of the
+ * arena and reused by later allocations of the same size.
+ *
+ * All memory is returned to the system at once by #release() (or when the
+ * arena is destroyed) in time linear in the number of chunks, not in the
+ * number of allocations. The chunks grow geometrically up to #MAX_CHUNK_SIZE.
+ */
+class OGDF_EXPORT ArenaMemoryAllocator {
+	//! Basic memory element used to realize a linked list of deallocated memory segments
+	struct MemElem {
+		MemElem *m_next;
+	};
+
+	using MemElemPtr = MemElem*;
+
+	static constexpr size_t TABLE_SIZE = 256;
+	static constexpr size_t MIN_CHUNK_SIZE = 4096;
+	static constexpr size_t MAX_CHUNK_SIZE = 1 << 20;
+
+public:
+	ArenaMemoryAllocator() { }
+
+	ArenaMemoryAllocator(const ArenaMemoryAllocator &) = delete;
+	ArenaMemoryAllocator &operator=(const ArenaMemoryAllocator &) = delete;
+
+	//! Frees all allocated memory
+	~ArenaMemoryAllocator() {
+		release();
+	}
+
+	//! Allocates memory of size \c nBytes.
+	void *allocate(size_t nBytes) {
+		nBytes = roundUp(nBytes);
+		m_bytesInUse += nBytes;
+
+		if (nBytes < TABLE_SIZE) {
+			MemElemPtr &pFreeBytes = m_freeList[nBytes];
+			if (pFreeBytes != nullptr) {
+				MemElemPtr p = pFreeBytes;
+				pFreeBytes = p->m_next;
+				return p;
+			}
+		}
+
+		if (OGDF_UNLIKELY(size_t(m_end - m_pos) < nBytes)) {
+			newChunk(nBytes);
+		}
+
+		void *result = m_pos;
+		m_pos += nBytes;
+		return result;
+	}
+
+	//! Deallocates memory at address \c p which is of size \c nBytes.
+	/**
+	 * The memory is kept by the arena for later allocations of the same size;
+	 * memory of #TABLE_SIZE or more bytes is only reclaimed by #release().
+	 */
+	void deallocate(size_t nBytes, void *p) {
+		nBytes = roundUp(nBytes);
+		m_bytesInUse -= nBytes;
+
+		if (nBytes < TABLE_SIZE) {
+			MemElemPtr &pFreeBytes = m_freeList[nBytes];
+			MemElemPtr(p)->m_next = pFreeBytes;
+			pFreeBytes = MemElemPtr(p);
+		}
+	}
+
+	//! Makes sure that the next allocations of \c nBytes in total are placed contiguously.
+	void reserve(size_t nBytes);
+
+	//! Frees all memory of the arena, invalidating everything allocated from it.
+	void release();
+
+	//! Returns the total amount of memory (in bytes) the arena allocated from the system.
+	size_t memoryAllocated() const { return m_bytesAllocated; }
+
+	//! Returns the amount of memory (in bytes) currently allocated from the arena.
+	size_t memoryInUse() const { return m_bytesInUse; }
+
+private:
+	static size_t roundUp(size_t nBytes) {
+		return (nBytes + OGDF_SIZEOF_POINTER - 1) / OGDF_SIZEOF_POINTER * OGDF_SIZEOF_POINTER;
+	}
+
+	//! Starts a new chunk that can hold at least \c nBytes.
+	void newChunk(size_t nBytes);
+
+	MemElemPtr m_freeList[TABLE_SIZE] = {}; //!< The free lists, indexed by the size.
+	MemElemPtr m_chunks = nullptr; //!< The allocated chunks, each one starts with a pointer to the next one.
+
+	char *m_pos = nullptr; //!< The first free byte of the current chunk.
+	char *m_end = nullptr; //!< The end of the current chunk.
+
+	size_t m_nextChunkSize = MIN_CHUNK_SIZE; //!< The size of the next regular chunk.
+	size_t m_bytesAllocated = 0; //!< The total size of all chunks.
+	size_t m_bytesInUse = 0; //!< The number of bytes allocated and not deallocated.
+};
+
+}
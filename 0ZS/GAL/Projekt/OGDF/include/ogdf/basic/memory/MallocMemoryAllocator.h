@@ -84,6 +84,9 @@ public:
 		}
 	}
 
+	//! Does nothing since every allocation is passed to malloc().
+	static void reserve(size_t /* nBytes */, size_t /* count */) { }
+
 	static void flushPool() { }
 	static void flushPool(uint16_t /* nBytes */) { }
 
@@ -34,6 +34,8 @@
 
 #include <ogdf/basic/System.h>
 
+#include <atomic>
+
 #ifndef OGDF_MEMORY_POOL_NTS
 # include <mutex>
 #endif
@@ -51,6 +53,13 @@ namespace ogdf {
  *
  * This allows to store memory that is requested to be deallocated in a single linked list,
  * and re-distribute it upon later allocation requests, instead of actually decallocating it.
+ *
+ * Every thread allocates from free lists of its own (#s_tp). Free memory is exchanged between
+ * threads in batches of up to one block worth of elements through the global pool (#s_pool),
+ * which holds a lock-free stack of batches for every size. Taking a batch from the pool or
+ * giving one back is a single compare-and-swap, new blocks are also obtained without locking.
+ * A block is sliced by the thread that allocated it, hence its pages are first touched by
+ * that thread and, under a first-touch policy, end up on the thread's NUMA node.
  */
 class PoolMemoryAllocator {
 	//! Basic memory element used to realize a linked list of deallocated memory segments
@@ -62,11 +71,17 @@ class PoolMemoryAllocator {
 
 	struct PoolElement;
 	struct BlockChain;
+	struct Batch;
 
 	static constexpr size_t MIN_BYTES = sizeof(MemElemPtr);
 	static constexpr size_t TABLE_SIZE = 256;
 	static constexpr size_t BLOCK_SIZE = 8192;
 
+	//! The number of batch descriptors in a chunk of descriptors (log2).
+	static constexpr int BATCH_CHUNK_BITS = 12;
+	//! The maximal number of chunks of batch descriptors.
+	static constexpr size_t BATCH_CHUNKS = 1 << 16;
+
 public:
 	PoolMemoryAllocator() { }
 	~PoolMemoryAllocator() { }
@@ -93,6 +108,14 @@ public:
 	 */
 	static OGDF_EXPORT void deallocateList(size_t nBytes, void *pHead, void *pTail);
 
+	//! Makes sure that the next \c count allocations of \c nBytes by this thread are served without refilling.
+	/**
+	 * The missing memory is taken from newly allocated blocks and put in front of the thread's
+	 * free list in the order of the blocks. Hence, elements allocated
+	 * one after another afterwards are placed contiguously in memory.
+	 */
+	static OGDF_EXPORT void reserve(size_t nBytes, size_t count);
+
 	//! Flushes all free but allocated bytes (#s_tp) to the thread-global list (#s_pool) of allocated bytes.
 	static OGDF_EXPORT void flushPool();
 
@@ -142,14 +165,50 @@ private:
 	static MemElemPtr allocateBlock();
 	static void makeSlices(MemElemPtr p, int nWords, int nSlices);
 
-	static size_t unguardedMemGlobalFreelist();
+	/**
+	 * @name Lock-free stacks of batches
+	 * A stack is represented by a tagged index of its top batch: the lower 32 bits hold the
+	 * index of the batch descriptor plus one (zero for an empty stack), the upper 32 bits a
+	 * counter incremented by every update, which prevents the ABA problem. Batch descriptors
+	 * are never freed before #cleanup(), so a descriptor can always be read safely.
+	 */
+	//! @{
+
+	//! Returns the batch descriptor with index \p index.
+	static Batch &batch(uint32_t index);
+
+	//! Pushes the batch with index \p index on \p stack.
+	static void pushBatch(std::atomic<uint64_t> &stack, uint32_t index);
+
+	//! Pops a batch from \p stack and stores its index in \p index, returns false if \p stack is empty.
+	static bool popBatch(std::atomic<uint64_t> &stack, uint32_t &index);
+
+	//! Returns the index of an unused batch descriptor.
+	static uint32_t newBatch();
+
+	//! Puts the list of \p count elements starting at \p pHead into the global pool as one batch of elements of size \p nBytes.
+	static void pushBatchToPool(uint16_t nBytes, MemElemPtr pHead, long count);
+
+	//! @}
 
 	//! Contains allocated but free memory that may be used by all threads.
 	//! Filled upon exiting a thread that allocated memory that was later freed.
 	static PoolElement s_pool[TABLE_SIZE];
 
 	//! Holds all allocated memory independently of whether it is cleared in chunks of size #BLOCK_SIZE.
-	static BlockChain *s_blocks;
+	static std::atomic<BlockChain*> s_blocks;
+
+	//! The number of blocks in #s_blocks.
+	static std::atomic<size_t> s_blockCount;
+
+	//! The chunks of batch descriptors, allocated on demand.
+	static std::atomic<Batch*> s_batchChunks[BATCH_CHUNKS];
+
+	//! The number of batch descriptors handed out so far.
+	static std::atomic<uint32_t> s_batchCount;
+
+	//! The stack of unused batch descriptors.
+	static std::atomic<uint64_t> s_freeBatches;
 
 #ifdef OGDF_DEBUG
 	//! Holds the number of globally allocated bytes for debugging.
@@ -38,6 +38,8 @@
 
 namespace ogdf {
 
+class OGDF_EXPORT CompactGraph;
+
 //! \name Methods for loops
 //! @{
 
@@ -451,6 +453,16 @@ inline void makeSimpleUndirected(Graph &G) {
 OGDF_EXPORT bool isConnected(const Graph &G);
 
 
+//! Returns true iff the graph of the snapshot \p G is connected.
+/**
+ * @ingroup ga-connectivity
+ *
+ * @param G is the input graph snapshot.
+ * @return true if \p G is connected, false otherwise.
+ */
+OGDF_EXPORT bool isConnected(const CompactGraph &G);
+
+
 //! Makes \p G connected by adding a minimum number of edges.
 /**
  * @ingroup ga-connectivity
@@ -492,6 +504,21 @@ OGDF_EXPORT int connectedComponents(const Graph &G,
 		List<node> *isolated = nullptr);
 
 
+//! Computes the connected components of the graph snapshot \p G.
+/**
+ * @ingroup ga-connectivity
+ *
+ * Assigns component numbers (0, 1, ...) to the nodes of \p G in the same way
+ * as connectedComponents(const Graph&, NodeArray<int>&, List<node>*), but
+ * works on the contiguous arrays of the snapshot.
+ *
+ * @param G         is the input graph snapshot.
+ * @param component is assigned a mapping from dense node ids to component numbers.
+ * @return the number of connected components.
+ */
+OGDF_EXPORT int connectedComponents(const CompactGraph &G, Array<int> &component);
+
+
 //! Computes the amount of connected components of \p G.
 /**
  * @ingroup ga-connectivity
@@ -906,6 +933,21 @@ OGDF_EXPORT void topologicalNumbering(const Graph &G, NodeArray<int> &num);
 OGDF_EXPORT int strongComponents(const Graph& G, NodeArray<int>& component);
 
 
+//! Computes the strongly connected components of the digraph snapshot \p G.
+/**
+ * @ingroup ga-connectivity
+ *
+ * The function implements the algorithm by Tarjan on the outgoing entries of
+ * the snapshot and numbers the components in the same order as
+ * strongComponents(const Graph&, NodeArray<int>&).
+ *
+ * @param G         is the input graph snapshot.
+ * @param component is assigned a mapping from dense node ids to component numbers (0, 1, ...).
+ * @return the number of strongly connected components.
+ */
+OGDF_EXPORT int strongComponents(const CompactGraph& G, Array<int>& component);
+
+
 //! Makes the digraph \p G bimodal.
 /**
  * @ingroup ga-digraph
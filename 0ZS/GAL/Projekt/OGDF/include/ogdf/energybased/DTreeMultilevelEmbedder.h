@@ -67,11 +67,24 @@ public:
 
 		m_numIterationsCoarsestLevel = 1000;
 		m_thresholdCoarsestLevel = 0.0;
+
+		m_numberOfThreads = 0;
 	}
 
 	//! call the multilevel embedder layout for graph, the result is stored in coords
 	void call(const Graph& graph, NodeArray<NodeCoords>& coords);
 
+	//! Sets the maximal number of threads; 0 means System::numberOfProcessors().
+	/**
+	 * The threads build the tree and evaluate the well-separated pair decomposition
+	 * on the levels with at least energybased::dtree::DTreeForce<Dim>::MinNumPointsPerThread
+	 * nodes per thread, each one accumulating its forces in its own buffer.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = numberOfThreads; }
+
+	//! Returns the maximal number of threads.
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
 private:
 	int m_maxIterationsPerLevel;
 	int m_minIterationsPerLevel;
@@ -85,6 +98,8 @@ private:
 
 	int m_levelMaxNumNodes;
 	double m_scaleFactorPerLevel;
+
+	unsigned int m_numberOfThreads;
 };
 
 class DTreeMultilevelEmbedder2D : public DTreeMultilevelEmbedder<2>, public LayoutModule
@@ -177,6 +192,7 @@ void DTreeMultilevelEmbedder<Dim>::call(const Graph& graph, NodeArray<NodeCoords
 
 		// new embedder instance for the current level
 		Embedder embedder(pCurrLevel->graph());
+		embedder.setNumberOfThreads(m_numberOfThreads);
 
 		// if this is coarsest one
 		if (pCurrLevel->isCoarsestLevel()) {
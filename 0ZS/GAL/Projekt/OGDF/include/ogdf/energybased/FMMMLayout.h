@@ -221,6 +221,10 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>nmPrecision</i><td>int<td>4
  *     <td>The precision \a p for the <i>p</i>-term multipole expansions.
+ *   </tr><tr>
+ *     <td><i>numberOfThreads</i><td>unsigned int<td>1
+ *     <td>The number of threads used by the New Multipole Method (0 means
+ *     the number of processors).
  *   </tr>
  * </table>
  *
@@ -723,6 +727,17 @@ public:
 	//! Sets the precision for the multipole expansions to \p p.
 	void nmPrecision(int p) { m_NMPrecision  = ((p >= 1 ) ? p : 1);}
 
+	//! Returns the number of threads used by the New Multipole Method.
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
+	//! Sets the number of threads used by the New Multipole Method; 0 means System::numberOfProcessors().
+	/**
+	 * With more than one thread, the reduced bucket quadtree is built from the
+	 * particles sorted in Morton order, regardless of nmTreeConstruction(), and
+	 * the expansions and forces are calculated for disjoint subtrees in parallel.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = numberOfThreads; }
+
 	//! @}
 
 private:
@@ -791,6 +806,7 @@ private:
 	FMMMOptions::SmallestCellFinding m_NMSmallCell; //!< The option for how to calculate smallest quadtratic cells.
 	int                   m_NMParticlesInLeaves; //!< The maximal number of particles in a leaf.
 	int                   m_NMPrecision; //!< The precision for multipole expansions.
+	unsigned int          m_numberOfThreads; //!< The number of threads used by NMM.
 
 	//other variables
 	double max_integer_position; //!< The maximum value for an integer position.
@@ -38,6 +38,8 @@
 #include <ogdf/graphalg/ShortestPathAlgorithms.h>
 #include <ogdf/basic/LayoutModule.h>
 
+#include <vector>
+
 namespace ogdf {
 
 template<typename T>
@@ -51,6 +53,13 @@ inline bool isinf(T value)
 //! The Pivot MDS (multi-dimensional scaling) layout algorithm.
 /**
  * @ingroup gd-energy
+ *
+ * The pivots are chosen by the max-min strategy. The distances from the pivots are
+ * kept in one contiguous matrix. For uniform edge costs and graphs of small diameter,
+ * they are computed by bit-parallel breadth-first searches from batches of 64 pivots,
+ * otherwise by one search per pivot. These searches, the double centering, the
+ * product of the matrix with its transpose and the final projection are split over
+ * setNumberOfThreads() threads for large graphs.
  */
 class OGDF_EXPORT PivotMDS : public LayoutModule {
 public:
@@ -59,6 +68,7 @@ public:
 		, m_dimensionCount(2)
 		, m_edgeCosts(100)
 		, m_hasEdgeCostsAttribute(false)
+		, m_numberOfThreads(0)
 		{ }
 
 	virtual ~PivotMDS() { }
@@ -87,7 +97,43 @@ public:
 		return m_hasEdgeCostsAttribute;
 	}
 
+	//! Sets the maximal number of threads; 0 means System::numberOfProcessors().
+	void setNumberOfThreads(unsigned int numberOfThreads) {
+		m_numberOfThreads = numberOfThreads;
+	}
+
+	//! Returns the maximal number of threads.
+	unsigned int numberOfThreads() const {
+		return m_numberOfThreads;
+	}
+
 private:
+	//! A dense matrix stored row by row in one contiguous block.
+	/**
+	 * The storage is padded with zero rows to a multiple of four rows, so that
+	 * the blocked kernels need no special handling of the last rows.
+	 */
+	struct Matrix {
+		int rows = 0; //!< The number of rows.
+		int cols = 0; //!< The number of columns.
+		std::vector<double> data; //!< The rows, one after another.
+
+		//! Reinitializes the matrix to \p r rows and \p c columns filled with 0.
+		void init(int r, int c) {
+			rows = r;
+			cols = c;
+			data.assign(size_t((r + 3) / 4 * 4) * c, 0.0);
+		}
+
+		//! Returns the row \p i.
+		double *row(int i) { return &data[size_t(i) * cols]; }
+
+		//! Returns the row \p i.
+		const double *row(int i) const { return &data[size_t(i) * cols]; }
+	};
+
+	//! Below this number of nodes, everything is done by the calling thread.
+	const static int MIN_NODES_PER_THREAD;
 
 	//! Convergence factor used for power iteration.
 	const static double EPSILON;
@@ -113,46 +159,55 @@ private:
 	//! edge costs attribute
 	bool m_hasEdgeCostsAttribute;
 
-	//! Centers the pivot matrix.
-	void centerPivotmatrix(Array<Array<double> >& pivotMatrix);
+	//! The maximal number of threads.
+	unsigned int m_numberOfThreads;
+
+	//! The number of threads used for a graph with \p n nodes.
+	unsigned int threadsFor(int n) const;
+
+	//! Centers the matrix of the squared pivot distances, \p rowMeans are the means of its rows.
+	void centerPivotmatrix(Matrix& pivotMatrix, const Array<double>& rowMeans, unsigned int numberOfThreads);
 
 	//! Computes the pivot mds layout of the given connected graph of \p GA.
 	void pivotMDSLayout(GraphAttributes& GA);
 
-	void copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom);
-
 	//! Computes the layout of a path.
 	void doPathLayout(GraphAttributes& GA, const node& v);
 
 	//! Computes the eigen value decomposition based on power iteration.
 	void eigenValueDecomposition(
-		Array<Array<double> >& K,
-		Array<Array<double> >& eVecs,
+		const Matrix& K,
+		Matrix& eVecs,
 		Array<double>& eValues);
 
-	//! Computes the pivot distance matrix based on the maxmin strategy
-	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<Array<double> >& pivDistMatrix);
+	//! Computes the matrix of the squared pivot distances based on the maxmin strategy.
+	/**
+	 * \p rowMeans is assigned the mean of every row, i.e., of the squared distances from every pivot.
+	 */
+	void getPivotDistanceMatrix(const GraphAttributes& GA, Matrix& pivDistMatrix,
+		Array<double>& rowMeans, unsigned int numberOfThreads);
 
 	//! Checks whether the given graph is a path or not.
 	node getRootedPath(const Graph& G);
 
-	//! Normalizes the vector \p x.
-	double normalize(Array<double>& x);
+	//! Normalizes the vector \p x of length \p size.
+	double normalize(double *x, int size);
 
-	//! Computes the product of two vectors \p x and \p y.
-	double prod(const Array<double>& x, const Array<double>& y);
+	//! Computes the product of two vectors \p x and \p y of length \p size.
+	double prod(const double *x, const double *y, int size);
 
 	//! Fills the given \p matrix with random doubles d 0 <= d <= 1.
-	void randomize(Array<Array<double> >& matrix);
+	void randomize(Matrix& matrix);
 
-	//! Computes the self product of \p d.
-	void selfProduct(const Array<Array<double> >&d, Array<Array<double> >& result);
+	//! Computes the self product of \p d, i.e., \p d times its transpose.
+	void selfProduct(const Matrix& d, Matrix& result, unsigned int numberOfThreads);
 
 	//! Computes the singular value decomposition of matrix \p K.
 	void singularValueDecomposition(
-		Array<Array<double> >& K,
-		Array<Array<double> >& eVecs,
-		Array<double>& eVals);
+		const Matrix& K,
+		Matrix& eVecs,
+		Array<double>& eVals,
+		unsigned int numberOfThreads);
 };
 
 }
@@ -32,7 +32,6 @@
 #pragma once
 
 #include <ogdf/energybased/spring_embedder/SpringEmbedderBase.h>
-#include <ogdf/basic/Array2D.h>
 #include <ogdf/energybased/SpringForceModel.h>
 #include <ogdf/basic/GraphAttributes.h>
 
@@ -77,6 +76,12 @@ namespace ogdf {
  *     <td>The user bounding box for scaling (used if scaling = scUserBoundingBox).
  *   </tr>
  * </table>
+ *
+ * The nodes are split evenly among up to maxThreads() threads. In every iteration,
+ * the threads rebuild the grid by a counting sort of the nodes by their cells, and
+ * each thread computes the forces on the nodes of a contiguous range of grid rows
+ * (its tile), reading the neighboring cells without locks. The phases of an iteration
+ * are separated by an EpochBarrier.
  */
 class OGDF_EXPORT SpringEmbedderGridVariant : public spring_embedder::SpringEmbedderBase
 {
@@ -98,8 +103,30 @@ private:
 
 		int m_gridX;
 		int m_gridY;
+	};
+
+	//! The grid of cells with side length Master::boxLength().
+	/**
+	 * The nodes are sorted by their cells, the cells row by row. There is a border
+	 * of empty cells around the grid, so each of the three rows of neighbors of a cell
+	 * is a contiguous range of entries. The coordinates of the entries are stored in
+	 * separate arrays in single precision for the repulsive forces.
+	 */
+	struct Grid
+	{
+		int m_highX; //!< the x-coordinates of the cells are -1, ..., m_highX
+		int m_highY; //!< the y-coordinates of the cells are -1, ..., m_highY
+
+		Array<int> m_cellStart; //!< the first entry of each cell (followed by the number of entries)
+		Array<int> m_node; //!< the node of each entry
+		Array<float> m_x; //!< the x-coordinate of the node of each entry
+		Array<float> m_y; //!< the y-coordinate of the node of each entry
+
+		//! Returns the number of cells (including the border).
+		int numberOfCells() const { return (m_highX + 2) * (m_highY + 2); }
 
-		ListIterator<int> m_lit;
+		//! Returns the index of cell (\p gridX, \p gridY).
+		int cell(int gridX, int gridY) const { return (gridY + 1) * (m_highX + 2) + gridX + 1; }
 	};
 
 	class ForceModelBase;
@@ -35,6 +35,7 @@
 #include <ogdf/basic/Array2D.h>
 #include <ogdf/basic/tuples.h>
 #include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
 
 namespace ogdf {
 
@@ -55,8 +56,9 @@ namespace ogdf {
  * First of all note that the algorithm uses all pairs shortest path
  * to compute the graph theoretic distance. This can be done either
  * with BFS (ignoring node sizes) in quadratic time or by using
- * e.g. Floyd's algorithm in cubic time with given edge lengths
- * that may reflect the node sizes.  Also m_computeMaxIt decides
+ * %Dijkstra's algorithm from every node with given edge lengths
+ * that may reflect the node sizes. Both are run in parallel and
+ * store the distances in a DistanceMatrix.  Also m_computeMaxIt decides
  * if the computation is stopped after a fixed maximum number of
  * iterations. The desirable edge length can either be set or computed
  * from the graph and the given layout.
@@ -82,6 +84,7 @@ public:
 	, m_ltolerance(0.0001)
 	, m_computeMaxIt(true)
 	, m_K(5.0)
+	, m_L(1.0)
 	, m_prevEnergy(startVal)
 	, m_prevLEnergy(startVal)
 	, m_zeroLength(-1.0)
@@ -231,28 +234,38 @@ protected:
 	dpair computeParDer(node m,
 		node u,
 		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
+		const DistanceMatrix& distances);
 
 	//! Compute partial derivative for v
 	dpair computeParDers(node v,
 		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
+		const DistanceMatrix& distances);
 
 	//! Does the necessary initialization work for the call functions
 	void initialize(GraphAttributes& GA,
 		NodeArray<dpair>& partialDer,
 		const EdgeArray<double>& eLength,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength,
+		DistanceMatrix& distances,
 		bool simpleBFS);
 
 	//! Main computation loop, nodes are moved here
 	void mainStep(GraphAttributes& GA,
 		NodeArray<dpair>& partialDer,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength);
+		const DistanceMatrix& distances);
+
+	//! Computes the strength k_mu and the original length l_mu of the spring between
+	//! the distinct nodes \p m and \p u from their graph theoretic distance d_mu
+	void spring(node m, node u, const DistanceMatrix& distances, double& strength, double& length) const
+	{
+		double d = distances(m, u);
+		if (d == std::numeric_limits<double>::max()) {
+			strength = minVal;
+			length = d;
+		} else {
+			strength = m_K / (d * d);
+			length = m_L * d;
+		}
+	}
 
 	//! Does the scaling if no edge lengths are given but node sizes
 	//! are respected
@@ -267,6 +280,7 @@ private:
 	int m_maxLocalIt; //!< Maximum number of local iterations
 	bool m_computeMaxIt; //!< If true, number of iterations is computed depending on number of nodes
 	double m_K; //! Big K constant for strength computation
+	double m_L; //!< Desirable length of an edge, the factor of the original spring lengths
 	double m_prevEnergy; //!<max energy value
 	double m_prevLEnergy; //!<local energy
 	double m_zeroLength; //!< Length of a side of the display area, used for edge length computation if > 0
@@ -281,9 +295,6 @@ private:
 	static const double desMinLength; //!< Defines minimum desired edge length. Smaller values are treated as zero
 	static const int maxVal; //!< defines infinite upper bound for iteration number
 
-	double allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance);
-	double allpairssp(const Graph& G, const EdgeArray<double>& eLengths,
-		NodeArray< NodeArray<double> >& distance, const double threshold = std::numeric_limits<double>::max());
 };
 
 #if 0
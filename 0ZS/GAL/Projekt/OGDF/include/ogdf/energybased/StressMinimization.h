@@ -38,7 +38,7 @@
 #include <ogdf/basic/LayoutModule.h>
 #include <ogdf/energybased/PivotMDS.h>
 #include <ogdf/basic/simple_graph_alg.h>
-#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
 #include <ogdf/packing/ComponentSplitterLayout.h>
 
 namespace ogdf {
@@ -46,6 +46,20 @@ namespace ogdf {
 //! Energy-based layout using stress minimization.
 /**
  * @ingroup gd-energy
+ *
+ * By default, the full stress model is minimized, which needs the distances of
+ * all pairs of nodes and thus time and memory quadratic in the number of nodes.
+ * For large graphs, the sparse stress model can be used instead (see
+ * useSparseStress()):
+ *
+ * Mark Ortmann, Mirza Klimenta, Ulrik Brandes: <i>A Sparse Stress Model</i>.
+ * Journal of Graph Algorithms and Applications 21(5), pp. 791-821, 2017.
+ *
+ * It keeps the exact terms only for the pairs of nodes within a few hops of each
+ * other; every node is attracted to a set of pivots (chosen by the max-min strategy
+ * as in PivotMDS) instead of all distant nodes, each pivot standing for the part of
+ * its region that is closer to it. The positions of all nodes are then updated at
+ * once from the previous ones, in parallel.
  */
 class OGDF_EXPORT StressMinimization: public LayoutModule {
 
@@ -59,7 +73,8 @@ public:
 			m_hasEdgeCostsAttribute(false), m_hasInitialLayout(false), m_numberOfIterations(
 					200), m_edgeCosts(100), m_avgEdgeCosts(-1), m_componentLayout(
 					false), m_terminationCriterion(TerminationCriterion::None), m_fixXCoords(false), m_fixYCoords(
-					false), m_fixZCoords(false) {
+					false), m_fixZCoords(false), m_sparse(false), m_sparseNumberOfPivots(
+					DEFAULT_NUMBER_OF_SPARSE_PIVOTS), m_sparseRadius(1), m_numberOfThreads(0) {
 	}
 
 	//! Destructor.
@@ -100,6 +115,21 @@ public:
 	//! Tells whether the edge costs are uniform or defined by some edge costs attribute.
 	inline void useEdgeCostsAttribute(bool useEdgeCostsAttribute);
 
+	//! Tells whether the sparse stress model should be used instead of the full one.
+	inline void useSparseStress(bool sparse);
+
+	//! Sets the number of pivots of the sparse stress model. If the new value is smaller or equal
+	//! 0 the default value (200) is used.
+	inline void setSparseNumberOfPivots(int numberOfPivots);
+
+	//! Sets the number of hops up to which the sparse stress model keeps the exact terms.
+	//! If the new value is smaller or equal 0 the default value (1, only adjacent nodes) is used.
+	inline void setSparseNeighborhoodRadius(int radius);
+
+	//! Sets the maximal number of threads used by the sparse stress model and the initial
+	//! PivotMDS layout; 0 means System::numberOfProcessors().
+	inline void setNumberOfThreads(unsigned int numberOfThreads);
+
 private:
 
 	//! Convergence constant.
@@ -108,6 +138,9 @@ private:
 	//! Default number of pivots used for the initial Pivot-MDS layout
 	const static int DEFAULT_NUMBER_OF_PIVOTS;
 
+	//! Default number of pivots of the sparse stress model
+	const static int DEFAULT_NUMBER_OF_SPARSE_PIVOTS;
+
 	//! Tells whether the stress minimization is based on uniform edge costs or a
 	//! edge costs attribute
 	bool m_hasEdgeCostsAttribute;
@@ -140,20 +173,23 @@ private:
 	//! Indicates whether the z coordinates will be modified or not.
 	bool m_fixZCoords;
 
-	//! Calculates the stress for the given layout
-	double calcStress(const GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! Indicates whether the sparse stress model is used.
+	bool m_sparse;
+
+	//! The number of pivots of the sparse stress model.
+	int m_sparseNumberOfPivots;
 
-	//! Runs the stress for a given Graph, shortest path and weight matrix.
-	void call(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! The number of hops up to which the sparse stress model keeps the exact terms.
+	int m_sparseRadius;
 
-	//! Calculates the weight matrix of the shortest path matrix. This is done by w_ij = s_ij^{-2}
-	void calcWeights(const Graph& G,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! The maximal number of threads used by the sparse stress model.
+	unsigned int m_numberOfThreads;
+
+	//! Calculates the stress for the given layout
+	double calcStress(const GraphAttributes& GA, const DistanceMatrix& distances);
+
+	//! Runs the stress for a given Graph and shortest path matrix.
+	void call(GraphAttributes& GA, DistanceMatrix& distances);
 
 	//! Calculates the intial layout of the graph if necessary.
 	void computeInitialLayout(GraphAttributes& GA);
@@ -172,26 +208,16 @@ private:
 			NodeArray<double>& prevXCoords, NodeArray<double>& prevYCoords,
 			const double prevStress, const double curStress);
 
-	//! Convenience method to initialize the matrices.
-	void initMatrices(const Graph& G,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
-
 	//! Minimizes the stress for each component separately given
-	//! the shortest path matrix and the weight matrix.
-	void minimizeStress(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! the shortest path matrix.
+	void minimizeStress(GraphAttributes& GA, const DistanceMatrix& distances);
 
 	//! Runs the next iteration of the stress minimization process. Note that serial update
-	//! is used.
-	void nextIteration(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! is used. The weights w_ij = d_ij^{-2} are derived from the distances on the fly.
+	void nextIteration(GraphAttributes& GA, const DistanceMatrix& distances);
 
-	//! Replaces infinite distances to the given value
-	void replaceInfinityDistances(
-			NodeArray<NodeArray<double> >& shortestPathMatrix, double newVal);
+	//! Computes the initial layout if necessary and minimizes the sparse stress.
+	void callSparse(GraphAttributes& GA);
 
 }
 ;
@@ -228,4 +254,20 @@ void StressMinimization::useEdgeCostsAttribute(bool useEdgeCostsAttribute) {
 	m_hasEdgeCostsAttribute = useEdgeCostsAttribute;
 }
 
+void StressMinimization::useSparseStress(bool sparse) {
+	m_sparse = sparse;
+}
+
+void StressMinimization::setSparseNumberOfPivots(int numberOfPivots) {
+	m_sparseNumberOfPivots = (numberOfPivots > 0) ? numberOfPivots : DEFAULT_NUMBER_OF_SPARSE_PIVOTS;
+}
+
+void StressMinimization::setSparseNeighborhoodRadius(int radius) {
+	m_sparseRadius = (radius > 0) ? radius : 1;
+}
+
+void StressMinimization::setNumberOfThreads(unsigned int numberOfThreads) {
+	m_numberOfThreads = numberOfThreads;
+}
+
 }
@@ -29,6 +29,9 @@
 #pragma once
 
 #include <algorithm>
+#include <queue>
+#include <vector>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/energybased/dtree/utils.h>
 
 namespace ogdf {
@@ -49,6 +52,7 @@ public:
 	: m_maxLevel((sizeof(IntType) << 3) + 1)
 	, m_numPoints(0)
 	, m_rootIndex(-1)
+	, m_numberOfThreads(1)
 	{
 		allocate(numPoints);
 	}
@@ -135,6 +139,9 @@ public:
 	//! Prepares both the leaf and inner node layer
 	void prepareNodeLayer();
 
+	//! Prepares the nodes of the cells starting in the sorted order at [\p from, \p to)
+	void prepareNodeLayer(int from, int to);
+
 	//! Merges curr with next node in the chain (used by linkNodes)
 	inline void mergeWithNext(int curr);
 
@@ -159,6 +166,22 @@ public:
 	//! returns the index of the root node
 	int rootIndex() const { return m_rootIndex; };
 
+	//! returns the number of threads used by build()
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
+	//! sets the number of threads used by build() (at least 1)
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = std::max(numberOfThreads, 1u); }
+
+	//! Splits the tree into at least \p minNumSubtrees disjoint subtrees (if there are enough nodes)
+	/**
+	 * The largest subtree is split repeatedly into its children. The roots of the resulting
+	 * subtrees are stored in \p subtrees, the split inner nodes above them in \p upperNodes;
+	 * every upper node precedes its children there. Hence a bottom-up pass may process the
+	 * subtrees in parallel and then the upper nodes in reverse order, a top-down pass the other
+	 * way round.
+	 */
+	void splitTree(int minNumSubtrees, std::vector<int>& subtrees, std::vector<int>& upperNodes) const;
+
 private:
 
 	//! Allocates memory for n points
@@ -173,6 +196,7 @@ private:
 	MortonEntry* m_mortonOrder = nullptr; //!< The order to be sorted
 	Node* m_nodes = nullptr; //!< Memory for all nodes
 	int m_rootIndex; //!< The index of the root node
+	unsigned int m_numberOfThreads; //!< The number of threads used by build()
 };
 
 //! allocates memory for n points
@@ -207,35 +231,75 @@ template<typename IntType, int Dim>
 void DTree<IntType, Dim>::prepareMortonOrder()
 {
 	// loop over the point order
-	for (int i=0; i<m_numPoints; i++) {
-		// set i's ref to i
-		m_mortonOrder[i].ref = i;
+	parallelFor(0, m_numPoints, m_numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			// set i's ref to i
+			m_mortonOrder[i].ref = i;
 
-		// generate the morton number by interleaving the bits
-		interleaveBits<IntType, Dim>(m_points[i].x, m_mortonOrder[i].mortonNr);
-	}
+			// generate the morton number by interleaving the bits
+			interleaveBits<IntType, Dim>(m_points[i].x, m_mortonOrder[i].mortonNr);
+		}
+	});
 }
 
 //! Sorts the points by morton number
 template<typename IntType, int Dim>
 void DTree<IntType, Dim>::sortMortonNumbers()
 {
-	// just sort them
-	std::sort(m_mortonOrder, m_mortonOrder + m_numPoints);
+	if (m_numberOfThreads == 1) {
+		// just sort them
+		std::sort(m_mortonOrder, m_mortonOrder + m_numPoints);
+		return;
+	}
+
+	// sort one block per thread
+	const unsigned int numBlocks = m_numberOfThreads;
+	std::vector<int> bounds(numBlocks + 1);
+	for (unsigned int b = 0; b <= numBlocks; b++) {
+		bounds[b] = int((long long)m_numPoints * b / numBlocks);
+	}
+
+	runThreads(numBlocks, [&](unsigned int b) {
+		std::sort(m_mortonOrder + bounds[b], m_mortonOrder + bounds[b + 1]);
+	});
+
+	// then merge neighboring blocks pairwise, doubling the block size in each round
+	for (unsigned int width = 1; width < numBlocks; width *= 2) {
+		const unsigned int numMerges = (numBlocks + 2 * width - 1) / (2 * width);
+		runThreads(numMerges, [&](unsigned int k) {
+			const unsigned int first = 2 * width * k;
+			const unsigned int middle = std::min(first + width, numBlocks);
+			const unsigned int last = std::min(first + 2 * width, numBlocks);
+			std::inplace_merge(m_mortonOrder + bounds[first], m_mortonOrder + bounds[middle], m_mortonOrder + bounds[last]);
+		});
+	}
 }
 
 
 //! Prepares both the leaf and inner node layer
 template<typename IntType, int Dim>
 void DTree<IntType, Dim>::prepareNodeLayer()
+{
+	// every thread prepares the cells starting in its range
+	parallelFor(0, m_numPoints, m_numberOfThreads, [&](int from, int to, unsigned int) {
+		prepareNodeLayer(from, to);
+	});
+}
+
+//! Prepares the nodes of the cells starting in the sorted order at [from, to)
+template<typename IntType, int Dim>
+void DTree<IntType, Dim>::prepareNodeLayer(int from, int to)
 {
 	Node* leafLayer	 = m_nodes;
 	Node* innerLayer = m_nodes + m_numPoints;
 
-#if 0
-	int last = 0;
-#endif
-	for (int i = 0; i<m_numPoints;) {
+	// skip the rest of a cell starting before from
+	int i = from;
+	while ((i > 0) && (i < to) &&
+		   (m_mortonOrder[i-1] == m_mortonOrder[i]))
+		i++;
+
+	while (i < to) {
 		Node& leaf = leafLayer[i];
 		Node& innerNode = innerLayer[i];
 		// i represents the current node on both layers
@@ -256,10 +320,6 @@ void DTree<IntType, Dim>::prepareNodeLayer()
 
 		if (j < m_numPoints) {
 			// Note: the n-th inner node is not needed because we only need n-1 inner nodes to cover n leaves
-			// if we reach the n-1-th inner node, the variable last is set for the last time
-#if 0
-			last = i;
-#endif
 			// init the node on the inner node layer
 			innerNode.child[0] = i; //< node sits above the first leaf
 			innerNode.child[1] = j; //< this leaf hasnt been created yet but we use indices so its ok
@@ -276,10 +336,6 @@ void DTree<IntType, Dim>::prepareNodeLayer()
 		// advance to the next cell
 		i = j;
 	};
-	// here we set the successor of the n-1-th inner node to zero to avoid dealing with the n-th inner node
-#if 0
-	innerLayer[last].next = 0;
-#endif
 };
 
 //! Merges curr with next node in the chain (used by linkNodes)
@@ -368,6 +424,39 @@ int DTree<IntType, Dim>::countPoints(int curr) const
 		return m_nodes[curr].numPoints;
 };
 
+template<typename IntType, int Dim>
+void DTree<IntType, Dim>::splitTree(int minNumSubtrees, std::vector<int>& subtrees, std::vector<int>& upperNodes) const
+{
+	subtrees.clear();
+	upperNodes.clear();
+
+	// the subtrees ordered by their number of points, the largest first
+	auto smaller = [&](int a, int b) { return numPoints(a) < numPoints(b); };
+	std::priority_queue<int, std::vector<int>, decltype(smaller)> queue(smaller);
+	queue.push(m_rootIndex);
+
+	while (!queue.empty() && int(queue.size() + subtrees.size()) < minNumSubtrees) {
+		const int curr = queue.top();
+		queue.pop();
+
+		if (numChilds(curr)) {
+			// replace the subtree by the ones of its children
+			upperNodes.push_back(curr);
+			for (int i = 0; i < numChilds(curr); i++) {
+				queue.push(child(curr, i));
+			}
+		} else {
+			// a leaf cannot be split any further
+			subtrees.push_back(curr);
+		}
+	}
+
+	while (!queue.empty()) {
+		subtrees.push_back(queue.top());
+		queue.pop();
+	}
+}
+
 //! Does all required steps except the allocate, deallocate, randomPoints
 template<typename IntType, int Dim>
 void DTree<IntType, Dim>::build()
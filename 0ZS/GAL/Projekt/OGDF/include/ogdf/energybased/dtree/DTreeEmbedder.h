@@ -132,6 +132,9 @@ public:
 	//! changes the position of nodes according to a given scale factor
 	void scaleNodes(double scaleFactor);
 
+	//! sets the maximal number of threads for the approximation of the repulsive forces; 0 means System::numberOfProcessors()
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_pTreeForce->setNumberOfThreads(numberOfThreads); }
+
 private:
 	//! node state
 	struct NodeInfo {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <ogdf/basic/Thread.h>
 #include <ogdf/energybased/dtree/DTreeWSPD.h>
 #include <ogdf/energybased/dtree/DTreeForceTypes.h>
 
@@ -35,16 +36,19 @@ namespace ogdf {
 namespace energybased {
 namespace dtree {
 
-template<int Dim, typename ForceFunc, bool UseForcePrime>
+template<int Dim, typename ForceFunc, bool UseForcePrime, typename ForceData>
 class DTreeWSPDCallback;
 
 template<int Dim>
 class DTreeForce
 {
 public:
-	template<int _Dim, typename ForceFunc, bool UseForcePrime>
+	template<int _Dim, typename ForceFunc, bool UseForcePrime, typename ForceData>
 	friend class DTreeWSPDCallback;
 
+	//! the minimal number of points per thread
+	static constexpr int MinNumPointsPerThread = 4096;
+
 	using WSPD = DTreeWSPD<Dim>;
 	using Tree = typename WSPD::Tree;
 
@@ -84,6 +88,17 @@ public:
 
 	//! returns a const reference to the tree
 	const Tree& tree() const;
+
+	//! returns the number of threads used by computeForces()
+	unsigned int numberOfThreads() const { return wspd().numberOfThreads(); }
+
+	//! sets the maximal number of threads used by computeForces(); 0 means System::numberOfProcessors()
+	/**
+	 * Every thread gets at least #MinNumPointsPerThread points. The forces
+	 * computed by several threads differ from the ones computed by one
+	 * thread only by rounding.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreads);
 private:
 	//! the point data
 	struct PointData {
@@ -111,6 +126,15 @@ private:
 		double force_prime;
 	};
 
+	//! the forces on a node accumulated by one thread
+	struct ThreadForceData {
+		//! the force
+		double force[Dim];
+
+		//! the first derivation of the distance based force function
+		double force_prime;
+	};
+
 	//! returns the wspd
 	WSPD& wspd();
 
@@ -121,11 +145,27 @@ private:
 	void deallocate();
 
 	//! internal function for computing the mass and center of mass of quadtree nodes
+	void bottomUpPhase();
+
+	//! the recursive function of the above
 	void bottomUpPhase(int curr);
 
+	//! computes the mass and center of mass of curr from its children or points
+	void bottomUpNode(int curr);
+
 	//! internal function for accumulating forces in the leaves
+	void topDownPhase();
+
+	//! the recursive function of the above
 	void topDownPhase(int curr);
 
+	//! pushes the force of curr down to its children or points
+	void topDownNode(int curr);
+
+	//! runs the WSPD cell cell interaction with one force buffer per thread
+	template<typename ForceFunc, bool UseForcePrime>
+	void computeWSPDInParallel(ForceFunc forceFunc);
+
 	//! reset the point forces
 	void resetPointForces();
 
@@ -143,14 +183,22 @@ private:
 
 	//! the WSPD instance
 	WSPD* m_pWSPD;
+
+	//! the force buffers of the threads except the first one, maxNumNodes() entries per thread
+	std::vector<ThreadForceData> m_threadForceData;
 };
 
-template<int Dim, typename ForceFunc, bool UseForcePrime>
+//! Adds the forces of a well-separated pair to the nodes in \p ForceData
+/**
+ * ForceData is either the node data of the tree force itself or the force
+ * buffer of a thread; both provide force and force_prime.
+ */
+template<int Dim, typename ForceFunc, bool UseForcePrime, typename ForceData>
 class DTreeWSPDCallback : public IWSPD
 {
 public:
-	DTreeWSPDCallback(DTreeForce<Dim>& treeForce, ForceFunc forceFunc)
-		: m_treeForce(treeForce), m_forceFunc(forceFunc)
+	DTreeWSPDCallback(DTreeForce<Dim>& treeForce, ForceFunc forceFunc, ForceData* forceData)
+		: m_treeForce(treeForce), m_forceFunc(forceFunc), m_forceData(forceData)
 	{
 	}
 
@@ -172,13 +220,13 @@ public:
 
 		// compute the force vector for each dim
 		for (int d = 0; d < Dim; d++) {
-			m_treeForce.m_nodeData[a].force[d] += force * delta[d] / dist * m_treeForce.m_nodeData[b].mass;
-			m_treeForce.m_nodeData[b].force[d] -= force * delta[d] / dist * m_treeForce.m_nodeData[a].mass;
+			m_forceData[a].force[d] += force * delta[d] / dist * m_treeForce.m_nodeData[b].mass;
+			m_forceData[b].force[d] -= force * delta[d] / dist * m_treeForce.m_nodeData[a].mass;
 		};
 
 		if (UseForcePrime) {
-			m_treeForce.m_nodeData[a].force_prime += force_prime * m_treeForce.m_nodeData[b].mass;
-			m_treeForce.m_nodeData[b].force_prime += force_prime * m_treeForce.m_nodeData[a].mass;
+			m_forceData[a].force_prime += force_prime * m_treeForce.m_nodeData[b].mass;
+			m_forceData[b].force_prime += force_prime * m_treeForce.m_nodeData[a].mass;
 		}
 
 
@@ -186,6 +234,7 @@ public:
 
 	DTreeForce<Dim>& m_treeForce;
 	ForceFunc m_forceFunc;
+	ForceData* m_forceData;
 };
 
 template<int Dim>
@@ -243,6 +292,12 @@ const typename DTreeForce<Dim>::Tree& DTreeForce<Dim>::tree() const
 	return wspd().tree();
 }
 
+template<int Dim>
+void DTreeForce<Dim>::setNumberOfThreads(unsigned int numberOfThreads)
+{
+	wspd().setNumberOfThreads(std::max(1u, std::min(resolveNumberOfThreads(numberOfThreads), unsigned(m_numPoints / MinNumPointsPerThread))));
+}
+
 template<int Dim>
 double DTreeForce<Dim>::position(int i , int d) const
 {
@@ -293,20 +348,120 @@ void DTreeForce<Dim>::computeForces(ForceFunc forceFunc)
 	wspd().update();
 
 	// now do the bottom up phase
-	bottomUpPhase(tree().rootIndex());
+	bottomUpPhase();
 
-	DTreeWSPDCallback<Dim, ForceFunc, UseForcePrime> wspdCallBack(*this, forceFunc);
+	if (numberOfThreads() > 1) {
+		computeWSPDInParallel<ForceFunc, UseForcePrime>(forceFunc);
+	} else {
+		DTreeWSPDCallback<Dim, ForceFunc, UseForcePrime, NodeData> wspdCallBack(*this, forceFunc, m_nodeData);
 
-	// run the WSPD cell cell interaction
-	wspd().computeWSPD(&wspdCallBack);
+		// run the WSPD cell cell interaction
+		wspd().computeWSPD(&wspdCallBack);
+	}
 
 	// finally, push down the forces
-	topDownPhase(tree().rootIndex());
+	topDownPhase();
+}
+
+template<int Dim>
+template<typename ForceFunc, bool UseForcePrime>
+void DTreeForce<Dim>::computeWSPDInParallel(ForceFunc forceFunc)
+{
+	using ThreadCallback = DTreeWSPDCallback<Dim, ForceFunc, UseForcePrime, ThreadForceData>;
+
+	const unsigned int numThreads = numberOfThreads();
+	const int numNodes = tree().maxNumNodes();
+
+	// the first thread adds its forces to the nodes directly, the others to their own buffers
+	m_threadForceData.resize(size_t(numThreads - 1) * numNodes);
+	DTreeWSPDCallback<Dim, ForceFunc, UseForcePrime, NodeData> firstCallback(*this, forceFunc, m_nodeData);
+	std::vector<ThreadCallback> threadCallbacks;
+	std::vector<IWSPD*> callbacks(1, &firstCallback);
+	threadCallbacks.reserve(numThreads - 1);
+	for (unsigned int t = 1; t < numThreads; t++) {
+		threadCallbacks.push_back(ThreadCallback(*this, forceFunc, m_threadForceData.data() + size_t(t - 1) * numNodes));
+	}
+	for (ThreadCallback& callback : threadCallbacks) {
+		callbacks.push_back(&callback);
+	}
+
+	parallelFor(0, int(m_threadForceData.size()), numThreads, [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			for (int d = 0; d < Dim; d++) {
+				m_threadForceData[i].force[d] = 0.0;
+			}
+			m_threadForceData[i].force_prime = 0.0;
+		}
+	});
+
+	// run the WSPD cell cell interaction
+	wspd().computeWSPD(callbacks.data());
+
+	// sum up the buffers
+	parallelFor(0, numNodes, numThreads, [&](int from, int to, unsigned int) {
+		for (unsigned int t = 1; t < numThreads; t++) {
+			const ThreadForceData* forceData = m_threadForceData.data() + size_t(t - 1) * numNodes;
+			for (int i = from; i < to; i++) {
+				for (int d = 0; d < Dim; d++) {
+					m_nodeData[i].force[d] += forceData[i].force[d];
+				}
+				m_nodeData[i].force_prime += forceData[i].force_prime;
+			}
+		}
+	});
+}
+
+template<int Dim>
+void DTreeForce<Dim>::bottomUpPhase()
+{
+	// the subtrees are independent of each other
+	const std::vector<int>& subtrees = wspd().subtrees();
+	const int numSubtrees = int(subtrees.size());
+	parallelFor(0, numSubtrees, std::min(numberOfThreads(), unsigned(numSubtrees)), [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			bottomUpPhase(subtrees[i]);
+		}
+	});
+
+	// the nodes above them bottom-up
+	const std::vector<int>& upperNodes = wspd().upperNodes();
+	for (auto it = upperNodes.rbegin(); it != upperNodes.rend(); ++it) {
+		bottomUpNode(*it);
+	}
+}
+
+template<int Dim>
+void DTreeForce<Dim>::topDownPhase()
+{
+	// the nodes above the subtrees top-down
+	for (int curr : wspd().upperNodes()) {
+		topDownNode(curr);
+	}
+
+	// the subtrees are independent of each other
+	const std::vector<int>& subtrees = wspd().subtrees();
+	const int numSubtrees = int(subtrees.size());
+	parallelFor(0, numSubtrees, std::min(numberOfThreads(), unsigned(numSubtrees)), [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			topDownPhase(subtrees[i]);
+		}
+	});
 }
 
 
 template<int Dim>
 void DTreeForce<Dim>::bottomUpPhase(int curr)
+{
+	// compute the size of the subtrees
+	for (int i = 0; i < tree().numChilds(curr); i++) {
+		bottomUpPhase(tree().child(curr, i));
+	}
+
+	bottomUpNode(curr);
+}
+
+template<int Dim>
+void DTreeForce<Dim>::bottomUpNode(int curr)
 {
 	// reset the force and the center of mass
 	for (int d = 0; d < Dim; d++) {
@@ -325,9 +480,6 @@ void DTreeForce<Dim>::bottomUpPhase(int curr)
 			// the child index
 			const int child = tree().child(curr, i);
 
-			// compute the size of the subtree
-			bottomUpPhase(child);
-
 			// node curr
 			for (int d = 0; d < Dim; d++) {
 				// sum up the center of mass coordinates
@@ -358,6 +510,17 @@ void DTreeForce<Dim>::bottomUpPhase(int curr)
 
 template<int Dim>
 void DTreeForce<Dim>::topDownPhase(int curr)
+{
+	topDownNode(curr);
+
+	// compute the size of the subtrees
+	for (int i = 0; i < tree().numChilds(curr); i++) {
+		topDownPhase(tree().child(curr, i));
+	}
+}
+
+template<int Dim>
+void DTreeForce<Dim>::topDownNode(int curr)
 {
 	// if this is an inner node
 	if (tree().numChilds(curr)) {
@@ -373,9 +536,6 @@ void DTreeForce<Dim>::topDownPhase(int curr)
 			}
 
 			m_nodeData[child].force_prime += m_nodeData[curr].force_prime;
-
-			// compute the size of the subtree
-			topDownPhase(child);
 		};
 	}	// else it is a leaf
 	else {
@@ -30,6 +30,8 @@
 
 #include <ogdf/basic/basic.h>
 #include <ogdf/energybased/dtree/DTree.h>
+#include <utility>
+#include <vector>
 
 namespace ogdf {
 namespace energybased {
@@ -94,6 +96,25 @@ public:
 	// temp function for
 	void computeWSPD(IWSPD* m_pIWSPD);
 
+	//! computes the WSPD with numberOfThreads() threads, thread t reports its pairs to \p pIWSPDs[t]
+	/**
+	 * Every well-separated pair is reported exactly once, but the order of the
+	 * pairs differs from the one of computeWSPD(IWSPD*).
+	 */
+	void computeWSPD(IWSPD* const* pIWSPDs);
+
+	//! returns the number of threads used by update() and computeWSPD()
+	unsigned int numberOfThreads() const { return m_pTree->numberOfThreads(); }
+
+	//! sets the number of threads used by update() and computeWSPD()
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_pTree->setNumberOfThreads(numberOfThreads); }
+
+	//! returns the roots of the subtrees processed by the threads, see DTree::splitTree()
+	const std::vector<int>& subtrees() const { return m_subtrees; }
+
+	//! returns the nodes above subtrees(), each one preceding its children
+	const std::vector<int>& upperNodes() const { return m_upperNodes; }
+
 	//! returns the parameter s of the WSPD (default is 1.0)
 	double separationFactor() const { return m_wspdSeparationFactor; };
 
@@ -118,11 +139,17 @@ protected:
 	//! the recursive function of the above
 	void updateTreeNodeGeometry(int curr);
 
+	//! computes the geometry of curr from the one of its children or points
+	void updateNodeGeometry(int curr);
+
 	//! the unary recursive function generating the binary calls
-	void wspdRecursive(int a);
+	void wspdRecursive(int a, IWSPD* pIWSPD);
 
 	//! the binary recursive function to separate the subtree a and b
-	void wspdRecursive(int a, int b);
+	void wspdRecursive(int a, int b, IWSPD* pIWSPD);
+
+	//! splits the binary call for a and b like wspdRecursive() until the calls cover at most maxNumPoints points
+	void collectPairs(int a, int b, int maxNumPoints, std::vector<std::pair<int, int>>& calls) const;
 
 	//! predicate for determining if cells are well-separated
 	bool areWellSeparated(int a, int b) const;
@@ -156,6 +183,12 @@ protected:
 
 	//! the bounding box max coord of the point set
 	double m_bboxMax[Dim];
+
+	//! the roots of the subtrees processed by the threads
+	std::vector<int> m_subtrees;
+
+	//! the nodes above the subtrees
+	std::vector<int> m_upperNodes;
 };
 
 //! constructs a new WSPD for numPoints
@@ -210,6 +243,14 @@ void DTreeWSPD<Dim>::update()
 	// rebuild the tree
 	m_pTree->build();
 
+	// split the tree for the threads, a few subtrees per thread balance the load
+	if (numberOfThreads() > 1) {
+		m_pTree->splitTree(8 * numberOfThreads(), m_subtrees, m_upperNodes);
+	} else {
+		m_subtrees.assign(1, m_pTree->rootIndex());
+		m_upperNodes.clear();
+	}
+
 	// compute center, radius and bbox for each node
 	updateTreeNodeGeometry();
 }
@@ -226,13 +267,80 @@ void DTreeWSPD<Dim>::computeWSPD(IWSPD* pIWSPD)
 	m_wspdSeparationFactorPlus2Squared_cached = s * s;
 
 	// go ahead with the decomposition
-	wspdRecursive(m_pTree->rootIndex());
+	wspdRecursive(m_pTree->rootIndex(), pIWSPD);
+}
+
+template<int Dim>
+void DTreeWSPD<Dim>::computeWSPD(IWSPD* const* pIWSPDs)
+{
+	const unsigned int numThreads = numberOfThreads();
+	if (numThreads == 1) {
+		computeWSPD(pIWSPDs[0]);
+		return;
+	}
+
+	m_pIWSPD = nullptr;
+
+	// update this cached value for the well-sep test
+	const double s = (m_wspdSeparationFactor + 2.0);
+
+	// precompute this
+	m_wspdSeparationFactorPlus2Squared_cached = s * s;
+
+	// The unary call for the root is replaced by the unary calls for the subtrees and
+	// the binary calls for the pairs of children of the upper nodes. The latter ones
+	// are split further, as a pair of large subtrees would keep one thread busy.
+	std::vector<std::pair<int, int>> calls;
+	for (int a : m_subtrees) {
+		calls.push_back(std::make_pair(a, -1));
+	}
+
+	const int maxNumPoints = std::max(m_numPoints / int(8 * numThreads), 1);
+	for (int curr : m_upperNodes) {
+		for (int i = 0; i < m_pTree->numChilds(curr); i++) {
+			for (int j = i+1; j < m_pTree->numChilds(curr); j++) {
+				collectPairs(m_pTree->child(curr, i), m_pTree->child(curr, j), maxNumPoints, calls);
+			}
+		}
+	}
+
+	// the calls are dealt out in a fixed order, so the result does not depend on the timing
+	const int numCalls = int(calls.size());
+	runThreads(numThreads, [&](unsigned int t) {
+		for (int k = int(t); k < numCalls; k += int(numThreads)) {
+			if (calls[k].second < 0) {
+				wspdRecursive(calls[k].first, pIWSPDs[t]);
+			} else {
+				wspdRecursive(calls[k].first, calls[k].second, pIWSPDs[t]);
+			}
+		}
+	});
+}
+
+template<int Dim>
+void DTreeWSPD<Dim>::collectPairs(int a, int b, int maxNumPoints, std::vector<std::pair<int, int>>& calls) const
+{
+	if (tree().numPoints(a) + tree().numPoints(b) <= maxNumPoints || areWellSeparated(a, b)) {
+		calls.push_back(std::make_pair(a, b));
+	} else {
+		// split the bigger one as wspdRecursive does
+		int small_node = a;
+		int large_node = b;
+
+		if (node(small_node).radius_sq > node(large_node).radius_sq) {
+			std::swap(small_node, large_node);
+		}
+
+		for (int i = 0; i < tree().numChilds(large_node); ++i) {
+			collectPairs(small_node, tree().child(large_node, i), maxNumPoints, calls);
+		}
+	}
 }
 
 
 // the unary recursive function generating the binary calls
 template<int Dim>
-void DTreeWSPD<Dim>::wspdRecursive(int curr)
+void DTreeWSPD<Dim>::wspdRecursive(int curr, IWSPD* pIWSPD)
 {
 	// iterate over all ordered pairs of children
 	for (int i = 0; i < m_pTree->numChilds(curr); i++) {
@@ -245,21 +353,21 @@ void DTreeWSPD<Dim>::wspdRecursive(int curr)
 			const int second_child = m_pTree->child(curr, j);
 
 			// call for each ordered pair the binary function
-			wspdRecursive(first_child, second_child);
+			wspdRecursive(first_child, second_child, pIWSPD);
 		}
 
 		// now do all this for every child
-		wspdRecursive(first_child);
+		wspdRecursive(first_child, pIWSPD);
 	}
 }
 
 template<int Dim>
-void DTreeWSPD<Dim>::wspdRecursive(int a, int b)
+void DTreeWSPD<Dim>::wspdRecursive(int a, int b, IWSPD* pIWSPD)
 {
 	if (areWellSeparated(a, b)) {
 		// far enough away => approx
-		if (m_pIWSPD)
-			m_pIWSPD->onWellSeparatedPair(a, b);
+		if (pIWSPD)
+			pIWSPD->onWellSeparatedPair(a, b);
 	} else {
 		// two cells are too close
 		int small_node = a;
@@ -273,7 +381,7 @@ void DTreeWSPD<Dim>::wspdRecursive(int a, int b)
 		// split the bigger one
 		for (int i = 0; i < tree().numChilds(large_node); ++i) {
 			// recurse on the child
-			wspdRecursive(small_node, tree().child(large_node, i));
+			wspdRecursive(small_node, tree().child(large_node, i), pIWSPD);
 		}
 	}
 }
@@ -356,16 +464,30 @@ void DTreeWSPD<Dim>::updateBoundingBox()
 	if (!m_numPoints)
 		return;
 
+	// every thread computes the bounding box of its range
+	const unsigned int numThreads = numberOfThreads();
+	std::vector<PointData> bboxMin(numThreads, point(0));
+	std::vector<PointData> bboxMax(numThreads, point(0));
+
+	// no magic here
+	parallelFor(1, m_numPoints, numThreads, [&](int from, int to, unsigned int t) {
+		for (int i = from; i < to; i++) {
+			for (int d = 0; d < Dim; d++) {
+				bboxMin[t].x[d] = std::min(bboxMin[t].x[d], point(i).x[d]);
+				bboxMax[t].x[d] = std::max(bboxMax[t].x[d], point(i).x[d]);
+			}
+		}
+	});
+
 	// initial values
 	for (int d = 0; d < Dim; d++) {
 		m_bboxMin[d] = m_bboxMax[d] = point(0).x[d];
 	}
 
-	// no magic here
-	for (int i = 1; i < m_numPoints; i++) {
+	for (unsigned int t = 0; t < numThreads; t++) {
 		for (int d = 0; d < Dim; d++) {
-			m_bboxMin[d] = std::min(m_bboxMin[d], point(i).x[d]);
-			m_bboxMax[d] = std::max(m_bboxMax[d], point(i).x[d]);
+			m_bboxMin[d] = std::min(m_bboxMin[d], bboxMin[t].x[d]);
+			m_bboxMax[d] = std::max(m_bboxMax[d], bboxMax[t].x[d]);
 		}
 	}
 }
@@ -389,32 +511,56 @@ void DTreeWSPD<Dim>::updateTreeGridPoints()
 
 	double scale = factor / quad_size;
 	// iterate over all points
-	for (int i = 0; i < m_numPoints; i++) {
-		for (int d = 0; d < Dim; d++) {
-			// put it in the bounding square
+	parallelFor(0, m_numPoints, numberOfThreads(), [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			for (int d = 0; d < Dim; d++) {
+				// put it in the bounding square
 #if 0
-			double nx = ((point(i).x[d] - m_bboxMin[d] + 0.01) / quad_size + 0.02);
+				double nx = ((point(i).x[d] - m_bboxMin[d] + 0.01) / quad_size + 0.02);
 #endif
-			double nx = ((point(i).x[d] - m_bboxMin[d]) * scale);
+				double nx = ((point(i).x[d] - m_bboxMin[d]) * scale);
 
-			// dirty put on grid here
-			unsigned int ix = static_cast<unsigned int>(nx); //nx * (double)(unsigned int)(0x1fffffff);
+				// dirty put on grid here
+				unsigned int ix = static_cast<unsigned int>(nx); //nx * (double)(unsigned int)(0x1fffffff);
 
-			// set the point coord
-			m_pTree->setPoint(i, d, ix);
+				// set the point coord
+				m_pTree->setPoint(i, d, ix);
+			}
 		}
-	}
+	});
 }
 
 template<int Dim>
 void DTreeWSPD<Dim>::updateTreeNodeGeometry()
 {
-	updateTreeNodeGeometry(m_pTree->rootIndex());
+	// the subtrees are independent of each other
+	const int numSubtrees = int(m_subtrees.size());
+	parallelFor(0, numSubtrees, std::min(numberOfThreads(), unsigned(numSubtrees)), [&](int from, int to, unsigned int) {
+		for (int i = from; i < to; i++) {
+			updateTreeNodeGeometry(m_subtrees[i]);
+		}
+	});
+
+	// the nodes above them bottom-up
+	for (auto it = m_upperNodes.rbegin(); it != m_upperNodes.rend(); ++it) {
+		updateNodeGeometry(*it);
+	}
 }
 
 // updates the geometry of the quadtree nodes
 template<int Dim>
 void DTreeWSPD<Dim>::updateTreeNodeGeometry(int curr)
+{
+	// compute the size of the subtrees
+	for (int i = 0; i < m_pTree->numChilds(curr); i++) {
+		updateTreeNodeGeometry(m_pTree->child(curr, i));
+	}
+
+	updateNodeGeometry(curr);
+}
+
+template<int Dim>
+void DTreeWSPD<Dim>::updateNodeGeometry(int curr)
 {
 	// if this is an inner node
 	if (m_pTree->numChilds(curr)) {
@@ -425,9 +571,6 @@ void DTreeWSPD<Dim>::updateTreeNodeGeometry(int curr)
 			// the child index
 			const int child = m_pTree->child(curr, i);
 
-			// compute the size of the subtree
-			updateTreeNodeGeometry(child);
-
 			// lazy set the first
 			if (!i) {
 				for (int d = 0; d < Dim; d++) {
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace ogdf {
@@ -90,7 +91,7 @@ mortonComparerLess(const unsigned int a[Dim], const unsigned int b[Dim]) {
 }
 
 template<typename IntType, int Dim>
-inline typename std::enable_if<Dim != 1 && Dim != 2, void>::type
+inline typename std::enable_if<Dim != 1 && Dim != 2 && Dim != 3, void>::type
 interleaveBits(const IntType coords[Dim], IntType mnr[Dim]) {
 	// number of bits of the grid coord type
 	const int BitLength = sizeof(IntType) << 3;
@@ -163,6 +164,38 @@ interleaveBits(const unsigned int coords[Dim], unsigned int mnr[Dim]) {
 	mnr[1] = x_hi[0] | (x_hi[1] << 1);
 }
 
+//! spreads the lower 21 bits of x such that there are two zero bits between each two of them
+inline uint64_t spreadBitsBy3(uint64_t x)
+{
+	x &= 0x1fffff;
+	x = (x | (x << 32)) & 0x1f00000000ffffULL;
+	x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+	x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+	x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+	x = (x | (x << 2)) & 0x1249249249249249ULL;
+	return x;
+}
+
+// special tuned version for unsigned int and dim = 3
+template<typename IntType, int Dim>
+inline typename std::enable_if<Dim == 3, void>::type
+interleaveBits(const unsigned int coords[Dim], unsigned int mnr[Dim]) {
+	// the lower 21 bits of each coord give the lower 63 bits of the morton number
+	const uint64_t lo = spreadBitsBy3(coords[0])
+	                 | (spreadBitsBy3(coords[1]) << 1)
+	                 | (spreadBitsBy3(coords[2]) << 2);
+
+	// the remaining 11 bits of each coord give the upper 33 bits
+	const uint64_t hi = spreadBitsBy3(coords[0] >> 21)
+	                 | (spreadBitsBy3(coords[1] >> 21) << 1)
+	                 | (spreadBitsBy3(coords[2] >> 21) << 2);
+
+	// split the 96 bits into the three blocks
+	mnr[0] = static_cast<unsigned int>(lo);
+	mnr[1] = static_cast<unsigned int>(lo >> 32) | static_cast<unsigned int>(hi << 31);
+	mnr[2] = static_cast<unsigned int>(hi >> 1);
+}
+
 
 template<typename IntType>
 inline int mostSignificantBit(IntType x)
@@ -167,7 +167,7 @@ inline void eval_direct(float* x1, float* y1, float* s1, float* fx1, float* fy1,
 }
 
 
-#ifndef OGDF_FME_KERNEL_USE_SSE_DIRECT
+#if !defined(OGDF_FME_KERNEL_USE_SSE_DIRECT) && !defined(OGDF_FME_KERNEL_USE_AVX)
 //! kernel function to evaluate forces between n points with coords x, y directly. result is stored in fx, fy
 inline void eval_direct_fast(float* x, float* y, float* s, float* fx, float* fy, size_t n)
 {
@@ -184,11 +184,35 @@ inline void eval_direct_fast(float* x1, float* y1, float* s1, float* fx1, float*
 
 #else
 //! kernel function to evaluate forces between n points with coords x, y directly. result is stored in fx, fy
+/**
+ * With OGDF_FME_KERNEL_USE_AVX, the AVX-512 or AVX2 variant is chosen at runtime
+ * depending on System::cpuSupports().
+ */
 void eval_direct_fast(float* x, float* y, float* s, float* fx, float* fy, size_t n);
 //! kernel function to evaluate forces between two sets of points with coords x1, y1 (x2, y2) directly. result is stored in fx1, fy1 (fx2, fy2
 void eval_direct_fast(
 	float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
 	float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2);
+
+#ifndef OGDF_FME_KERNEL_USE_SSE_DIRECT
+//! the AVX2 variant of eval_direct(), which requires System::cpuSupports() AVX2 and FMA
+OGDF_FME_TARGET_AVX2
+void eval_direct_avx2(float* x, float* y, float* s, float* fx, float* fy, size_t n);
+//! the AVX2 variant of eval_direct() for two sets of points, which requires System::cpuSupports() AVX2 and FMA
+OGDF_FME_TARGET_AVX2
+void eval_direct_avx2(
+	float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
+	float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2);
+
+//! the AVX-512 variant of eval_direct(), which requires System::cpuSupports() AVX512F
+OGDF_FME_TARGET_AVX512
+void eval_direct_avx512(float* x, float* y, float* s, float* fx, float* fy, size_t n);
+//! the AVX-512 variant of eval_direct() for two sets of points, which requires System::cpuSupports() AVX512F
+OGDF_FME_TARGET_AVX512
+void eval_direct_avx512(
+	float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
+	float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2);
+#endif
 #endif
 
 //! kernel function to evalute a local expansion at point x,y result is added to fx, fy
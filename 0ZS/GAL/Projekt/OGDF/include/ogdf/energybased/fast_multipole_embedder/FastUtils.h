@@ -53,6 +53,13 @@ namespace fast_multipole_embedder {
 // use SSE for direct interaction (this is slower than the normal direct computation)
 //#define OGDF_FME_KERNEL_USE_SSE_DIRECT
 
+// use AVX2 / AVX-512 for direct interaction and expansions if System::cpuSupports() them at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define OGDF_FME_KERNEL_USE_AVX
+#define OGDF_FME_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define OGDF_FME_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
 inline void OGDF_FME_Print_Config()
 {
 #ifdef OGDF_FME_KERNEL_USE_SSE
@@ -64,6 +71,9 @@ inline void OGDF_FME_Print_Config()
 #ifdef OGDF_FME_KERNEL_USE_SSE_DIRECT
 	std::cout << "OGDF_FME_KERNEL_USE_SSE_DIRECT" << std::endl;
 #endif
+#ifdef OGDF_FME_KERNEL_USE_AVX
+	std::cout << "OGDF_FME_KERNEL_USE_AVX" << std::endl;
+#endif
 }
 
 using MortonNR = uint64_t;
@@ -74,6 +74,12 @@ public:
 
 	//! the quadtree
 	const LinearQuadtree& tree() { return m_tree; }
+
+	//! returns whether P2M, M2L and L2P use the AVX2 kernels
+	bool usesAVX2() const { return m_useAVX2; }
+
+	//! sets whether P2M, M2L and L2P use the AVX2 kernels; they are only used if the CPU supports them
+	void useAVX2(bool enable);
 private:
 
 	//! allocates the space for the coeffs
@@ -99,6 +105,10 @@ public:
 	uint32_t m_numCoeff;
 
 	BinCoeff<double> binCoef;
+
+private:
+	//! whether P2M, M2L and L2P use the AVX2 kernels
+	bool m_useAVX2;
 };
 
 }
@@ -34,6 +34,7 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/fmmm/FMMMOptions.h>
 #include <ogdf/energybased/fmmm/new_multipole_method/QuadTreeNM.h>
@@ -56,13 +57,19 @@ public:
 		NodeArray<DPoint>& F_rep);
 
 	//! Make all initialisations that are needed for New Multipole Method (NMM)
+	/**
+	 * With \p number_of_threads other than 1 (0 means the number of processors),
+	 * the reduced quadtree is built in Morton order instead of by
+	 * \p tree_construction_way and the forces are calculated in parallel.
+	 */
 	void make_initialisations (const Graph &G,
 		double boxlength,
 		DPoint down_left_corner,
 		int particles_in_leaves,
 		int precision,
 		FMMMOptions::ReducedTreeConstruction tree_construction_way,
-		FMMMOptions::SmallestCellFinding find_small_cell);
+		FMMMOptions::SmallestCellFinding find_small_cell,
+		unsigned int number_of_threads = 1);
 
 	//! Dynamically allocated memory is freed here.
 	void deallocate_memory();
@@ -84,6 +91,7 @@ private:
 	FMMMOptions::SmallestCellFinding _find_small_cell;
 	int _particles_in_leaves;//!< max. number of particles for leaves of the quadtree
 	int _precision;  //!< precision for p-term multipole expansion
+	unsigned int _number_of_threads; //!< number of threads (1 for the sequential NMM)
 
 	double boxlength;//!< length of drawing box
 	DPoint down_left_corner;//!< down left corner of drawing box
@@ -107,6 +115,11 @@ private:
 	void  calculate_repulsive_forces_by_NMM(const Graph &G, NodeArray
 		<NodeAttributes>& A, NodeArray<DPoint>& F_rep);
 
+	//! Use NMM with _number_of_threads threads for force calculation.
+	void calculate_repulsive_forces_by_parallel_NMM(const Graph &G,
+		NodeArray<NodeAttributes>& A,
+		NodeArray<DPoint>& F_rep);
+
 	//! Use the exact method for force calculation (used for small Graphs (|V| <=
 	//! MIN_NODE_NUMBER) for speed reasons).
 	void  calculate_repulsive_forces_by_exact_method(const Graph &G,
@@ -307,6 +320,51 @@ private:
 	//! are placed at a point nothing is done.
 	bool find_smallest_quad(NodeArray<NodeAttributes>& A, QuadTreeNM& T);
 
+	//! @}
+	//! \name Functions needed for Morton order tree construction
+	//! @{
+
+	//! A subtree of the reduced quadtree whose construction has been deferred.
+	struct MortonSubtree {
+		QuadTreeNodeNM* root_ptr; //!< the root of the subtree
+		int first; //!< the first particle of the subtree
+		int last; //!< the last particle of the subtree
+		int father_level; //!< the Sm_level of the father of *root_ptr
+	};
+
+	//! The reduced quadtree is build up from the particles sorted by their Morton
+	//! codes (the lists LE, ME, the centers, D1, D2 and M are not calculated here);
+	//! subtrees with at most grain particles are constructed in parallel.
+	void build_up_red_quad_tree_in_morton_order(const Graph& G,
+		NodeArray<NodeAttributes>& A,
+		QuadTreeNM& T,
+		int grain);
+
+	//! *act_ptr is made the root of the reduced subtree that contains the particles
+	//! particle[first],...,particle[last] with the sorted Morton codes
+	//! code[first],...,code[last]; father_level is the Sm_level of the father of
+	//! *act_ptr (-1 for the root of T). If deferred is not nullptr, the construction of
+	//! the subtrees of the children with at most grain particles is deferred to it.
+	void construct_morton_subtree(QuadTreeNodeNM* act_ptr,
+		const Array<uint64_t>& code,
+		const Array<node>& particle,
+		int first,
+		int last,
+		int father_level,
+		int grain,
+		ArrayBuffer<MortonSubtree>* deferred);
+
+	//! The lists ME and LE and the centers are initialized for all nodes of the subtree
+	//! rooted at *act_ptr in preorder. The roots of the maximal subtrees with at most
+	//! grain particles (or a single leaf) are appended to subtree_roots, all other
+	//! nodes to top_nodes and the leaves to quad_tree_leaves.
+	void init_expansions_and_collect_subtrees(QuadTreeNodeNM* act_ptr,
+		int grain,
+		bool in_subtree,
+		ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+		ArrayBuffer<QuadTreeNodeNM*>& subtree_roots,
+		ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves);
+
 	//! @}
 
 	//! Finds the small cell of the actual Node of T iteratively,and updates
@@ -345,6 +403,12 @@ private:
 		QuadTreeNM& T,
 		List<QuadTreeNodeNM*>& quad_tree_leaves);
 
+	//! The multipole expansion List ME for the subtree rooted at *act_ptr is
+	//! recursively calculated, but not added to the expansion of its father;
+	//! precondition: the Lists ME, LE and the centers have been initialized.
+	void form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A,
+		QuadTreeNodeNM* act_ptr);
+
 	//! The Lists ME and LE are both initialized to zero entries for *act_ptr.
 	void init_expansion_Lists(QuadTreeNodeNM* act_ptr);
 
@@ -365,6 +429,11 @@ private:
 	void calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes>&A,
 		QuadTreeNodeNM* act_node_ptr);
 
+	//! The lists D1, D2, M and LE of *act_node_ptr are calculated; precondition: they
+	//! have been calculated for all ancestors of *act_node_ptr.
+	void calculate_local_expansion_and_WSPRLS_of_node(NodeArray<NodeAttributes>&A,
+		QuadTreeNodeNM* act_node_ptr);
+
 	//! If the small cell of ptr_1 and ptr_2 are well separated true is returned (else
 	//! false).
 	bool well_separated(QuadTreeNodeNM* ptr_1, QuadTreeNodeNM* ptr_2);
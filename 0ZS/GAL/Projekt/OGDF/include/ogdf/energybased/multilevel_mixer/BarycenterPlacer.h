@@ -50,6 +50,14 @@ public:
 	void placeOneLevel(MultilevelGraph &MLG) override;
 	void placeOneNode(MultilevelGraph &MLG);
 	void weightedPositionPriority(bool on);
+
+private:
+	//! Undoes all merges of the current level and places the reinserted nodes in parallel.
+	/**
+	 * A reinserted node is placed at the barycenter of its neighbors that have not
+	 * been reinserted on this level, or at the node it was merged into if there are none.
+	 */
+	void placeOneLevelInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads);
 };
 
 }
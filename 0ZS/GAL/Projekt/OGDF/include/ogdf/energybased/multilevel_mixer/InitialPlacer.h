@@ -32,6 +32,7 @@
 #pragma once
 
 #include <ogdf/basic/Graph.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/energybased/multilevel_mixer/MultilevelGraph.h>
 
 namespace ogdf {
@@ -44,9 +45,15 @@ class OGDF_EXPORT InitialPlacer
 {
 protected:
 	bool m_randomOffset;
+	unsigned int m_numberOfThreads; //!< the number of threads used for placing a level
+
+	//! Returns the number of threads to use, resolving 0 to the number of processors.
+	unsigned int threadsToUse() const {
+		return resolveNumberOfThreads(m_numberOfThreads);
+	}
 
 public:
-	InitialPlacer():m_randomOffset(true) { }
+	InitialPlacer():m_randomOffset(true),m_numberOfThreads(1) { }
 	virtual ~InitialPlacer() { }
 
 	virtual void placeOneLevel(MultilevelGraph &MLG) = 0;
@@ -55,6 +62,23 @@ public:
 	{
 		m_randomOffset = on;
 	}
+
+	//! Sets the number of threads; 0 means System::numberOfProcessors().
+	/**
+	 * With more than one thread, the placers that support it (BarycenterPlacer and
+	 * SolarPlacer) first undo all merges of a level and then compute the positions
+	 * of the reinserted nodes in parallel. The default is 1.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreads)
+	{
+		m_numberOfThreads = numberOfThreads;
+	}
+
+	//! Returns the number of threads.
+	unsigned int numberOfThreads() const
+	{
+		return m_numberOfThreads;
+	}
 };
 
 }
@@ -38,6 +38,17 @@ namespace ogdf {
 //! The matching merger for multilevel layout.
 /**
  * @ingroup gd-multi
+ *
+ * With more than one thread (see setNumberOfThreads()), the matching is computed
+ * by handshaking: in each round, every unmatched node points to one of its
+ * unmatched neighbors, and mutually pointing nodes are matched. The neighbor is
+ * chosen by the following criteria, in this order:
+ *  -# the lowest total mass of both nodes, only with selectByNodeMass();
+ *  -# the lowest sum of the degrees of both nodes;
+ *  -# the highest pseudo-random priority of the connecting edge.
+ *
+ * All criteria are the same at both end nodes of an edge. The result is a maximal
+ * matching that does not depend on the number of threads.
  */
 class OGDF_EXPORT MatchingMerger : public MultilevelBuilder
 {
@@ -47,6 +58,12 @@ private:
 
 	bool buildOneLevel(MultilevelGraph &MLG) override;
 
+	//! Computes a matching of \p MLG by parallel handshaking, returns the pairs of matched nodes.
+	std::vector<std::pair<node, node>> matchInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads);
+
+	//! Merges the matched nodes \p u and \p v, the one of lower degree into the other one.
+	void mergeMatchedNodes(MultilevelGraph &MLG, int level, node u, node v);
+
 public:
 	MatchingMerger();
 	void selectByNodeMass(bool on);
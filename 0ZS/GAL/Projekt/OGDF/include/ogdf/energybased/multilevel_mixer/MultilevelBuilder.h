@@ -32,6 +32,7 @@
 #pragma once
 
 #include <ogdf/basic/Graph.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/energybased/multilevel_mixer/MultilevelGraph.h>
 
 namespace ogdf {
@@ -60,10 +61,24 @@ protected:
 	//  all edges that are moved to the other node in this merge.
 	int m_adjustEdgeLengths;
 	int m_numLevels; //!< stores number of levels for statistics purposes
+	unsigned int m_numberOfThreads; //!< the number of threads used for building a level
+
+	//! Returns the number of threads to use, resolving 0 to the number of processors.
+	unsigned int threadsToUse() const {
+		return resolveNumberOfThreads(m_numberOfThreads);
+	}
+
+	//! Returns a pseudo-random priority of the element with index \p index, which is fixed for a \p seed.
+	static uint64_t randomPriority(int index, uint64_t seed) {
+		uint64_t x = seed + 0x9e3779b97f4a7c15ULL * (uint64_t(index) + 1);
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
 
 public:
 	virtual ~MultilevelBuilder() { }
-	MultilevelBuilder():m_adjustEdgeLengths(0),m_numLevels(1) { }
+	MultilevelBuilder():m_adjustEdgeLengths(0),m_numLevels(1),m_numberOfThreads(1) { }
 
 	virtual void buildAllLevels(MultilevelGraph &MLG)
 	{
@@ -79,6 +94,18 @@ public:
 
 	void setEdgeLengthAdjustment(int factor) { m_adjustEdgeLengths = factor; }
 	int getNumLevels() {return m_numLevels;}
+
+	//! Sets the number of threads; 0 means System::numberOfProcessors().
+	/**
+	 * With more than one thread, the mergers that support it (MatchingMerger and
+	 * SolarMerger) select the nodes to merge by parallel rounds on a CompactGraph
+	 * of the current level instead of the sequential random selection. The merges
+	 * themselves are applied sequentially. The default is 1.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = numberOfThreads; }
+
+	//! Returns the number of threads.
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
 };
 
 }
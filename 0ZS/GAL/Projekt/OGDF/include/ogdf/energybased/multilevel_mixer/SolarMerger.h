@@ -39,6 +39,12 @@ namespace ogdf {
 //! The solar merger for multilevel layout.
 /**
  * @ingroup gd-multi
+ *
+ * With more than one thread (see setNumberOfThreads()), the suns are selected by
+ * Luby-style rounds: an eligible node becomes a sun if its pseudo-random priority
+ * is minimal among the eligible nodes within distance 2. Unless the sun selection
+ * is simple, nodes of small system mass are preferred. The selection does not
+ * depend on the number of threads.
  */
 class OGDF_EXPORT SolarMerger : public MultilevelBuilder
 {
@@ -69,6 +75,7 @@ class OGDF_EXPORT SolarMerger : public MultilevelBuilder
 	bool collapseSolarSystem(MultilevelGraph &MLG, node sun, int level);
 	bool buildOneLevel(MultilevelGraph &MLG) override;
 	std::vector<node> selectSuns(MultilevelGraph &MLG);
+	std::vector<node> selectSunsInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads);
 
 public:
 	explicit SolarMerger(bool simple = false, bool massAsNodeRadius = false);
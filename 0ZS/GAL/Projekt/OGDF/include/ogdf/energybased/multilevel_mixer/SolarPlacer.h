@@ -46,6 +46,9 @@ public:
 
 private:
 	void placeOneNode(MultilevelGraph &MLG);
+
+	//! Undoes all merges of the current level and places the reinserted nodes in parallel.
+	void placeOneLevelInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads);
 };
 
 }
@@ -56,7 +56,7 @@ protected:
 	ForceModelBase *m_forceModel;
 	ForceModelBase *m_forceModelImprove;
 
-	Barrier        *m_barrier;
+	EpochBarrier   *m_barrier;
 
 	double m_idealEdgeLength;
 
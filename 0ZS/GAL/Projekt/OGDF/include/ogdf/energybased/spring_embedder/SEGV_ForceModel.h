@@ -39,9 +39,9 @@ namespace ogdf {
 class SpringEmbedderGridVariant::ForceModelBase : public spring_embedder::CommonForceModelBase<NodeInfo>
 {
 public:
-	ForceModelBase(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
+	ForceModelBase(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
 	  : spring_embedder::CommonForceModelBase<NodeInfo>(vInfo, adjLists, idealEdgeLength)
-	  , m_gridCell(gridCell)
+	  , m_grid(grid)
 	{
 	}
 
@@ -50,7 +50,11 @@ public:
 	virtual DPoint computeDisplacement(int j, double boxLength) const = 0;
 
 protected:
-	const Array2D<ListPure<int>> &m_gridCell;
+	const Grid &m_grid;
+
+	//! Returns the sum of the repulsive forces iel^2 / d^NormExponent of the nodes in neighboring cells on node j.
+	template<int NormExponent>
+	DPoint computeRepulsiveForce(int j, double boxLength) const;
 
 	DPoint computeRepulsiveForce(int j, double boxLength, int idealExponent, int normExponent = 1) const;
 	DPoint computeMixedForcesDisplacement(int j, int boxLength, std::function<DPoint(double, const DPoint &)> attractiveChange, std::function<double()> attractiveFinal) const;
@@ -60,8 +64,8 @@ protected:
 class SpringEmbedderGridVariant::ForceModelFR : public ForceModelBase
 {
 public:
-	ForceModelFR(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelFR(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
@@ -69,8 +73,8 @@ public:
 class SpringEmbedderGridVariant::ForceModelFRModAttr : public ForceModelBase
 {
 public:
-	ForceModelFRModAttr(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelFRModAttr(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
@@ -78,8 +82,8 @@ public:
 class SpringEmbedderGridVariant::ForceModelFRModRep : public ForceModelBase
 {
 public:
-	ForceModelFRModRep(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelFRModRep(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
@@ -88,8 +92,8 @@ public:
 class SpringEmbedderGridVariant::ForceModelEades : public ForceModelBase
 {
 public:
-	ForceModelEades(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelEades(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
@@ -98,8 +102,8 @@ public:
 class SpringEmbedderGridVariant::ForceModelHachul : public ForceModelBase
 {
 public:
-	ForceModelHachul(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelHachul(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
@@ -108,8 +112,8 @@ public:
 class SpringEmbedderGridVariant::ForceModelGronemann : public ForceModelBase
 {
 public:
-	ForceModelGronemann(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Array2D<ListPure<int>> &gridCell, double idealEdgeLength)
-		: ForceModelBase(vInfo, adjLists, gridCell, idealEdgeLength) { }
+	ForceModelGronemann(const Array<NodeInfo> &vInfo, const Array<int> &adjLists, const Grid &grid, double idealEdgeLength)
+		: ForceModelBase(vInfo, adjLists, grid, idealEdgeLength) { }
 
 	DPoint computeDisplacement(int j, double boxLength) const override;
 };
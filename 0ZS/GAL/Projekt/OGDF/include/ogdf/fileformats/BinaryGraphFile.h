@@ -0,0 +1,183 @@
+/** \file
+ * \brief Declaration of ogdf::BinaryGraphFile, a read-only view of a graph
+ *        stored in OGDF's binary graph format.
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/cluster/ClusterGraph.h>
+#include <ogdf/fileformats/MappedFile.h>
+
+#include <memory>
+
+namespace ogdf {
+
+//! Read-only view of a graph stored in OGDF's binary graph format (.ogb).
+/**
+ * @ingroup graphs
+ *
+ * The format is made for loading large graphs fast: all data is stored in
+ * columns of native binary values that can be used in place, so a file
+ * can be mapped into memory and accessed without parsing it.
+ *
+ * A file consists of a header (the magic bytes \c OGDFGRPH, a byte order
+ * mark, the format version and the number of sections) followed by a
+ * sequence of sections. Every section starts with its type and its size in
+ * bytes; its contents are padded to a multiple of 8 bytes, so all columns
+ * are aligned. Readers skip sections of unknown types, and a file only holds
+ * the sections that have been written.
+ *
+ * The nodes are numbered 0, ..., \a n - 1 and the edges are stored in
+ * compressed sparse row (CSR) order: the edges leaving node \a v are
+ * offsets()[\a v], ..., offsets()[\a v + 1] - 1 and targets() holds their
+ * targets. Node columns have \a n entries, edge columns \a m entries in this
+ * edge order. Labels are stored as string tables (the offsets of the
+ * strings followed by their characters).
+ *
+ * Reading a file into a Graph creates the nodes in the order of their
+ * numbers and the edges in CSR order, using the bulk construction of Graph.
+ * The order of the adjacency entries around a node (an embedding) is not
+ * stored.
+ *
+ * \sa GraphIO::readBinary(), GraphIO::writeBinary()
+ */
+class OGDF_EXPORT BinaryGraphFile {
+public:
+	//! The format version written by write().
+	static constexpr uint32_t VERSION = 1;
+
+	//! The types of sections.
+	enum class Section : uint32_t {
+		Topology = 1, //!< The numbers of nodes and edges, offsets() and targets().
+		Attributes = 2, //!< The GraphAttributes flags of the columns and whether the graph is directed.
+		NodeX = 16, //!< The x-coordinates of the nodes (double).
+		NodeY = 17, //!< The y-coordinates of the nodes (double).
+		NodeZ = 18, //!< The z-coordinates of the nodes (double).
+		NodeWidth = 19, //!< The widths of the nodes (double).
+		NodeHeight = 20, //!< The heights of the nodes (double).
+		NodeShape = 21, //!< The shapes of the nodes (int32_t).
+		NodeWeight = 22, //!< The weights of the nodes (int32_t).
+		NodeLabel = 23, //!< The labels of the nodes (string table).
+		EdgeIntWeight = 32, //!< The integer weights of the edges (int32_t).
+		EdgeDoubleWeight = 33, //!< The weights of the edges (double).
+		EdgeLabel = 34, //!< The labels of the edges (string table).
+		Clusters = 48 //!< The parents of the clusters (the root cluster is 0) and the cluster of every node.
+	};
+
+	//! Creates an empty view.
+	BinaryGraphFile() { }
+
+	//! Opens the file \p filename; see good() for whether this succeeded.
+	explicit BinaryGraphFile(const string &filename) {
+		open(filename);
+	}
+
+	//! Maps the file \p filename into memory and checks its header and sections.
+	bool open(const string &filename);
+
+	//! Uses the \p size bytes at \p data (aligned to 8 bytes) as the contents, without copying them.
+	/**
+	 * The memory has to stay valid as long as the view is used.
+	 */
+	bool open(const char *data, size_t size);
+
+	//! Returns whether the view holds a valid graph.
+	bool good() const { return m_topology != nullptr; }
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return m_n; }
+
+	//! Returns the number of edges.
+	int numberOfEdges() const { return m_m; }
+
+	//! Returns the offsets of the edges of all nodes (numberOfNodes() + 1 values).
+	const int32_t *offsets() const { return m_offsets; }
+
+	//! Returns the targets of all edges in CSR order.
+	const int32_t *targets() const { return m_targets; }
+
+	//! Returns whether the file holds section \p s.
+	bool has(Section s) const { return section(s) != nullptr; }
+
+	//! Returns the GraphAttributes flags of the stored attributes (0 if there are none).
+	long attributes() const { return m_attributes; }
+
+	//! Returns whether the graph is stored as directed.
+	bool directed() const { return m_directed; }
+
+	//! Returns the column of section \p s, or nullptr if the file does not hold it.
+	template<class T>
+	const T *column(Section s) const {
+		return reinterpret_cast<const T *>(section(s));
+	}
+
+	//! Returns string \p i of the string table in section \p s.
+	string label(Section s, int i) const;
+
+	//! Reads the graph into \p G.
+	bool read(Graph &G) const;
+
+	//! Reads the graph into \p G and the attributes enabled in \p A (that are stored) into \p A.
+	bool read(GraphAttributes &A, Graph &G) const;
+
+	//! Reads the graph into \p G and its clustering into \p C.
+	bool read(ClusterGraph &C, Graph &G) const;
+
+	//! Writes \p G and, if given, the attributes of \p A and the clustering \p C to \p os.
+	/**
+	 * \pre \p A and \p C belong to \p G.
+	 */
+	static bool write(const Graph &G, const GraphAttributes *A, const ClusterGraph *C, std::ostream &os);
+
+private:
+	//! Returns the contents of section \p s, or nullptr if the file does not hold it.
+	const char *section(Section s) const;
+
+	//! Creates the nodes and edges, \p nodes is assigned the nodes in the order of their numbers.
+	bool readGraph(Graph &G, Array<node> &nodes) const;
+
+	std::unique_ptr<MappedFile> m_file; //!< The mapped file, if the view is opened from a file.
+
+	const char *m_sections[64] = {}; //!< The contents of the sections by their types.
+	size_t m_sectionSize[64] = {}; //!< The sizes of the sections by their types.
+
+	const char *m_topology = nullptr; //!< The contents of the topology section.
+	int m_n = 0; //!< The number of nodes.
+	int m_m = 0; //!< The number of edges.
+	const int32_t *m_offsets = nullptr; //!< The offsets of the edges of the nodes.
+	const int32_t *m_targets = nullptr; //!< The targets of the edges.
+
+	long m_attributes = 0; //!< The stored GraphAttributes flags.
+	bool m_directed = true; //!< Whether the graph is directed.
+};
+
+}
@@ -269,6 +269,10 @@ public:
 	 * 	<td>.rudy
 	 * 	<td>X<td> <td>X<td>X<td> <td> <td> <td>
 	 * <tr>
+	 * 	<td>OGDF binary graph
+	 * 	<td>.ogb
+	 * 	<td>X<td>X<td>X<td>X<td>X<td>X<td> <td>
+	 * <tr>
 	 * 	<td>SVG
 	 * 	<td>.svg
 	 * 	<td> <td> <td> <td>X<td> <td> <td> <td>X
@@ -281,13 +285,17 @@ public:
 	 * 	<td>.mtx
 	 * 	<td>X<td> <td> <td> <td> <td> <td> <td>
 	 * <tr>
+	 * 	<td>Edge list (SNAP, DIMACS)
+	 * 	<td>.edges, .el, .col
+	 * 	<td>X<td> <td> <td> <td> <td> <td> <td>
+	 * <tr>
 	 * 	<td>TsplibXml
 	 * 	<td>.xml
 	 * 	<td>X<td> <td>X<td> <td> <td> <td> <td>
 	 * </table>
 	 *
-	 * Note: The Rome and MatrixMarket formats won't be guessed from an input stream, as they would also wrongly interpret files of other formats.
-	 * Use a filename matching "*.rome" or "grafo*.*" / "*.mtx" or pass the readRome / readMatrixMarket reader explicitly if you are reading Rome / MatrixMarket files.
+	 * Note: The Rome, MatrixMarket and edge list formats won't be guessed from an input stream, as they would also wrongly interpret files of other formats.
+	 * Use a filename matching "*.rome" or "grafo*.*" / "*.mtx" / "*.edges" or pass the readRome / readMatrixMarket / readEdgeList reader explicitly if you are reading Rome / MatrixMarket / edge list files.
 	 * Similarly, (Di)Graph6/Sparse6 files will only be guessed from an input stream if they include the header specified as optional by the file format.
 	 * If you have a (Di)Graph6/Sparse6 file without a header, pass it using its filename (with the appropriate extension) or pass the right reader function explicitly.
 	 *
@@ -855,6 +863,130 @@ public:
 	 */
 	static OGDF_EXPORT bool readMatrixMarket(Graph& G, std::istream &inStream);
 
+	//! Reads graph \p G in Matrix Market exchange format from the file \p filename.
+	/**
+	 * The file is mapped into memory and split into chunks that are parsed by
+	 * \p numberOfThreads threads in parallel. The resulting graph is the same as the
+	 * one read by readMatrixMarket(Graph&, std::istream&).
+	 *
+	 * @param G               is assigned the read graph.
+	 * @param filename        is the name of the file to read from.
+	 * @param numberOfThreads is the maximal number of threads used; 0 means System::numberOfProcessors().
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readMatrixMarketFile(Graph &G, const string &filename, unsigned int numberOfThreads = 0);
+
+	//@}
+
+#pragma mark Edge lists
+	/**
+	 * @name Edge lists
+	 *
+	 * Plain lists of edges, one edge per line, as used by SNAP ("u v", comments starting with \c #)
+	 * and by the DIMACS graph formats (an optional problem line "p edge n m" and edges "e u v",
+	 * comments starting with \c c). Lines starting with \c % are comments as well; further
+	 * columns of an edge line (e.g., weights) are ignored.
+	 *
+	 * Node ids are non-negative integers. If a problem line is given, the graph has its \a n
+	 * nodes with ids 1, ..., \a n in this order; otherwise, the nodes are created in the order
+	 * in which their ids appear first. Every line yields an edge, including self-loops and
+	 * parallel edges.
+	 */
+	//@{
+
+	//! Reads graph \p G as an edge list from stream \p is.
+	/**
+	 * @param G  is assigned the read graph.
+	 * @param is is the input stream to read from.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readEdgeList(Graph &G, std::istream &is);
+
+	//! Reads graph \p G as an edge list from the file \p filename.
+	/**
+	 * The file is mapped into memory and split into chunks that are parsed by
+	 * \p numberOfThreads threads in parallel.
+	 *
+	 * @param G               is assigned the read graph.
+	 * @param filename        is the name of the file to read from.
+	 * @param numberOfThreads is the maximal number of threads used; 0 means System::numberOfProcessors().
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readEdgeListFile(Graph &G, const string &filename, unsigned int numberOfThreads = 0);
+
+	//@}
+
+#pragma mark Binary
+	/**
+	 * @name Binary graph format
+	 *
+	 * OGDF's own binary format for loading large graphs fast; see BinaryGraphFile
+	 * for its layout. The nodes are read in the order in which they have been written
+	 * and the edges in the order of their sources. Of the graph attributes, the node
+	 * graphics (without colors), z-coordinates, node weights and labels, edge weights
+	 * and labels and the directedness are stored.
+	 *
+	 * The stream readers read the whole stream into memory; use BinaryGraphFile directly
+	 * to access a file mapped into memory without copying it.
+	 */
+	//@{
+
+	//! Reads graph \p G in binary format from input stream \p is.
+	/**
+	 * @param G  is assigned the read graph.
+	 * @param is is the input stream to read from.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(Graph &G, std::istream &is);
+
+	//! Reads graph \p G with attributes \p A in binary format from input stream \p is.
+	/**
+	 * Only the attributes enabled in \p A are read.
+	 *
+	 * \pre \p G is the graph associated with attributes \p A.
+	 *
+	 * @param A  is assigned the graph's attributes.
+	 * @param G  is assigned the read graph.
+	 * @param is is the input stream to read from.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(GraphAttributes &A, Graph &G, std::istream &is);
+
+	//! Reads graph \p G with clustering \p C in binary format from input stream \p is.
+	/**
+	 * \pre \p G is the graph associated with clustering \p C.
+	 *
+	 * @param C  is assigned the graph's clustering.
+	 * @param G  is assigned the read graph.
+	 * @param is is the input stream to read from.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(ClusterGraph &C, Graph &G, std::istream &is);
+
+	//! Writes graph \p G in binary format to output stream \p os.
+	/**
+	 * @param G  is the graph to be written.
+	 * @param os is the output stream to which the graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const Graph &G, std::ostream &os);
+
+	//! Writes graph with attributes \p A in binary format to output stream \p os.
+	/**
+	 * @param A  specifies the graph and its attributes to be written.
+	 * @param os is the output stream to which the graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const GraphAttributes &A, std::ostream &os);
+
+	//! Writes graph with clustering \p C in binary format to output stream \p os.
+	/**
+	 * @param C  specifies the graph and its clustering to be written.
+	 * @param os is the output stream to which the graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const ClusterGraph &C, std::ostream &os);
+
 	//@}
 
 #pragma mark Rudy
@@ -0,0 +1,83 @@
+/** \file
+ * \brief Declaration of ogdf::MappedFile, read-only access to the
+ *        contents of a file mapped into memory.
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+
+namespace ogdf {
+
+//! Read-only contents of a file, mapped into memory if possible.
+/**
+ * On Unix systems, the file is mapped with mmap(), so its contents are only
+ * read from the disk when they are accessed and no copy is made. Where this
+ * is not possible (other systems, or files that are not regular files such
+ * as pipes), the whole file is read into a buffer.
+ *
+ * The contents are valid as long as the object exists.
+ */
+class OGDF_EXPORT MappedFile {
+public:
+	//! Maps the file \p filename; see good() for whether this succeeded.
+	explicit MappedFile(const string &filename);
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	//! Unmaps the file.
+	~MappedFile();
+
+	//! Returns whether the file could be read.
+	bool good() const { return m_good; }
+
+	//! Returns whether the file is mapped (instead of being copied into a buffer).
+	bool mapped() const { return m_mapped; }
+
+	//! Returns the first byte of the contents.
+	const char *begin() const { return m_data; }
+
+	//! Returns the position after the last byte of the contents.
+	const char *end() const { return m_data + m_size; }
+
+	//! Returns the size of the file in bytes.
+	size_t size() const { return m_size; }
+
+private:
+	const char *m_data = nullptr; //!< The contents.
+	size_t m_size = 0; //!< The size of the contents.
+	bool m_good = false; //!< Whether the file could be read.
+	bool m_mapped = false; //!< Whether #m_data is mapped.
+	string m_buffer; //!< The contents of a file that is not mapped.
+};
+
+}
@@ -0,0 +1,174 @@
+/** \file
+ * \brief Declaration of ogdf::DistanceMatrix, a flat all-pairs shortest path matrix
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/CompactGraph.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ogdf {
+
+//! All-pairs shortest path distances of a graph, stored in one contiguous row-major matrix.
+/**
+ * @ingroup ga-sp
+ *
+ * The distances are computed on a CompactGraph snapshot of the graph by running one
+ * breadth-first search (computeHops()) or one run of %Dijkstra's algorithm (compute())
+ * from every node; the sources are distributed among several threads. Row \a v of the
+ * matrix holds the distances from the node with dense id \a v (see CompactGraph) to all
+ * nodes, so a whole row is contiguous in memory.
+ *
+ * Unweighted distances are stored as hop counts of 16 bits if the graph has less than
+ * 65535 nodes, which takes a quarter of the memory of a matrix of doubles; the hop counts
+ * are multiplied by the uniform edge cost when they are read. Weighted distances are stored
+ * as floats or doubles.
+ *
+ * The edges are treated as undirected. Pairs of nodes that are not connected have the
+ * distance unreachableDistance(), which is infinity unless it is changed.
+ */
+class OGDF_EXPORT DistanceMatrix {
+public:
+	//! The representation of the distances in memory.
+	enum class Storage {
+		Hops16, //!< Hop counts of 16 bits (for unweighted graphs with less than 65535 nodes).
+		Float, //!< Single precision distances.
+		Double //!< Double precision distances.
+	};
+
+	//! Creates an empty matrix.
+	DistanceMatrix() { }
+
+	//! Computes the distances in \p G with uniform edge costs \p edgeCosts using breadth-first search.
+	/**
+	 * The distances are stored as Storage::Hops16 if possible and as Storage::Float otherwise.
+	 *
+	 * @param G               is the graph.
+	 * @param edgeCosts       is the cost of every edge.
+	 * @param numberOfThreads is the maximal number of threads used; 0 means System::numberOfProcessors().
+	 */
+	void computeHops(const Graph &G, double edgeCosts = 1.0, unsigned int numberOfThreads = 0);
+
+	//! Computes the distances in \p G with edge costs \p edgeCosts using %Dijkstra's algorithm.
+	/**
+	 * \pre All edge costs are non-negative.
+	 *
+	 * @param G               is the graph.
+	 * @param edgeCosts       are the costs of the edges.
+	 * @param storage         is either Storage::Float or Storage::Double.
+	 * @param numberOfThreads is the maximal number of threads used; 0 means System::numberOfProcessors().
+	 */
+	void compute(const Graph &G, const EdgeArray<double> &edgeCosts,
+		Storage storage = Storage::Double, unsigned int numberOfThreads = 0);
+
+	//! Returns the snapshot of the graph the dense node ids refer to.
+	const CompactGraph &graph() const { return m_graph; }
+
+	//! Returns the number of nodes (rows and columns).
+	int numberOfNodes() const { return m_n; }
+
+	//! Returns the representation of the distances.
+	Storage storage() const { return m_storage; }
+
+	//! Returns the number of bytes taken by the matrix.
+	size_t memoryUsage() const {
+		return m_hops.size() * sizeof(uint16_t) + m_float.size() * sizeof(float) + m_double.size() * sizeof(double);
+	}
+
+	//! Returns the distance from the node with dense id \p v to the node with dense id \p w.
+	double operator()(int v, int w) const {
+		OGDF_ASSERT(0 <= v);
+		OGDF_ASSERT(v < m_n);
+		OGDF_ASSERT(0 <= w);
+		OGDF_ASSERT(w < m_n);
+
+		const size_t i = size_t(v) * m_n + w;
+		switch (m_storage) {
+		case Storage::Hops16:
+			return m_hops[i] == UNREACHABLE_HOPS ? m_unreachable : m_hops[i] * m_unit;
+		case Storage::Float:
+			return std::isinf(m_float[i]) ? m_unreachable : m_float[i] * m_unit;
+		default:
+			return std::isinf(m_double[i]) ? m_unreachable : m_double[i];
+		}
+	}
+
+	//! Returns the distance from node \p v to node \p w.
+	double operator()(node v, node w) const {
+		return (*this)(m_graph.id(v), m_graph.id(w));
+	}
+
+	//! Returns whether there is a path between the nodes with dense ids \p v and \p w.
+	bool reachable(int v, int w) const {
+		const size_t i = size_t(v) * m_n + w;
+		switch (m_storage) {
+		case Storage::Hops16:
+			return m_hops[i] != UNREACHABLE_HOPS;
+		case Storage::Float:
+			return !std::isinf(m_float[i]);
+		default:
+			return !std::isinf(m_double[i]);
+		}
+	}
+
+	//! Returns the largest distance between two connected nodes.
+	double maxDistance() const { return m_maxDistance; }
+
+	//! Returns the distance returned for pairs of nodes that are not connected.
+	double unreachableDistance() const { return m_unreachable; }
+
+	//! Sets the distance returned for pairs of nodes that are not connected to \p distance.
+	void setUnreachableDistance(double distance) { m_unreachable = distance; }
+
+private:
+	//! The hop count of nodes that are not reachable.
+	static constexpr uint16_t UNREACHABLE_HOPS = std::numeric_limits<uint16_t>::max();
+
+	//! Takes a snapshot of \p G and allocates the matrix in representation \p storage.
+	void init(const Graph &G, Storage storage);
+
+	CompactGraph m_graph; //!< The snapshot of the graph.
+	int m_n = 0; //!< The number of nodes.
+	Storage m_storage = Storage::Double; //!< The representation of the distances.
+
+	std::vector<uint16_t> m_hops; //!< The matrix for Storage::Hops16.
+	std::vector<float> m_float; //!< The matrix for Storage::Float.
+	std::vector<double> m_double; //!< The matrix for Storage::Double.
+
+	double m_unit = 1.0; //!< The factor of the stored values (the edge costs of hop counts).
+	double m_maxDistance = 0.0; //!< The largest finite distance.
+	double m_unreachable = std::numeric_limits<double>::infinity(); //!< The distance of unconnected pairs.
+};
+
+}
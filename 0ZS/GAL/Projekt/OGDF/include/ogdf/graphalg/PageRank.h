@@ -1,5 +1,6 @@
 /** \file
- * \brief Declaration of basic page rank.
+ * \brief Declaration of basic page rank and of the parallel
+ *        PageRank engine on graph snapshots.
  *
  * \author Martin Gronemann
  *
@@ -33,9 +34,12 @@
 
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/EdgeArray.h>
+#include <ogdf/basic/Array.h>
 
 namespace ogdf {
 
+class OGDF_EXPORT CompactGraph;
+
 //! Basic page rank calculation.
 /**
  * @ingroup graph-algs
@@ -54,6 +58,18 @@ public:
 		const EdgeArray<double>& edgeWeight,
 		NodeArray<double>& pageRankResult);
 
+	//! main algorithm call on a graph snapshot
+	/**
+	 * Computes the same ranks as call(const Graph&, const EdgeArray<double>&, NodeArray<double>&),
+	 * but gathers the contributions of the neighbours of each node from the contiguous arrays
+	 * of the snapshot instead of scattering them along the edge list.
+	 * \p edgeWeight is indexed by dense edge ids and \p pageRankResult by dense node ids.
+	 */
+	void call(
+		const CompactGraph& graph,
+		const Array<double>& edgeWeight,
+		Array<double>& pageRankResult);
+
 	//! sets the default options.
 	void initDefaultOptions()
 	{
@@ -89,6 +105,7 @@ public:
 	/*! returns the threshold/epsilon. After each iteration the result is compared to
 	 * to the old one and in case all changes are smaller than threshold the algorithm
 	 * stops. Note that the default value is 0.0 resulting in maxNumIterations usually.
+	 * PageRank stops by the L1 norm of the change instead.
 	 */
 	double threshold() const
 	{
@@ -113,4 +130,146 @@ private:
 	double m_threshold;
 };
 
+//! PageRank computed on a CSR snapshot of a graph.
+/**
+ * @ingroup graph-algs
+ *
+ * The rank of a node is its probability in the stationary distribution of a random
+ * surfer. With probability dampingFactor(), the surfer follows an edge leaving its node,
+ * chosen with probability proportional to the edge weights (by default all weights are
+ * 1). Otherwise, or if there is no such edge, it jumps to a node of the teleport
+ * distribution: a uniformly chosen node for call(), the seed node for callPersonalized().
+ * The ranks of all nodes sum up to 1. Edges are followed from their source to their
+ * target only, unless setDirected(false) is set.
+ *
+ * Every node pulls the ranks from its predecessors, reading the contiguous arrays of
+ * a CompactGraph, and the nodes are split over up to numberOfThreads() threads by
+ * their numbers of adjacency entries. The iteration stops as soon as the L1 norm of the
+ * change of the ranks in an iteration (the residual) drops below tolerance(), or after
+ * maxNumIterations() iterations. numberOfIterations() and residual() report the
+ * iterations of the last call.
+ *
+ * See Method for the available iteration schemes. callPersonalized() computes the
+ * personalized ranks of many seeds at once, interleaving up to eight rank vectors so
+ * that every adjacency entry is read once for all of them. Since personalized ranks
+ * are linear in the teleport distribution, the ranks for a set of seeds are the mean
+ * of the ranks of its members.
+ */
+class OGDF_EXPORT PageRank
+{
+public:
+	//! The iteration scheme.
+	enum class Method {
+		//! The power (Jacobi) iteration: all nodes are updated from the ranks of the previous iteration.
+		PowerIteration,
+		//! Gauss-Seidel iteration: the nodes are updated in place, so later nodes use the new ranks of
+		//! earlier ones (with several threads, only those of the same thread). Usually needs fewer
+		//! iterations than the power iteration.
+		GaussSeidel,
+		//! The ranks are accumulated from residuals, and only nodes with a residual above
+		//! tolerance() / (2n) push it on to their successors. Once few nodes are active, an
+		//! iteration only touches their neighbourhoods.
+		DeltaPush
+	};
+
+	PageRank()
+		: m_dampingFactor(0.85)
+		, m_tolerance(1e-9)
+		, m_maxNumIterations(1000)
+		, m_method(Method::PowerIteration)
+		, m_directed(true)
+		, m_numberOfThreads(0)
+		, m_numberOfIterations(0)
+		, m_residual(0)
+	{ }
+
+	//! Computes the ranks of the nodes of \p G.
+	/**
+	 * @param G is the graph.
+	 * @param rank is assigned the rank of every node.
+	 * @param weight are the weights of the edges (non-negative), or nullptr for unit weights.
+	 */
+	void call(const Graph& G, NodeArray<double>& rank, const EdgeArray<double>* weight = nullptr);
+
+	//! Computes the ranks of the nodes of the snapshot \p C.
+	/**
+	 * \p rank is indexed by dense node ids and \p weight (if not nullptr) by dense edge ids.
+	 */
+	void call(const CompactGraph& C, Array<double>& rank, const Array<double>* weight = nullptr);
+
+	//! Computes the personalized ranks of the nodes of \p G for every node of \p seeds.
+	/**
+	 * \p ranks[i] is assigned the ranks for teleporting to \p seeds[i] only. numberOfIterations()
+	 * and residual() report the maximum over all seeds.
+	 */
+	void callPersonalized(const Graph& G, const Array<node>& seeds, Array<NodeArray<double>>& ranks,
+		const EdgeArray<double>* weight = nullptr);
+
+	//! Computes the personalized ranks of the nodes of the snapshot \p C for every node of \p seeds.
+	/**
+	 * \p seeds are dense node ids, the arrays of \p ranks are indexed by dense node ids and
+	 * \p weight (if not nullptr) by dense edge ids. The personalized ranks are always computed
+	 * by the power iteration.
+	 */
+	void callPersonalized(const CompactGraph& C, const Array<int>& seeds, Array<Array<double>>& ranks,
+		const Array<double>* weight = nullptr);
+
+	//! Returns the damping factor, the probability of following an edge (default is 0.85).
+	double dampingFactor() const { return m_dampingFactor; }
+
+	//! Sets the damping factor to \p dampingFactor, which must be in [0, 1).
+	void setDampingFactor(double dampingFactor) {
+		OGDF_ASSERT(dampingFactor >= 0);
+		OGDF_ASSERT(dampingFactor < 1);
+		m_dampingFactor = dampingFactor;
+	}
+
+	//! Returns the bound on the L1 norm of the change of an iteration at which the iteration stops (default is 1e-9).
+	double tolerance() const { return m_tolerance; }
+
+	//! Sets the tolerance to \p tolerance.
+	void setTolerance(double tolerance) { m_tolerance = tolerance; }
+
+	//! Returns the maximum number of iterations (default is 1000).
+	int maxNumIterations() const { return m_maxNumIterations; }
+
+	//! Sets the maximum number of iterations to \p maxNumIterations.
+	void setMaxNumIterations(int maxNumIterations) { m_maxNumIterations = maxNumIterations; }
+
+	//! Returns the iteration scheme (default is Method::PowerIteration).
+	Method method() const { return m_method; }
+
+	//! Sets the iteration scheme to \p method.
+	void setMethod(Method method) { m_method = method; }
+
+	//! Returns whether edges are followed from their source to their target only (default is true).
+	bool directed() const { return m_directed; }
+
+	//! Sets whether edges are followed from their source to their target only.
+	void setDirected(bool directed) { m_directed = directed; }
+
+	//! Returns the maximal number of threads; 0 (the default) means System::numberOfProcessors().
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
+	//! Sets the maximal number of threads to \p numberOfThreads.
+	void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = numberOfThreads; }
+
+	//! Returns the number of iterations of the last call.
+	int numberOfIterations() const { return m_numberOfIterations; }
+
+	//! Returns the residual (the L1 norm of the change of the last iteration) of the last call.
+	double residual() const { return m_residual; }
+
+private:
+	double m_dampingFactor; //!< The damping factor.
+	double m_tolerance; //!< The bound on the residual.
+	int m_maxNumIterations; //!< The maximum number of iterations.
+	Method m_method; //!< The iteration scheme.
+	bool m_directed; //!< Whether edges are only followed from their source to their target.
+	unsigned int m_numberOfThreads; //!< The maximal number of threads.
+
+	int m_numberOfIterations; //!< The number of iterations of the last call.
+	double m_residual; //!< The residual of the last call.
+};
+
 }
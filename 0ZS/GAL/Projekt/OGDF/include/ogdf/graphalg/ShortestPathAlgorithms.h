@@ -36,8 +36,11 @@
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/Array.h>
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/graphalg/Dijkstra.h>
 
+#include <queue>
+
 
 namespace ogdf {
 
@@ -84,6 +87,41 @@ void bfs_SPSS(node s, const Graph& G, NodeArray<TCost> & distanceArray, TCost ed
 }
 
 
+//! Computes single-source shortest paths from \p s in the graph snapshot \p G using breadth-first search (BFS).
+/**
+ * @ingroup ga-sp
+ *
+ * \p s is a dense node id of \p G. The cost of each edge are \p edgeCosts and the result is stored
+ * in \p distanceArray, indexed by dense node ids. Nodes that are not reachable from \p s get the
+ * distance std::numeric_limits<TCost>::max().
+ */
+template<typename TCost>
+void bfs_SPSS(int s, const CompactGraph& G, Array<TCost> & distanceArray, TCost edgeCosts) {
+	const int n = G.numberOfNodes();
+	distanceArray.init(0, n - 1, std::numeric_limits<TCost>::max());
+
+	// the queue is the prefix of an array as every node is added at most once
+	Array<int> bfs(n);
+	int head = 0, tail = 0;
+	Array<bool> mark(0, n - 1, false);
+	bfs[tail++] = s;
+	mark[s] = true;
+	distanceArray[s] = TCost(0);
+	while (head < tail) {
+		int w = bfs[head++];
+		TCost d = distanceArray[w] + edgeCosts;
+		for (int i = G.offset(w); i < G.offset(w + 1); ++i) {
+			int v = G.target(i);
+			if (!mark[v]) {
+				mark[v] = true;
+				bfs[tail++] = v;
+				distanceArray[v] = d;
+			}
+		}
+	}
+}
+
+
 //! Computes all-pairs shortest paths in \p GA using %Dijkstra's algorithm.
 /**
  * @ingroup ga-sp
@@ -145,6 +183,60 @@ void dijkstra_SPSS(
 }
 
 
+//! Computes single-source shortest paths from \p s in the graph snapshot \p G using %Dijkstra's algorithm.
+/**
+ * @ingroup ga-sp
+ *
+ * \p s is a dense node id of \p G. The cost of an edge are given by \p edgeCosts, indexed by dense
+ * edge ids (see CompactGraph::gatherEdges()), and the result is stored in \p distance, indexed by
+ * dense node ids. Nodes that are not reachable from \p s get the distance
+ * std::numeric_limits<TCost>::max().
+ *
+ * The priority queue is a binary heap with lazy deletion, so no handles into the heap are needed.
+ *
+ * @param directed True iff only the outgoing edges should be followed.
+ */
+template<typename TCost>
+void dijkstra_SPSS(
+	int s,
+	const CompactGraph& G,
+	Array<TCost>& distance,
+	const Array<TCost>& edgeCosts,
+	bool directed = false)
+{
+	using Entry = std::pair<TCost, int>;
+
+	const int n = G.numberOfNodes();
+	distance.init(0, n - 1, std::numeric_limits<TCost>::max());
+	Array<bool> settled(0, n - 1, false);
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	distance[s] = TCost(0);
+	queue.push(Entry(TCost(0), s));
+
+	while (!queue.empty()) {
+		int v = queue.top().second;
+		queue.pop();
+		if (settled[v]) {
+			continue;
+		}
+		settled[v] = true;
+
+		const int end = directed ? G.outEnd(v) : G.offset(v + 1);
+		for (int i = G.offset(v); i < end; ++i) {
+			int w = G.target(i);
+			TCost d = distance[v] + edgeCosts[G.edgeOf(i)];
+			OGDF_ASSERT(edgeCosts[G.edgeOf(i)] >= 0);
+
+			if (d < distance[w]) {
+				distance[w] = d;
+				queue.push(Entry(d, w));
+			}
+		}
+	}
+}
+
+
 //! Computes all-pairs shortest paths in graph \p G using Floyd-Warshall's algorithm.
 /**
  * @ingroup ga-sp
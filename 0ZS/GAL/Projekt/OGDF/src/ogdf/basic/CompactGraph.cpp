@@ -0,0 +1,109 @@
+/** \file
+ * \brief Implementation of ogdf::CompactGraph
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/CompactGraph.h>
+
+namespace ogdf {
+
+void CompactGraph::init(const Graph &G)
+{
+	m_graph = &G;
+
+	const int n = G.numberOfNodes();
+	const int m = G.numberOfEdges();
+
+	m_nodes.init(n);
+	m_edges.init(m);
+	m_nodeId.init(0, G.maxNodeIndex(), -1);
+	m_edgeId.init(0, G.maxEdgeIndex(), -1);
+
+	m_offset.init(n + 1);
+	m_outEnd.init(n);
+	m_entryTarget.init(2 * m);
+	m_entryEdge.init(2 * m);
+	m_entryTwin.init(2 * m);
+	m_edgeEntry.init(m);
+
+	int i = 0;
+	for (node v : G.nodes) {
+		m_nodes[i] = v;
+		m_nodeId[v->index()] = i++;
+	}
+
+	i = 0;
+	for (edge e : G.edges) {
+		m_edges[i] = e;
+		m_edgeId[e->index()] = i++;
+	}
+
+	// The offsets follow from the degrees, the outgoing entries of a node precede its incoming ones.
+	int pos = 0;
+	for (int v = 0; v < n; ++v) {
+		m_offset[v] = pos;
+		m_outEnd[v] = pos + m_nodes[v]->outdeg();
+		pos += m_nodes[v]->degree();
+	}
+	m_offset[n] = pos;
+
+	for (int v = 0; v < n; ++v) {
+		int out = m_offset[v];
+		int in = m_outEnd[v];
+
+		for (adjEntry adj : m_nodes[v]->adjEntries) {
+			const int e = m_edgeId[adj->theEdge()->index()];
+			const int w = m_nodeId[adj->twinNode()->index()];
+
+			if (adj->isSource()) {
+				m_entryTarget[out] = w;
+				m_entryEdge[out] = e;
+				m_edgeEntry[e] = out++;
+			} else {
+				m_entryTarget[in] = w;
+				m_entryEdge[in] = e;
+				in++;
+			}
+		}
+
+		OGDF_ASSERT(out == m_outEnd[v]);
+		OGDF_ASSERT(in == m_offset[v + 1]);
+	}
+
+	// The incoming entry of an edge is the only one that is not the outgoing entry of its edge.
+	for (int j = 0; j < 2 * m; ++j) {
+		const int source = m_edgeEntry[m_entryEdge[j]];
+		if (source != j) {
+			m_entryTwin[j] = source;
+			m_entryTwin[source] = j;
+		}
+	}
+}
+
+}
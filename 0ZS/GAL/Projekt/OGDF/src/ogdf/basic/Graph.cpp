@@ -50,16 +50,23 @@ namespace ogdf {
 
 using Math::nextPower2;
 
-Graph::Graph()
+Graph::Graph() : m_arena(nullptr)
 {
 	m_nodeIdCount = m_edgeIdCount = 0;
 	resetTableSizes();
 }
 
 
-Graph::Graph(const Graph &G)
+Graph::Graph(ElementAllocation allocation) : Graph()
+{
+	setElementAllocation(allocation);
+}
+
+
+Graph::Graph(const Graph &G) : m_arena(nullptr)
 {
 	m_nodeIdCount = m_edgeIdCount = 0;
+	setElementAllocation(G.elementAllocation());
 	copy(G);
 	resetTableSizes();
 }
@@ -81,9 +88,68 @@ Graph::~Graph()
 		m_regAdjArrays.popFrontRet()->disconnect();
 	}
 
-	for (node v = nodes.head(); v; v = v->succ()) {
-		v->adjEntries.~GraphObjectContainer<AdjElement>();
+	deleteAllElements();
+	delete m_arena;
+}
+
+
+void Graph::setElementAllocation(ElementAllocation allocation)
+{
+	OGDF_ASSERT(empty());
+	OGDF_ASSERT(m_hiddenEdgeSets.empty());
+
+	if (allocation == elementAllocation()) {
+		return;
+	}
+
+	if (allocation == ElementAllocation::arena) {
+		m_arena = new ArenaMemoryAllocator;
+	} else {
+		delete m_arena;
+		m_arena = nullptr;
+	}
+}
+
+
+size_t Graph::elementMemory() const
+{
+	if (m_arena != nullptr) {
+		return m_arena->memoryAllocated();
+	}
+
+	size_t hiddenEdges = 0;
+	for (HiddenEdgeSet *set : m_hiddenEdgeSets) {
+		hiddenEdges += set->size();
+	}
+
+	return size_t(numberOfNodes()) * sizeof(NodeElement)
+	     + (numberOfEdges() + hiddenEdges) * (sizeof(EdgeElement) + 2 * sizeof(AdjElement));
+}
+
+
+void Graph::deleteAllElements()
+{
+	if (m_arena == nullptr) {
+		for (node v = nodes.head(); v; v = v->succ()) {
+			v->adjEntries.~GraphObjectContainer<AdjElement>();
+		}
+
+		nodes.clear();
+		edges.clear();
+		return;
+	}
+
+	// Hidden edges live in the arena, too; their sets are detached from the graph.
+	while (!m_hiddenEdgeSets.empty()) {
+		HiddenEdgeSet *set = m_hiddenEdgeSets.popFrontRet();
+		set->m_edges.clearPure();
+		set->m_graph = nullptr;
 	}
+
+	// The elements need no destruction, their lists are simply forgotten.
+	nodes.clearPure();
+	edges.clearPure();
+	m_arena->release();
 }
 
 
@@ -137,11 +203,11 @@ void Graph::copy(const Graph &G, NodeArray<node> &mapNode,
 	for(edge e : G.edges) {
 		edge eC;
 		edges.pushBack(eC = mapEdge[e] =
-			new EdgeElement(
+			newElement<EdgeElement>(
 				mapNode[e->source()],mapNode[e->target()],m_edgeIdCount));
 
-		eC->m_adjSrc = new AdjElement(eC,m_edgeIdCount<<1);
-		(eC->m_adjTgt = new AdjElement(eC,(m_edgeIdCount<<1)|1))
+		eC->m_adjSrc = newElement<AdjElement>(eC,m_edgeIdCount<<1);
+		(eC->m_adjTgt = newElement<AdjElement>(eC,(m_edgeIdCount<<1)|1))
 			->m_twin = eC->m_adjSrc;
 		eC->m_adjSrc->m_twin = eC->m_adjTgt;
 		m_edgeIdCount++;
@@ -181,12 +247,7 @@ void Graph::constructInitByCC(
 	EdgeArray<edge> &mapEdge)
 {
 	// clear
-	for (node v = nodes.head(); v; v = v->succ()) {
-		v->adjEntries.~GraphObjectContainer<AdjElement>();
-	}
-
-	nodes.clear();
-	edges.clear();
+	deleteAllElements();
 
 	m_nodeIdCount = m_edgeIdCount = 0;
 
@@ -195,9 +256,9 @@ void Graph::constructInitByCC(
 		node vG = info.v(i);
 
 #ifdef OGDF_DEBUG
-		node v = new NodeElement(this,m_nodeIdCount++);
+		node v = newElement<NodeElement>(this,m_nodeIdCount++);
 #else
-		node v = new NodeElement(m_nodeIdCount++);
+		node v = newElement<NodeElement>(m_nodeIdCount++);
 #endif
 		mapNode[vG] = v;
 		nodes.pushBack(v);
@@ -212,11 +273,11 @@ void Graph::constructInitByCC(
 		node v = mapNode[eG->source()];
 		node w = mapNode[eG->target()];
 
-		edge eC = mapEdge[eG] = new EdgeElement(v, w, m_edgeIdCount);
+		edge eC = mapEdge[eG] = newElement<EdgeElement>(v, w, m_edgeIdCount);
 		edges.pushBack(eC);
 
-		adjEntry adjSrc = new AdjElement(eC,  m_edgeIdCount<<1   );
-		adjEntry adjTgt = new AdjElement(eC, (m_edgeIdCount<<1)|1);
+		adjEntry adjSrc = newElement<AdjElement>(eC,  m_edgeIdCount<<1   );
+		adjEntry adjTgt = newElement<AdjElement>(eC, (m_edgeIdCount<<1)|1);
 
 		(eC->m_adjSrc = adjSrc)->m_twin = adjTgt;
 		(eC->m_adjTgt = adjTgt)->m_twin = adjSrc;
@@ -256,12 +317,7 @@ void Graph::constructInitByNodes(
 	EdgeArray<edge> &mapEdge)
 {
 	// clear
-	for (node v = nodes.head(); v; v = v->succ()) {
-		v->adjEntries.~GraphObjectContainer<AdjElement>();
-	}
-
-	nodes.clear();
-	edges.clear();
+	deleteAllElements();
 
 	m_nodeIdCount = m_edgeIdCount = 0;
 	m_nodeArrayTableSize = MIN_NODE_TABLE_SIZE;
@@ -292,11 +348,11 @@ void Graph::constructInitByNodes(
 		node v = mapNode[eG->source()];
 		node w = mapNode[eG->target()];
 
-		edge eC = mapEdge[eG] = new EdgeElement(v, w, m_edgeIdCount);
+		edge eC = mapEdge[eG] = newElement<EdgeElement>(v, w, m_edgeIdCount);
 		edges.pushBack(eC);
 
-		eC->m_adjSrc = new AdjElement(eC, m_edgeIdCount<<1);
-		(eC->m_adjTgt = new AdjElement(eC, (m_edgeIdCount<<1)|1))
+		eC->m_adjSrc = newElement<AdjElement>(eC, m_edgeIdCount<<1);
+		(eC->m_adjTgt = newElement<AdjElement>(eC, (m_edgeIdCount<<1)|1))
 			->m_twin = eC->m_adjSrc;
 		eC->m_adjSrc->m_twin = eC->m_adjTgt;
 		++m_edgeIdCount;
@@ -344,12 +400,7 @@ void Graph::constructInitByActiveNodes(
 	EdgeArray<edge> &mapEdge)
 {
 	// clear
-	for (node v = nodes.head(); v; v = v->succ()) {
-		v->adjEntries.~GraphObjectContainer<AdjElement>();
-	}
-
-	nodes.clear();
-	edges.clear();
+	deleteAllElements();
 
 	m_nodeIdCount = m_edgeIdCount = 0;
 	m_nodeArrayTableSize = MIN_NODE_TABLE_SIZE;
@@ -390,11 +441,11 @@ void Graph::constructInitByActiveNodes(
 		node v = mapNode[eG->source()];
 		node w = mapNode[eG->target()];
 
-		AdjElement *adjSrc = new AdjElement(v);
+		AdjElement *adjSrc = newElement<AdjElement>(v);
 
 		v->adjEntries.pushBack(adjSrc);
 
-		AdjElement *adjTgt = new AdjElement(w);
+		AdjElement *adjTgt = newElement<AdjElement>(w);
 
 		w->adjEntries.pushBack(adjTgt);
 
@@ -402,7 +453,7 @@ void Graph::constructInitByActiveNodes(
 		adjTgt->m_twin = adjSrc;
 
 		adjTgt->m_id = (adjSrc->m_id = m_edgeIdCount << 1) | 1;
-		edge e = new EdgeElement(v,w,adjSrc,adjTgt,m_edgeIdCount++);
+		edge e = newElement<EdgeElement>(v,w,adjSrc,adjTgt,m_edgeIdCount++);
 
 		edges.pushBack(e);
 
@@ -427,9 +478,9 @@ node Graph::newNode()
 	}
 
 #ifdef OGDF_DEBUG
-	node v = new NodeElement(this,m_nodeIdCount++);
+	node v = newElement<NodeElement>(this,m_nodeIdCount++);
 #else
-	node v = new NodeElement(m_nodeIdCount++);
+	node v = newElement<NodeElement>(m_nodeIdCount++);
 #endif
 
 	nodes.pushBack(v);
@@ -456,9 +507,9 @@ node Graph::newNode(int index)
 	}
 
 #ifdef OGDF_DEBUG
-	node v = new NodeElement(this,index);
+	node v = newElement<NodeElement>(this,index);
 #else
-	node v = new NodeElement(index);
+	node v = newElement<NodeElement>(index);
 #endif
 
 	nodes.pushBack(v);
@@ -471,12 +522,47 @@ node Graph::newNode(int index)
 }
 
 
+void Graph::reserveNodes(int n)
+{
+	OGDF_ASSERT(n >= 0);
+
+	if (m_nodeIdCount + n > m_nodeArrayTableSize) {
+		m_nodeArrayTableSize = nextPower2(m_nodeArrayTableSize, m_nodeIdCount + n);
+		for(NodeArrayBase *nab : m_regNodeArrays)
+			nab->enlargeTable(m_nodeArrayTableSize);
+	}
+
+	if (m_arena != nullptr) {
+		m_arena->reserve(n * sizeof(NodeElement));
+	} else if (OGDF_ALLOCATOR::checkSize(sizeof(NodeElement))) {
+		OGDF_ALLOCATOR::reserve(sizeof(NodeElement), n);
+	}
+}
+
+
+void Graph::newNodes(int n, Array<node> *newNodes)
+{
+	reserveNodes(n);
+
+	if (newNodes != nullptr) {
+		newNodes->init(n);
+	}
+
+	for (int i = 0; i < n; ++i) {
+		node v = newNode();
+		if (newNodes != nullptr) {
+			(*newNodes)[i] = v;
+		}
+	}
+}
+
+
 node Graph::pureNewNode()
 {
 #ifdef OGDF_DEBUG
-	node v = new NodeElement(this,m_nodeIdCount++);
+	node v = newElement<NodeElement>(this,m_nodeIdCount++);
 #else
-	node v = new NodeElement(m_nodeIdCount++);
+	node v = newElement<NodeElement>(m_nodeIdCount++);
 #endif
 
 	nodes.pushBack(v);
@@ -507,7 +593,7 @@ edge Graph::createEdgeElement(node v, node w, adjEntry adjSrc, adjEntry adjTgt)
 	}
 
 	adjTgt->m_id = (adjSrc->m_id = m_edgeIdCount << 1) | 1;
-	edge e = new EdgeElement(v,w,adjSrc,adjTgt,m_edgeIdCount++);
+	edge e = newElement<EdgeElement>(v,w,adjSrc,adjTgt,m_edgeIdCount++);
 	edges.pushBack(e);
 
 	// notify all registered observers
@@ -525,12 +611,12 @@ edge Graph::newEdge(node v, node w, int index)
 	OGDF_ASSERT(v->graphOf() == this);
 	OGDF_ASSERT(w->graphOf() == this);
 
-	AdjElement *adjSrc = new AdjElement(v);
+	AdjElement *adjSrc = newElement<AdjElement>(v);
 
 	v->adjEntries.pushBack(adjSrc);
 	v->m_outdeg++;
 
-	AdjElement *adjTgt = new AdjElement(w);
+	AdjElement *adjTgt = newElement<AdjElement>(w);
 
 	w->adjEntries.pushBack(adjTgt);
 	w->m_indeg++;
@@ -553,7 +639,7 @@ edge Graph::newEdge(node v, node w, int index)
 	}
 
 	adjTgt->m_id = (adjSrc->m_id = index/*m_edgeIdCount*/ << 1) | 1;
-	edge e = new EdgeElement(v,w,adjSrc,adjTgt,index);
+	edge e = newElement<EdgeElement>(v,w,adjSrc,adjTgt,index);
 	edges.pushBack(e);
 
 	// notify all registered observers
@@ -571,12 +657,12 @@ edge Graph::newEdge(node v, node w)
 	OGDF_ASSERT(v->graphOf() == this);
 	OGDF_ASSERT(w->graphOf() == this);
 
-	AdjElement *adjSrc = new AdjElement(v);
+	AdjElement *adjSrc = newElement<AdjElement>(v);
 
 	v->adjEntries.pushBack(adjSrc);
 	v->m_outdeg++;
 
-	AdjElement *adjTgt = new AdjElement(w);
+	AdjElement *adjTgt = newElement<AdjElement>(w);
 
 	w->adjEntries.pushBack(adjTgt);
 	w->m_indeg++;
@@ -590,6 +676,53 @@ edge Graph::newEdge(node v, node w)
 }
 
 
+void Graph::reserveEdges(int m)
+{
+	OGDF_ASSERT(m >= 0);
+
+	if (m_edgeIdCount + m > m_edgeArrayTableSize) {
+		m_edgeArrayTableSize = nextPower2(m_edgeArrayTableSize, m_edgeIdCount + m);
+
+		for(EdgeArrayBase *eab : m_regEdgeArrays)
+			eab->enlargeTable(m_edgeArrayTableSize);
+
+		for(AdjEntryArrayBase *aab : m_regAdjArrays)
+			aab->enlargeTable(m_edgeArrayTableSize << 1);
+	}
+
+	if (m_arena != nullptr) {
+		m_arena->reserve(m * (sizeof(EdgeElement) + 2 * sizeof(AdjElement)));
+		return;
+	}
+
+	if (OGDF_ALLOCATOR::checkSize(sizeof(EdgeElement))) {
+		OGDF_ALLOCATOR::reserve(sizeof(EdgeElement), m);
+	}
+	if (OGDF_ALLOCATOR::checkSize(sizeof(AdjElement))) {
+		OGDF_ALLOCATOR::reserve(sizeof(AdjElement), 2 * size_t(m));
+	}
+}
+
+
+void Graph::newEdges(const Array<std::pair<node, node>> &edgeList, Array<edge> *newEdges)
+{
+	reserveEdges(edgeList.size());
+
+	if (newEdges != nullptr) {
+		newEdges->init(edgeList.size());
+	}
+
+	int i = 0;
+	for (const std::pair<node, node> &vw : edgeList) {
+		edge e = newEdge(vw.first, vw.second);
+		if (newEdges != nullptr) {
+			(*newEdges)[i] = e;
+		}
+		++i;
+	}
+}
+
+
 edge Graph::newEdge(adjEntry adjStart, adjEntry adjEnd, Direction dir)
 {
 	OGDF_ASSERT(adjStart != nullptr);
@@ -599,8 +732,8 @@ edge Graph::newEdge(adjEntry adjStart, adjEntry adjEnd, Direction dir)
 
 	node v = adjStart->theNode(), w = adjEnd->theNode();
 
-	AdjElement *adjTgt = new AdjElement(w);
-	AdjElement *adjSrc = new AdjElement(v);
+	AdjElement *adjTgt = newElement<AdjElement>(w);
+	AdjElement *adjSrc = newElement<AdjElement>(v);
 
 	if(dir == Direction::after) {
 		w->adjEntries.insertAfter(adjTgt,adjEnd);
@@ -630,12 +763,12 @@ edge Graph::newEdge(node v, adjEntry adjEnd)
 
 	node w = adjEnd->theNode();
 
-	AdjElement *adjTgt = new AdjElement(w);
+	AdjElement *adjTgt = newElement<AdjElement>(w);
 
 	w->adjEntries.insertAfter(adjTgt,adjEnd);
 	w->m_indeg++;
 
-	AdjElement *adjSrc = new AdjElement(v);
+	AdjElement *adjSrc = newElement<AdjElement>(v);
 
 	v->adjEntries.pushBack(adjSrc);
 	v->m_outdeg++;
@@ -658,12 +791,12 @@ edge Graph::newEdge(adjEntry adjStart, node v)
 
 	node w = adjStart->theNode();
 
-	AdjElement *adjSrc = new AdjElement(w);
+	AdjElement *adjSrc = newElement<AdjElement>(w);
 
 	w->adjEntries.insertAfter(adjSrc, adjStart);
 	w->m_outdeg++;
 
-	AdjElement *adjTgt = new AdjElement(v);
+	AdjElement *adjTgt = newElement<AdjElement>(v);
 
 	v->adjEntries.pushBack(adjTgt);
 	v->m_indeg++;
@@ -771,7 +904,7 @@ edge Graph::split(edge e)
 	node u = newNode();
 	u->m_indeg = u->m_outdeg = 1;
 
-	adjEntry adjTgt = new AdjElement(u);
+	adjEntry adjTgt = newElement<AdjElement>(u);
 	adjTgt->m_edge = e;
 	adjTgt->m_twin = e->m_adjSrc;
 	e->m_adjSrc->m_twin = adjTgt;
@@ -781,7 +914,7 @@ edge Graph::split(edge e)
 
 	u->adjEntries.pushBack(adjTgt);
 
-	adjEntry adjSrc = new AdjElement(u);
+	adjEntry adjSrc = newElement<AdjElement>(u);
 	adjSrc->m_twin = e->m_adjTgt;
 	u->adjEntries.pushBack(adjSrc);
 
@@ -850,8 +983,10 @@ void Graph::unsplit(edge eIn, edge eOut)
 		obs->nodeDeleted(u);
 
 	// remove structures that are no longer used
-	edges.del(eOut);
-	nodes.del(u);
+	edges.delPure(eOut);
+	deleteElement(eOut);
+	nodes.delPure(u);
+	deleteElement(u);
 }
 
 
@@ -888,7 +1023,8 @@ void Graph::delNode(node v)
 	while((adj = adjEdges.head()) != nullptr)
 		delEdge(adj->m_edge);
 
-	nodes.del(v);
+	nodes.delPure(v);
+	deleteElement(v);
 }
 
 
@@ -903,12 +1039,15 @@ void Graph::delEdge(edge e)
 
 	node src = e->m_src, tgt = e->m_tgt;
 
-	src->adjEntries.del(e->m_adjSrc);
+	src->adjEntries.delPure(e->m_adjSrc);
+	deleteElement(e->m_adjSrc);
 	src->m_outdeg--;
-	tgt->adjEntries.del(e->m_adjTgt);
+	tgt->adjEntries.delPure(e->m_adjTgt);
+	deleteElement(e->m_adjTgt);
 	tgt->m_indeg--;
 
-	edges.del(e);
+	edges.delPure(e);
+	deleteElement(e);
 }
 
 
@@ -918,12 +1057,7 @@ void Graph::clear()
 	for(GraphObserver *obs : m_regStructures)
 		obs->cleared();
 
-	for (node v = nodes.head(); v; v = v->succ()) {
-		v->adjEntries.~GraphObjectContainer<AdjElement>();
-	}
-
-	nodes.clear();
-	edges.clear();
+	deleteAllElements();
 
 	m_nodeIdCount = m_edgeIdCount = 0;
 	m_nodeArrayTableSize = MIN_NODE_TABLE_SIZE;
@@ -41,12 +41,15 @@ namespace ogdf {
 GraphCopySimple::GraphCopySimple() {}
 
 
-GraphCopySimple::GraphCopySimple(const Graph &G)
+GraphCopySimple::GraphCopySimple(ElementAllocation allocation) : Graph(allocation) {}
+
+
+GraphCopySimple::GraphCopySimple(const Graph &G, ElementAllocation allocation) : Graph(allocation)
 {
 	init(G);
 }
 
-GraphCopySimple::GraphCopySimple(const GraphCopySimple &GC) : Graph()
+GraphCopySimple::GraphCopySimple(const GraphCopySimple &GC) : Graph(GC.elementAllocation())
 {
 	*this = GC;
 }
@@ -130,13 +133,13 @@ void GraphCopySimple::delNode(node v) {
 }
 
 
-GraphCopy::GraphCopy(const Graph &G)
+GraphCopy::GraphCopy(const Graph &G, ElementAllocation allocation) : Graph(allocation)
 {
 	init(G);
 }
 
 
-GraphCopy::GraphCopy(const GraphCopy &GC) : Graph()
+GraphCopy::GraphCopy(const GraphCopy &GC) : Graph(GC.elementAllocation())
 {
 	*this = GC;
 }
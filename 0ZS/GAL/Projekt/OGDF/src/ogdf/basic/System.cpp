@@ -92,6 +92,43 @@ static inline void cpuid(int CPUInfo[4], int infoType)
 #endif
 }
 
+static inline void cpuidex(int CPUInfo[4], int infoType, int subInfoType)
+{
+#if defined(OGDF_SYSTEM_WINDOWS) && !defined(__GNUC__)
+	__cpuidex(CPUInfo, infoType, subInfoType);
+#else
+	uint32_t a = 0;
+	uint32_t b = 0;
+	uint32_t c = 0;
+	uint32_t d = 0;
+
+# if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	if (static_cast<unsigned int>(infoType) <= __get_cpuid_max(0, nullptr)) {
+		__cpuid_count(infoType, subInfoType, a, b, c, d);
+	}
+# endif
+
+	CPUInfo[0] = a;
+	CPUInfo[1] = b;
+	CPUInfo[2] = c;
+	CPUInfo[3] = d;
+#endif
+}
+
+//! Returns the extended control register XCR0, i.e., the register states saved by the OS.
+static inline uint64_t xgetbv0()
+{
+#if defined(OGDF_SYSTEM_WINDOWS) && !defined(__GNUC__)
+	return _xgetbv(0);
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	uint32_t a, d;
+	__asm__ __volatile__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return (uint64_t(d) << 32) | a;
+#else
+	return 0;
+#endif
+}
+
 
 namespace ogdf {
 
@@ -134,6 +171,29 @@ void System::init()
 		if(featureInfoECX & (1 <<  6)) s_cpuFeatures |= CPUFeatureMask::SMX;
 		if(featureInfoECX & (1 <<  7)) s_cpuFeatures |= CPUFeatureMask::EST;
 		if(featureInfoECX & (1 <<  3)) s_cpuFeatures |= CPUFeatureMask::MONITOR;
+
+		// AVX requires the OS to save the YMM registers (XCR0 bits 1 and 2),
+		// AVX-512 additionally the opmask and ZMM registers (XCR0 bits 5 to 7)
+		bool osSavesYMM = false;
+		bool osSavesZMM = false;
+		if(featureInfoECX & (1 << 27)) {
+			uint64_t xcr0 = xgetbv0();
+			osSavesYMM = (xcr0 & 0x6) == 0x6;
+			osSavesZMM = osSavesYMM && (xcr0 & 0xe0) == 0xe0;
+		}
+
+		if(osSavesYMM) {
+			if(featureInfoECX & (1 << 28)) s_cpuFeatures |= CPUFeatureMask::AVX;
+			if(featureInfoECX & (1 << 12)) s_cpuFeatures |= CPUFeatureMask::FMA;
+
+			if(nIds >= 7) {
+				cpuidex(CPUInfo, 7, 0);
+				int extFeatureInfoEBX = CPUInfo[1];
+
+				if(extFeatureInfoEBX & (1 <<  5)) s_cpuFeatures |= CPUFeatureMask::AVX2;
+				if(osSavesZMM && (extFeatureInfoEBX & (1 << 16))) s_cpuFeatures |= CPUFeatureMask::AVX512F;
+			}
+		}
 	}
 
 	cpuid(CPUInfo, 0x80000000);
@@ -114,16 +114,14 @@ void randomGraph(Graph &G, int n, int m)
 	G.clear();
 	if (n == 0) return;
 
-	Array<node> v(n);
-
-	int i;
-	for(i = 0; i < n; i++)
-		v[i] = G.newNode();
+	Array<node> v;
+	G.newNodes(n, &v);
+	G.reserveEdges(m);
 
 	minstd_rand rng(randomSeed());
 	uniform_int_distribution<> dist(0,n-1);
 
-	for(i = 0; i < m; i++) {
+	for(int i = 0; i < m; i++) {
 		int v1 = dist(rng);
 		int v2 = dist(rng);
 
@@ -177,16 +175,15 @@ static bool randomSimpleGraphByMask(Graph& G, int n, int m, Array<bool>& preEdge
 		return false;
 	}
 
-	Array<node> v(n);
-
-	for (int i = 0; i < n; i++) {
-		v[i] = G.newNode();
-	}
+	Array<node> v;
+	G.newNodes(n, &v);
 
 	if (m == 0) {
 		return true;
 	}
 
+	G.reserveEdges(m);
+
 	minstd_rand rng(randomSeed());
 	uniform_int_distribution<> dist_a(0, n-1);
 	uniform_int_distribution<> dist_b(0, n-2);
@@ -257,10 +254,9 @@ static bool randomSimpleGraphBySet(Graph& G, int n, int m, std::vector<std::pair
 		return false;
 	}
 
-	Array<node> v(n);
-	for (int i = 0; i < n; i++) {
-		v[i] = G.newNode();
-	}
+	Array<node> v;
+	G.newNodes(n, &v);
+	G.reserveEdges(m);
 
 	unordered_set<int> edgeIndices(2*m);
 	for (auto e: preEdges) {
@@ -0,0 +1,89 @@
+/** \file
+ * \brief Implementation of a memory manager that allocates from chunks
+ *        owned by a single object
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
+#include <ogdf/basic/exceptions.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace ogdf {
+
+void ArenaMemoryAllocator::reserve(size_t nBytes)
+{
+	if (size_t(m_end - m_pos) < nBytes) {
+		newChunk(nBytes);
+	}
+}
+
+
+void ArenaMemoryAllocator::release()
+{
+	MemElemPtr p = m_chunks;
+	while (p != nullptr) {
+		MemElemPtr pNext = p->m_next;
+		free(p);
+		p = pNext;
+	}
+
+	m_chunks = nullptr;
+	m_pos = m_end = nullptr;
+	for (MemElemPtr &pFreeBytes : m_freeList) {
+		pFreeBytes = nullptr;
+	}
+
+	m_nextChunkSize = MIN_CHUNK_SIZE;
+	m_bytesAllocated = 0;
+	m_bytesInUse = 0;
+}
+
+
+void ArenaMemoryAllocator::newChunk(size_t nBytes)
+{
+	// the first word of a chunk links it to the previous one
+	size_t size = std::max(m_nextChunkSize, nBytes + sizeof(MemElem));
+	MemElemPtr chunk = static_cast<MemElemPtr>(malloc(size));
+	if (OGDF_UNLIKELY(chunk == nullptr)) {
+		OGDF_THROW(InsufficientMemoryException);
+	}
+
+	chunk->m_next = m_chunks;
+	m_chunks = chunk;
+
+	m_pos = reinterpret_cast<char *>(chunk + 1);
+	m_end = reinterpret_cast<char *>(chunk) + size;
+
+	m_bytesAllocated += size;
+	m_nextChunkSize = std::min(2 * m_nextChunkSize, MAX_CHUNK_SIZE);
+}
+
+}
@@ -29,15 +29,17 @@
  * License along with this program; if not, see
  * http://www.gnu.org/copyleft/gpl.html
  */
-
 #include <ogdf/basic/memory.h>
+#include <ogdf/basic/exceptions.h>
+
+#include <vector>
 
 namespace ogdf {
 
 struct PoolMemoryAllocator::PoolElement
 {
-	MemElemPtr m_gp;
-	int        m_size;
+	std::atomic<uint64_t> m_top;  //!< The tagged index of the top batch.
+	std::atomic<long>     m_size; //!< The number of elements in all batches.
 };
 
 struct PoolMemoryAllocator::BlockChain
@@ -46,9 +48,20 @@ struct PoolMemoryAllocator::BlockChain
 	BlockChain *m_next;
 };
 
+struct PoolMemoryAllocator::Batch
+{
+	MemElemPtr            m_head;  //!< The first element of the batch, the last one links to nullptr.
+	long                  m_count; //!< The number of elements of the batch.
+	std::atomic<uint32_t> m_next;  //!< The index of the next batch on the stack plus one.
+};
+
 
 PoolMemoryAllocator::PoolElement PoolMemoryAllocator::s_pool[TABLE_SIZE];
-PoolMemoryAllocator::BlockChain *PoolMemoryAllocator::s_blocks;
+std::atomic<PoolMemoryAllocator::BlockChain*> PoolMemoryAllocator::s_blocks;
+std::atomic<size_t> PoolMemoryAllocator::s_blockCount;
+std::atomic<PoolMemoryAllocator::Batch*> PoolMemoryAllocator::s_batchChunks[BATCH_CHUNKS];
+std::atomic<uint32_t> PoolMemoryAllocator::s_batchCount;
+std::atomic<uint64_t> PoolMemoryAllocator::s_freeBatches;
 
 #ifdef OGDF_DEBUG
 long long PoolMemoryAllocator::s_globallyAllocatedBytes = 0;
@@ -67,12 +80,16 @@ void PoolMemoryAllocator::cleanup()
 	// check if all memory is correctly freed (if not we have a memory leak)
 	OGDF_ASSERT(s_globallyAllocatedBytes + s_locallyAllocatedBytes == 0);
 
-	BlockChain *p = s_blocks;
+	BlockChain *p = s_blocks.load();
 	while(p != nullptr) {
 		BlockChain *pNext = p->m_next;
 		free(p);
 		p = pNext;
 	}
+
+	for (std::atomic<Batch*> &chunk : s_batchChunks) {
+		delete[] chunk.load();
+	}
 }
 
 
@@ -122,32 +139,65 @@ void PoolMemoryAllocator::deallocateList(size_t nBytes, void *pHead, void *pTail
 
 
 
+void PoolMemoryAllocator::reserve(size_t nBytes, size_t count)
+{
+	MemElemPtr &pFreeBytes = s_tp[nBytes];
+
+	// only the part not covered by the thread's free list is allocated
+	for (MemElemPtr p = pFreeBytes; p != nullptr && count > 0; p = p->m_next) {
+		--count;
+	}
+	if (count == 0) {
+		return;
+	}
+
+	int nWords;
+	const int nSlices = slicesPerBlock(max(uint16_t(nBytes),(uint16_t)MIN_BYTES),nWords);
+	const size_t nBlocks = (count + nSlices - 1) / nSlices;
+
+	MemElemPtr *blocks = new MemElemPtr[nBlocks];
+	for (size_t i = 0; i < nBlocks; ++i) {
+		blocks[i] = allocateBlock();
+	}
+
+	// chain the slices of all blocks in front of the current free list
+	MemElemPtr pNext = pFreeBytes;
+	for (size_t i = nBlocks; i-- > 0; ) {
+		makeSlices(blocks[i], nWords, nSlices);
+		(blocks[i] + (nSlices - 1) * nWords)->m_next = pNext;
+		pNext = blocks[i];
+	}
+	pFreeBytes = pNext;
+
+	delete[] blocks;
+}
+
+
 void PoolMemoryAllocator::flushPool()
 {
 #ifndef OGDF_MEMORY_POOL_NTS
 	for(uint16_t nBytes = 1; nBytes < TABLE_SIZE; ++nBytes) {
-		MemElemPtr &pHead = s_tp[nBytes];
-		if(pHead != nullptr) {
-			MemElemPtr pTail = pHead;
-			int n = 1;
+		MemElemPtr p = s_tp[nBytes];
+		if(p == nullptr) {
+			continue;
+		}
+		s_tp[nBytes] = nullptr;
 
-			while(pTail->m_next != nullptr) {
-				pTail = pTail->m_next;
+		// the list is handed over in batches of one block each, so other threads refill at once
+		const long maxCount = slicesPerBlock(max(nBytes,(uint16_t)MIN_BYTES));
+		while(p != nullptr) {
+			MemElemPtr pHead = p;
+			long n = 1;
+
+			while(n < maxCount && p->m_next != nullptr) {
+				p = p->m_next;
 				++n;
 			}
 
-			MemElemPtr pOldHead = pHead;
-			pHead = nullptr;
-
-			enterCS();
-
-			PoolElement &pe = s_pool[nBytes];
-
-			pTail->m_next = pe.m_gp;
-			pe.m_gp = pOldHead;
-			pe.m_size += n;
-
-			leaveCS();
+			MemElemPtr pNext = p->m_next;
+			p->m_next = nullptr;
+			pushBatchToPool(nBytes, pHead, n);
+			p = pNext;
 		}
 	}
 #endif
@@ -170,26 +220,17 @@ void *PoolMemoryAllocator::fillPool(MemElemPtr &pFreeBytes, uint16_t nBytes)
 	pFreeBytes = allocateBlock();
 	makeSlices(pFreeBytes, nWords, nSlices);
 #else
-	enterCS();
-
 	PoolElement &pe = s_pool[nBytes];
-	if(pe.m_size >= nSlices) {
-		MemElemPtr p = pFreeBytes = pe.m_gp;
-		for(int i = 1; i < nSlices; ++i)
-			p = p->m_next;
-
-		pe.m_gp = p->m_next;
-		pe.m_size -= nSlices;
+	uint32_t index;
 
-		leaveCS();
-
-		p->m_next = nullptr;
+	if(popBatch(pe.m_top, index)) {
+		Batch &b = batch(index);
+		pFreeBytes = b.m_head;
+		pe.m_size.fetch_sub(b.m_count, std::memory_order_relaxed);
+		pushBatch(s_freeBatches, index);
 
 	} else {
 		pFreeBytes = allocateBlock();
-
-		leaveCS();
-
 		makeSlices(pFreeBytes, nWords, nSlices);
 	}
 #endif
@@ -204,9 +245,13 @@ PoolMemoryAllocator::MemElemPtr
 PoolMemoryAllocator::allocateBlock()
 {
 	BlockChain *pBlock = static_cast<BlockChain*>( malloc(BLOCK_SIZE) );
+	if (OGDF_UNLIKELY(pBlock == nullptr)) {
+		OGDF_THROW(InsufficientMemoryException);
+	}
 
-	pBlock->m_next = s_blocks;
-	s_blocks = pBlock;
+	pBlock->m_next = s_blocks.load(std::memory_order_relaxed);
+	while(!s_blocks.compare_exchange_weak(pBlock->m_next, pBlock, std::memory_order_release, std::memory_order_relaxed));
+	s_blockCount.fetch_add(1, std::memory_order_relaxed);
 
 	return reinterpret_cast<MemElemPtr>(pBlock);
 }
@@ -221,39 +266,102 @@ void PoolMemoryAllocator::makeSlices(MemElemPtr pBlock, int nWords, int nSlices)
 }
 
 
+PoolMemoryAllocator::Batch &PoolMemoryAllocator::batch(uint32_t index)
+{
+	Batch *chunk = s_batchChunks[index >> BATCH_CHUNK_BITS].load(std::memory_order_acquire);
+	return chunk[index & ((uint32_t(1) << BATCH_CHUNK_BITS) - 1)];
+}
 
-size_t PoolMemoryAllocator::memoryAllocatedInBlocks()
+
+void PoolMemoryAllocator::pushBatch(std::atomic<uint64_t> &stack, uint32_t index)
 {
-	enterCS();
+	uint64_t top = stack.load(std::memory_order_relaxed);
+	uint64_t newTop;
+
+	do {
+		batch(index).m_next.store(uint32_t(top), std::memory_order_relaxed);
+		newTop = (((top >> 32) + 1) << 32) | (index + 1);
+	} while(!stack.compare_exchange_weak(top, newTop, std::memory_order_release, std::memory_order_relaxed));
+}
 
-	size_t nBlocks = 0;
-	for (BlockChain *p = s_blocks; p != nullptr; p = p->m_next)
-		++nBlocks;
 
-	leaveCS();
+bool PoolMemoryAllocator::popBatch(std::atomic<uint64_t> &stack, uint32_t &index)
+{
+	uint64_t top = stack.load(std::memory_order_acquire);
+
+	for(;;) {
+		const uint32_t first = uint32_t(top);
+		if(first == 0) {
+			return false;
+		}
+
+		// the descriptor may have been popped and reused meanwhile, then the tag differs and the exchange fails
+		const uint32_t next = batch(first - 1).m_next.load(std::memory_order_relaxed);
+		const uint64_t newTop = (((top >> 32) + 1) << 32) | next;
 
-	return nBlocks * BLOCK_SIZE;
+		if(stack.compare_exchange_weak(top, newTop, std::memory_order_acquire, std::memory_order_acquire)) {
+			index = first - 1;
+			return true;
+		}
+	}
 }
 
 
-size_t PoolMemoryAllocator::unguardedMemGlobalFreelist()
+uint32_t PoolMemoryAllocator::newBatch()
 {
-	size_t bytesFree = 0;
-	for (size_t sz = 1; sz < TABLE_SIZE; ++sz)
-	{
-		const PoolElement &pe = s_pool[sz];
-		bytesFree += pe.m_size * sz;
+	uint32_t index;
+	if(popBatch(s_freeBatches, index)) {
+		return index;
 	}
 
-	return bytesFree;
+	index = s_batchCount.fetch_add(1, std::memory_order_relaxed);
+	const size_t chunk = index >> BATCH_CHUNK_BITS;
+	if (OGDF_UNLIKELY(chunk >= BATCH_CHUNKS)) {
+		OGDF_THROW(InsufficientMemoryException);
+	}
+
+	// chunks of descriptors are allocated rarely, the first thread that needs one allocates it
+	if(s_batchChunks[chunk].load(std::memory_order_acquire) == nullptr) {
+		enterCS();
+		if(s_batchChunks[chunk].load(std::memory_order_relaxed) == nullptr) {
+			s_batchChunks[chunk].store(new Batch[size_t(1) << BATCH_CHUNK_BITS](), std::memory_order_release);
+		}
+		leaveCS();
+	}
+
+	return index;
+}
+
+
+void PoolMemoryAllocator::pushBatchToPool(uint16_t nBytes, MemElemPtr pHead, long count)
+{
+	const uint32_t index = newBatch();
+	Batch &b = batch(index);
+	b.m_head = pHead;
+	b.m_count = count;
+
+	PoolElement &pe = s_pool[nBytes];
+	pe.m_size.fetch_add(count, std::memory_order_relaxed);
+	pushBatch(pe.m_top, index);
+}
+
+
+
+size_t PoolMemoryAllocator::memoryAllocatedInBlocks()
+{
+	return s_blockCount.load(std::memory_order_relaxed) * BLOCK_SIZE;
 }
 
 
 size_t PoolMemoryAllocator::memoryInGlobalFreeList()
 {
-	enterCS();
-	size_t bytesFree = unguardedMemGlobalFreelist();
-	leaveCS();
+	size_t bytesFree = 0;
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz)
+	{
+		// the counters are updated independently of the stacks, so they are only approximate meanwhile
+		const long size = s_pool[sz].m_size.load(std::memory_order_relaxed);
+		bytesFree += max(size, 0L) * sz;
+	}
 
 	return bytesFree;
 }
@@ -264,8 +372,7 @@ size_t PoolMemoryAllocator::memoryInThreadFreeList()
 	size_t bytesFree = 0;
 	for (size_t sz = 1; sz < TABLE_SIZE; ++sz)
 	{
-		MemElemPtr &p = s_tp[sz];
-		for(; p != nullptr; p = p->m_next)
+		for(MemElemPtr p = s_tp[sz]; p != nullptr; p = p->m_next)
 			bytesFree += sz;
 	}
 
@@ -275,39 +382,46 @@ size_t PoolMemoryAllocator::memoryInThreadFreeList()
 
 void PoolMemoryAllocator::defrag()
 {
-	enterCS();
+	std::vector<MemElemPtr> a;
 
-	int maxSize = 0;
-	for(size_t sz = 1; sz < TABLE_SIZE; ++sz) {
-		int size = s_pool[sz].m_size;
-		maxSize = max(maxSize, size);
-	}
+	for(uint16_t sz = 1; sz < TABLE_SIZE; ++sz)
+	{
+		PoolElement &pe = s_pool[sz];
+
+		// take all batches of this size at once
+		uint64_t top = pe.m_top.load(std::memory_order_acquire);
+		while(uint32_t(top) != 0
+		   && !pe.m_top.compare_exchange_weak(top, ((top >> 32) + 1) << 32, std::memory_order_acquire, std::memory_order_acquire));
+
+		a.clear();
+		for(uint32_t next = uint32_t(top); next != 0; ) {
+			const uint32_t index = next - 1;
+			Batch &b = batch(index);
+			for(MemElemPtr p = b.m_head; p != nullptr; p = p->m_next)
+				a.push_back(p);
+			next = b.m_next.load(std::memory_order_relaxed);
+			pushBatch(s_freeBatches, index);
+		}
 
-	if(maxSize > 1) {
-		MemElemPtr *a = new MemElemPtr[maxSize];
-
-		for(size_t sz = 1; sz < TABLE_SIZE; ++sz)
-		{
-			PoolElement &pe = s_pool[sz];
-			int n = pe.m_size;
-			if(n > 1)
-			{
-				int i = 0;
-				for(MemElemPtr p = pe.m_gp; p != nullptr; p = p->m_next)
-					a[i++] = p;
-				OGDF_ASSERT(i == n);
-				std::sort(a, a+n);
-				pe.m_gp = a[0];
-				for(i = 0; i < n-1; ++i) {
-					a[i]->m_next = a[i+1];
-				}
-				a[n-1]->m_next = nullptr;
+		if(a.empty()) {
+			continue;
+		}
+
+		const long n = long(a.size());
+		pe.m_size.fetch_sub(n, std::memory_order_relaxed);
+		std::sort(a.begin(), a.end());
+
+		// put the elements back in batches of one block each, the batch with the lowest addresses ends up on top
+		const long maxCount = slicesPerBlock(max(sz,(uint16_t)MIN_BYTES));
+		for(long first = (n - 1) / maxCount * maxCount; first >= 0; first -= maxCount) {
+			const long last = min(first + maxCount, n) - 1;
+			for(long i = first; i < last; ++i) {
+				a[i]->m_next = a[i+1];
 			}
+			a[last]->m_next = nullptr;
+			pushBatchToPool(sz, a[first], last - first + 1);
 		}
-		delete[] a;
 	}
-
-	leaveCS();
 }
 
 }
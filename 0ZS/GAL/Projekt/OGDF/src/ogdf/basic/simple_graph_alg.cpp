@@ -31,6 +31,7 @@
 
 
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/basic/GraphCopy.h>
 #include <ogdf/basic/Math.h>
 #include <ogdf/basic/extended_graph_alg.h>
@@ -153,6 +154,34 @@ bool isConnected(const Graph &G)
 }
 
 
+bool isConnected(const CompactGraph &G)
+{
+	const int n = G.numberOfNodes();
+	if (n == 0) return true;
+
+	int count = 0;
+	Array<bool> visited(0, n - 1, false);
+	ArrayBuffer<int> S(n);
+
+	S.push(0);
+	visited[0] = true;
+	while(!S.empty()) {
+		int v = S.popRet();
+		++count;
+
+		for(int i = G.offset(v); i < G.offset(v + 1); ++i) {
+			int w = G.target(i);
+			if(!visited[w]) {
+				visited[w] = true;
+				S.push(w);
+			}
+		}
+	}
+
+	return count == n;
+}
+
+
 void makeConnected(Graph &G, List<edge> &added)
 {
 	added.clear();
@@ -232,6 +261,38 @@ int connectedComponents(const Graph &G,
 	return nComponent;
 }
 
+
+int connectedComponents(const CompactGraph &G, Array<int> &component)
+{
+	const int n = G.numberOfNodes();
+	int nComponent = 0;
+	component.init(0, n - 1, -1);
+
+	ArrayBuffer<int> S;
+
+	for(int v = 0; v < n; ++v) {
+		if (component[v] != -1) continue;
+
+		S.push(v);
+		component[v] = nComponent;
+
+		while(!S.empty()) {
+			int w = S.popRet();
+			for(int i = G.offset(w); i < G.offset(w + 1); ++i) {
+				int x = G.target(i);
+				if (component[x] == -1) {
+					component[x] = nComponent;
+					S.push(x);
+				}
+			}
+		}
+
+		++nComponent;
+	}
+
+	return nComponent;
+}
+
 // Testing and establishing biconnectivity
 
 //! Build up a dfs-tree starting from the node root by assigning each reachable
@@ -1196,6 +1257,74 @@ int strongComponents(const Graph &graph, NodeArray<int> &components)
 	return result;
 }
 
+int strongComponents(const CompactGraph &G, Array<int> &components)
+{
+	const int nNodes = G.numberOfNodes();
+	components.init(0, nNodes - 1, -1);
+
+	if (nNodes == 0) {
+		return 0;
+	}
+
+	// As above, a node v is on the stack set iff index[v] > -1 and lowLinks[v] < nNodes.
+	Array<int> lowLinks(0, nNodes - 1, -1);
+	Array<int> index(0, nNodes - 1, -1);
+	ArrayBuffer<int> set(nNodes);
+	int nextIndex = 0;
+	int result = 0;
+
+	// The simulated call stack holds a node and the position of its next outgoing entry.
+	ArrayBuffer<Tuple2<int, int>> stack(nNodes);
+
+	for (int u = 0; u < nNodes; ++u) {
+		if (index[u] != -1) {
+			continue;
+		}
+
+		index[u] = lowLinks[u] = nextIndex++;
+		set.push(u);
+		stack.push(Tuple2<int, int>(u, G.offset(u)));
+
+		while (!stack.empty()) {
+			const int v = stack.top().x1();
+			int &next = stack.top().x2();
+
+			if (next < G.outEnd(v)) {
+				const int w = G.target(next++);
+
+				if (index[w] == -1) {
+					// Continue the dfs with w.
+					index[w] = lowLinks[w] = nextIndex++;
+					set.push(w);
+					stack.push(Tuple2<int, int>(w, G.offset(w)));
+				} else {
+					Math::updateMin(lowLinks[v], lowLinks[w]);
+				}
+				continue;
+			}
+
+			// The nodes collected so far form one component.
+			if (lowLinks[v] == index[v]) {
+				int w;
+				do {
+					w = set.popRet();
+					components[w] = result;
+					lowLinks[w] = nNodes;
+				} while (w != v);
+				result++;
+			}
+
+			// v has no more children to visit. Backtrack and update the lowlink of its parent.
+			stack.pop();
+			if (!stack.empty()) {
+				Math::updateMin(lowLinks[stack.top().x1()], lowLinks[v]);
+			}
+		}
+	}
+
+	return result;
+}
+
 // makes the DiGraph bimodal such that all embeddings of the
 // graph are bimodal embeddings!
 void makeBimodal(Graph &G, List<edge> &newEdge)
@@ -320,6 +320,7 @@ void FMMMLayout::resetOptions()
 	nmSmallCell(FMMMOptions::SmallestCellFinding::Iteratively);
 	nmParticlesInLeaves(25);
 	nmPrecision(4);
+	setNumberOfThreads(1);
 }
 
 
@@ -1195,7 +1196,7 @@ void FMMMLayout::make_initialisations_for_rep_calc_classes(Graph& G)
 	case FMMMOptions::RepulsiveForcesMethod::NMM:
 		NM.make_initialisations(G, boxlength, down_left_corner,
 		nmParticlesInLeaves(), nmPrecision(),
-		nmTreeConstruction(), nmSmallCell());
+		nmTreeConstruction(), nmSmallCell(), numberOfThreads());
 	}
 }
 
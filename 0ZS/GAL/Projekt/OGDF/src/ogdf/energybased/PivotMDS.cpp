@@ -29,14 +29,227 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+
 #include <ogdf/energybased/PivotMDS.h>
 #include <ogdf/basic/GraphCopy.h>
+#include <ogdf/basic/Thread.h>
+
+#include <cstdint>
+#include <queue>
 
 
 namespace ogdf {
 
 const double PivotMDS::EPSILON = 1 - 1e-10;
 const double PivotMDS::FACTOR = -0.5;
+const int PivotMDS::MIN_NODES_PER_THREAD = 4096;
+
+namespace pivot_mds {
+
+//! The number of pivots traversed at once by a bit-parallel breadth-first search.
+constexpr int BATCH_SIZE = 64;
+
+//! The largest eccentricity (in hops) of the first pivot for which the bit-parallel search is used.
+/**
+ * The bit-parallel search scans the adjacency list of a node once for every distinct
+ * distance from the sources of a batch, each scan being a few times as expensive as
+ * in a single search. This pays off for graphs of small diameter only.
+ */
+constexpr int MAX_BATCH_ECCENTRICITY = 16;
+
+//! The number of columns processed at once by the blocked matrix kernels.
+constexpr int BLOCK_SIZE = 256;
+
+//! Returns the position of the lowest set bit of \p bits, which must not be 0.
+static inline int lowestBit(uint64_t bits)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(bits);
+#else
+	int b = 0;
+	while ((bits & 1) == 0) {
+		bits >>= 1;
+		++b;
+	}
+	return b;
+#endif
+}
+
+//! The per-search state of searchBall().
+struct BallSearch {
+	Array<double> distance; //!< The distance of each marked node.
+	Array<int> mark; //!< The last search that reached each node.
+	Array<int> queue; //!< The queue of the breadth-first search.
+
+	explicit BallSearch(int n) : distance(n), mark(0, n - 1, -1), queue(n) { }
+};
+
+//! Updates \p minDistance by the distances from \p s that are smaller than \p radius.
+/**
+ * The nodes farther away can be skipped: as \p radius is the largest minimal distance
+ * of all nodes, their minimal distance does not change.
+ *
+ * @param stamp is a number not used by any previous search with \p state.
+ * @param costs are the dense edge costs, or nullptr for uniform costs \p edgeCosts.
+ */
+static void searchBall(const CompactGraph& C, int s, int stamp, double radius,
+		const Array<double>* costs, double edgeCosts, Array<double>& minDistance, BallSearch& state)
+{
+	state.mark[s] = stamp;
+	state.distance[s] = 0;
+	minDistance[s] = 0;
+
+	if (costs == nullptr) {
+		int size = 0;
+		state.queue[size++] = s;
+		for (int head = 0; head < size; ++head) {
+			const int v = state.queue[head];
+			const double d = state.distance[v] + edgeCosts;
+			if (d >= radius) {
+				// the distances in the queue do not decrease
+				break;
+			}
+			for (int i = C.offset(v); i < C.offset(v + 1); ++i) {
+				const int w = C.target(i);
+				if (state.mark[w] != stamp) {
+					state.mark[w] = stamp;
+					state.distance[w] = d;
+					Math::updateMin(minDistance[w], d);
+					state.queue[size++] = w;
+				}
+			}
+		}
+	} else {
+		using Entry = std::pair<double, int>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		queue.push(Entry(0.0, s));
+		while (!queue.empty()) {
+			const Entry top = queue.top();
+			queue.pop();
+			const int v = top.second;
+			if (top.first > state.distance[v]) {
+				continue;
+			}
+			Math::updateMin(minDistance[v], top.first);
+			for (int i = C.offset(v); i < C.offset(v + 1); ++i) {
+				const int w = C.target(i);
+				const double d = top.first + (*costs)[C.edgeOf(i)];
+				if (d < radius && (state.mark[w] != stamp || d < state.distance[w])) {
+					state.mark[w] = stamp;
+					state.distance[w] = d;
+					queue.push(Entry(d, w));
+				}
+			}
+		}
+	}
+}
+
+//! The per-thread state of bfsBatch().
+struct BatchSearch {
+	std::vector<uint64_t> seen; //!< The sources that have reached each node.
+	std::vector<uint64_t> visit; //!< The sources that have reached each node of the frontier in the last step.
+	std::vector<uint64_t> next; //!< The sources that reach each node in the current step.
+	std::vector<int> frontier; //!< The nodes reached in the last step.
+	std::vector<int> nextFrontier; //!< The nodes reached in the current step.
+
+	explicit BatchSearch(int n) : seen(n, 0), visit(n, 0), next(n, 0) { }
+};
+
+//! Writes the squared distances from up to BATCH_SIZE \p sources by one bit-parallel breadth-first search.
+/**
+ * Every node keeps a bit set of the sources that have reached it, so the searches
+ * from all sources share the scans of the adjacency lists of the nodes they reach
+ * in the same step.
+ *
+ * @param rows are the rows of the distance matrix of the sources.
+ * @param rowSums are increased by the sums of the rows.
+ */
+static void bfsBatch(const CompactGraph& C, const int* sources, int count, double edgeCosts,
+		double** rows, double* rowSums, BatchSearch& state)
+{
+	for (int b = 0; b < count; ++b) {
+		const int s = sources[b];
+		if (state.seen[s] == 0) {
+			state.frontier.push_back(s);
+		}
+		state.seen[s] |= uint64_t(1) << b;
+		state.visit[s] |= uint64_t(1) << b;
+		rows[b][s] = 0;
+	}
+
+	double d = 0;
+	while (!state.frontier.empty()) {
+		d += edgeCosts;
+		const double square = d * d;
+
+		for (int v : state.frontier) {
+			const uint64_t bits = state.visit[v];
+			for (int i = C.offset(v); i < C.offset(v + 1); ++i) {
+				const int w = C.target(i);
+				const uint64_t newBits = bits & ~state.seen[w];
+				if (newBits != 0) {
+					if (state.next[w] == 0) {
+						state.nextFrontier.push_back(w);
+					}
+					state.next[w] |= newBits;
+				}
+			}
+		}
+
+		for (int v : state.frontier) {
+			state.visit[v] = 0;
+		}
+		for (int w : state.nextFrontier) {
+			uint64_t bits = state.next[w];
+			state.next[w] = 0;
+			state.seen[w] |= bits;
+			state.visit[w] = bits;
+			while (bits != 0) {
+				const int b = lowestBit(bits);
+				bits &= bits - 1;
+				rows[b][w] = square;
+				rowSums[b] += square;
+			}
+		}
+
+		state.frontier.swap(state.nextFrontier);
+		state.nextFrontier.clear();
+	}
+
+	std::fill(state.seen.begin(), state.seen.end(), 0);
+}
+
+//! Writes the squared distances from \p s to \p row by a breadth-first search, returns the sum of the row.
+static double bfsRow(const CompactGraph& C, int s, double edgeCosts, double* row, Array<int>& queue)
+{
+	const int n = C.numberOfNodes();
+
+	// the row holds the distances during the search, -1 marks the nodes not reached yet
+	std::fill(row, row + n, -1.0);
+	int size = 0;
+	queue[size++] = s;
+	row[s] = 0;
+	for (int head = 0; head < size; ++head) {
+		const int v = queue[head];
+		const double d = row[v] + edgeCosts;
+		for (int i = C.offset(v); i < C.offset(v + 1); ++i) {
+			const int w = C.target(i);
+			if (row[w] < 0) {
+				row[w] = d;
+				queue[size++] = w;
+			}
+		}
+	}
+
+	double sum = 0;
+	for (int v = 0; v < n; ++v) {
+		row[v] *= row[v];
+		sum += row[v];
+	}
+	return sum;
+}
+
+}
 
 
 void PivotMDS::call(GraphAttributes& GA)
@@ -47,38 +260,53 @@ void PivotMDS::call(GraphAttributes& GA)
 }
 
 
-void PivotMDS::centerPivotmatrix(Array<Array<double> >& pivotMatrix)
+unsigned int PivotMDS::threadsFor(int n) const
+{
+	return max(1u, min(resolveNumberOfThreads(m_numberOfThreads), unsigned(n / MIN_NODES_PER_THREAD)));
+}
+
+
+void PivotMDS::centerPivotmatrix(Matrix& pivotMatrix, const Array<double>& rowMeans, unsigned int numberOfThreads)
 {
-	int numberOfPivots = pivotMatrix.size();
+	using pivot_mds::BLOCK_SIZE;
+
+	const int numberOfPivots = pivotMatrix.rows;
 	// this is ensured since the graph size is at least 2!
-	int nodeCount = pivotMatrix[0].size();
+	const int nodeCount = pivotMatrix.cols;
 
 	double normalizationFactor = 0;
-	double rowColNormalizer;
-	Array<double> colNormalization(numberOfPivots);
-
-	for (int i = 0; i < numberOfPivots; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < nodeCount; j++) {
-			rowColNormalizer += pivotMatrix[i][j] * pivotMatrix[i][j];
-		}
-		normalizationFactor += rowColNormalizer;
-		colNormalization[i] = rowColNormalizer / nodeCount;
+	for (double rowMean : rowMeans) {
+		normalizationFactor += rowMean;
 	}
-	normalizationFactor = normalizationFactor / (nodeCount * numberOfPivots);
-	for (int i = 0; i < nodeCount; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < numberOfPivots; j++) {
-			double square = pivotMatrix[j][i] * pivotMatrix[j][i];
-			pivotMatrix[j][i] = square + normalizationFactor
-					- colNormalization[j];
-			rowColNormalizer += square;
-		}
-		rowColNormalizer /= numberOfPivots;
-		for (int j = 0; j < numberOfPivots; j++) {
-			pivotMatrix[j][i] = FACTOR * (pivotMatrix[j][i] - rowColNormalizer);
+	normalizationFactor /= numberOfPivots;
+
+	// the columns are centered block by block, so that every block is swept
+	// once for the column means and once more, still cached, for the update
+	parallelFor(0, nodeCount, numberOfThreads, [&](int from, int to, unsigned int) {
+		double colMeans[BLOCK_SIZE];
+		for (int begin = from; begin < to; begin += BLOCK_SIZE) {
+			const int length = min(to - begin, BLOCK_SIZE);
+
+			std::fill(colMeans, colMeans + length, 0.0);
+			for (int i = 0; i < numberOfPivots; i++) {
+				const double *row = pivotMatrix.row(i) + begin;
+				for (int j = 0; j < length; j++) {
+					colMeans[j] += row[j];
+				}
+			}
+			for (int j = 0; j < length; j++) {
+				colMeans[j] /= numberOfPivots;
+			}
+
+			for (int i = 0; i < numberOfPivots; i++) {
+				double *row = pivotMatrix.row(i) + begin;
+				const double shift = normalizationFactor - rowMeans[i];
+				for (int j = 0; j < length; j++) {
+					row[j] = FACTOR * (row[j] + shift - colMeans[j]);
+				}
+			}
 		}
-	}
+	});
 }
 
 
@@ -109,34 +337,34 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 		doPathLayout(GA, head);
 	}
 	else {
-		Array<Array<double> > pivDistMatrix;
+		const unsigned int numberOfThreads = threadsFor(n);
+		Matrix pivDistMatrix;
+		Array<double> rowMeans;
 		// compute the pivot matrix
-		getPivotDistanceMatrix(GA, pivDistMatrix);
+		getPivotDistanceMatrix(GA, pivDistMatrix, rowMeans, numberOfThreads);
 		// center the pivot matrix
-		centerPivotmatrix(pivDistMatrix);
+		centerPivotmatrix(pivDistMatrix, rowMeans, numberOfThreads);
 		// init the coordinate matrix
-		Array<Array<double> > coord(m_dimensionCount);
-		for (auto &elem : coord) {
-			elem.init(n);
-		}
+		Matrix coord;
+		coord.init(m_dimensionCount, n);
 		// init the eigen values array
 		Array<double> eVals(m_dimensionCount);
-		singularValueDecomposition(pivDistMatrix, coord, eVals);
+		singularValueDecomposition(pivDistMatrix, coord, eVals, numberOfThreads);
 		// compute the correct aspect ratio
-		for (int i = 0; i < coord.size(); i++) {
+		for (int i = 0; i < coord.rows; i++) {
 			eVals[i] = sqrt(eVals[i]);
 			for (int j = 0; j < n; j++) {
-				coord[i][j] *= eVals[i];
+				coord.row(i)[j] *= eVals[i];
 			}
 		}
 		// set the new positions to the graph
 		int i = 0;
 		for (node v : G.nodes)
 		{
-			GA.x(v) = coord[0][i];
-			GA.y(v) = coord[1][i];
+			GA.x(v) = coord.row(0)[i];
+			GA.y(v) = coord.row(1)[i];
 			if (use3D){
-				GA.z(v) = coord[2][i];//std::cout << coord[2][i] << "\n";
+				GA.z(v) = coord.row(2)[i];
 			}
 			++i;
 		}
@@ -176,16 +404,17 @@ void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v)
 
 
 void PivotMDS::eigenValueDecomposition(
-	Array<Array<double> >& K,
-	Array<Array<double> >& eVecs,
+	const Matrix& K,
+	Matrix& eVecs,
 	Array<double>& eValues)
 {
 	randomize(eVecs);
-	const int p = K.size();
+	const int p = K.rows;
 	double r = 0;
 	for (int i = 0; i < m_dimensionCount; i++) {
-		eValues[i] = normalize(eVecs[i]);
+		eValues[i] = normalize(eVecs.row(i), p);
 	}
+	Matrix tmpOld;
 	while (r < EPSILON) {
 		if (std::isnan(r) || isinf(r)) {
 			// Throw arithmetic exception (Shouldn't occur
@@ -194,40 +423,33 @@ void PivotMDS::eigenValueDecomposition(
 			return;
 		}
 		// remember prev values
-		Array<Array<double> > tmpOld(m_dimensionCount);
-		for (int i = 0; i < m_dimensionCount; i++) {
-			tmpOld[i].init(p);
-			for (int j = 0; j < p; j++) {
-				tmpOld[i][j] = eVecs[i][j];
-				eVecs[i][j] = 0;
-			}
-		}
-		// multiply matrices
-		for (int i = 0; i < m_dimensionCount; i++) {
-			for (int j = 0; j < p; j++) {
-				for (int k = 0; k < p; k++) {
-					eVecs[i][k] += K[j][k] * tmpOld[i][j];
-				}
+		tmpOld = eVecs;
+		// multiply matrices, K is symmetric, so all vectors are multiplied
+		// by its contiguous rows in one sweep over K
+		for (int j = 0; j < p; j++) {
+			const double *row = K.row(j);
+			for (int i = 0; i < m_dimensionCount; i++) {
+				eVecs.row(i)[j] = prod(row, tmpOld.row(i), p);
 			}
 		}
 		// orthogonalize
 		for (int i = 0; i < m_dimensionCount; i++) {
 			for (int j = 0; j < i; j++) {
-				double fac = prod(eVecs[j], eVecs[i])
-						/ prod(eVecs[j], eVecs[j]);
+				double fac = prod(eVecs.row(j), eVecs.row(i), p)
+						/ prod(eVecs.row(j), eVecs.row(j), p);
 				for (int k = 0; k < p; k++) {
-					eVecs[i][k] -= fac * eVecs[j][k];
+					eVecs.row(i)[k] -= fac * eVecs.row(j)[k];
 				}
 			}
 		}
 		// normalize
 		for (int i = 0; i < m_dimensionCount; i++) {
-			eValues[i] = normalize(eVecs[i]);
+			eValues[i] = normalize(eVecs.row(i), p);
 		}
 		r = 1;
 		for (int i = 0; i < m_dimensionCount; i++) {
 			// get absolute value (abs only defined for int)
-			double tmp = prod(eVecs[i], tmpOld[i]);
+			double tmp = prod(eVecs.row(i), tmpOld.row(i), p);
 			if (tmp < 0) {
 				tmp *= -1;
 			}
@@ -239,66 +461,90 @@ void PivotMDS::eigenValueDecomposition(
 
 void PivotMDS::getPivotDistanceMatrix(
 	const GraphAttributes& GA,
-	Array<Array<double> >& pivDistMatrix)
+	Matrix& pivDistMatrix,
+	Array<double>& rowMeans,
+	unsigned int numberOfThreads)
 {
+	using namespace pivot_mds;
+
 	const Graph& G = GA.constGraph();
-	const int n = G.numberOfNodes();
+	const CompactGraph C(G);
+	const int n = C.numberOfNodes();
 
 	// lower the number of pivots if necessary
-	int numberOfPivots = min(n, m_numberOfPivots);
-	// number of pivots times n matrix used to store the graph distances
-	pivDistMatrix.init(numberOfPivots);
-	for (int i = 0; i < numberOfPivots; i++) {
-		pivDistMatrix[i].init(n);
-	}
-	// edges costs array
-	EdgeArray<double> edgeCosts;
-	bool hasEdgeCosts = false;
-	// already checked whether this attribute exists or not (see call method)
+	const int numberOfPivots = min(n, m_numberOfPivots);
+	// number of pivots times n matrix used to store the squared graph distances
+	pivDistMatrix.init(numberOfPivots, n);
+	rowMeans.init(0, numberOfPivots - 1, 0.0);
+	// edges costs array, already checked whether this attribute exists or not (see call method)
+	Array<double> edgeCosts;
 	if (m_hasEdgeCostsAttribute) {
-		edgeCosts.init(G);
-		for(edge e : G.edges)
-		{
-			edgeCosts[e] = GA.doubleWeight(e);
+		EdgeArray<double> costs(G);
+		for (edge e : G.edges) {
+			costs[e] = GA.doubleWeight(e);
 		}
-		hasEdgeCosts = true;
+		C.gatherEdges(costs, edgeCosts);
 	}
-	// used for min-max strategy
-	NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
-	NodeArray<double> shortestPathSingleSource(G);
-	// the current pivot node
-	node pivNode = G.firstNode();
+	const Array<double>* costs = m_hasEdgeCostsAttribute ? &edgeCosts : nullptr;
+
+	// Choose the pivots by the min-max strategy. The next pivot is the node farthest
+	// from all previous ones, so a search from a pivot only needs to update the nodes
+	// closer to it than the largest minimal distance. These balls shrink quickly, the
+	// complete rows of the matrix are computed afterwards.
+	Array<int> pivots(numberOfPivots);
+	Array<double> minDistances(0, n - 1, std::numeric_limits<double>::infinity());
+	BallSearch ball(n);
+	int pivot = 0;
+	double eccentricity = 0;
 	for (int i = 0; i < numberOfPivots; i++) {
-		// get the shortest path from the currently processed pivot node to
-		// all other nodes in the graph
-		shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
-		if (hasEdgeCosts) {
-			dijkstra_SPSS(pivNode, G, shortestPathSingleSource, edgeCosts);
-		} else {
-			bfs_SPSS(pivNode, G, shortestPathSingleSource, m_edgeCosts);
-		}
-		copySPSS(pivDistMatrix[i], shortestPathSingleSource);
-		// update the pivot and the minDistances array ... to ensure the
-		// correctness set minDistance of the pivot node to zero
-		minDistances[pivNode] = 0;
-		for(node v : G.nodes)
-		{
-			Math::updateMin(minDistances[v], shortestPathSingleSource[v]);
-			if (minDistances[v] > minDistances[pivNode]) {
-				pivNode = v;
+		pivots[i] = pivot;
+		searchBall(C, pivot, i, minDistances[pivot], costs, m_edgeCosts, minDistances, ball);
+		for (int v = 0; v < n; v++) {
+			if (minDistances[v] > minDistances[pivot]) {
+				pivot = v;
 			}
 		}
+		if (i == 0) {
+			eccentricity = minDistances[pivot];
+		}
 	}
-}
 
+	if (costs == nullptr && eccentricity <= MAX_BATCH_ECCENTRICITY * m_edgeCosts) {
+		const int numberOfBatches = (numberOfPivots + BATCH_SIZE - 1) / BATCH_SIZE;
+		parallelFor(0, numberOfBatches, min(numberOfThreads, unsigned(numberOfBatches)),
+				[&](int from, int to, unsigned int) {
+			BatchSearch state(n);
+			double *rows[BATCH_SIZE];
+			for (int batch = from; batch < to; batch++) {
+				const int first = batch * BATCH_SIZE;
+				const int count = min(BATCH_SIZE, numberOfPivots - first);
+				for (int b = 0; b < count; b++) {
+					rows[b] = pivDistMatrix.row(first + b);
+				}
+				bfsBatch(C, &pivots[first], count, m_edgeCosts, rows, &rowMeans[first], state);
+			}
+		});
+	} else {
+		parallelFor(0, numberOfPivots, numberOfThreads, [&](int from, int to, unsigned int) {
+			Array<int> queue(costs == nullptr ? n : 0);
+			Array<double> distance;
+			for (int i = from; i < to; i++) {
+				double *row = pivDistMatrix.row(i);
+				if (costs == nullptr) {
+					rowMeans[i] = bfsRow(C, pivots[i], m_edgeCosts, row, queue);
+				} else {
+					dijkstra_SPSS(pivots[i], C, distance, edgeCosts);
+					for (int v = 0; v < n; v++) {
+						row[v] = distance[v] * distance[v];
+						rowMeans[i] += row[v];
+					}
+				}
+			}
+		});
+	}
 
-void PivotMDS::copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom)
-{
-	const Graph &G = *copyFrom.graphOf();
-
-	int i = 0;
-	for (node v : G.nodes) {
-		copyTo[i++] = copyFrom[v];
+	for (double& rowMean : rowMeans) {
+		rowMean /= n;
 	}
 }
 
@@ -329,88 +575,161 @@ node PivotMDS::getRootedPath(const Graph& G)
 }
 
 
-double PivotMDS::normalize(Array<double>& x)
+double PivotMDS::normalize(double *x, int size)
 {
-	double norm = sqrt(prod(x, x));
+	double norm = sqrt(prod(x, x, size));
 	if (norm != 0) {
-		for (auto &elem : x) {
-			elem /= norm;
+		for (int i = 0; i < size; i++) {
+			x[i] /= norm;
 		}
 	}
 	return norm;
 }
 
 
-double PivotMDS::prod(const Array<double>& x, const Array<double>& y)
+double PivotMDS::prod(const double *x, const double *y, int size)
 {
-	double result = 0;
-	for (int i = 0; i < x.size(); i++) {
-		result += x[i] * y[i];
+	// independent partial sums let the products be computed in parallel
+	double sum[4] = {0, 0, 0, 0};
+	int i = 0;
+	for (; i + 4 <= size; i += 4) {
+		sum[0] += x[i] * y[i];
+		sum[1] += x[i + 1] * y[i + 1];
+		sum[2] += x[i + 2] * y[i + 2];
+		sum[3] += x[i + 3] * y[i + 3];
 	}
-	return result;
+	for (; i < size; i++) {
+		sum[0] += x[i] * y[i];
+	}
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
 }
 
 
-void PivotMDS::randomize(Array<Array<double> >& matrix)
+void PivotMDS::randomize(Matrix& matrix)
 {
 	srand(SEED);
-	for (auto &elem : matrix) {
-		for (int j = 0; j < elem.size(); j++) {
-			elem[j] = ((double) rand()) / RAND_MAX;
+	for (int i = 0; i < matrix.rows; i++) {
+		double *row = matrix.row(i);
+		for (int j = 0; j < matrix.cols; j++) {
+			row[j] = ((double) rand()) / RAND_MAX;
 		}
 	}
 }
 
 
-void PivotMDS::selfProduct(const Array<Array<double> >& d, Array<Array<double> >& result)
+void PivotMDS::selfProduct(const Matrix& d, Matrix& result, unsigned int numberOfThreads)
 {
-	double sum;
-	for (int i = 0; i < d.size(); i++) {
+	using pivot_mds::BLOCK_SIZE;
+
+	const int size = d.rows;
+	const int padded = (size + 3) / 4 * 4;
+
+	// Every thread sums the products over its range of columns. These are processed in
+	// blocks of BLOCK_SIZE columns, which are first packed into panels of four rows
+	// interleaved column by column (the storage of d is padded to whole panels). The
+	// product of two panels is then a sum of outer products of four-element vectors,
+	// accumulated in a 4 x 4 tile of the result.
+	std::vector<Matrix> partial(numberOfThreads);
+	parallelFor(0, d.cols, numberOfThreads, [&](int from, int to, unsigned int t) {
+		Matrix& sum = partial[t];
+		sum.init(padded, padded);
+		std::vector<double> panels(size_t(padded) * BLOCK_SIZE);
+
+		for (int begin = from; begin < to; begin += BLOCK_SIZE) {
+			const int length = min(to - begin, BLOCK_SIZE);
+
+			for (int i = 0; i < padded; i += 4) {
+				double *panel = &panels[size_t(i) * length];
+				for (int u = 0; u < 4; u++) {
+					const double *row = d.row(i + u) + begin;
+					for (int k = 0; k < length; k++) {
+						panel[4 * k + u] = row[k];
+					}
+				}
+			}
+
+			for (int i = 0; i < padded; i += 4) {
+				const double *a = &panels[size_t(i) * length];
+				for (int j = 0; j <= i; j += 4) {
+					const double *b = &panels[size_t(j) * length];
+
+					double tile[4][4] = {};
+					for (int k = 0; k < length; k++) {
+						for (int u = 0; u < 4; u++) {
+							for (int v = 0; v < 4; v++) {
+								tile[u][v] += a[4 * k + u] * b[4 * k + v];
+							}
+						}
+					}
+
+					for (int u = 0; u < 4; u++) {
+						for (int v = 0; v < 4; v++) {
+							sum.row(i + u)[j + v] += tile[u][v];
+						}
+					}
+				}
+			}
+		}
+	});
+
+	result.init(size, size);
+	for (int i = 0; i < size; i++) {
 		for (int j = 0; j <= i; j++) {
-			sum = 0;
-			for (int k = 0; k < d[0].size(); k++) {
-				sum += d[i][k] * d[j][k];
+			double sum = 0;
+			for (const Matrix& part : partial) {
+				sum += part.row(i)[j];
 			}
-			result[i][j] = sum;
-			result[j][i] = sum;
+			result.row(i)[j] = sum;
+			result.row(j)[i] = sum;
 		}
 	}
 }
 
 
 void PivotMDS::singularValueDecomposition(
-	Array<Array<double> >& pivDistMatrix,
-	Array<Array<double> >& eVecs,
-	Array<double>& eVals)
+	const Matrix& pivDistMatrix,
+	Matrix& eVecs,
+	Array<double>& eVals,
+	unsigned int numberOfThreads)
 {
-	const int size = pivDistMatrix.size();
-	const int n = pivDistMatrix[0].size();
-	Array<Array<double> > K(size);
-	for (int i = 0; i < size; i++) {
-		K[i].init(size);
-	}
+	using pivot_mds::BLOCK_SIZE;
+
+	const int size = pivDistMatrix.rows;
+	const int n = pivDistMatrix.cols;
+	Matrix K;
 	// calc C^TC
-	selfProduct(pivDistMatrix, K);
+	selfProduct(pivDistMatrix, K, numberOfThreads);
 
-	Array<Array<double> > tmp(m_dimensionCount);
-	for (int i = 0; i < m_dimensionCount; i++) {
-		tmp[i].init(size);
-	}
+	Matrix tmp;
+	tmp.init(m_dimensionCount, size);
 
 	eigenValueDecomposition(K, tmp, eVals);
 
-	// C^Tx
 	for (int i = 0; i < m_dimensionCount; i++) {
 		eVals[i] = sqrt(eVals[i]);
-		for (int j = 0; j < n; j++) { // node j
-			eVecs[i][j] = 0;
+	}
+
+	// C^Tx, for one block of nodes after another
+	parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int begin = from; begin < to; begin += BLOCK_SIZE) {
+			const int end = min(to, begin + BLOCK_SIZE);
+			for (int i = 0; i < m_dimensionCount; i++) {
+				std::fill(eVecs.row(i) + begin, eVecs.row(i) + end, 0.0);
+			}
 			for (int k = 0; k < size; k++) { // pivot k
-				eVecs[i][j] += pivDistMatrix[k][j] * tmp[i][k];
+				const double *row = pivDistMatrix.row(k);
+				for (int i = 0; i < m_dimensionCount; i++) {
+					const double factor = tmp.row(i)[k];
+					double *eVec = eVecs.row(i);
+					for (int j = begin; j < end; j++) { // node j
+						eVec[j] += row[j] * factor;
+					}
+				}
 			}
 		}
-	}
+	});
 	for (int i = 0; i < m_dimensionCount; i++) {
-		normalize(eVecs[i]);
+		normalize(eVecs.row(i), n);
 	}
 }
 
@@ -39,6 +39,8 @@
 #include <ogdf/basic/Thread.h>
 #include <ogdf/fileformats/GraphIO.h>
 
+#include <algorithm>
+
 using std::minstd_rand;
 using std::uniform_real_distribution;
 using ogdf::Math::updateMax;
@@ -48,7 +50,9 @@ namespace ogdf {
 
 class SpringEmbedderGridVariant::Master : public spring_embedder::MasterBase<NodeInfo, ForceModelBase> {
 	Array<Worker*> m_worker;
-	Array2D<ListPure<int>> m_gridCell;
+	Grid m_grid;
+	Array<int> m_cellCount; //!< the number of nodes of each thread in each cell, thread by thread
+	Array<int> m_rangeCount; //!< the number of nodes in the range of cells of each thread
 
 	double m_k2;
 
@@ -64,10 +68,13 @@ public:
 	double ymin() const { return m_ymin; }
 
 	double boxLength() const { return m_k2; }
-	Array2D<ListPure<int>> &gridCell() { return m_gridCell; }
+	Grid &grid() { return m_grid; }
+	Array<int> &cellCount() { return m_cellCount; }
+	Array<int> &rangeCount() { return m_rangeCount; }
+	unsigned int numberOfThreads() const { return m_worker.size(); }
 
 	void initialize(double wsum, double hsum, double xmin, double xmax, double ymin, double ymax);
-	void updateGridAndMoveNodes();
+	void updateBoundingBox();
 	void scaleLayout(double sumLengths);
 	void computeFinalBB();
 };
@@ -78,9 +85,16 @@ class SpringEmbedderGridVariant::Worker : spring_embedder::WorkerBase<Master, No
 private:
 	int m_eStartIndex;
 
+	int m_entryBegin; //!< the first grid entry of the tile of this thread
+	int m_entryEnd; //!< the entry after the last one of the tile of this thread
+
+	//! Sorts the nodes by their cells together with the other threads and determines the tile of this thread.
+	void updateGrid();
+
 public:
 	Worker(unsigned int id, Master &master, int vStartIndex, int vStopIndex, node vStart, node vStop, int eStartIndex)
-		: WorkerBase(id, master, vStartIndex, vStopIndex, vStart, vStop), m_eStartIndex(eStartIndex) {}
+		: WorkerBase(id, master, vStartIndex, vStopIndex, vStart, vStop), m_eStartIndex(eStartIndex)
+		, m_entryBegin(0), m_entryEnd(0) {}
 	void operator()() override;
 };
 
@@ -122,7 +136,7 @@ SpringEmbedderGridVariant::Master::Master(const SpringEmbedderGridVariant &sprin
 		startNode [nThreads] = nullptr;
 		startIndex[nThreads] = gc.numberOfNodes();
 
-		m_barrier = new Barrier(nThreads);
+		m_barrier = new EpochBarrier(nThreads);
 		Array<Thread> thread(nThreads-1);
 
 		for(unsigned int i = 1; i < nThreads; ++i) {
@@ -244,67 +258,59 @@ void SpringEmbedderGridVariant::Master::initialize(double wsum, double hsum, dou
 
 	switch(m_spring.forceModel()) {
 	case SpringForceModel::FruchtermanReingold:
-		m_forceModel = new ForceModelFR(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelFR(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::FruchtermanReingoldModAttr:
-		m_forceModel = new ForceModelFRModAttr(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelFRModAttr(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::FruchtermanReingoldModRep:
-		m_forceModel = new ForceModelFRModRep(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelFRModRep(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Eades:
-		m_forceModel = new ForceModelEades(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelEades(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Hachul:
-		m_forceModel = new ForceModelHachul(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelHachul(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Gronemann:
-		m_forceModel = new ForceModelGronemann(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModel = new ForceModelGronemann(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	}
 
 	switch(m_spring.forceModelImprove()) {
 	case SpringForceModel::FruchtermanReingold:
-		m_forceModelImprove = new ForceModelFR(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelFR(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::FruchtermanReingoldModAttr:
-		m_forceModelImprove = new ForceModelFRModAttr(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelFRModAttr(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::FruchtermanReingoldModRep:
-		m_forceModelImprove = new ForceModelFRModRep(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelFRModRep(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Eades:
-		m_forceModelImprove = new ForceModelEades(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelEades(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Hachul:
-		m_forceModelImprove = new ForceModelHachul(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelHachul(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	case SpringForceModel::Gronemann:
-		m_forceModelImprove = new ForceModelGronemann(m_vInfo, m_adjLists, m_gridCell, m_idealEdgeLength);
+		m_forceModelImprove = new ForceModelGronemann(m_vInfo, m_adjLists, m_grid, m_idealEdgeLength);
 		break;
 	}
 
-	// build grid cells
-	int xA = int(width / m_k2 + 2);
-	int yA = int(height / m_k2 + 2);
-	m_gridCell.init(-1,xA,-1,yA);
-
-	for(int j = 0; j < n; ++j) {
-		NodeInfo &vj = m_vInfo[j];
+	// allocate grid cells, the workers fill them
+	m_grid.m_highX = int(width / m_k2 + 2);
+	m_grid.m_highY = int(height / m_k2 + 2);
+	m_grid.m_cellStart.init(m_grid.numberOfCells() + 1);
+	m_grid.m_node.init(n);
+	m_grid.m_x.init(n);
+	m_grid.m_y.init(n);
 
-		vj.m_gridX = int((vj.m_pos.m_x - m_xmin ) / m_k2);
-		vj.m_gridY = int((vj.m_pos.m_y - m_ymin) / m_k2);
-
-		OGDF_ASSERT(vj.m_gridX < xA);
-		OGDF_ASSERT(vj.m_gridX > -1);
-		OGDF_ASSERT(vj.m_gridY < yA);
-		OGDF_ASSERT(vj.m_gridY > -1);
-
-		m_vInfo[j].m_lit = m_gridCell(vj.m_gridX,vj.m_gridY).pushFront(j);
-	}
+	m_cellCount.init(m_worker.size() * m_grid.numberOfCells());
+	m_rangeCount.init(m_worker.size());
 }
 
-void SpringEmbedderGridVariant::Master::updateGridAndMoveNodes() {
+void SpringEmbedderGridVariant::Master::updateBoundingBox() {
 	const Worker &worker = *m_worker[0];
 
 	double xmin = worker.m_xmin;
@@ -325,8 +331,8 @@ void SpringEmbedderGridVariant::Master::updateGridAndMoveNodes() {
 
 	m_avgDisplacement = sumForces / numberOfNodes();
 
-	const int xA = m_gridCell.high1();
-	const int yA = m_gridCell.high2();
+	const int xA = m_grid.m_highX;
+	const int yA = m_grid.m_highY;
 
 	// prevent drawing area from getting too small
 	double hMargin = 0.5 * max(0.0, m_idealEdgeLength * xA - (xmax-xmin));
@@ -339,30 +345,6 @@ void SpringEmbedderGridVariant::Master::updateGridAndMoveNodes() {
 	m_ymax = ymax + vMargin;
 
 	m_k2 = max( (m_xmax-m_xmin) / (xA-1), (m_ymax-m_ymin) / (yA-1) );
-
-	// move nodes
-	for(int j = 0; j <= m_vInfo.high(); ++j) {
-		NodeInfo &vj = m_vInfo[j];
-
-		// new position
-		vj.m_pos += m_disp[j];
-
-		// new cell
-		int grid_x = int((vj.m_pos.m_x - m_xmin ) / m_k2);
-		int grid_y = int((vj.m_pos.m_y - m_ymin) / m_k2);
-
-		OGDF_ASSERT(grid_x >= 0);
-		OGDF_ASSERT(grid_x < m_gridCell.high1());
-		OGDF_ASSERT(grid_y >= 0);
-		OGDF_ASSERT(grid_y < m_gridCell.high2());
-
-		// move to different cell?
-		if( (grid_x != vj.m_gridX) || (grid_y != vj.m_gridY) ) {
-			m_gridCell(vj.m_gridX,vj.m_gridY).moveToFront(vj.m_lit, m_gridCell(grid_x,grid_y));
-			vj.m_gridX = grid_x;
-			vj.m_gridY = grid_y;
-		}
-	}
 }
 
 void SpringEmbedderGridVariant::Master::computeFinalBB() {
@@ -399,13 +381,96 @@ void SpringEmbedderGridVariant::Master::scaleLayout(double sumLengths) {
 	m_ymin *= m_scaleFactor;
 	m_ymax *= m_scaleFactor;
 
-	m_k2 = max( (m_xmax-m_xmin) / (m_gridCell.high1()-1), (m_ymax-m_ymin) / (m_gridCell.high2()-1) );
+	m_k2 = max( (m_xmax-m_xmin) / (m_grid.m_highX-1), (m_ymax-m_ymin) / (m_grid.m_highY-1) );
 }
 
 void SpringEmbedderGridVariant::callMaster(const GraphCopy& copy, GraphAttributes& attr, DPoint& box) {
 	Master(*this, copy, attr, box);
 }
 
+void SpringEmbedderGridVariant::Worker::updateGrid() {
+	Grid &grid = m_master.grid();
+	Array<NodeInfo> &vInfo = m_master.vInfo();
+	Array<int> &cellCount = m_master.cellCount();
+	Array<int> &rangeCount = m_master.rangeCount();
+
+	const int n = m_master.numberOfNodes();
+	const int numThreads = int(m_master.numberOfThreads());
+	const int numCells = grid.numberOfCells();
+	const double xmin = m_master.xmin();
+	const double ymin = m_master.ymin();
+	const double boxLength = m_master.boxLength();
+
+	// count the nodes of this thread in each cell
+	int *count = &cellCount[m_id * numCells];
+	std::fill(count, count + numCells, 0);
+
+	for(int j = m_vStartIndex; j < m_vStopIndex; ++j) {
+		NodeInfo &vj = vInfo[j];
+
+		vj.m_gridX = int((vj.m_pos.m_x - xmin) / boxLength);
+		vj.m_gridY = int((vj.m_pos.m_y - ymin) / boxLength);
+
+		OGDF_ASSERT(vj.m_gridX >= 0);
+		OGDF_ASSERT(vj.m_gridX < grid.m_highX);
+		OGDF_ASSERT(vj.m_gridY >= 0);
+		OGDF_ASSERT(vj.m_gridY < grid.m_highY);
+
+		++count[grid.cell(vj.m_gridX, vj.m_gridY)];
+	}
+
+	m_master.syncThreads();
+
+	// prefix sums within the range of cells of this thread, a cell holds the nodes of thread 0 first
+	const int cellBegin = int((long long)numCells * m_id / numThreads);
+	const int cellEnd = int((long long)numCells * (m_id + 1) / numThreads);
+
+	int sum = 0;
+	for(int c = cellBegin; c < cellEnd; ++c) {
+		for(int t = 0; t < numThreads; ++t) {
+			int &countTC = cellCount[t * numCells + c];
+			const int countC = countTC;
+			countTC = sum;
+			sum += countC;
+		}
+	}
+	rangeCount[m_id] = sum;
+
+	m_master.syncThreads();
+
+	// shift them by the nodes in the ranges before
+	int offset = 0;
+	for(unsigned int t = 0; t < m_id; ++t)
+		offset += rangeCount[t];
+
+	for(int c = cellBegin; c < cellEnd; ++c) {
+		for(int t = 0; t < numThreads; ++t)
+			cellCount[t * numCells + c] += offset;
+		grid.m_cellStart[c] = cellCount[c];
+	}
+	if(m_id == unsigned(numThreads - 1))
+		grid.m_cellStart[numCells] = n;
+
+	m_master.syncThreads();
+
+	// move the nodes of this thread into place
+	for(int j = m_vStartIndex; j < m_vStopIndex; ++j) {
+		const NodeInfo &vj = vInfo[j];
+		const int entry = count[grid.cell(vj.m_gridX, vj.m_gridY)]++;
+
+		grid.m_node[entry] = j;
+		grid.m_x[entry] = float(vj.m_pos.m_x);
+		grid.m_y[entry] = float(vj.m_pos.m_y);
+	}
+
+	// the tile of this thread consists of whole cells with about n / numThreads nodes
+	const int *cellStart = grid.m_cellStart.begin();
+	m_entryBegin = *std::lower_bound(cellStart, cellStart + numCells + 1, int((long long)n * m_id / numThreads));
+	m_entryEnd = *std::lower_bound(cellStart, cellStart + numCells + 1, int((long long)n * (m_id + 1) / numThreads));
+
+	m_master.syncThreads();
+}
+
 void SpringEmbedderGridVariant::Worker::operator()() {
 	const double forceScaleFactor = 0.1; //0.05;
 
@@ -455,10 +520,13 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 
 	m_master.syncThreads();
 
+	updateGrid();
+
 	// Main step
 
 	const bool noise = m_master.noise();
 	Array<DPoint> &disp = m_master.disp();
+	const Array<int> &gridNode = m_master.grid().m_node;
 
 	// random number generator for adding noise
 	minstd_rand rng(randomSeed());
@@ -481,7 +549,8 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 		double t = m_master.maxForceLength();
 		double f = m_master.coolingFactor() * forceScaleFactor;
 
-		for(int j = m_vStartIndex; j < m_vStopIndex; ++j) {
+		for(int k = m_entryBegin; k < m_entryEnd; ++k) {
+			const int j = gridNode[k];
 			NodeInfo &vj = vInfo[j];
 
 			DPoint dp = forceModel.computeDisplacement(j, boxLength);
@@ -520,11 +589,17 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 		m_master.syncThreads();
 
 		if(m_id == 0) {
-			m_master.updateGridAndMoveNodes();
+			m_master.updateBoundingBox();
 			m_master.coolDown();
 		}
 
+		// move nodes
+		for(int j = m_vStartIndex; j < m_vStopIndex; ++j)
+			vInfo[j].m_pos += disp[j];
+
 		m_master.syncThreads();
+
+		updateGrid();
 	}
 
 
@@ -535,6 +610,8 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 		// scaling to ideal edge length
 		scaling(vInfo,adjLists);
 
+		updateGrid();
+
 		const ForceModelBase &forceModelImprove = m_master.forceModelImprove();
 
 		for(int iter = 1; !m_master.hasConverged() && iter <= numIterImp; ++iter) {
@@ -549,7 +626,8 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 			double t = m_master.maxForceLength();
 			double f = m_master.coolingFactor() * forceScaleFactor;
 
-			for(int j = m_vStartIndex; j < m_vStopIndex; ++j) {
+			for(int k = m_entryBegin; k < m_entryEnd; ++k) {
+				const int j = gridNode[k];
 				NodeInfo &vj = vInfo[j];
 
 				DPoint dp = forceModelImprove.computeDisplacement(j, boxLength);
@@ -595,12 +673,22 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 					vj.m_pos += disp[j];
 				}
 
-			} else if(m_id == 0) {
-				m_master.updateGridAndMoveNodes();
-				m_master.coolDown();
-			}
+				m_master.syncThreads();
 
-			m_master.syncThreads();
+			} else {
+				if(m_id == 0) {
+					m_master.updateBoundingBox();
+					m_master.coolDown();
+				}
+
+				// move nodes
+				for(int j = m_vStartIndex; j < m_vStopIndex; ++j)
+					vInfo[j].m_pos += disp[j];
+
+				m_master.syncThreads();
+
+				updateGrid();
+			}
 		}
 	}
 
@@ -42,8 +42,7 @@ void SpringEmbedderKK::initialize(
 	GraphAttributes& GA,
 	NodeArray<dpair>& partialDer,
 	const EdgeArray<double>& eLength,
-	NodeArray< NodeArray<double> >& oLength,
-	NodeArray< NodeArray<double> >& sstrength,
+	DistanceMatrix& distances,
 	bool simpleBFS)
 {
 	double maxDist;
@@ -56,38 +55,21 @@ void SpringEmbedderKK::initialize(
 	if (!m_useLayout)
 		shufflePositions(GA);
 
-	//the shortest path lengths
-	for(node v : G.nodes)
-		oLength[v].init(G, std::numeric_limits<double>::max());
-
 	//computes shortest path distances d_ij
 	if (simpleBFS)
 	{
 		//we use simply BFS n times
-		//TODO experimentally compare speed, also with bintree dijkstra
-#if 0
-#ifdef OGDF_DEBUG
-		double timeUsed;
-		usedTime(timeUsed);
-#endif
-#endif
-		maxDist = allpairsspBFS(G, oLength);
-
-#if 0
-#ifdef OGDF_DEBUG
-		timeUsed = usedTime(timeUsed);
-		std::cout << "\n******APSP BFS runtime: \n";
-#endif
-#endif
+		distances.computeHops(G);
 	}
 	else
 	{
 		EdgeArray<double> adaptedLength(G);
 		adaptLengths(G, GA, eLength, adaptedLength);
-		//we use simply the BFM n times or Floyd instead, leading to cubic runtime
-		//TODO experimentally compare speed, also with bintree dijkstra
-		maxDist = allpairssp(G, adaptedLength, oLength, std::numeric_limits<double>::max());
+		//we use Dijkstra n times
+		distances.compute(G, adaptedLength);
 	}
+	distances.setUnreachableDistance(std::numeric_limits<double>::max());
+	maxDist = distances.maxDistance();
 	//computes original spring length l_ij
 
 	//first we determine desirable edge length L
@@ -137,34 +119,14 @@ void SpringEmbedderKK::initialize(
 #endif
 #endif
 	}
-	// Having L we can compute the original lengths l_ij
-	// Computes spring strengths k_ij
-	double dij;
-	for(node v : G.nodes)
-	{
-		sstrength[v].init(G);
-		for(node w : G.nodes)
-		{
-			dij = oLength[v][w];
-			if (dij == std::numeric_limits<double>::max())
-			{
-				sstrength[v][w] = minVal;
-			}
-			else
-			{
-				oLength[v][w] = L * dij;
-				if (v==w) sstrength[v][w] = 1.0;
-				else
-				sstrength[v][w] = m_K / (dij * dij);
-			}
-		}
-	}
+	// Having L, the original lengths l_ij and the spring strengths k_ij
+	// follow from the distances, see spring()
+	m_L = L;
 }
 
 void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 								NodeArray<dpair>& partialDer,
-								NodeArray< NodeArray<double> >& oLength,
-								NodeArray< NodeArray<double> >& sstrength)
+								const DistanceMatrix& distances)
 {
 	const Graph &G = GA.constGraph();
 
@@ -179,7 +141,7 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 	// Compute the partial derivatives first
 	for(node v : G.nodes)
 	{
-		dpair parder = computeParDers(v, GA, sstrength, oLength);
+		dpair parder = computeParDers(v, GA, distances);
 		partialDer[v] = parder;
 		//delta_m is sqrt of squares of partial derivatives
 		double delta_v = sqrt(parder.x1()*parder.x1() + parder.x2()*parder.x2());
@@ -215,7 +177,7 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 		NodeArray<dpair> p_partials(G);
 		for(node v : G.nodes)
 		{
-			p_partials[v] = computeParDer(v, best_m, GA, sstrength, oLength);
+			p_partials[v] = computeParDer(v, best_m, GA, distances);
 		}
 
 		localItCount = 0;
@@ -230,8 +192,8 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 					double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
 					double dist3 = dist * dist * dist;
 					OGDF_ASSERT(dist3 != 0.0);
-					double k_mi = sstrength[best_m][v];
-					double l_mi = oLength[best_m][v];
+					double k_mi, l_mi;
+					spring(best_m, v, distances, k_mi, l_mi);
 					dE_dx_dx += k_mi * (1 - (l_mi * y_diff * y_diff)/dist3);
 					dE_dx_dy += k_mi * l_mi * x_diff * y_diff / dist3;
 					dE_dy_dx += k_mi * l_mi * x_diff * y_diff / dist3;
@@ -256,7 +218,7 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 			GA.y(best_m) += delta_y;
 
 			// Recompute partial derivatives and delta_p
-			dpair deriv = computeParDers(best_m, GA, sstrength, oLength);
+			dpair deriv = computeParDers(best_m, GA, distances);
 			partialDer[best_m] = deriv;
 
 			delta_m =
@@ -269,7 +231,7 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA,
 		{
 			dpair old_deriv_p = p_partials[v];
 			dpair old_p_partial =
-				computeParDer(v, old_p, GA, sstrength, oLength);
+				computeParDer(v, old_p, GA, distances);
 			dpair deriv = partialDer[v];
 
 			deriv.x1() += old_p_partial.x1() - old_deriv_p.x1();
@@ -290,17 +252,16 @@ void SpringEmbedderKK::doCall(GraphAttributes& GA, const EdgeArray<double>& eLen
 {
 	const Graph& G = GA.constGraph();
 	NodeArray<dpair> partialDer(G); //stores the partial derivative per node
-	NodeArray< NodeArray<double> > oLength(G);//first distance, then original length
-	NodeArray< NodeArray<double> > sstrength(G);//the spring strength
+	DistanceMatrix distances;//the graph theoretic distances
 
 	//only for debugging
 	OGDF_ASSERT(isConnected(G));
 
 	//compute relevant values
-	initialize(GA, partialDer, eLength, oLength, sstrength, simpleBFS);
+	initialize(GA, partialDer, eLength, distances, simpleBFS);
 
 	//main loop with node movement
-	mainStep(GA, partialDer, oLength, sstrength);
+	mainStep(GA, partialDer, distances);
 
 	if (simpleBFS) scale(GA);
 }
@@ -364,8 +325,7 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
 	node m,
 	node u,
 	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
+	const DistanceMatrix& distances)
 {
 	dpair result(0.0, 0.0);
 	if (m != u)
@@ -373,8 +333,10 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
 		double x_diff = GA.x(m) - GA.x(u);
 		double y_diff = GA.y(m) - GA.y(u);
 		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
-		result.x1() = (ss[m][u]) * (x_diff - (dist[m][u])*x_diff/distance);
-		result.x2() = (ss[m][u]) * (y_diff - (dist[m][u])*y_diff/distance);
+		double ss, dist;
+		spring(m, u, distances, ss, dist);
+		result.x1() = ss * (x_diff - dist*x_diff/distance);
+		result.x2() = ss * (y_diff - dist*y_diff/distance);
 	}
 
 	return result;
@@ -384,13 +346,12 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
 //compute partial derivative for v
 SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v,
 	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
+	const DistanceMatrix& distances)
 {
 	dpair result(0.0, 0.0);
 	for(node u : GA.constGraph().nodes)
 	{
-		dpair deriv = computeParDer(v, u, GA, ss, dist);
+		dpair deriv = computeParDer(v, u, GA, distances);
 		result.x1() += deriv.x1();
 		result.x2() += deriv.x2();
 	}
@@ -399,137 +360,6 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v,
 }
 
 
-/**
- * Initialise the original estimates from nodes and edges.
- */
-
-//we could speed this up by not using nested NodeArrays and
-//by not doing the fully symmetrical computation on undirected graphs
-//All Pairs Shortest Path Floyd, initializes the whole matrix
-//returns maximum distance. Does not detect negative cycles (lead to neg. values on diagonal)
-//threshold is the value for the distance of non-adjacent nodes, distance has to be
-//initialized with
-double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLengths, NodeArray< NodeArray<double> >& distance,
-	const double threshold)
-{
-	double maxDist = -threshold;
-
-	for(node v : G.nodes)
-	{
-		distance[v][v] = 0.0;
-	}
-
-	//TODO: Experimentally compare this against
-	// all nodes and incident edges (memory access) on huge graphs
-	for(edge e : G.edges)
-	{
-		distance[e->source()][e->target()] = eLengths[e];
-		distance[e->target()][e->source()] = eLengths[e];
-	}
-
-///**
-// * And run the main loop of the algorithm.
-// */
-	for(node v : G.nodes)
-	{
-		for(node u : G.nodes)
-		{
-			for(node w : G.nodes)
-			{
-				if ((distance[u][v] < threshold) && (distance[v][w] < threshold))
-				{
-					Math::updateMin(distance[u][w], distance[u][v] + distance[v][w]);
-#if 0
-					distance[w][u] = distance[u][w]; //is done anyway afterwards
-#endif
-				}
-				if (distance[u][w] < threshold)
-					Math::updateMax(maxDist, distance[u][w]);
-			}
-		}
-	}
-#if 0
-#ifdef OGDF_DEBUG
-	for(node v : G.nodes)
-	{
-		if (distance[v][v] < 0.0) std::cerr << "\n###Error in shortest path computation###\n\n";
-	}
-	std::cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-#if 0
-		std::cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-#endif
-	}
-	}
-#endif
-#endif
-	return maxDist;
-}
-
-//the same without weights, i.e. all pairs shortest paths with BFS
-//Runs in time |V|²
-//for compatibility, distances are double
-double SpringEmbedderKK::allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance)
-{
-	double maxDist = 0;
-
-	for(node v : G.nodes)
-	{
-		distance[v][v] = 0.0;
-	}
-
-	//start in each node once
-	for(node v: G.nodes)
-	{
-		//do a bfs
-		NodeArray<bool> mark(G, true);
-		SListPure<node> bfs;
-		bfs.pushBack(v);
-		mark[v] = false;
-
-		while (!bfs.empty())
-		{
-			node w = bfs.popFrontRet();
-			double d = distance[v][w]+1.0f;
-
-
-			for(adjEntry adj : w->adjEntries) {
-				node u = adj->twinNode();
-				if (mark[u])
-				{
-					mark[u] = false;
-					bfs.pushBack(u);
-					distance[v][u] = d;
-					Math::updateMax(maxDist, d);
-				}
-			}
-		}
-	}
-	//check for negative cycles
-	for(node v : G.nodes)
-	{
-		if (distance[v][v] < 0.0)
-			std::cerr << "\n###Error in shortest path computation###\n\n";
-	}
-
-#if 0
-#ifdef OGDF_DEBUG
-	std::cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-		std::cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-	}
-	}
-#endif
-#endif
-	return maxDist;
-}
-
 void SpringEmbedderKK::scale(GraphAttributes& GA)
 {
 	//Simple version: Just scale to max needed
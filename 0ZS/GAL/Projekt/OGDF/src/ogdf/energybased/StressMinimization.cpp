@@ -31,6 +31,11 @@
  */
 
 #include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+
+#include <algorithm>
+#include <queue>
 
 
 namespace ogdf {
@@ -39,6 +44,8 @@ const double StressMinimization::EPSILON = 10e-4;
 
 const int StressMinimization::DEFAULT_NUMBER_OF_PIVOTS = 50;
 
+const int StressMinimization::DEFAULT_NUMBER_OF_SPARSE_PIVOTS = 200;
+
 
 void StressMinimization::call(GraphAttributes& GA)
 {
@@ -55,44 +62,47 @@ void StressMinimization::call(GraphAttributes& GA)
 	}
 	// Separate component layout cant be applied to a non-connected graph
 	OGDF_ASSERT(!m_componentLayout || isConnected(G));
-	NodeArray<NodeArray<double> > shortestPathMatrix(G);
-	NodeArray<NodeArray<double> > weightMatrix(G);
-	initMatrices(G, shortestPathMatrix, weightMatrix);
+	if (m_sparse) {
+		callSparse(GA);
+		return;
+	}
+	DistanceMatrix distances;
 	// if the edge costs are defined by the attribute copy it to an array and
 	// construct the proper shortest path matrix
 	if (m_hasEdgeCostsAttribute) {
 		OGDF_ASSERT(GA.has(GraphAttributes::edgeDoubleWeight));
-		m_avgEdgeCosts = dijkstra_SPAP(GA, shortestPathMatrix);
+		EdgeArray<double> edgeCosts(G);
+		double totalCosts = 0;
+		for (edge e : G.edges) {
+			edgeCosts[e] = GA.doubleWeight(e);
+			totalCosts += edgeCosts[e];
+		}
+		m_avgEdgeCosts = totalCosts / G.numberOfEdges();
 		// compute shortest path all pairs
+		distances.compute(G, edgeCosts);
 	} else {
 		m_avgEdgeCosts = m_edgeCosts;
-		bfs_SPAP(G, shortestPathMatrix, m_edgeCosts);
+		distances.computeHops(G, m_edgeCosts);
 	}
-	call(GA, shortestPathMatrix, weightMatrix);
+	call(GA, distances);
 }
 
 
-void StressMinimization::call(
-	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+void StressMinimization::call(GraphAttributes& GA, DistanceMatrix& distances)
 {
 	// compute the initial layout if necessary
 	if (!m_hasInitialLayout) {
 		computeInitialLayout(GA);
 	}
 	const Graph& G = GA.constGraph();
-	// replace infinity distances by sqrt(n) and compute weights.
+	// replace infinity distances by sqrt(n).
 	// Note isConnected is only true during calls triggered by the
 	// ComponentSplitterLayout.
 	if (!m_componentLayout && !isConnected(G)) {
-		replaceInfinityDistances(shortestPathMatrix,
-				m_avgEdgeCosts * sqrt((double)(G.numberOfNodes())));
+		distances.setUnreachableDistance(m_avgEdgeCosts * sqrt((double)(G.numberOfNodes())));
 	}
-	// calculate the weights
-	calcWeights(G, shortestPathMatrix, weightMatrix);
 	// minimize the stress
-	minimizeStress(GA, shortestPathMatrix, weightMatrix);
+	minimizeStress(GA, distances);
 }
 
 
@@ -102,6 +112,7 @@ void StressMinimization::computeInitialLayout(GraphAttributes& GA)
 	pivMDS->setNumberOfPivots(DEFAULT_NUMBER_OF_PIVOTS);
 	pivMDS->useEdgeCostsAttribute(m_hasEdgeCostsAttribute);
 	pivMDS->setEdgeCosts(m_edgeCosts);
+	pivMDS->setNumberOfThreads(m_numberOfThreads);
 	if (!m_componentLayout) {
 		// the graph might be disconnected therefore we need
 		// the component layouter
@@ -116,47 +127,17 @@ void StressMinimization::computeInitialLayout(GraphAttributes& GA)
 }
 
 
-void StressMinimization::replaceInfinityDistances(
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	double newVal)
-{
-	const Graph &G = *shortestPathMatrix.graphOf();
-
-	for(node v : G.nodes) {
-		for(node w : G.nodes) {
-			if (v != w && isinf(shortestPathMatrix[v][w])) {
-				shortestPathMatrix[v][w] = newVal;
-			}
-		}
-	}
-}
-
-
-void StressMinimization::calcWeights(
-	const Graph& G,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
-{
-	for (node v : G.nodes) {
-		for (node w : G.nodes) {
-			if (v != w) {
-				// w_ij = d_ij^-2
-				weightMatrix[v][w] = 1
-					/ (shortestPathMatrix[v][w] * shortestPathMatrix[v][w]);
-			}
-		}
-	}
-}
-
-
 double StressMinimization::calcStress(
 	const GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	const DistanceMatrix& distances)
 {
+	const CompactGraph& C = distances.graph();
+	const int n = C.numberOfNodes();
 	double stress = 0;
-	for (node v = GA.constGraph().firstNode(); v != nullptr; v = v->succ()) {
-		for (node w = v->succ(); w != nullptr; w = w->succ()) {
+	for (int i = 0; i < n; ++i) {
+		node v = C.toNode(i);
+		for (int j = i + 1; j < n; ++j) {
+			node w = C.toNode(j);
 			double xDiff = GA.x(v) - GA.x(w);
 			double yDiff = GA.y(v) - GA.y(w);
 			double zDiff = 0.0;
@@ -166,8 +147,9 @@ double StressMinimization::calcStress(
 			}
 			double dist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
 			if (dist != 0) {
-				stress += weightMatrix[v][w] * (shortestPathMatrix[v][w] - dist)
-					* (shortestPathMatrix[v][w] - dist);//
+				// w_ij = d_ij^-2
+				double desDistance = distances(i, j);
+				stress += (desDistance - dist) * (desDistance - dist) / (desDistance * desDistance);
 			}
 		}
 	}
@@ -207,8 +189,7 @@ void StressMinimization::copyLayout(
 
 void StressMinimization::minimizeStress(
 	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	const DistanceMatrix& distances)
 {
 	const Graph& G = GA.constGraph();
 	int numberOfPerformedIterations = 0;
@@ -217,7 +198,7 @@ void StressMinimization::minimizeStress(
 	double curStress = std::numeric_limits<double>::max();
 
 	if (m_terminationCriterion == TerminationCriterion::Stress) {
-		curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+		curStress = calcStress(GA, distances);
 	}
 
 	NodeArray<double> newX;
@@ -236,47 +217,49 @@ void StressMinimization::minimizeStress(
 				copyLayout(GA, newX, newY, newZ);
 			else copyLayout(GA, newX, newY);
 		}
-		nextIteration(GA, shortestPathMatrix, weightMatrix);
+		nextIteration(GA, distances);
 		if (m_terminationCriterion == TerminationCriterion::Stress) {
 			prevStress = curStress;
-			curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+			curStress = calcStress(GA, distances);
 		}
 	} while (!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress));
 
 	Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
-		<< "\tStress:\t" << calcStress(GA, shortestPathMatrix, weightMatrix) << std::endl;
+		<< "\tStress:\t" << calcStress(GA, distances) << std::endl;
 }
 
 
 void StressMinimization::nextIteration(
 	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weights)
+	const DistanceMatrix& distances)
 {
-	const Graph& G = GA.constGraph();
+	const CompactGraph& C = distances.graph();
+	const int n = C.numberOfNodes();
 
-	for (node v : G.nodes)
+	for (int i = 0; i < n; ++i)
 	{
+		node v = C.toNode(i);
 		double newXCoord = 0.0;
 		double newYCoord = 0.0;
 		double newZCoord = 0.0;
 		double& currXCoord = GA.x(v);
 		double& currYCoord = GA.y(v);
 		double totalWeight = 0;
-		for (node w : G.nodes)
+		for (int j = 0; j < n; ++j)
 		{
-			if (v == w) {
+			if (i == j) {
 				continue;
 			}
+			node w = C.toNode(j);
 			// calculate euclidean distance between both points
 			double xDiff = currXCoord - GA.x(w);
 			double yDiff = currYCoord - GA.y(w);
 			double zDiff = (GA.has(GraphAttributes::threeD)) ? GA.z(v) - GA.z(w) : 0.0;
 			double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
-			// get the weight
-			double weight = weights[v][w];
 			// get the desired distance
-			double desDistance = shortestPathMatrix[v][w];
+			double desDistance = distances(i, j);
+			// get the weight w_ij = d_ij^-2
+			double weight = 1 / (desDistance * desDistance);
 			// reset the voted x coordinate
 			// if x is not fixed
 			if (!m_fixXCoords) {
@@ -364,17 +347,441 @@ bool StressMinimization::finished(
 }
 
 
-void StressMinimization::initMatrices(const Graph& G,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+namespace sparse_stress {
+
+//! The terms of the sparse stress model, indexed by the dense node ids of a CompactGraph.
+struct Model {
+	int n = 0; //!< The number of nodes.
+	int k = 0; //!< The number of pivots.
+	Array<int> pivots; //!< The pivots.
+
+	Array<int> offset; //!< The first neighborhood term of each node (plus a sentinel).
+	std::vector<int> target; //!< The other node of each neighborhood term.
+	std::vector<double> distance; //!< The graph theoretic distance of each neighborhood term.
+
+	std::vector<double> pivotDistance; //!< The distance of every node to every pivot (row per node).
+	std::vector<double> pivotWeight; //!< The weight of every node's pivot term, 0 for no term (row per node).
+};
+
+//! Computes the distances from \p s in \p C, unreachable nodes get infinity.
+static void singleSource(const CompactGraph& C, int s, const Array<double>* costs, double edgeCosts, Array<double>& distance)
 {
-	// init shortest path matrix by infinity distances
-	for (node v : G.nodes)
-	{
-		shortestPathMatrix[v].init(G, std::numeric_limits<double>::infinity());
-		shortestPathMatrix[v][v] = 0;
-		weightMatrix[v].init(G, 0);
+	if (costs != nullptr) {
+		dijkstra_SPSS(s, C, distance, *costs);
+	} else {
+		bfs_SPSS(s, C, distance, edgeCosts);
+	}
+	for (double& d : distance) {
+		if (d == std::numeric_limits<double>::max()) {
+			d = std::numeric_limits<double>::infinity();
+		}
+	}
+}
+
+//! The per-thread state of the neighborhood searches.
+struct Ball {
+	Array<int> mark; //!< The last source that reached each node.
+	Array<int> hops; //!< The hop distance of each node from the source.
+	Array<double> distance; //!< The distance of each node from the source.
+	Array<int> nodes; //!< The nodes of the ball, in BFS order.
+	int size = 0; //!< The number of nodes of the ball.
+
+	explicit Ball(int n) : mark(0, n - 1, -1), hops(n), distance(n), nodes(n) { }
+
+	//! Collects the nodes within \p radius hops of \p s and their distances from \p s.
+	void search(const CompactGraph& C, int s, int radius, const Array<double>* costs, double edgeCosts) {
+		size = 0;
+		nodes[size++] = s;
+		mark[s] = s;
+		hops[s] = 0;
+		distance[s] = 0;
+
+		for (int head = 0; head < size; ++head) {
+			const int v = nodes[head];
+			if (hops[v] == radius) {
+				continue;
+			}
+			for (int i = C.offset(v); i < C.offset(v + 1); ++i) {
+				const int w = C.target(i);
+				if (mark[w] != s) {
+					mark[w] = s;
+					hops[w] = hops[v] + 1;
+					distance[w] = hops[w] * edgeCosts;
+					nodes[size++] = w;
+				}
+			}
+		}
+
+		if (costs != nullptr) {
+			dijkstra(C, s, *costs);
+		}
+	}
+
+private:
+	//! Computes the distances from \p s within the subgraph induced by the ball.
+	void dijkstra(const CompactGraph& C, int s, const Array<double>& costs) {
+		using Entry = std::pair<double, int>;
+		for (int j = 0; j < size; ++j) {
+			distance[nodes[j]] = std::numeric_limits<double>::infinity();
+		}
+
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		distance[s] = 0;
+		queue.push(Entry(0.0, s));
+		while (!queue.empty()) {
+			const Entry top = queue.top();
+			queue.pop();
+			if (top.first > distance[top.second]) {
+				continue;
+			}
+			for (int i = C.offset(top.second); i < C.offset(top.second + 1); ++i) {
+				const int w = C.target(i);
+				const double d = top.first + costs[C.edgeOf(i)];
+				if (mark[w] == s && d < distance[w]) {
+					distance[w] = d;
+					queue.push(Entry(d, w));
+				}
+			}
+		}
+	}
+};
+
+/**
+ * Builds the sparse stress model of \p C.
+ *
+ * @param costs are the dense edge costs, or nullptr for uniform costs \p edgeCosts.
+ * @param unreachable is the distance used for nodes in different components, or infinity
+ *                    if these pairs should not attract each other.
+ */
+static void buildModel(const CompactGraph& C, const Array<double>* costs, double edgeCosts,
+		int numberOfPivots, int radius, double unreachable, unsigned int numberOfThreads, Model& model)
+{
+	const int n = C.numberOfNodes();
+	const int k = min(n, numberOfPivots);
+	model.n = n;
+	model.k = k;
+	model.pivots.init(k);
+
+	// choose the pivots by the max-min strategy, like PivotMDS, and keep their distances
+	std::vector<double> fromPivot(size_t(k) * n);
+	Array<double> minDistance(0, n - 1, std::numeric_limits<double>::infinity());
+	Array<double> distance;
+	int pivot = 0;
+	for (int p = 0; p < k; ++p) {
+		model.pivots[p] = pivot;
+		singleSource(C, pivot, costs, edgeCosts, distance);
+		std::copy(distance.begin(), distance.end(), fromPivot.begin() + size_t(p) * n);
+
+		minDistance[pivot] = 0;
+		for (int v = 0; v < n; ++v) {
+			Math::updateMin(minDistance[v], distance[v]);
+			if (minDistance[v] > minDistance[pivot]) {
+				pivot = v;
+			}
+		}
+	}
+
+	// every node belongs to the region of its closest pivot
+	Array<std::vector<double>> region(k);
+	for (int v = 0; v < n; ++v) {
+		int closest = -1;
+		for (int p = 0; p < k; ++p) {
+			if (fromPivot[size_t(p) * n + v] < std::numeric_limits<double>::infinity()
+			 && (closest < 0 || fromPivot[size_t(p) * n + v] < fromPivot[size_t(closest) * n + v])) {
+				closest = p;
+			}
+		}
+		if (closest >= 0) {
+			region[closest].push_back(fromPivot[size_t(closest) * n + v]);
+		}
+	}
+	for (auto& distances : region) {
+		std::sort(distances.begin(), distances.end());
+	}
+
+	model.pivotDistance.assign(size_t(n) * k, 0.0);
+	model.pivotWeight.assign(size_t(n) * k, 0.0);
+	model.offset.init(n + 1);
+
+	// the neighborhoods of the nodes are searched in parallel, each thread keeps the
+	// terms of its contiguous range of nodes
+	Array<std::vector<int>> targets(static_cast<int>(numberOfThreads));
+	Array<std::vector<double>> distances(static_cast<int>(numberOfThreads));
+
+	parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int t) {
+		Ball ball(n);
+		for (int v = from; v < to; ++v) {
+			ball.search(C, v, radius, costs, edgeCosts);
+
+			int terms = 0;
+			for (int j = 1; j < ball.size; ++j) {
+				const int w = ball.nodes[j];
+				if (ball.distance[w] > 0) {
+					targets[t].push_back(w);
+					distances[t].push_back(ball.distance[w]);
+					++terms;
+				}
+			}
+			model.offset[v] = terms;
+
+			// a pivot stands for the nodes of its region that are closer to it than to v
+			double* pivotDistance = &model.pivotDistance[size_t(v) * k];
+			double* pivotWeight = &model.pivotWeight[size_t(v) * k];
+			for (int p = 0; p < k; ++p) {
+				const int u = model.pivots[p];
+				double d = fromPivot[size_t(p) * n + v];
+				if (ball.mark[u] == v) {
+					continue;
+				}
+
+				double represented;
+				if (d == std::numeric_limits<double>::infinity()) {
+					d = unreachable;
+					represented = double(region[p].size());
+				} else {
+					represented = double(std::upper_bound(region[p].begin(), region[p].end(), d / 2) - region[p].begin());
+				}
+
+				if (d < std::numeric_limits<double>::infinity()) {
+					pivotDistance[p] = d;
+					pivotWeight[p] = represented / (d * d);
+				}
+			}
+		}
+	});
+
+	// turn the numbers of terms into offsets and concatenate the terms of the threads
+	int sum = 0;
+	for (int v = 0; v < n; ++v) {
+		const int terms = model.offset[v];
+		model.offset[v] = sum;
+		sum += terms;
+	}
+	model.offset[n] = sum;
+
+	model.target.clear();
+	model.distance.clear();
+	model.target.reserve(sum);
+	model.distance.reserve(sum);
+	for (unsigned int t = 0; t < numberOfThreads; ++t) {
+		model.target.insert(model.target.end(), targets[t].begin(), targets[t].end());
+		model.distance.insert(model.distance.end(), distances[t].begin(), distances[t].end());
+	}
+}
+
+//! The coordinates of all nodes in separate arrays, indexed by dense node ids.
+struct Coordinates {
+	Array<double> x, y, z;
+
+	void init(int n, bool use3D) {
+		x.init(n);
+		y.init(n);
+		z.init(use3D ? n : 0);
+	}
+};
+
+//! Computes the new position of every node in [\p from, \p to) from the positions \p cur into \p next.
+static void updateRange(const Model& model, const Coordinates& cur, const Coordinates& pivotCur,
+		Coordinates& next, bool use3D, const bool fixed[3], int from, int to)
+{
+	const int k = model.k;
+
+	for (int v = from; v < to; ++v) {
+		const double xv = cur.x[v], yv = cur.y[v], zv = use3D ? cur.z[v] : 0.0;
+		double totalWeight = 0, newX = 0, newY = 0, newZ = 0;
+
+		// the votes of the neighbors: w_vu * (p_u + d_vu * (p_v - p_u) / |p_v - p_u|)
+		for (int i = model.offset[v]; i < model.offset[v + 1]; ++i) {
+			const int u = model.target[i];
+			const double d = model.distance[i];
+			const double weight = 1 / (d * d);
+			const double xDiff = xv - cur.x[u], yDiff = yv - cur.y[u], zDiff = use3D ? zv - cur.z[u] : 0.0;
+			const double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+			const double scale = euclideanDist != 0 ? d / euclideanDist : 0.0;
+
+			newX += weight * (cur.x[u] + scale * xDiff);
+			newY += weight * (cur.y[u] + scale * yDiff);
+			if (use3D) {
+				newZ += weight * (cur.z[u] + scale * zDiff);
+			}
+			totalWeight += weight;
+		}
+
+		// the votes of the pivots, the coordinates of the pivots are contiguous
+		const double* pivotDistance = &model.pivotDistance[size_t(v) * k];
+		const double* pivotWeight = &model.pivotWeight[size_t(v) * k];
+		for (int p = 0; p < k; ++p) {
+			const double xDiff = xv - pivotCur.x[p], yDiff = yv - pivotCur.y[p], zDiff = use3D ? zv - pivotCur.z[p] : 0.0;
+			const double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+			const double scale = euclideanDist != 0 ? pivotDistance[p] / euclideanDist : 0.0;
+
+			newX += pivotWeight[p] * (pivotCur.x[p] + scale * xDiff);
+			newY += pivotWeight[p] * (pivotCur.y[p] + scale * yDiff);
+			if (use3D) {
+				newZ += pivotWeight[p] * (pivotCur.z[p] + scale * zDiff);
+			}
+			totalWeight += pivotWeight[p];
+		}
+
+		next.x[v] = fixed[0] || totalWeight == 0 ? xv : newX / totalWeight;
+		next.y[v] = fixed[1] || totalWeight == 0 ? yv : newY / totalWeight;
+		if (use3D) {
+			next.z[v] = fixed[2] || totalWeight == 0 ? zv : newZ / totalWeight;
+		}
+	}
+}
+
+//! Returns the sparse stress of the nodes in [\p from, \p to).
+static double stressOfRange(const Model& model, const Coordinates& cur, const Coordinates& pivotCur,
+		bool use3D, int from, int to)
+{
+	const int k = model.k;
+	double stress = 0;
+
+	for (int v = from; v < to; ++v) {
+		const double xv = cur.x[v], yv = cur.y[v], zv = use3D ? cur.z[v] : 0.0;
+
+		for (int i = model.offset[v]; i < model.offset[v + 1]; ++i) {
+			const int u = model.target[i];
+			const double d = model.distance[i];
+			const double xDiff = xv - cur.x[u], yDiff = yv - cur.y[u], zDiff = use3D ? zv - cur.z[u] : 0.0;
+			const double diff = d - sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+			stress += diff * diff / (d * d);
+		}
+
+		const double* pivotDistance = &model.pivotDistance[size_t(v) * k];
+		const double* pivotWeight = &model.pivotWeight[size_t(v) * k];
+		for (int p = 0; p < k; ++p) {
+			const double xDiff = xv - pivotCur.x[p], yDiff = yv - pivotCur.y[p], zDiff = use3D ? zv - pivotCur.z[p] : 0.0;
+			const double diff = pivotDistance[p] - sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+			stress += pivotWeight[p] * diff * diff;
+		}
+	}
+
+	return stress;
+}
+
+}
+
+
+void StressMinimization::callSparse(GraphAttributes& GA)
+{
+	using namespace sparse_stress;
+
+	const Graph& G = GA.constGraph();
+	const CompactGraph C(G);
+	const int n = C.numberOfNodes();
+	const bool use3D = GA.has(GraphAttributes::threeD);
+
+	Array<double> costs;
+	if (m_hasEdgeCostsAttribute) {
+		OGDF_ASSERT(GA.has(GraphAttributes::edgeDoubleWeight));
+		EdgeArray<double> edgeCosts(G);
+		double totalCosts = 0;
+		for (edge e : G.edges) {
+			edgeCosts[e] = GA.doubleWeight(e);
+			totalCosts += edgeCosts[e];
+		}
+		m_avgEdgeCosts = totalCosts / G.numberOfEdges();
+		C.gatherEdges(edgeCosts, costs);
+	} else {
+		m_avgEdgeCosts = m_edgeCosts;
 	}
+
+	if (!m_hasInitialLayout) {
+		computeInitialLayout(GA);
+	}
+
+	const unsigned int numberOfThreads = max(1u, min(resolveNumberOfThreads(m_numberOfThreads), unsigned(n / 64)));
+
+	// as in the full model, nodes of different components get the distance avgEdgeCosts * sqrt(n)
+	const double unreachable = m_componentLayout || isConnected(G)
+		? std::numeric_limits<double>::infinity() : m_avgEdgeCosts * sqrt(double(n));
+
+	Model model;
+	buildModel(C, m_hasEdgeCostsAttribute ? &costs : nullptr, m_edgeCosts,
+		m_sparseNumberOfPivots, m_sparseRadius, unreachable, numberOfThreads, model);
+
+	Coordinates cur, next, pivotCur;
+	cur.init(n, use3D);
+	next.init(n, use3D);
+	pivotCur.init(model.k, use3D);
+	for (int v = 0; v < n; ++v) {
+		cur.x[v] = GA.x(C.toNode(v));
+		cur.y[v] = GA.y(C.toNode(v));
+		if (use3D) {
+			cur.z[v] = GA.z(C.toNode(v));
+		}
+	}
+
+	const bool fixed[3] = {m_fixXCoords, m_fixYCoords, m_fixZCoords};
+	Array<double> partialStress(0, numberOfThreads - 1, 0.0);
+
+	auto gatherPivots = [&] {
+		for (int p = 0; p < model.k; ++p) {
+			pivotCur.x[p] = cur.x[model.pivots[p]];
+			pivotCur.y[p] = cur.y[model.pivots[p]];
+			if (use3D) {
+				pivotCur.z[p] = cur.z[model.pivots[p]];
+			}
+		}
+	};
+
+	auto calcSparseStress = [&] {
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int t) {
+			partialStress[t] = stressOfRange(model, cur, pivotCur, use3D, from, to);
+		});
+		double stress = 0;
+		for (double s : partialStress) {
+			stress += s;
+		}
+		return stress;
+	};
+
+	int numberOfPerformedIterations = 0;
+	double prevStress = std::numeric_limits<double>::max();
+	double curStress = std::numeric_limits<double>::max();
+
+	gatherPivots();
+	if (m_terminationCriterion == TerminationCriterion::Stress) {
+		curStress = calcSparseStress();
+	}
+
+	NodeArray<double> newX;
+	NodeArray<double> newY;
+	if (m_terminationCriterion == TerminationCriterion::PositionDifference) {
+		newX.init(G);
+		newY.init(G);
+	}
+
+	do {
+		if (m_terminationCriterion == TerminationCriterion::PositionDifference) {
+			copyLayout(GA, newX, newY);
+		}
+
+		// all nodes move at once, based on the previous positions
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			updateRange(model, cur, pivotCur, next, use3D, fixed, from, to);
+		});
+		std::swap(cur, next);
+		gatherPivots();
+
+		for (int v = 0; v < n; ++v) {
+			GA.x(C.toNode(v)) = cur.x[v];
+			GA.y(C.toNode(v)) = cur.y[v];
+			if (use3D) {
+				GA.z(C.toNode(v)) = cur.z[v];
+			}
+		}
+
+		if (m_terminationCriterion == TerminationCriterion::Stress) {
+			prevStress = curStress;
+			curStress = calcSparseStress();
+		}
+	} while (!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress));
+
+	Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
+		<< "\tSparse stress:\t" << calcSparseStress() << std::endl;
 }
 
 }
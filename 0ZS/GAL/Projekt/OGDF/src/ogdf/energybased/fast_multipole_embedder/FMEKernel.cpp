@@ -32,6 +32,10 @@
 #include <ogdf/energybased/fast_multipole_embedder/FMEKernel.h>
 #include <ogdf/energybased/fast_multipole_embedder/ComplexDouble.h>
 
+#ifdef OGDF_FME_KERNEL_USE_AVX
+#include <immintrin.h>
+#endif
+
 using namespace ogdf::sse;
 
 namespace ogdf {
@@ -395,6 +399,216 @@ void eval_direct_fast(float* x1, float* y1, float* s1, float* fx1, float* fy1, s
 }
 #endif
 
+#if defined(OGDF_FME_KERNEL_USE_AVX) && !defined(OGDF_FME_KERNEL_USE_SSE_DIRECT)
+
+// The AVX kernels compute the same forces as eval_direct(): the outer loop runs
+// over the points of the first set, the inner loop handles 8 (AVX2) or 16 (AVX-512)
+// points of the second set at once. The points of a leaf are not aligned to the
+// vector width, hence the loads are unaligned and the remainder of the inner loop
+// is done by a scalar (AVX2) or masked (AVX-512) iteration.
+
+//! minimal number of points in the inner loop for using the vectorized kernels
+static const size_t AVX_MIN_INNER_POINTS = 8;
+
+OGDF_FME_TARGET_AVX2
+static inline float hsum_avx2(__m256 v)
+{
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	sum = _mm_hadd_ps(sum, sum);
+	sum = _mm_hadd_ps(sum, sum);
+	return _mm_cvtss_f32(sum);
+}
+
+//! adds the forces between point i and the points [begin, end) of the second set
+OGDF_FME_TARGET_AVX2
+static inline void eval_direct_row_avx2(float xi, float yi, float si, float& fxi, float& fyi,
+                                        const float* x, const float* y, const float* s, float* fx, float* fy,
+                                        size_t begin, size_t end)
+{
+	const __m256 factor = _mm256_set1_ps(OGDF_FME_KERNEL_COMPUTE_FORCE_PROTECTION_FACTOR);
+	const __m256 x_i = _mm256_set1_ps(xi);
+	const __m256 y_i = _mm256_set1_ps(yi);
+	const __m256 s_i = _mm256_set1_ps(si);
+	__m256 fx_sum = _mm256_setzero_ps();
+	__m256 fy_sum = _mm256_setzero_ps();
+
+	size_t j = begin;
+	for (; j + 8 <= end; j += 8) {
+		__m256 dx = _mm256_sub_ps(x_i, _mm256_loadu_ps(x + j));
+		__m256 dy = _mm256_sub_ps(y_i, _mm256_loadu_ps(y + j));
+#ifdef OGDF_FME_KERNEL_USE_OLD
+		__m256 s_sum = _mm256_add_ps(s_i, _mm256_loadu_ps(s + j));
+#else
+		__m256 s_sum = _mm256_mul_ps(s_i, _mm256_loadu_ps(s + j));
+#endif
+		__m256 dsq = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+		__m256 f = _mm256_div_ps(s_sum, _mm256_max_ps(_mm256_mul_ps(s_sum, factor), dsq));
+		__m256 fx_j = _mm256_mul_ps(dx, f);
+		__m256 fy_j = _mm256_mul_ps(dy, f);
+		fx_sum = _mm256_add_ps(fx_sum, fx_j);
+		fy_sum = _mm256_add_ps(fy_sum, fy_j);
+		_mm256_storeu_ps(fx + j, _mm256_sub_ps(_mm256_loadu_ps(fx + j), fx_j));
+		_mm256_storeu_ps(fy + j, _mm256_sub_ps(_mm256_loadu_ps(fy + j), fy_j));
+	}
+
+	float fx_i = hsum_avx2(fx_sum);
+	float fy_i = hsum_avx2(fy_sum);
+	for (; j < end; j++) {
+		float dx = xi - x[j];
+		float dy = yi - y[j];
+#ifdef OGDF_FME_KERNEL_USE_OLD
+		float s_sum = si + s[j];
+#else
+		float s_sum = si * s[j];
+#endif
+		float f = OGDF_FME_KERNEL_COMPUTE_FORCE(dx, dy, s_sum);
+		fx_i += dx*f;
+		fy_i += dy*f;
+		fx[j] -= dx*f;
+		fy[j] -= dy*f;
+	}
+	fxi += fx_i;
+	fyi += fy_i;
+}
+
+OGDF_FME_TARGET_AVX2
+void eval_direct_avx2(float* x, float* y, float* s, float* fx, float* fy, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		eval_direct_row_avx2(x[i], y[i], s[i], fx[i], fy[i], x, y, s, fx, fy, i + 1, n);
+	}
+}
+
+OGDF_FME_TARGET_AVX2
+void eval_direct_avx2(float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
+                             float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2)
+{
+	for (size_t i = 0; i < n1; i++) {
+		eval_direct_row_avx2(x1[i], y1[i], s1[i], fx1[i], fy1[i], x2, y2, s2, fx2, fy2, 0, n2);
+	}
+}
+
+// The unmasked forms of some AVX-512 intrinsics pass an undefined vector as the
+// source of the masked-off lanes, which GCC reports as possibly uninitialized. The
+// AVX-512 kernel therefore uses the zero-masking forms with the lanes it needs.
+
+OGDF_FME_TARGET_AVX512
+static inline float hsum_avx512(__m512 v)
+{
+	const __m512d vd = _mm512_castps_pd(v);
+	const __m256 low = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(__mmask8(0xff), vd, 0));
+	const __m256 high = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(__mmask8(0xff), vd, 1));
+	return hsum_avx2(_mm256_add_ps(low, high));
+}
+
+//! adds the forces between point i and the points [begin, end) of the second set
+OGDF_FME_TARGET_AVX512
+static inline void eval_direct_row_avx512(float xi, float yi, float si, float& fxi, float& fyi,
+                                          const float* x, const float* y, const float* s, float* fx, float* fy,
+                                          size_t begin, size_t end)
+{
+	const __m512 factor = _mm512_set1_ps(OGDF_FME_KERNEL_COMPUTE_FORCE_PROTECTION_FACTOR);
+	const __m512 x_i = _mm512_set1_ps(xi);
+	const __m512 y_i = _mm512_set1_ps(yi);
+	const __m512 s_i = _mm512_set1_ps(si);
+	__m512 fx_sum = _mm512_setzero_ps();
+	__m512 fy_sum = _mm512_setzero_ps();
+
+	for (size_t j = begin; j < end; j += 16) {
+		// the last iteration only handles the remaining points
+		const __mmask16 mask = end - j >= 16 ? __mmask16(0xffff) : __mmask16((1u << (end - j)) - 1);
+		__m512 dx = _mm512_sub_ps(x_i, _mm512_maskz_loadu_ps(mask, x + j));
+		__m512 dy = _mm512_sub_ps(y_i, _mm512_maskz_loadu_ps(mask, y + j));
+#ifdef OGDF_FME_KERNEL_USE_OLD
+		__m512 s_sum = _mm512_add_ps(s_i, _mm512_maskz_loadu_ps(mask, s + j));
+#else
+		__m512 s_sum = _mm512_mul_ps(s_i, _mm512_maskz_loadu_ps(mask, s + j));
+#endif
+		__m512 dsq = _mm512_fmadd_ps(dx, dx, _mm512_mul_ps(dy, dy));
+		__m512 f = _mm512_div_ps(s_sum, _mm512_maskz_max_ps(mask, _mm512_mul_ps(s_sum, factor), dsq));
+		__m512 fx_j = _mm512_maskz_mul_ps(mask, dx, f);
+		__m512 fy_j = _mm512_maskz_mul_ps(mask, dy, f);
+		fx_sum = _mm512_add_ps(fx_sum, fx_j);
+		fy_sum = _mm512_add_ps(fy_sum, fy_j);
+		_mm512_mask_storeu_ps(fx + j, mask, _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, fx + j), fx_j));
+		_mm512_mask_storeu_ps(fy + j, mask, _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, fy + j), fy_j));
+	}
+
+	fxi += hsum_avx512(fx_sum);
+	fyi += hsum_avx512(fy_sum);
+}
+
+OGDF_FME_TARGET_AVX512
+void eval_direct_avx512(float* x, float* y, float* s, float* fx, float* fy, size_t n)
+{
+	for (size_t i = 0; i < n; i++) {
+		eval_direct_row_avx512(x[i], y[i], s[i], fx[i], fy[i], x, y, s, fx, fy, i + 1, n);
+	}
+}
+
+OGDF_FME_TARGET_AVX512
+void eval_direct_avx512(float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
+                               float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2)
+{
+	for (size_t i = 0; i < n1; i++) {
+		eval_direct_row_avx512(x1[i], y1[i], s1[i], fx1[i], fy1[i], x2, y2, s2, fx2, fy2, 0, n2);
+	}
+}
+
+//! the direct interaction kernels for one instruction set
+struct DirectKernels
+{
+	void (*self)(float*, float*, float*, float*, float*, size_t);
+	void (*pair)(float*, float*, float*, float*, float*, size_t,
+	             float*, float*, float*, float*, float*, size_t);
+};
+
+//! returns the fastest kernels supported by the CPU
+static DirectKernels chooseDirectKernels()
+{
+	DirectKernels kernels;
+	if (System::cpuSupports(CPUFeature::AVX512F)) {
+		kernels.self = eval_direct_avx512;
+		kernels.pair = eval_direct_avx512;
+	} else if (System::cpuSupports(CPUFeature::AVX2) && System::cpuSupports(CPUFeature::FMA)) {
+		kernels.self = eval_direct_avx2;
+		kernels.pair = eval_direct_avx2;
+	} else {
+		kernels.self = eval_direct;
+		kernels.pair = eval_direct;
+	}
+	return kernels;
+}
+
+static const DirectKernels& directKernels()
+{
+	static const DirectKernels kernels = chooseDirectKernels();
+	return kernels;
+}
+
+void eval_direct_fast(float* x, float* y, float* s, float* fx, float* fy, size_t n)
+{
+	if (n > AVX_MIN_INNER_POINTS) {
+		directKernels().self(x, y, s, fx, fy, n);
+	} else {
+		eval_direct(x, y, s, fx, fy, n);
+	}
+}
+
+void eval_direct_fast(float* x1, float* y1, float* s1, float* fx1, float* fy1, size_t n1,
+                      float* x2, float* y2, float* s2, float* fx2, float* fy2, size_t n2)
+{
+	// the forces are symmetric, so the larger set is handled by the vectorized inner loop
+	if (n1 > n2) {
+		eval_direct_fast(x2, y2, s2, fx2, fy2, n2, x1, y1, s1, fx1, fy1, n1);
+	} else if (n2 >= AVX_MIN_INNER_POINTS) {
+		directKernels().pair(x1, y1, s1, fx1, fy1, n1, x2, y2, s2, fx2, fy2, n2);
+	} else {
+		eval_direct(x1, y1, s1, fx1, fy1, n1, x2, y2, s2, fx2, fy2, n2);
+	}
+}
+#endif
+
 
 #if 0
 template<typename T>
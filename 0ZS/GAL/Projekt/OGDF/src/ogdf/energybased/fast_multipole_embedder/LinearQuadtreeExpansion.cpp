@@ -33,18 +33,162 @@
 #include <ogdf/energybased/fast_multipole_embedder/ComplexDouble.h>
 #include <ogdf/energybased/fast_multipole_embedder/WSPD.h>
 
+#ifdef OGDF_FME_KERNEL_USE_AVX
+#include <immintrin.h>
+#endif
+
 using namespace ogdf::sse;
 
 namespace ogdf {
 namespace fast_multipole_embedder {
 
+#ifdef OGDF_FME_KERNEL_USE_AVX
+
+// The AVX2 kernels handle the coefficients a_k, a_k+1 of an expansion as a packed
+// pair of complex numbers (re_k, im_k, re_k+1, im_k+1). Powers of complex numbers
+// are advanced by two per step, an odd number of coefficients ends with a masked
+// load of the last one.
+
+//! multiplies two packed pairs of complex numbers
+OGDF_FME_TARGET_AVX2
+static inline __m256d cmul_avx2(__m256d a, __m256d b)
+{
+	__m256d a_re = _mm256_movedup_pd(a);
+	__m256d a_im = _mm256_permute_pd(a, 0xf);
+	__m256d b_swapped = _mm256_permute_pd(b, 0x5);
+	return _mm256_fmaddsub_pd(a_re, b, _mm256_mul_pd(a_im, b_swapped));
+}
+
+//! returns the packed pair (z, z^2)
+OGDF_FME_TARGET_AVX2
+static inline __m256d first_powers_avx2(double re, double im)
+{
+	return _mm256_setr_pd(re, im, re*re - im*im, 2*re*im);
+}
+
+//! loads the coefficient pair starting at \p ptr, or only the first one if it is the last coefficient
+OGDF_FME_TARGET_AVX2
+static inline __m256d load_coeff_avx2(const double* ptr, bool onlyFirst)
+{
+	return onlyFirst ? _mm256_maskload_pd(ptr, _mm256_setr_epi64x(-1, -1, 0, 0)) : _mm256_loadu_pd(ptr);
+}
+
+//! adds the high and the low complex number of a packed pair
+OGDF_FME_TARGET_AVX2
+static inline void hsum_avx2(__m256d v, double& re, double& im)
+{
+	double res[2];
+	_mm_storeu_pd(res, _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+	re = res[0];
+	im = res[1];
+}
+
+//! P2M for a point at offset (dx, dy) from the center with charge q
+OGDF_FME_TARGET_AVX2
+static void p2m_avx2(double* coeff, uint32_t numCoeff, double dx, double dy, double q)
+{
+	const __m256d delta2 = _mm256_setr_pd(dx*dx - dy*dy, 2*dx*dy, dx*dx - dy*dy, 2*dx*dy);
+	// (delta^k, delta^k+1)
+	__m256d delta_k = first_powers_avx2(dx, dy);
+	for (uint32_t k = 1; k < numCoeff; k += 2)
+	{
+		const bool last = k + 1 == numCoeff;
+		const double q0 = q/(double)k;
+		const double q1 = q/(double)(k + 1);
+		__m256d ak = load_coeff_avx2(coeff + (k << 1), last);
+		ak = _mm256_fnmadd_pd(delta_k, _mm256_setr_pd(q0, q0, q1, q1), ak);
+		if (last) {
+			_mm256_maskstore_pd(coeff + (k << 1), _mm256_setr_epi64x(-1, -1, 0, 0), ak);
+		} else {
+			_mm256_storeu_pd(coeff + (k << 1), ak);
+		}
+		delta_k = cmul_avx2(delta_k, delta2);
+	}
+}
+
+//! L2P for a point at offset (dx, dy) from the center, returns the force
+OGDF_FME_TARGET_AVX2
+static void l2p_avx2(const double* coeff, uint32_t numCoeff, double dx, double dy, double& fx, double& fy)
+{
+	const __m256d delta2 = _mm256_setr_pd(dx*dx - dy*dy, 2*dx*dy, dx*dx - dy*dy, 2*dx*dy);
+	// (delta^k-1, delta^k)
+	__m256d delta_k = _mm256_setr_pd(1.0, 0.0, dx, dy);
+	__m256d res = _mm256_setzero_pd();
+	for (uint32_t k = 1; k < numCoeff; k += 2)
+	{
+		__m256d ak = load_coeff_avx2(coeff + (k << 1), k + 1 == numCoeff);
+		const __m256d scale = _mm256_setr_pd((double)k, (double)k, (double)(k + 1), (double)(k + 1));
+		res = _mm256_fmadd_pd(cmul_avx2(ak, delta_k), scale, res);
+		delta_k = cmul_avx2(delta_k, delta2);
+	}
+	double re, im;
+	hsum_avx2(res, re, im);
+	// the force is the conjugate
+	fx = re;
+	fy = -im;
+}
+
+//! M2L of the coefficients b_1.. for the offset (dx, dy) of the source center from the receiver center
+OGDF_FME_TARGET_AVX2
+static void m2l_avx2(double* receiv_coeff, const double* source_coeff, uint32_t numCoeff,
+                     double dx, double dy, const BinCoeff<double>& binCoef)
+{
+	// the divisions by powers of delta0 and delta1 = -delta0 become multiplications
+	const double len = dx*dx + dy*dy;
+	const double inv_re = dx/len;
+	const double inv_im = -dy/len;
+	const __m256d inv2 = _mm256_setr_pd(inv_re*inv_re - inv_im*inv_im, 2*inv_re*inv_im,
+	                                    inv_re*inv_re - inv_im*inv_im, 2*inv_re*inv_im);
+	const __m256d inv_12 = first_powers_avx2(inv_re, inv_im);
+	ComplexDouble a0(source_coeff[0], source_coeff[1]);
+	ComplexDouble inv1(-inv_re, -inv_im);
+	ComplexDouble inv1_l(inv1);
+
+	for (uint32_t j = 1; j < numCoeff; j++)
+	{
+		// (delta0^-k, delta0^-(k+1))
+		__m256d inv_k = inv_12;
+		__m256d sum_k = _mm256_setzero_pd();
+		for (uint32_t k = 1; k < numCoeff; k += 2)
+		{
+			const bool last = k + 1 == numCoeff;
+			__m256d ak = load_coeff_avx2(source_coeff + (k << 1), last);
+			const double b0 = binCoef.value(j + k - 1, k - 1);
+			const double b1 = last ? 0.0 : binCoef.value(j + k, k);
+			sum_k = _mm256_fmadd_pd(cmul_avx2(ak, inv_k), _mm256_setr_pd(b0, b0, b1, b1), sum_k);
+			inv_k = cmul_avx2(inv_k, inv2);
+		}
+		double re, im;
+		hsum_avx2(sum_k, re, im);
+		ComplexDouble sum(a0 * (-1 / (double)j) + ComplexDouble(re, im));
+
+		ComplexDouble b(receiv_coeff + (j << 1));
+		b += sum*inv1_l;
+		b.store(receiv_coeff + (j << 1));
+		inv1_l *= inv1;
+	}
+}
+
+#endif
+
 LinearQuadtreeExpansion::LinearQuadtreeExpansion(uint32_t precision, const LinearQuadtree& tree) : m_tree(tree), m_numCoeff(precision), binCoef(2*m_numCoeff)
 {
 	m_numExp = m_tree.maxNumberOfNodes();
+	useAVX2(true);
 	allocate();
 }
 
 
+void LinearQuadtreeExpansion::useAVX2(bool enable)
+{
+#ifdef OGDF_FME_KERNEL_USE_AVX
+	m_useAVX2 = enable && System::cpuSupports(CPUFeature::AVX2) && System::cpuSupports(CPUFeature::FMA);
+#else
+	m_useAVX2 = false;
+#endif
+}
+
+
 LinearQuadtreeExpansion::~LinearQuadtreeExpansion(void)
 {
 	deallocate();
@@ -75,6 +219,12 @@ void LinearQuadtreeExpansion::P2M(uint32_t point, uint32_t receiver)
 	const double centerY = (double)m_tree.nodeY(receiver);
 	// a0 += q_i
 	receiv_coeff[0] += q;
+#ifdef OGDF_FME_KERNEL_USE_AVX
+	if (m_useAVX2) {
+		p2m_avx2(receiv_coeff, m_numCoeff, x - centerX, y - centerY, q);
+		return;
+	}
+#endif
 	// a_1..m
 	ComplexDouble ak;
 	// p - z0
@@ -98,6 +248,15 @@ void LinearQuadtreeExpansion::L2P(uint32_t source, uint32_t point, float& fx, fl
 	const double y = (double)m_tree.pointY(point);
 	const double centerX = (double)m_tree.nodeX(source);
 	const double centerY = (double)m_tree.nodeY(source);
+#ifdef OGDF_FME_KERNEL_USE_AVX
+	if (m_useAVX2) {
+		double resX, resY;
+		l2p_avx2(source_coeff, m_numCoeff, x - centerX, y - centerY, resX, resY);
+		fx -= (float)resX;
+		fy -= (float)resY;
+		return;
+	}
+#endif
 	ComplexDouble ak;
 	ComplexDouble res;
 	ComplexDouble delta(ComplexDouble(x,y) - ComplexDouble(centerX, centerY));
@@ -199,6 +358,13 @@ void LinearQuadtreeExpansion::M2L(uint32_t source, uint32_t receiver)
 	ComplexDouble a0(source_coeff);
 	ComplexDouble b;
 	ComplexDouble sum;
+#ifdef OGDF_FME_KERNEL_USE_AVX
+	if (m_useAVX2) {
+		m2l_avx2(receiv_coeff, source_coeff, m_numCoeff,
+		         (double)center_x_source - (double)center_x_receiver,
+		         (double)center_y_source - (double)center_y_receiver, binCoef);
+	} else
+#endif
 	for (uint32_t j = 1; j < m_numCoeff; j++)
 	{
 		b.load(receiv_coeff + (j << 1));
@@ -32,6 +32,11 @@
 
 #include <ogdf/energybased/fmmm/NewMultipoleMethod.h>
 #include <ogdf/energybased/fmmm/common.h>
+#include <ogdf/basic/Thread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
 
 #define MIN_BOX_LENGTH   1e-300
 
@@ -98,9 +103,102 @@ static ParticleListState traverse(List<ParticleInfo> &relevantList, double mid_c
 	return state;
 }
 
+//! The number of levels resolved by the Morton codes of the particles.
+constexpr int MORTON_DEPTH = 32;
+
+//! The minimal number of particles handled by a single thread.
+constexpr int MIN_PARTICLES_PER_THREAD = 2048;
+
+//! The number of subtrees per thread that are distributed dynamically.
+constexpr int SUBTREES_PER_THREAD = 16;
+
+//! A particle together with its Morton code.
+struct MortonParticle {
+	uint64_t code;
+	int index;
+
+	bool operator<(const MortonParticle &other) const {
+		return code < other.code || (code == other.code && index < other.index);
+	}
+};
+
+//! Spreads the bits of \p x to the even positions of the result.
+static inline uint64_t spreadBits(uint32_t x)
+{
+	uint64_t b = x;
+	b = (b | (b << 16)) & 0x0000FFFF0000FFFFULL;
+	b = (b | (b << 8)) & 0x00FF00FF00FF00FFULL;
+	b = (b | (b << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	b = (b | (b << 2)) & 0x3333333333333333ULL;
+	b = (b | (b << 1)) & 0x5555555555555555ULL;
+	return b;
+}
+
+//! Gathers the bits at the even positions of \p b, the inverse of spreadBits().
+static inline uint32_t compactBits(uint64_t b)
+{
+	b &= 0x5555555555555555ULL;
+	b = (b | (b >> 1)) & 0x3333333333333333ULL;
+	b = (b | (b >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+	b = (b | (b >> 4)) & 0x00FF00FF00FF00FFULL;
+	b = (b | (b >> 8)) & 0x0000FFFF0000FFFFULL;
+	b = (b | (b >> 16)) & 0x00000000FFFFFFFFULL;
+	return uint32_t(b);
+}
+
+//! Returns the index of coordinate \p c on a grid of 2^MORTON_DEPTH cells covering [\p low, \p low + \p length).
+static inline uint32_t gridIndex(double c, double low, double length)
+{
+	const double cells = std::ldexp(1.0, MORTON_DEPTH);
+	const double i = std::floor((c - low) / length * cells);
+	if (!(i > 0)) {
+		return 0;
+	}
+	return i >= cells ? uint32_t(cells - 1) : uint32_t(i);
+}
+
+//! Returns whether two of the particles in \p nodes have the same position.
+static bool containsCoincidentParticles(const NodeArray<NodeAttributes> &A, const List<node> &nodes)
+{
+	for (ListConstIterator<node> it = nodes.begin(); it.valid(); ++it) {
+		for (ListConstIterator<node> it2 = it.succ(); it2.valid(); ++it2) {
+			if (A[*it].get_position() == A[*it2].get_position()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+//! Sorts \p particles in parallel by sorting contiguous runs and merging them pairwise.
+static void sortInParallel(Array<MortonParticle> &particles, unsigned int numberOfThreads)
+{
+	const int n = particles.size();
+	Array<int> bound(numberOfThreads + 1);
+	for (unsigned int t = 0; t <= numberOfThreads; ++t) {
+		bound[t] = int((long long)n * t / numberOfThreads);
+	}
+
+	MortonParticle *p = particles.begin();
+	runThreads(numberOfThreads, [&](unsigned int t) {
+		std::sort(p + bound[t], p + bound[t + 1]);
+	});
+
+	for (unsigned int width = 1; width < numberOfThreads; width *= 2) {
+		const unsigned int merges = (numberOfThreads + 2 * width - 1) / (2 * width);
+		runThreads(merges, [&](unsigned int i) {
+			const unsigned int first = 2 * width * i;
+			const unsigned int middle = min(first + width, numberOfThreads);
+			const unsigned int last = min(first + 2 * width, numberOfThreads);
+			std::inplace_merge(p + bound[first], p + bound[middle], p + bound[last]);
+		});
+	}
+}
+
 NewMultipoleMethod::NewMultipoleMethod()
   : MIN_NODE_NUMBER(175)
   , using_NMM(true)
+  , _number_of_threads(1)
   , max_power_of_2_index(30)
 {
 	// setting predefined parameters
@@ -115,7 +213,9 @@ void NewMultipoleMethod::calculate_repulsive_forces(
 	NodeArray <NodeAttributes>& A,
 	NodeArray<DPoint>& F_rep)
 {
-	if (using_NMM) { // use NewMultipoleMethod
+	if (using_NMM && _number_of_threads != 1) { // use NewMultipoleMethod in parallel
+		calculate_repulsive_forces_by_parallel_NMM(G,A,F_rep);
+	} else if (using_NMM) { // use NewMultipoleMethod
 		calculate_repulsive_forces_by_NMM(G,A,F_rep);
 	} else { // use the exact naive way
 		calculate_repulsive_forces_by_exact_method(G,A,F_rep);
@@ -159,6 +259,270 @@ void NewMultipoleMethod::calculate_repulsive_forces_by_NMM(
 }
 
 
+void NewMultipoleMethod::calculate_repulsive_forces_by_parallel_NMM(
+	const Graph &G,
+	NodeArray<NodeAttributes>& A,
+	NodeArray<DPoint>& F_rep)
+{
+	const int n = G.numberOfNodes();
+	const unsigned int threads = unsigned(max(min(int(_number_of_threads), n / MIN_PARTICLES_PER_THREAD), 1));
+	const int grain = max(n / (SUBTREES_PER_THREAD * int(threads)), particles_in_leaves());
+
+	QuadTreeNM T;
+	build_up_red_quad_tree_in_morton_order(G,A,T,grain);
+
+	// the centers are set sequentially, so the random waggles do not depend on the threads
+	ArrayBuffer<QuadTreeNodeNM*> top_nodes, subtree_roots, quad_tree_leaves;
+	init_expansions_and_collect_subtrees(T.get_root_ptr(),grain,false,top_nodes,subtree_roots,quad_tree_leaves);
+
+	// the subtrees are distributed dynamically, each of them is handled by one thread
+	auto forAllSubtrees = [&](std::function<void(QuadTreeNodeNM*)> body) {
+		std::atomic<int> next(0);
+		runThreads(threads, [&](unsigned int) {
+			for (int i = next++; i < subtree_roots.size(); i = next++) {
+				body(subtree_roots[i]);
+			}
+		});
+	};
+
+	// multipole expansions bottom-up: the subtrees first, then the nodes above them
+	forAllSubtrees([&](QuadTreeNodeNM* root_ptr) {
+		form_multipole_expansion_of_subtree(A,root_ptr);
+	});
+	for (int i = top_nodes.size() - 1; i >= 0; --i) {
+		QuadTreeNodeNM* act_ptr = top_nodes[i];
+		for (QuadTreeNodeNM* child_ptr : {act_ptr->get_child_lt_ptr(), act_ptr->get_child_rt_ptr(),
+		                                  act_ptr->get_child_lb_ptr(), act_ptr->get_child_rb_ptr()}) {
+			if (child_ptr != nullptr) {
+				add_shifted_expansion_to_father_expansion(child_ptr);
+			}
+		}
+	}
+
+	// local expansions top-down: the nodes above the subtrees first, then the subtrees
+	for (QuadTreeNodeNM* act_ptr : top_nodes) {
+		calculate_local_expansion_and_WSPRLS_of_node(A,act_ptr);
+	}
+	forAllSubtrees([&](QuadTreeNodeNM* root_ptr) {
+		calculate_local_expansions_and_WSPRLS(A,root_ptr);
+	});
+
+	// the forces on the particles of the leaves, the direct forces act on the particles of
+	// other leaves as well and are thus accumulated separately by each thread
+	NodeArray<DPoint> F_local_exp(G, DPoint(0, 0));
+	NodeArray<DPoint> F_multipole_exp(G, DPoint(0, 0));
+	Array<NodeArray<DPoint>> F_direct(static_cast<int>(threads));
+	Array<List<QuadTreeNodeNM*>> coincident_leaves(static_cast<int>(threads));
+
+	parallelFor(0, quad_tree_leaves.size(), threads, [&](int from, int to, unsigned int t) {
+		List<QuadTreeNodeNM*> leaves, direct_leaves;
+		List<node> contained_nodes;
+		for (int i = from; i < to; ++i) {
+			QuadTreeNodeNM* leaf_ptr = quad_tree_leaves[i];
+			leaves.pushBack(leaf_ptr);
+			leaf_ptr->get_contained_nodes(contained_nodes);
+			if (contained_nodes.size() > particles_in_leaves() || containsCoincidentParticles(A, contained_nodes)) {
+				coincident_leaves[t].pushBack(leaf_ptr);
+			} else {
+				direct_leaves.pushBack(leaf_ptr);
+			}
+		}
+		F_direct[t].init(G, DPoint(0, 0));
+		transform_local_exp_to_forces(A,leaves,F_local_exp);
+		transform_multipole_exp_to_forces(A,leaves,F_multipole_exp);
+		calculate_neighbourcell_forces(A,direct_leaves,F_direct[t]);
+	});
+
+	// coincident particles are moved apart randomly, so these leaves are handled sequentially
+	for (unsigned int t = 0; t < threads; ++t) {
+		calculate_neighbourcell_forces(A,coincident_leaves[t],F_direct[t]);
+	}
+
+	Array<node> nodes(n);
+	int i = 0;
+	for (node v : G.nodes) {
+		nodes[i++] = v;
+	}
+	parallelFor(0, n, threads, [&](int from, int to, unsigned int) {
+		for (int j = from; j < to; ++j) {
+			const node v = nodes[j];
+			DPoint force = F_local_exp[v] + F_multipole_exp[v];
+			for (const NodeArray<DPoint> &F : F_direct) {
+				force += F[v];
+			}
+			F_rep[v] = force;
+		}
+	});
+
+	// the subtrees are deleted in parallel, the nodes above them afterwards
+	forAllSubtrees([&](QuadTreeNodeNM* root_ptr) {
+		T.delete_tree(root_ptr);
+	});
+	for (QuadTreeNodeNM* act_ptr : top_nodes) {
+		delete act_ptr;
+	}
+	T.set_root_ptr(nullptr);
+}
+
+
+void NewMultipoleMethod::build_up_red_quad_tree_in_morton_order(
+	const Graph& G,
+	NodeArray<NodeAttributes>& A,
+	QuadTreeNM& T,
+	int grain)
+{
+	const int n = G.numberOfNodes();
+	const unsigned int threads = unsigned(max(min(int(_number_of_threads), n / MIN_PARTICLES_PER_THREAD), 1));
+
+	Array<node> nodes(n);
+	int i = 0;
+	for (node v : G.nodes) {
+		nodes[i++] = v;
+	}
+
+	// the Morton code interleaves the grid indices of the particle, with x in the higher bits
+	Array<MortonParticle> particles(n);
+	parallelFor(0, n, threads, [&](int from, int to, unsigned int) {
+		for (int j = from; j < to; ++j) {
+			const NodeAttributes &attr = A[nodes[j]];
+			const uint64_t x = spreadBits(gridIndex(attr.get_x(), down_left_corner.m_x, boxlength));
+			const uint64_t y = spreadBits(gridIndex(attr.get_y(), down_left_corner.m_y, boxlength));
+			particles[j].code = (x << 1) | y;
+			particles[j].index = j;
+		}
+	});
+	sortInParallel(particles, threads);
+
+	Array<uint64_t> code(n);
+	Array<node> particle(n);
+	parallelFor(0, n, threads, [&](int from, int to, unsigned int) {
+		for (int j = from; j < to; ++j) {
+			code[j] = particles[j].code;
+			particle[j] = nodes[particles[j].index];
+		}
+	});
+
+	// the top of the tree is constructed sequentially, its small subtrees in parallel
+	T.init_tree();
+	ArrayBuffer<MortonSubtree> deferred;
+	construct_morton_subtree(T.get_root_ptr(),code,particle,0,n-1,-1,grain,&deferred);
+
+	std::atomic<int> next(0);
+	runThreads(threads, [&](unsigned int) {
+		for (int j = next++; j < deferred.size(); j = next++) {
+			const MortonSubtree &subtree = deferred[j];
+			construct_morton_subtree(subtree.root_ptr,code,particle,subtree.first,subtree.last,
+				subtree.father_level,grain,nullptr);
+		}
+	});
+}
+
+
+void NewMultipoleMethod::construct_morton_subtree(
+	QuadTreeNodeNM* act_ptr,
+	const Array<uint64_t>& code,
+	const Array<node>& particle,
+	int first,
+	int last,
+	int father_level,
+	int grain,
+	ArrayBuffer<MortonSubtree>* deferred)
+{
+	const int particle_number = last - first + 1;
+	act_ptr->set_particlenumber_in_subtree(particle_number);
+
+	if (deferred != nullptr && father_level >= 0 && particle_number <= grain) {
+		deferred->push(MortonSubtree{act_ptr, first, last, father_level});
+		return;
+	}
+
+	// the small cell is given by the common prefix of the codes; if all particles share
+	// the same grid cell, the box is the quad of the father that contains them
+	const uint64_t diff = code[first] ^ code[last];
+	int level = father_level + 1;
+	if (diff != 0) {
+		level = 0;
+		while (((diff >> (2 * (MORTON_DEPTH - 1 - level))) & 3) == 0) {
+			++level;
+		}
+	}
+
+	const uint64_t prefix = level == 0 ? 0 : code[first] >> (2 * (MORTON_DEPTH - level));
+	const double Sm_boxlength = std::ldexp(boxlength, -level);
+	act_ptr->set_Sm_level(level);
+	act_ptr->set_Sm_boxlength(Sm_boxlength);
+	act_ptr->set_Sm_downleftcorner(down_left_corner
+		+ DPoint(compactBits(prefix >> 1) * Sm_boxlength, compactBits(prefix) * Sm_boxlength));
+
+	if (diff == 0 || particle_number <= particles_in_leaves()) {
+		for (int i = first; i <= last; ++i) {
+			act_ptr->pushBack_contained_nodes(particle[i]);
+		}
+		return;
+	}
+
+	// the children are the runs of codes with equal bits on the next level
+	const int shift = 2 * (MORTON_DEPTH - 1 - level);
+	const uint64_t *begin = code.begin() + first;
+	const uint64_t *end = code.begin() + last + 1;
+	for (uint64_t quad = 0; quad < 4; ++quad) {
+		const uint64_t *quad_end = std::partition_point(begin, end, [&](uint64_t c) {
+			return ((c >> shift) & 3) <= quad;
+		});
+		if (quad_end == begin) {
+			continue;
+		}
+
+		QuadTreeNodeNM* child_ptr = new QuadTreeNodeNM();
+		child_ptr->set_father_ptr(act_ptr);
+		switch (quad) {
+		case 0: act_ptr->set_child_lb_ptr(child_ptr); break;
+		case 1: act_ptr->set_child_lt_ptr(child_ptr); break;
+		case 2: act_ptr->set_child_rb_ptr(child_ptr); break;
+		default: act_ptr->set_child_rt_ptr(child_ptr);
+		}
+
+		construct_morton_subtree(child_ptr,code,particle,int(begin - code.begin()),
+			int(quad_end - code.begin()) - 1,level,grain,deferred);
+		begin = quad_end;
+	}
+}
+
+
+void NewMultipoleMethod::init_expansions_and_collect_subtrees(
+	QuadTreeNodeNM* act_ptr,
+	int grain,
+	bool in_subtree,
+	ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+	ArrayBuffer<QuadTreeNodeNM*>& subtree_roots,
+	ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves)
+{
+	init_expansion_Lists(act_ptr);
+	set_center(act_ptr);
+
+	if (!in_subtree) {
+		in_subtree = act_ptr->is_leaf() || act_ptr->get_particlenumber_in_subtree() <= grain;
+		if (in_subtree) {
+			subtree_roots.push(act_ptr);
+		} else {
+			top_nodes.push(act_ptr);
+		}
+	}
+
+	if (act_ptr->is_leaf()) {
+		quad_tree_leaves.push(act_ptr);
+	} else {
+		// the same order as in form_multipole_expansion_of_subtree()
+		for (QuadTreeNodeNM* child_ptr : {act_ptr->get_child_lt_ptr(), act_ptr->get_child_rt_ptr(),
+		                                  act_ptr->get_child_lb_ptr(), act_ptr->get_child_rb_ptr()}) {
+			if (child_ptr != nullptr) {
+				init_expansions_and_collect_subtrees(child_ptr,grain,in_subtree,top_nodes,subtree_roots,quad_tree_leaves);
+			}
+		}
+	}
+}
+
+
 inline void NewMultipoleMethod::calculate_repulsive_forces_by_exact_method(
 	const Graph &G,
 	NodeArray<NodeAttributes>& A,
@@ -175,8 +539,11 @@ void NewMultipoleMethod::make_initialisations(
 	int p_i_l,
 	int p,
 	FMMMOptions::ReducedTreeConstruction t_c_w,
-	FMMMOptions::SmallestCellFinding f_s_c)
+	FMMMOptions::SmallestCellFinding f_s_c,
+	unsigned int number_of_threads)
 {
+	_number_of_threads = resolveNumberOfThreads(number_of_threads);
+
 	if (G.numberOfNodes() >= MIN_NODE_NUMBER) { // using_NMM
 		using_NMM = true; //indicate that NMM is used for force calculation
 
@@ -1536,6 +1903,24 @@ void NewMultipoleMethod::form_multipole_expansion_of_subtree(
 }
 
 
+void NewMultipoleMethod::form_multipole_expansion_of_subtree(
+	NodeArray<NodeAttributes>& A,
+	QuadTreeNodeNM* act_ptr)
+{
+	if (act_ptr->is_leaf()) {
+		form_multipole_expansion_of_leaf_node(A,act_ptr);
+	} else {
+		for (QuadTreeNodeNM* child_ptr : {act_ptr->get_child_lt_ptr(), act_ptr->get_child_rt_ptr(),
+		                                  act_ptr->get_child_lb_ptr(), act_ptr->get_child_rb_ptr()}) {
+			if (child_ptr != nullptr) {
+				form_multipole_expansion_of_subtree(A,child_ptr);
+				add_shifted_expansion_to_father_expansion(child_ptr);
+			}
+		}
+	}
+}
+
+
 inline void NewMultipoleMethod::init_expansion_Lists(QuadTreeNodeNM* act_ptr)
 {
 	int i;
@@ -1635,6 +2020,30 @@ void NewMultipoleMethod::add_shifted_expansion_to_father_expansion(QuadTreeNodeN
 void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS(
 	NodeArray<NodeAttributes>&A,
 	QuadTreeNodeNM* act_node_ptr)
+{
+	calculate_local_expansion_and_WSPRLS_of_node(A,act_node_ptr);
+
+	// recursive calls if act_node is not a leaf
+	if (!act_node_ptr->is_leaf()) {
+		if(act_node_ptr->child_lt_exists()) {
+			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_lt_ptr());
+		}
+		if(act_node_ptr->child_rt_exists()) {
+			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_rt_ptr());
+		}
+		if(act_node_ptr->child_lb_exists()) {
+			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_lb_ptr());
+		}
+		if(act_node_ptr->child_rb_exists()) {
+			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_rb_ptr());
+		}
+	}
+}
+
+
+void NewMultipoleMethod::calculate_local_expansion_and_WSPRLS_of_node(
+	NodeArray<NodeAttributes>&A,
+	QuadTreeNodeNM* act_node_ptr)
 {
 	List<QuadTreeNodeNM*> I,L,L2,E,D1,D2,M;
 	QuadTreeNodeNM *selected_node_ptr;
@@ -1716,21 +2125,8 @@ void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS(
 	for (QuadTreeNodeNM *ptr : L2)
 		add_local_expansion_of_leaf(A,ptr,act_node_ptr);
 
-	// Step 4: recursive calls if act_node is not a leaf
-	if (!act_node_ptr->is_leaf()) {
-		if(act_node_ptr->child_lt_exists()) {
-			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_lt_ptr());
-		}
-		if(act_node_ptr->child_rt_exists()) {
-			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_rt_ptr());
-		}
-		if(act_node_ptr->child_lb_exists()) {
-			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_lb_ptr());
-		}
-		if(act_node_ptr->child_rb_exists()) {
-			calculate_local_expansions_and_WSPRLS(A,act_node_ptr->get_child_rb_ptr());
-		}
-	} else { // *act_node_ptr is a leaf
+	// Step 4 (the recursive calls) is done by calculate_local_expansions_and_WSPRLS()
+	if (act_node_ptr->is_leaf()) {
 		// Step 5: WSPRLS(Well Separateness Preserving Refinement of leaf surroundings)
 		// if act_node is a leaf then calculate the list D1,D2 and M from I and D1
 		act_node_ptr->get_D1(D1);
@@ -30,11 +30,18 @@
  */
 
 #include <ogdf/energybased/multilevel_mixer/BarycenterPlacer.h>
+#include <ogdf/basic/Thread.h>
 
 namespace ogdf {
 
 void BarycenterPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
+	const unsigned int numberOfThreads = threadsToUse();
+	if (numberOfThreads > 1) {
+		placeOneLevelInParallel(MLG, numberOfThreads);
+		return;
+	}
+
 	int level = MLG.getLevel();
 	while (MLG.getLevel() == level && MLG.getLastMerge() != nullptr)
 	{
@@ -71,6 +78,67 @@ void BarycenterPlacer::placeOneNode(MultilevelGraph &MLG)
 }
 
 
+void BarycenterPlacer::placeOneLevelInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads)
+{
+	std::vector<node> merged;
+	std::vector<int> parents;
+
+	int level = MLG.getLevel();
+	while (MLG.getLevel() == level && MLG.getLastMerge() != nullptr)
+	{
+		parents.push_back(MLG.getLastMerge()->m_changedNodes.front());
+		merged.push_back(MLG.undoLastMerge());
+	}
+
+	NodeArray<bool> reinserted(MLG.getGraph(), false);
+	for (node v : merged) {
+		reinserted[v] = true;
+	}
+
+	// the offsets are drawn in the same order as by placeOneNode()
+	const int k = static_cast<int>(merged.size());
+	Array<double> offset(0, 2 * k - 1, 0.0);
+	if (m_randomOffset) {
+		for (int j = 0; j < 2 * k; j++) {
+			offset[j] = (float)randomDouble(-1.0, 1.0);
+		}
+	}
+
+	// positions are computed first since the reinserted nodes may be adjacent
+	Array<double> x(0, k - 1, 0.0);
+	Array<double> y(0, k - 1, 0.0);
+	parallelFor(0, k, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int j = from; j < to; j++) {
+			double i = 0.0;
+			for(adjEntry adj : merged[j]->adjEntries) {
+				node twin = adj->twinNode();
+				if (reinserted[twin]) {
+					continue;
+				}
+				double weight = m_weightedPositions ? 1.0 / MLG.weight(adj->theEdge()) : 1.0;
+				i = i + weight;
+				x[j] += MLG.x(twin) * weight;
+				y[j] += MLG.y(twin) * weight;
+			}
+
+			if (i > 0) {
+				x[j] = x[j] / i;
+				y[j] = y[j] / i;
+			} else {
+				node parent = MLG.getNode(parents[j]);
+				x[j] = MLG.x(parent);
+				y[j] = MLG.y(parent);
+			}
+		}
+	});
+
+	for (int j = 0; j < k; j++) {
+		MLG.x(merged[j], x[j] + offset[2 * j]);
+		MLG.y(merged[j], y[j] + offset[2 * j + 1]);
+	}
+}
+
+
 BarycenterPlacer::BarycenterPlacer()
 :m_weightedPositions(false)
 {
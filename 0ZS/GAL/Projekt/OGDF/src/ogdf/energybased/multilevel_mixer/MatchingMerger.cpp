@@ -30,6 +30,10 @@
  */
 
 #include <ogdf/energybased/multilevel_mixer/MatchingMerger.h>
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Thread.h>
+
+#include <atomic>
 
 namespace ogdf {
 
@@ -53,6 +57,14 @@ bool MatchingMerger::buildOneLevel(MultilevelGraph &MLG)
 		return false;
 	}
 
+	const unsigned int numberOfThreads = threadsToUse();
+	if (numberOfThreads > 1) {
+		for (const std::pair<node, node> &pair : matchInParallel(MLG, numberOfThreads)) {
+			mergeMatchedNodes(MLG, level, pair.first, pair.second);
+		}
+		return true;
+	}
+
 	NodeArray<bool> nodeMarks(G, false);
 	std::vector<edge> matching;
 	std::vector<node> candidates;
@@ -100,36 +112,114 @@ bool MatchingMerger::buildOneLevel(MultilevelGraph &MLG)
 	while (!matching.empty()) {
 		edge matchingEdge = matching.back();
 		matching.pop_back();
+		mergeMatchedNodes(MLG, level, matchingEdge->source(), matchingEdge->target());
+	}
+
+	return true;
+}
 
-		node mergeNode;
-		node parent;
 
-		// choose high degree node as parent!
-		mergeNode = matchingEdge->source();
-		parent = matchingEdge->target();
-		if (mergeNode->degree() > parent->degree()) {
-			mergeNode = matchingEdge->target();
-			parent = matchingEdge->source();
+std::vector<std::pair<node, node>> MatchingMerger::matchInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads)
+{
+	const CompactGraph CG(MLG.getGraph());
+	const int n = CG.numberOfNodes();
+	const uint64_t seed = uint64_t(randomNumber(0, std::numeric_limits<int>::max()));
+
+	Array<unsigned int> mass;
+	if (m_selectByMass) {
+		CG.gatherNodes(m_mass, mass);
+	}
+
+	Array<int> mate(0, n - 1, -1);
+	Array<int> candidate(n);
+	std::atomic<int> matched;
+
+	do {
+		// every unmatched node points to the neighbor of its heaviest edge to an unmatched node
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			for (int v = from; v < to; ++v) {
+				candidate[v] = -1;
+				if (mate[v] >= 0) {
+					continue;
+				}
+
+				unsigned int bestMass = std::numeric_limits<unsigned int>::max();
+				int bestDegree = std::numeric_limits<int>::max();
+				uint64_t bestPriority = 0;
+				for (int i = CG.offset(v); i < CG.offset(v + 1); ++i) {
+					const int w = CG.target(i);
+					if (w == v || mate[w] >= 0) {
+						continue;
+					}
+
+					// The weight of an edge is the same at both of its nodes. Edges at nodes
+					// of small degree are preferred, as otherwise the high degree nodes would
+					// be matched with each other and the graph would shrink slowly.
+					const unsigned int pairMass = m_selectByMass ? mass[v] + mass[w] : 0;
+					const int pairDegree = CG.degree(v) + CG.degree(w);
+					const uint64_t priority = randomPriority(CG.edgeOf(i), seed);
+					if (candidate[v] < 0 || pairMass < bestMass
+					 || (pairMass == bestMass && (pairDegree < bestDegree
+					  || (pairDegree == bestDegree && priority > bestPriority)))) {
+						candidate[v] = w;
+						bestMass = pairMass;
+						bestDegree = pairDegree;
+						bestPriority = priority;
+					}
+				}
+			}
+		});
+
+		// nodes pointing to each other are matched
+		matched = 0;
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			int count = 0;
+			for (int v = from; v < to; ++v) {
+				const int w = candidate[v];
+				if (w >= 0 && candidate[w] == v) {
+					mate[v] = w;
+					++count;
+				}
+			}
+			matched += count;
+		});
+	} while (matched > 0);
+
+	std::vector<std::pair<node, node>> pairs;
+	for (int v = 0; v < n; ++v) {
+		if (mate[v] > v) {
+			pairs.push_back(std::make_pair(CG.toNode(v), CG.toNode(mate[v])));
 		}
+	}
+	return pairs;
+}
+
+
+void MatchingMerger::mergeMatchedNodes(MultilevelGraph &MLG, int level, node u, node v)
+{
+	// choose high degree node as parent!
+	node mergeNode = u;
+	node parent = v;
+	if (mergeNode->degree() > parent->degree()) {
+		mergeNode = v;
+		parent = u;
+	}
 
-		NodeMerge * NM = new NodeMerge(level);
-		bool ret;
+	NodeMerge * NM = new NodeMerge(level);
+	bool ret;
 #ifdef OGDF_DEBUG
-		ret =
+	ret =
 #endif
-			MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
-		OGDF_ASSERT( ret );
-		if (m_selectByMass) {
-			m_mass[parent] = m_mass[parent] + m_mass[mergeNode];
-		}
-		MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
-		ret = MLG.postMerge(NM, mergeNode);
-		if( !ret ) {
-			delete NM;
-		}
+		MLG.changeNode(NM, parent, MLG.radius(parent), mergeNode);
+	OGDF_ASSERT( ret );
+	if (m_selectByMass) {
+		m_mass[parent] = m_mass[parent] + m_mass[mergeNode];
+	}
+	MLG.moveEdgesToParent(NM, mergeNode, parent, true, m_adjustEdgeLengths);
+	ret = MLG.postMerge(NM, mergeNode);
+	if( !ret ) {
+		delete NM;
 	}
-
-	return true;
 }
 
 
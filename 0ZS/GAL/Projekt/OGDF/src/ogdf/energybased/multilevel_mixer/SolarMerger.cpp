@@ -30,6 +30,10 @@
  */
 
 #include <ogdf/energybased/multilevel_mixer/SolarMerger.h>
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Thread.h>
+
+#include <atomic>
 
 namespace ogdf {
 
@@ -50,6 +54,11 @@ int SolarMerger::calcSystemMass(node v) {
 
 std::vector<node> SolarMerger::selectSuns(MultilevelGraph &MLG)
 {
+	const unsigned int numberOfThreads = threadsToUse();
+	if (numberOfThreads > 1) {
+		return selectSunsInParallel(MLG, numberOfThreads);
+	}
+
 	Graph &G = MLG.getGraph();
 	std::vector<node> suns;
 	std::vector<node> candidates;
@@ -177,6 +186,128 @@ std::vector<node> SolarMerger::selectSuns(MultilevelGraph &MLG)
 }
 
 
+std::vector<node> SolarMerger::selectSunsInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads)
+{
+	const CompactGraph CG(MLG.getGraph());
+	const int n = CG.numberOfNodes();
+	const uint64_t seed = uint64_t(randomNumber(0, std::numeric_limits<int>::max()));
+
+	// 0 = unknown, 1 = sun, 2 = planet, 3 = moon
+	Array<int> celestial(0, n - 1, 0);
+	// the orbital center of planets and moons and the entry leading to it
+	Array<int> center(0, n - 1, -1);
+	Array<int> centerEntry(0, n - 1, -1);
+	Array<uint64_t> priority(n);
+	Array<bool> eligible(n);
+	Array<bool> sun(n);
+
+	parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int v = from; v < to; ++v) {
+			priority[v] = randomPriority(v, seed);
+			if (!m_sunSelectionSimple) {
+				priority[v] = (uint64_t(calcSystemMass(CG.toNode(v))) << 32) | (priority[v] >> 32);
+			}
+		}
+	});
+
+	auto precedes = [&](int v, int w) {
+		return priority[v] < priority[w] || (priority[v] == priority[w] && v < w);
+	};
+
+	std::atomic<int> numberOfEligible;
+	for (;;) {
+		// a node may become a sun if neither it nor a neighbor belongs to a system
+		numberOfEligible = 0;
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			int count = 0;
+			for (int v = from; v < to; ++v) {
+				eligible[v] = celestial[v] == 0;
+				for (int i = CG.offset(v); eligible[v] && i < CG.offset(v + 1); ++i) {
+					eligible[v] = celestial[CG.target(i)] == 0;
+				}
+				count += eligible[v];
+			}
+			numberOfEligible += count;
+		});
+
+		if (numberOfEligible == 0) {
+			break;
+		}
+
+		// suns of the same round have a distance of at least 3, so their systems are disjoint
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			for (int v = from; v < to; ++v) {
+				sun[v] = eligible[v];
+				for (int i = CG.offset(v); sun[v] && i < CG.offset(v + 1); ++i) {
+					const int w = CG.target(i);
+					sun[v] = w == v || !eligible[w] || precedes(v, w);
+					for (int j = CG.offset(w); sun[v] && j < CG.offset(w + 1); ++j) {
+						const int u = CG.target(j);
+						sun[v] = u == v || !eligible[u] || precedes(v, u);
+					}
+				}
+			}
+		});
+
+		parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+			for (int v = from; v < to; ++v) {
+				if (!sun[v]) {
+					continue;
+				}
+				celestial[v] = 1;
+				for (int i = CG.offset(v); i < CG.offset(v + 1); ++i) {
+					const int w = CG.target(i);
+					if (w != v) {
+						celestial[w] = 2;
+						center[w] = v;
+						centerEntry[w] = i;
+					}
+				}
+			}
+		});
+	}
+
+	// the remaining nodes become moons of the neighboring planet with the highest priority
+	parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int v = from; v < to; ++v) {
+			if (celestial[v] != 0) {
+				continue;
+			}
+			uint64_t bestPriority = 0;
+			for (int i = CG.offset(v); i < CG.offset(v + 1); ++i) {
+				const int w = CG.target(i);
+				const uint64_t edgePriority = randomPriority(CG.edgeOf(i), seed);
+				if (celestial[w] == 2 && (center[v] < 0 || edgePriority > bestPriority)) {
+					center[v] = w;
+					centerEntry[v] = i;
+					bestPriority = edgePriority;
+				}
+			}
+			OGDF_ASSERT(center[v] >= 0);
+		}
+	});
+
+	parallelFor(0, n, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int v = from; v < to; ++v) {
+			node object = CG.toNode(v);
+			m_celestial[object] = celestial[v] == 0 ? 3 : celestial[v];
+			if (center[v] >= 0) {
+				m_orbitalCenter[object] = CG.toNode(center[v]);
+				m_distanceToOrbit[object] = MLG.weight(CG.toEdge(CG.edgeOf(centerEntry[v])));
+			}
+		}
+	});
+
+	std::vector<node> suns;
+	for (int v = 0; v < n; ++v) {
+		if (celestial[v] == 1) {
+			suns.push_back(CG.toNode(v));
+		}
+	}
+	return suns;
+}
+
+
 void SolarMerger::buildAllLevels(MultilevelGraph &MLG)
 {
 	m_numLevels = 1;
@@ -30,11 +30,18 @@
  */
 
 #include <ogdf/energybased/multilevel_mixer/SolarPlacer.h>
+#include <ogdf/basic/Thread.h>
 
 namespace ogdf {
 
 void SolarPlacer::placeOneLevel(MultilevelGraph &MLG)
 {
+	const unsigned int numberOfThreads = threadsToUse();
+	if (numberOfThreads > 1) {
+		placeOneLevelInParallel(MLG, numberOfThreads);
+		return;
+	}
+
 	int level = MLG.getLevel();
 	while (MLG.getLevel() == level && MLG.getLastMerge() != nullptr)
 	{
@@ -78,4 +85,58 @@ void SolarPlacer::placeOneNode(MultilevelGraph &MLG)
 	MLG.y(merged, (y / static_cast<double>(i)));
 }
 
+
+void SolarPlacer::placeOneLevelInParallel(MultilevelGraph &MLG, unsigned int numberOfThreads)
+{
+	// the suns are not merged on this level, so all nodes of the level can be placed at once
+	std::vector<node> merged;
+	std::vector<int> suns;
+	std::vector< std::vector< std::pair<int, double> > > positions;
+
+	int level = MLG.getLevel();
+	while (MLG.getLevel() == level && MLG.getLastMerge() != nullptr)
+	{
+		NodeMerge * lastNM = MLG.getLastMerge();
+		suns.push_back(lastNM->m_changedNodes.front());
+		positions.push_back(lastNM->m_position);
+		merged.push_back(MLG.undoLastMerge());
+	}
+
+	// the offsets are drawn in the same order as by placeOneNode()
+	const int k = static_cast<int>(merged.size());
+	Array<double> offset(0, 2 * k - 1, 0.0);
+	for (int j = 0; j < k; j++) {
+		if (positions[j].empty() || m_randomOffset) {
+			offset[2 * j] = randomDouble(-1.0, 1.0);
+			offset[2 * j + 1] = randomDouble(-1.0, 1.0);
+		}
+	}
+
+	parallelFor(0, k, numberOfThreads, [&](int from, int to, unsigned int) {
+		for (int j = from; j < to; j++) {
+			node sun = MLG.getNode(suns[j]);
+			double x = 0.0;
+			double y = 0.0;
+			int i = 0;
+
+			if (positions[j].size() > 0) {
+				for (const std::pair<int, double> &p : positions[j]) {
+					double factor = p.second;
+					node other_sun = MLG.getNode(p.first);
+					i++;
+					x += MLG.x(sun) * factor + MLG.x(other_sun) * (1.0f-factor);
+					y += MLG.y(sun) * factor + MLG.y(other_sun) * (1.0f-factor);
+				}
+			} else {
+				i++;
+				x += MLG.x(sun);
+				y += MLG.y(sun);
+			}
+
+			MLG.x(merged[j], ((x + offset[2 * j]) / static_cast<double>(i)));
+			MLG.y(merged[j], ((y + offset[2 * j + 1]) / static_cast<double>(i)));
+		}
+	});
+}
+
 }
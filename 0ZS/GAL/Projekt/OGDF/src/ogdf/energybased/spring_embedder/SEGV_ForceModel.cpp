@@ -33,32 +33,62 @@
 
 namespace ogdf {
 
+template<int NormExponent>
 DPoint SpringEmbedderGridVariant::ForceModelBase::
-computeRepulsiveForce(int j, double boxLength, int idealExponent, int normExponent) const
+computeRepulsiveForce(int j, double boxLength) const
 {
 	const NodeInfo &vj = m_vInfo[j];
 	int grid_x = vj.m_gridX;
 	int grid_y = vj.m_gridY;
 
-	// repulsive forces on node j: F_rep(d) = iel^2 / d^normExponent
+	// the coordinates of j are rounded like the ones in the grid, so j itself adds no force
+	const float x = float(vj.m_pos.m_x);
+	const float y = float(vj.m_pos.m_y);
+	const float box = float(boxLength);
+	const float epsilon = float(eps());
+	const float *gridX = m_grid.m_x.begin();
+	const float *gridY = m_grid.m_y.begin();
+
+	// repulsive forces on node j: F_rep(d) = 1 / d^NormExponent
 	DPoint force(0, 0);
-	for (int gi = -1; gi <= 1; ++gi) {
-		for (int gj = -1; gj <= 1; ++gj) {
-			for (int u : m_gridCell(grid_x + gi, grid_y + gj)) {
-				if (u == j) {
-					continue;
-				}
-				DPoint dist = vj.m_pos - m_vInfo[u].m_pos;
-				double d = dist.norm();
-
-				if(d < boxLength) {
-					dist /= std::pow(d, normExponent+1) + eps();
-					force += dist;
-				}
+	for (int gj = -1; gj <= 1; ++gj) {
+		// the three cells of a row are contiguous
+		const int first = m_grid.m_cellStart[m_grid.cell(grid_x - 1, grid_y + gj)];
+		const int stop = m_grid.m_cellStart[m_grid.cell(grid_x + 1, grid_y + gj) + 1];
+
+		float forceX = 0, forceY = 0;
+		for (int k = first; k < stop; ++k) {
+			const float dx = x - gridX[k];
+			const float dy = y - gridY[k];
+			const float d = std::sqrt(dx*dx + dy*dy);
+
+			float dPow = d;
+			for (int e = 0; e < NormExponent; ++e) {
+				dPow *= d;
 			}
+
+			const float f = (d < box) ? 1.0f / (dPow + epsilon) : 0.0f;
+			forceX += dx * f;
+			forceY += dy * f;
 		}
+
+		force.m_x += forceX;
+		force.m_y += forceY;
 	}
 
+	return force;
+}
+
+DPoint SpringEmbedderGridVariant::ForceModelBase::
+computeRepulsiveForce(int j, double boxLength, int idealExponent, int normExponent) const
+{
+	OGDF_ASSERT(normExponent == 1 || normExponent == 2);
+
+	// repulsive forces on node j: F_rep(d) = iel^2 / d^normExponent
+	DPoint force = (normExponent == 1)
+	             ? computeRepulsiveForce<1>(j, boxLength)
+	             : computeRepulsiveForce<2>(j, boxLength);
+
 	force *= std::pow(m_idealEdgeLength, idealExponent);
 
 	return force;
@@ -0,0 +1,578 @@
+/** \file
+ * \brief Implementation of ogdf::BinaryGraphFile
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/fileformats/BinaryGraphFile.h>
+#include <ogdf/cluster/ClusterArray.h>
+
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace ogdf {
+
+namespace binary_graph {
+
+//! The magic bytes at the beginning of a file.
+static const char MAGIC[8] = {'O', 'G', 'D', 'F', 'G', 'R', 'P', 'H'};
+
+//! The byte order mark, it reads differently on machines of the other byte order.
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t version;
+	uint64_t sectionCount;
+};
+
+struct SectionHeader {
+	uint32_t type;
+	uint32_t reserved;
+	uint64_t size;
+};
+
+//! The number of section types that can be told apart.
+constexpr uint32_t MAX_SECTION_TYPES = 64;
+
+static inline uint64_t padded(uint64_t size) {
+	return (size + 7) & ~uint64_t(7);
+}
+
+//! Returns the size of a column with one value per node or edge, or 0 for sections of variable size.
+static uint64_t columnSize(BinaryGraphFile::Section s, uint64_t n, uint64_t m)
+{
+	using Section = BinaryGraphFile::Section;
+
+	switch (s) {
+	case Section::NodeX:
+	case Section::NodeY:
+	case Section::NodeZ:
+	case Section::NodeWidth:
+	case Section::NodeHeight:
+		return n * sizeof(double);
+	case Section::NodeShape:
+	case Section::NodeWeight:
+		return n * sizeof(int32_t);
+	case Section::EdgeIntWeight:
+		return m * sizeof(int32_t);
+	case Section::EdgeDoubleWeight:
+		return m * sizeof(double);
+	default:
+		return 0;
+	}
+}
+
+//! Checks that \p size bytes at \p p hold a string table of \p count strings.
+static bool isStringTable(const char *p, uint64_t size, uint64_t count)
+{
+	if (size < sizeof(int64_t) || *reinterpret_cast<const int64_t *>(p) != int64_t(count)
+	 || (size - sizeof(int64_t)) / sizeof(int64_t) < count + 1) {
+		return false;
+	}
+
+	const int64_t *offsets = reinterpret_cast<const int64_t *>(p) + 1;
+	const uint64_t chars = size - (count + 2) * sizeof(int64_t);
+	if (offsets[0] != 0 || uint64_t(offsets[count]) > chars) {
+		return false;
+	}
+	for (uint64_t i = 0; i < count; ++i) {
+		if (offsets[i] > offsets[i + 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! A section to be written.
+struct PendingSection {
+	BinaryGraphFile::Section type;
+	uint64_t size;
+	std::function<void(std::ostream&)> write;
+};
+
+template<class T>
+static void writeValues(std::ostream &os, const std::vector<T> &values) {
+	os.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+//! Adds a column of the values returned by \p get for all \p elements if \p enabled.
+template<class T, class E, class Get>
+static void addColumn(std::vector<PendingSection> &sections, bool enabled, BinaryGraphFile::Section type,
+		const Array<E> &elements, Get get)
+{
+	if (enabled) {
+		sections.push_back({type, elements.size() * sizeof(T), [&elements, get](std::ostream &os) {
+			std::vector<T> values(elements.size());
+			for (int i = 0; i < elements.size(); ++i) {
+				values[i] = get(elements[i]);
+			}
+			writeValues(os, values);
+		}});
+	}
+}
+
+//! Adds a string table of \p count strings returned by \p label.
+static void addStringTable(std::vector<PendingSection> &sections, BinaryGraphFile::Section type,
+		int count, std::function<const string&(int)> label)
+{
+	uint64_t chars = 0;
+	for (int i = 0; i < count; ++i) {
+		chars += label(i).size();
+	}
+
+	sections.push_back({type, (count + 2) * sizeof(int64_t) + chars, [count, label](std::ostream &os) {
+		std::vector<int64_t> offsets(count + 2);
+		offsets[0] = count;
+		for (int i = 0; i < count; ++i) {
+			offsets[i + 2] = offsets[i + 1] + int64_t(label(i).size());
+		}
+		writeValues(os, offsets);
+		for (int i = 0; i < count; ++i) {
+			os.write(label(i).data(), label(i).size());
+		}
+	}});
+}
+
+}
+
+using namespace binary_graph;
+
+
+bool BinaryGraphFile::open(const string &filename)
+{
+	m_file.reset(new MappedFile(filename));
+	if (!m_file->good() || !open(m_file->begin(), m_file->size())) {
+		m_file.reset();
+		return false;
+	}
+	return true;
+}
+
+
+bool BinaryGraphFile::open(const char *data, size_t size)
+{
+	m_topology = nullptr;
+	for (uint32_t type = 0; type < MAX_SECTION_TYPES; ++type) {
+		m_sections[type] = nullptr;
+		m_sectionSize[type] = 0;
+	}
+
+	// the columns are used in place, so the data has to be aligned
+	if (size < sizeof(FileHeader) || reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t) != 0) {
+		return false;
+	}
+
+	const FileHeader &header = *reinterpret_cast<const FileHeader *>(data);
+	if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK
+	 || header.version == 0 || header.version > VERSION) {
+		return false;
+	}
+
+	size_t pos = sizeof(FileHeader);
+	for (uint64_t i = 0; i < header.sectionCount; ++i) {
+		if (size - pos < sizeof(SectionHeader)) {
+			return false;
+		}
+		const SectionHeader &sh = *reinterpret_cast<const SectionHeader *>(data + pos);
+		pos += sizeof(SectionHeader);
+
+		if (sh.size > size - pos || padded(sh.size) > size - pos) {
+			return false;
+		}
+
+		// sections of unknown types are skipped
+		if (sh.type < MAX_SECTION_TYPES) {
+			m_sections[sh.type] = data + pos;
+			m_sectionSize[sh.type] = sh.size;
+		}
+		pos += padded(sh.size);
+	}
+
+	// the topology is mandatory
+	const char *topology = m_sections[uint32_t(Section::Topology)];
+	const uint64_t topologySize = m_sectionSize[uint32_t(Section::Topology)];
+	if (topology == nullptr || topologySize < 2 * sizeof(int64_t)) {
+		return false;
+	}
+
+	const int64_t n = reinterpret_cast<const int64_t *>(topology)[0];
+	const int64_t m = reinterpret_cast<const int64_t *>(topology)[1];
+	if (n < 0 || m < 0 || n >= INT_MAX || m > INT_MAX
+	 || topologySize != 2 * sizeof(int64_t) + (n + 1 + m) * sizeof(int32_t)) {
+		return false;
+	}
+
+	m_n = int(n);
+	m_m = int(m);
+	m_offsets = reinterpret_cast<const int32_t *>(topology + 2 * sizeof(int64_t));
+	m_targets = m_offsets + n + 1;
+
+	// the sizes of the other sections have to match the graph
+	for (uint32_t type = 0; type < MAX_SECTION_TYPES; ++type) {
+		const char *p = m_sections[type];
+		const uint64_t sectionSize = m_sectionSize[type];
+		if (p == nullptr) {
+			continue;
+		}
+
+		const uint64_t expected = columnSize(Section(type), n, m);
+		bool valid = expected == 0 || sectionSize == expected;
+
+		switch (Section(type)) {
+		case Section::Attributes:
+			valid = sectionSize == 2 * sizeof(int64_t);
+			break;
+		case Section::NodeLabel:
+			valid = isStringTable(p, sectionSize, n);
+			break;
+		case Section::EdgeLabel:
+			valid = isStringTable(p, sectionSize, m);
+			break;
+		case Section::Clusters: {
+			const int64_t c = sectionSize < sizeof(int64_t) ? 0 : *reinterpret_cast<const int64_t *>(p);
+			valid = c >= 1 && c < INT_MAX && sectionSize == sizeof(int64_t) + (c + n) * sizeof(int32_t);
+			break;
+		}
+		default:
+			break;
+		}
+
+		if (!valid) {
+			return false;
+		}
+	}
+
+	const int64_t *attributes = reinterpret_cast<const int64_t *>(m_sections[uint32_t(Section::Attributes)]);
+	m_attributes = attributes == nullptr ? 0 : long(attributes[0]);
+	m_directed = attributes == nullptr || attributes[1] != 0;
+
+	m_topology = topology;
+	return true;
+}
+
+
+const char *BinaryGraphFile::section(Section s) const
+{
+	return uint32_t(s) < MAX_SECTION_TYPES ? m_sections[uint32_t(s)] : nullptr;
+}
+
+
+string BinaryGraphFile::label(Section s, int i) const
+{
+	const char *p = section(s);
+	OGDF_ASSERT(p != nullptr);
+
+	const int64_t count = *reinterpret_cast<const int64_t *>(p);
+	OGDF_ASSERT(0 <= i);
+	OGDF_ASSERT(i < count);
+
+	const int64_t *offsets = reinterpret_cast<const int64_t *>(p) + 1;
+	const char *chars = reinterpret_cast<const char *>(offsets + count + 1);
+	return string(chars + offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+
+bool BinaryGraphFile::readGraph(Graph &G, Array<node> &nodes) const
+{
+	if (!good()) {
+		return false;
+	}
+
+	// the topology is checked before anything is created
+	if (m_offsets[0] != 0 || m_offsets[m_n] != m_m) {
+		return false;
+	}
+	for (int v = 0; v < m_n; ++v) {
+		if (m_offsets[v] > m_offsets[v + 1]) {
+			return false;
+		}
+	}
+	for (int i = 0; i < m_m; ++i) {
+		if (m_targets[i] < 0 || m_targets[i] >= m_n) {
+			return false;
+		}
+	}
+
+	G.clear();
+	G.newNodes(m_n, &nodes);
+
+	Array<std::pair<node, node>> edgeList(m_m);
+	for (int v = 0; v < m_n; ++v) {
+		for (int i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+			edgeList[i] = std::make_pair(nodes[v], nodes[m_targets[i]]);
+		}
+	}
+	G.newEdges(edgeList);
+
+	return true;
+}
+
+
+bool BinaryGraphFile::read(Graph &G) const
+{
+	Array<node> nodes;
+	return readGraph(G, nodes);
+}
+
+
+bool BinaryGraphFile::read(GraphAttributes &A, Graph &G) const
+{
+	OGDF_ASSERT(&A.constGraph() == &G);
+
+	Array<node> nodes;
+	if (!readGraph(G, nodes)) {
+		return false;
+	}
+
+	if (has(Section::Attributes)) {
+		A.directed() = m_directed;
+	}
+
+	// calls set for every node if attr is enabled in A and section s is stored
+	auto readNodes = [&](long attr, Section s, std::function<void(node, int)> set) {
+		if (A.has(attr) && has(s)) {
+			for (int v = 0; v < m_n; ++v) {
+				set(nodes[v], v);
+			}
+		}
+	};
+
+	const double *x = column<double>(Section::NodeX);
+	const double *y = column<double>(Section::NodeY);
+	const double *z = column<double>(Section::NodeZ);
+	const double *width = column<double>(Section::NodeWidth);
+	const double *height = column<double>(Section::NodeHeight);
+	const int32_t *shape = column<int32_t>(Section::NodeShape);
+	const int32_t *nodeWeight = column<int32_t>(Section::NodeWeight);
+
+	readNodes(GraphAttributes::nodeGraphics, Section::NodeX, [&](node w, int v) { A.x(w) = x[v]; });
+	readNodes(GraphAttributes::nodeGraphics, Section::NodeY, [&](node w, int v) { A.y(w) = y[v]; });
+	readNodes(GraphAttributes::threeD, Section::NodeZ, [&](node w, int v) { A.z(w) = z[v]; });
+	readNodes(GraphAttributes::nodeGraphics, Section::NodeWidth, [&](node w, int v) { A.width(w) = width[v]; });
+	readNodes(GraphAttributes::nodeGraphics, Section::NodeHeight, [&](node w, int v) { A.height(w) = height[v]; });
+	readNodes(GraphAttributes::nodeGraphics, Section::NodeShape, [&](node w, int v) { A.shape(w) = Shape(shape[v]); });
+	readNodes(GraphAttributes::nodeWeight, Section::NodeWeight, [&](node w, int v) { A.weight(w) = nodeWeight[v]; });
+	readNodes(GraphAttributes::nodeLabel, Section::NodeLabel, [&](node w, int v) { A.label(w) = label(Section::NodeLabel, v); });
+
+	// the edges have been created in CSR order
+	const int32_t *intWeight = column<int32_t>(Section::EdgeIntWeight);
+	const double *doubleWeight = column<double>(Section::EdgeDoubleWeight);
+	const bool readIntWeight = A.has(GraphAttributes::edgeIntWeight) && intWeight != nullptr;
+	const bool readDoubleWeight = A.has(GraphAttributes::edgeDoubleWeight) && doubleWeight != nullptr;
+	const bool readLabel = A.has(GraphAttributes::edgeLabel) && has(Section::EdgeLabel);
+
+	int i = 0;
+	for (edge e : G.edges) {
+		if (readIntWeight) {
+			A.intWeight(e) = intWeight[i];
+		}
+		if (readDoubleWeight) {
+			A.doubleWeight(e) = doubleWeight[i];
+		}
+		if (readLabel) {
+			A.label(e) = label(Section::EdgeLabel, i);
+		}
+		++i;
+	}
+
+	return true;
+}
+
+
+bool BinaryGraphFile::read(ClusterGraph &C, Graph &G) const
+{
+	OGDF_ASSERT(&C.constGraph() == &G);
+
+	const char *clusters = section(Section::Clusters);
+	const int c = clusters == nullptr ? 1 : int(*reinterpret_cast<const int64_t *>(clusters));
+	const int32_t *parent = clusters == nullptr ? nullptr : reinterpret_cast<const int32_t *>(clusters + sizeof(int64_t));
+	const int32_t *nodeCluster = parent == nullptr ? nullptr : parent + c;
+
+	// the parent of a cluster precedes it
+	for (int i = 1; i < c; ++i) {
+		if (parent[i] < 0 || parent[i] >= i) {
+			return false;
+		}
+	}
+	for (int v = 0; nodeCluster != nullptr && v < m_n; ++v) {
+		if (nodeCluster[v] < 0 || nodeCluster[v] >= c) {
+			return false;
+		}
+	}
+
+	// clearing the graph resets the clustering to the root cluster
+	Array<node> nodes;
+	if (!readGraph(G, nodes)) {
+		return false;
+	}
+
+	if (clusters == nullptr) {
+		return true;
+	}
+
+	Array<cluster> cl(c);
+	cl[0] = C.rootCluster();
+	for (int i = 1; i < c; ++i) {
+		cl[i] = C.newCluster(cl[parent[i]]);
+	}
+	for (int v = 0; v < m_n; ++v) {
+		if (nodeCluster[v] != 0) {
+			C.reassignNode(nodes[v], cl[nodeCluster[v]]);
+		}
+	}
+
+	return true;
+}
+
+
+bool BinaryGraphFile::write(const Graph &G, const GraphAttributes *A, const ClusterGraph *C, std::ostream &os)
+{
+	OGDF_ASSERT(A == nullptr || &A->constGraph() == &G);
+	OGDF_ASSERT(C == nullptr || &C->constGraph() == &G);
+
+	if (!os.good()) {
+		return false;
+	}
+
+	const int n = G.numberOfNodes();
+	const int m = G.numberOfEdges();
+
+	Array<node> nodes(n);
+	NodeArray<int> id(G);
+	int i = 0;
+	for (node v : G.nodes) {
+		nodes[i] = v;
+		id[v] = i++;
+	}
+
+	// the edges in CSR order
+	Array<edge> edges(m);
+	std::vector<int32_t> offsets(n + 1), targets(m);
+	i = 0;
+	for (int v = 0; v < n; ++v) {
+		offsets[v] = i;
+		for (adjEntry adj : nodes[v]->adjEntries) {
+			if (adj->isSource()) {
+				edges[i] = adj->theEdge();
+				targets[i++] = id[adj->twinNode()];
+			}
+		}
+	}
+	offsets[n] = i;
+
+	std::vector<PendingSection> sections;
+	sections.push_back({Section::Topology, 2 * sizeof(int64_t) + (n + 1 + m) * sizeof(int32_t), [&](std::ostream &out) {
+		std::vector<int64_t> counts = {n, m};
+		writeValues(out, counts);
+		writeValues(out, offsets);
+		writeValues(out, targets);
+	}});
+
+	if (A != nullptr) {
+		const long stored = A->attributes() & (GraphAttributes::nodeGraphics | GraphAttributes::threeD
+			| GraphAttributes::nodeWeight | GraphAttributes::nodeLabel
+			| GraphAttributes::edgeIntWeight | GraphAttributes::edgeDoubleWeight | GraphAttributes::edgeLabel);
+
+		sections.push_back({Section::Attributes, 2 * sizeof(int64_t), [A, stored](std::ostream &out) {
+			std::vector<int64_t> values = {stored, A->directed() ? 1 : 0};
+			writeValues(out, values);
+		}});
+
+		auto has = [A](long attr) { return A->has(attr); };
+
+		addColumn<double>(sections, has(GraphAttributes::nodeGraphics), Section::NodeX, nodes, [A](node v) { return A->x(v); });
+		addColumn<double>(sections, has(GraphAttributes::nodeGraphics), Section::NodeY, nodes, [A](node v) { return A->y(v); });
+		addColumn<double>(sections, has(GraphAttributes::threeD), Section::NodeZ, nodes, [A](node v) { return A->z(v); });
+		addColumn<double>(sections, has(GraphAttributes::nodeGraphics), Section::NodeWidth, nodes, [A](node v) { return A->width(v); });
+		addColumn<double>(sections, has(GraphAttributes::nodeGraphics), Section::NodeHeight, nodes, [A](node v) { return A->height(v); });
+		addColumn<int32_t>(sections, has(GraphAttributes::nodeGraphics), Section::NodeShape, nodes, [A](node v) { return int32_t(A->shape(v)); });
+		addColumn<int32_t>(sections, has(GraphAttributes::nodeWeight), Section::NodeWeight, nodes, [A](node v) { return A->weight(v); });
+		addColumn<int32_t>(sections, has(GraphAttributes::edgeIntWeight), Section::EdgeIntWeight, edges, [A](edge e) { return A->intWeight(e); });
+		addColumn<double>(sections, has(GraphAttributes::edgeDoubleWeight), Section::EdgeDoubleWeight, edges, [A](edge e) { return A->doubleWeight(e); });
+
+		if (A->has(GraphAttributes::nodeLabel)) {
+			addStringTable(sections, Section::NodeLabel, n, [A, &nodes](int v) -> const string& { return A->label(nodes[v]); });
+		}
+		if (A->has(GraphAttributes::edgeLabel)) {
+			addStringTable(sections, Section::EdgeLabel, m, [A, &edges](int e) -> const string& { return A->label(edges[e]); });
+		}
+	}
+
+	// the clusters in preorder, so every parent precedes its children
+	std::vector<int32_t> clusterParents, nodeClusters;
+	if (C != nullptr) {
+		ClusterArray<int> clusterId(*C, -1);
+		std::vector<cluster> order = {C->rootCluster()};
+		clusterParents.push_back(-1);
+		clusterId[C->rootCluster()] = 0;
+
+		for (size_t j = 0; j < order.size(); ++j) {
+			for (cluster child : order[j]->children) {
+				clusterId[child] = int(order.size());
+				clusterParents.push_back(int32_t(j));
+				order.push_back(child);
+			}
+		}
+
+		nodeClusters.resize(n);
+		for (int v = 0; v < n; ++v) {
+			nodeClusters[v] = clusterId[C->clusterOf(nodes[v])];
+		}
+
+		sections.push_back({Section::Clusters, sizeof(int64_t) + (clusterParents.size() + n) * sizeof(int32_t), [&](std::ostream &out) {
+			std::vector<int64_t> count = {int64_t(clusterParents.size())};
+			writeValues(out, count);
+			writeValues(out, clusterParents);
+			writeValues(out, nodeClusters);
+		}});
+	}
+
+	FileHeader header;
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.version = VERSION;
+	header.sectionCount = sections.size();
+	os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	const char padding[8] = {};
+	for (const PendingSection &s : sections) {
+		SectionHeader sh = {uint32_t(s.type), 0, s.size};
+		os.write(reinterpret_cast<const char *>(&sh), sizeof(sh));
+		s.write(os);
+		os.write(padding, padded(s.size) - s.size);
+	}
+
+	return os.good();
+}
+
+}
@@ -119,6 +119,8 @@ const std::vector<GraphIO::FileType> GraphIO::FILE_TYPES = {
 		GraphIO::FileType({"dmf"}, GraphIO::readDMF, nullptr, GraphIO::readDMF, nullptr),
 		GraphIO::FileType({"pm", "pmd"}, GraphIO::readPMDissGraph, GraphIO::writePMDissGraph),
 		GraphIO::FileType({"rudy"}, GraphIO::readRudy, nullptr, GraphIO::readRudy, GraphIO::writeRudy),
+		GraphIO::FileType({"ogb"}, GraphIO::readBinary, GraphIO::writeBinary, GraphIO::readBinary, GraphIO::writeBinary,
+					GraphIO::readBinary, GraphIO::writeBinary),
 
 		// SVG can only write GraphAttributes and ClusterGraphAttributes
 		GraphIO::FileType({"svg"}, nullptr, nullptr, nullptr, GraphIO::drawSVG,
@@ -131,6 +133,8 @@ const std::vector<GraphIO::FileType> GraphIO::FILE_TYPES = {
 //				.replaceAutoReaders(nullptr), // readYGraph("dl/invalid/*.dl") == true
 		GraphIO::FileType({"mtx"}, GraphIO::readMatrixMarket)
 				.replaceAutoReaders(nullptr), // otherwise accepts many (~42) invalid files of other formats
+		GraphIO::FileType({"edges", "el", "col"}, GraphIO::readEdgeList)
+				.replaceAutoReaders(nullptr), // accepts any file of numbers
 
 		// The following graph formats have no corresponding generic ReaderFunc:
 //		GraphIO::FileType( {}, GraphIO::readBENCH, nullptr,GraphIO::readBENCH), // (Hypergraph)
@@ -767,108 +771,6 @@ bool GraphIO::readGML(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, std:
 	return gml.read(G, A) && gml.readCluster(G, C, &A);
 }
 
-bool GraphIO::readMatrixMarket(Graph& G, std::istream &inStream)
-{
-	// check if the stream is good
-	if (!inStream.good())
-		return false;
-
-	// clear the graph
-	G.clear();
-
-	// flag for reading the first triplet because it is special
-	bool isFirstEntry = true;
-
-	// simple map to map from indices to nodes
-	std::map<int, node> idToNodeMap;
-
-	// while there is somethng to read
-	while (!inStream.eof())
-	{
-		// the current line
-		std::string line;
-
-		// read one line at a time
-		getline(inStream, line);
-
-		// skip empty lines
-		if (line.empty())
-			continue;
-
-		// skip comments
-		if (line.at(0) == '%')
-			continue;
-
-		// stringstream for the single line
-		std::stringstream fin(line);
-
-		// if this is the real line (triplet
-		if (isFirstEntry)
-		{
-			// read the number of rows, columns and non zero entries
-			int numRows, numCols, numNonZero;
-
-			// read triplet
-			fin >> numRows;
-			fin >> numCols;
-			fin >> numNonZero;
-
-			// set flag that we parsed that line
-			isFirstEntry = false;
-		} else
-		{
-			// the usual triplet ( row and column indices and the corresponding weight
-			int rowIndex, colIndex;
-			double weight;
-
-			// read the triplet
-			fin >> rowIndex;
-			fin >> colIndex;
-			fin >> weight;
-
-			// node corresponding to the row
-			node s = nullptr;
-
-			// and to the column
-			node t = nullptr;
-
-			// look up the nodes in the map
-			std::map<int, node>::const_iterator s_it = idToNodeMap.find(rowIndex);
-			std::map<int, node>::const_iterator t_it = idToNodeMap.find(colIndex);
-
-			// check if we already created the node
-			if (s_it == idToNodeMap.end())
-			{
-				// no we did not, create it
-				s = G.newNode();
-				// and put it in the map
-				idToNodeMap[rowIndex] = s;
-			} else {
-				// we did, get it
-				s = (*s_it).second;
-			}
-
-			// check if we already created the node
-			if (t_it == idToNodeMap.end())
-			{
-				// no we did not, create it
-				t = G.newNode();
-				// and put it in the map
-				idToNodeMap[colIndex] = t;
-			} else {
-				 // we did, get it
-				t = (*t_it).second;
-			}
-
-			// both nodes are there now, create the edge
-			G.newEdge(s, t);
-		}
-	}
-
-	makeParallelFree(G);
-	return true;
-}
-
 bool GraphIO::readChallengeGraph(Graph &G, GridLayout &gl, std::istream &is)
 {
 	if(!is.good()) return false;
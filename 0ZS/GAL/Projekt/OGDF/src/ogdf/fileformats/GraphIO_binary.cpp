@@ -0,0 +1,97 @@
+/** \file
+ * \brief Implements the binary graph format of GraphIO using ogdf::BinaryGraphFile
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/fileformats/BinaryGraphFile.h>
+
+#include <iterator>
+#include <vector>
+
+namespace ogdf {
+
+namespace binary_graph {
+
+//! Reads the whole stream \p is into \p buffer and opens it as \p file.
+static bool openStream(std::istream &is, std::vector<uint64_t> &buffer, BinaryGraphFile &file)
+{
+	if (!is.good()) {
+		return false;
+	}
+
+	std::string data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+	// the buffer of words keeps the columns aligned
+	buffer.resize((data.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+	data.copy(reinterpret_cast<char *>(buffer.data()), data.size());
+
+	return file.open(reinterpret_cast<const char *>(buffer.data()), data.size());
+}
+
+}
+
+bool GraphIO::readBinary(Graph &G, std::istream &is)
+{
+	std::vector<uint64_t> buffer;
+	BinaryGraphFile file;
+	return binary_graph::openStream(is, buffer, file) && file.read(G);
+}
+
+bool GraphIO::readBinary(GraphAttributes &A, Graph &G, std::istream &is)
+{
+	std::vector<uint64_t> buffer;
+	BinaryGraphFile file;
+	return binary_graph::openStream(is, buffer, file) && file.read(A, G);
+}
+
+bool GraphIO::readBinary(ClusterGraph &C, Graph &G, std::istream &is)
+{
+	std::vector<uint64_t> buffer;
+	BinaryGraphFile file;
+	return binary_graph::openStream(is, buffer, file) && file.read(C, G);
+}
+
+bool GraphIO::writeBinary(const Graph &G, std::ostream &os)
+{
+	return BinaryGraphFile::write(G, nullptr, nullptr, os);
+}
+
+bool GraphIO::writeBinary(const GraphAttributes &A, std::ostream &os)
+{
+	return BinaryGraphFile::write(A.constGraph(), &A, nullptr, os);
+}
+
+bool GraphIO::writeBinary(const ClusterGraph &C, std::ostream &os)
+{
+	return BinaryGraphFile::write(C.constGraph(), nullptr, &C, os);
+}
+
+}
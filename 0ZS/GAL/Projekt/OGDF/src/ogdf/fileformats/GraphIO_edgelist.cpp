@@ -0,0 +1,351 @@
+/** \file
+ * \brief Implements reading of Matrix Market files and edge lists
+ *        (SNAP, DIMACS) from memory-mapped files in parallel.
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/fileformats/MappedFile.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/Thread.h>
+
+#include <climits>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+namespace ogdf {
+
+namespace edgelist {
+
+//! The minimal number of bytes parsed by a single thread.
+constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+
+//! The syntax of the lines of a file.
+enum class Format { MatrixMarket, EdgeList };
+
+static inline bool isBlank(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool isDigit(char c) {
+	return unsigned(c - '0') <= 9;
+}
+
+//! Returns the beginning of the line after the one \p p points into.
+static inline const char *nextLine(const char *p, const char *end) {
+	const char *q = static_cast<const char *>(memchr(p, '\n', end - p));
+	return q == nullptr ? end : q + 1;
+}
+
+//! Returns the first character at or after \p p that is not blank.
+static inline const char *skipBlanks(const char *p, const char *end) {
+	while (p != end && isBlank(*p)) {
+		++p;
+	}
+	return p;
+}
+
+//! Scans a non-negative integer after optional blanks, returns the position after it or nullptr if there is none.
+static inline const char *scanInt(const char *p, const char *end, int &value) {
+	p = skipBlanks(p, end);
+	if (p == end || !isDigit(*p)) {
+		return nullptr;
+	}
+
+	long long x = 0;
+	do {
+		x = 10 * x + (*p++ - '0');
+		if (x > INT_MAX) {
+			return nullptr;
+		}
+	} while (p != end && isDigit(*p));
+
+	// the number has to end with the token
+	if (p != end && !isBlank(*p) && *p != '\n') {
+		return nullptr;
+	}
+
+	value = int(x);
+	return p;
+}
+
+//! Returns whether a line starting with \p c is a comment.
+static inline bool isComment(char c, Format format) {
+	return c == '%' || (format == Format::EdgeList && (c == '#' || c == 'c'));
+}
+
+//! Parses the header of a file, returns the position of the first entry or nullptr if the header is invalid.
+/**
+ * @param numberOfNodes is assigned the number of nodes declared by a DIMACS problem line, or -1.
+ * @param numberOfEdges is assigned the number of entries announced by the header, or -1.
+ */
+static const char *parseHeader(const char *p, const char *end, Format format, int &numberOfNodes, int &numberOfEdges)
+{
+	numberOfNodes = numberOfEdges = -1;
+
+	while (p != end) {
+		const char *q = skipBlanks(p, end);
+
+		if (q == end) {
+			return end;
+		} else if (*q == '\n' || isComment(*q, format)) {
+			p = nextLine(q, end);
+		} else if (format == Format::MatrixMarket) {
+			// the size line: numbers of rows, columns and entries
+			int rows, cols;
+			if ((q = scanInt(q, end, rows)) == nullptr
+			 || (q = scanInt(q, end, cols)) == nullptr
+			 || (q = scanInt(q, end, numberOfEdges)) == nullptr) {
+				return nullptr;
+			}
+			return nextLine(q, end);
+		} else if (*q == 'p') {
+			// the DIMACS problem line "p <format> n m"
+			q = skipBlanks(q + 1, end);
+			while (q != end && !isBlank(*q) && *q != '\n') {
+				++q;
+			}
+			if ((q = scanInt(q, end, numberOfNodes)) == nullptr
+			 || (q = scanInt(q, end, numberOfEdges)) == nullptr) {
+				return nullptr;
+			}
+			p = nextLine(q, end);
+		} else {
+			return p;
+		}
+	}
+
+	return end;
+}
+
+//! Parses the entries in [\p p, \p end), each one adds a pair of ids to \p ids.
+static bool parseEntries(const char *p, const char *end, Format format, std::vector<int> &ids)
+{
+	while (p != end) {
+		const char *q = skipBlanks(p, end);
+
+		if (q == end) {
+			break;
+		} else if (*q == '\n' || isComment(*q, format)) {
+			p = nextLine(q, end);
+			continue;
+		}
+
+		if (format == Format::EdgeList && *q == 'e') {
+			++q;
+		}
+
+		// further columns (e.g., the values of a matrix) are ignored
+		int u, v;
+		if ((q = scanInt(q, end, u)) == nullptr || (q = scanInt(q, end, v)) == nullptr) {
+			return false;
+		}
+
+		ids.push_back(u);
+		ids.push_back(v);
+		p = nextLine(q, end);
+	}
+
+	return true;
+}
+
+//! Parses the entries in [\p begin, \p end) by up to \p numberOfThreads threads, each one filling a part of \p chunks.
+static bool parseChunks(const char *begin, const char *end, Format format, unsigned int numberOfThreads,
+		std::vector<std::vector<int>> &chunks)
+{
+	const size_t size = end - begin;
+	const size_t nChunks = min(size_t(resolveNumberOfThreads(numberOfThreads)), max(size / MIN_CHUNK_SIZE, size_t(1)));
+
+	// the chunks are split at line boundaries
+	std::vector<const char *> bounds(nChunks + 1);
+	bounds[0] = begin;
+	for (size_t i = 1; i < nChunks; ++i) {
+		bounds[i] = max(bounds[i - 1], nextLine(begin + i * (size / nChunks), end));
+	}
+	bounds[nChunks] = end;
+
+	chunks.resize(nChunks);
+	Array<bool> good(0, int(nChunks) - 1, false);
+
+	runThreads(unsigned(nChunks), [&](unsigned int i) {
+		good[int(i)] = parseEntries(bounds[i], bounds[i + 1], format, chunks[i]);
+	});
+
+	for (bool chunkGood : good) {
+		if (!chunkGood) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Maps the ids in \p chunks to dense indices in the order of their first appearance.
+static int mapIds(std::vector<std::vector<int>> &chunks, Array<int> &index)
+{
+	int n = 0;
+	for (std::vector<int> &ids : chunks) {
+		for (int &id : ids) {
+			int &v = index[id];
+			if (v < 0) {
+				v = n++;
+			}
+			id = v;
+		}
+	}
+	return n;
+}
+
+//! Creates the nodes and edges of \p G from the ids in \p chunks.
+static bool buildGraph(Graph &G, std::vector<std::vector<int>> &chunks, int numberOfNodes)
+{
+	size_t m = 0;
+	int maxId = -1;
+	for (const std::vector<int> &ids : chunks) {
+		m += ids.size() / 2;
+		for (int id : ids) {
+			maxId = max(maxId, id);
+		}
+	}
+	if (m > size_t(INT_MAX)) {
+		return false;
+	}
+
+	if (numberOfNodes >= 0) {
+		// DIMACS ids are 1, ..., n
+		for (std::vector<int> &ids : chunks) {
+			for (int &id : ids) {
+				if (id < 1 || id > numberOfNodes) {
+					return false;
+				}
+				--id;
+			}
+		}
+	} else if (size_t(maxId) <= 4 * m + (1 << 16)) {
+		Array<int> index(0, maxId, -1);
+		numberOfNodes = mapIds(chunks, index);
+	} else {
+		// the ids are too sparse for an array
+		std::unordered_map<int, int> index(2 * m);
+		numberOfNodes = 0;
+		for (std::vector<int> &ids : chunks) {
+			for (int &id : ids) {
+				id = index.emplace(id, numberOfNodes).first->second;
+				if (id == numberOfNodes) {
+					++numberOfNodes;
+				}
+			}
+		}
+	}
+
+	Array<node> nodes;
+	G.newNodes(numberOfNodes, &nodes);
+
+	Array<std::pair<node, node>> edgeList(static_cast<int>(m));
+	int i = 0;
+	for (const std::vector<int> &ids : chunks) {
+		for (size_t j = 0; j < ids.size(); j += 2) {
+			edgeList[i++] = std::make_pair(nodes[ids[j]], nodes[ids[j + 1]]);
+		}
+	}
+	G.newEdges(edgeList);
+
+	return true;
+}
+
+//! Reads \p G from the contents [\p begin, \p end) of a file.
+static bool read(Graph &G, const char *begin, const char *end, Format format, unsigned int numberOfThreads)
+{
+	G.clear();
+
+	// an empty file is an empty graph (and MappedFile maps it to a range without a pointer)
+	if (begin == end) {
+		return true;
+	}
+
+	int numberOfNodes, numberOfEdges;
+	const char *body = parseHeader(begin, end, format, numberOfNodes, numberOfEdges);
+	if (body == nullptr || (format == Format::MatrixMarket && numberOfEdges < 0)) {
+		return false;
+	}
+
+	std::vector<std::vector<int>> chunks;
+	if (!parseChunks(body, end, format, numberOfThreads, chunks)
+	 || !buildGraph(G, chunks, format == Format::EdgeList ? numberOfNodes : -1)) {
+		G.clear();
+		return false;
+	}
+
+	if (format == Format::MatrixMarket) {
+		makeParallelFree(G);
+	}
+	return true;
+}
+
+//! Reads \p G from stream \p is.
+static bool read(Graph &G, std::istream &is, Format format)
+{
+	if (!is.good()) {
+		return false;
+	}
+
+	string buffer{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+	return read(G, buffer.data(), buffer.data() + buffer.size(), format, 0);
+}
+
+//! Reads \p G from the file \p filename.
+static bool read(Graph &G, const string &filename, Format format, unsigned int numberOfThreads)
+{
+	MappedFile file(filename);
+	return file.good() && read(G, file.begin(), file.end(), format, numberOfThreads);
+}
+
+}
+
+bool GraphIO::readMatrixMarket(Graph &G, std::istream &inStream)
+{
+	return edgelist::read(G, inStream, edgelist::Format::MatrixMarket);
+}
+
+bool GraphIO::readMatrixMarketFile(Graph &G, const string &filename, unsigned int numberOfThreads)
+{
+	return edgelist::read(G, filename, edgelist::Format::MatrixMarket, numberOfThreads);
+}
+
+bool GraphIO::readEdgeList(Graph &G, std::istream &is)
+{
+	return edgelist::read(G, is, edgelist::Format::EdgeList);
+}
+
+bool GraphIO::readEdgeListFile(Graph &G, const string &filename, unsigned int numberOfThreads)
+{
+	return edgelist::read(G, filename, edgelist::Format::EdgeList, numberOfThreads);
+}
+
+}
@@ -0,0 +1,95 @@
+/** \file
+ * \brief Implementation of ogdf::MappedFile
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/fileformats/MappedFile.h>
+
+#include <fstream>
+#include <iterator>
+
+#ifdef OGDF_SYSTEM_UNIX
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace ogdf {
+
+MappedFile::MappedFile(const string &filename)
+{
+#ifdef OGDF_SYSTEM_UNIX
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+		m_size = size_t(st.st_size);
+		m_good = true;
+
+		if (m_size > 0) {
+			void *p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED) {
+				madvise(p, m_size, MADV_SEQUENTIAL);
+				m_data = static_cast<const char *>(p);
+				m_mapped = true;
+			}
+		}
+	}
+	close(fd);
+
+	if (m_mapped || (m_good && m_size == 0)) {
+		return;
+	}
+#endif
+	// the file cannot be mapped, read it at once
+	std::ifstream is(filename, std::ios::binary);
+	m_good = is.good();
+	if (m_good) {
+		m_buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+	}
+}
+
+
+MappedFile::~MappedFile()
+{
+#ifdef OGDF_SYSTEM_UNIX
+	if (m_mapped) {
+		munmap(const_cast<char *>(m_data), m_size);
+	}
+#endif
+}
+
+}
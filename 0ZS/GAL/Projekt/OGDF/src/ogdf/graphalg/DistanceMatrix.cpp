@@ -0,0 +1,227 @@
+/** \file
+ * \brief Implementation of ogdf::DistanceMatrix
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/graphalg/DistanceMatrix.h>
+#include <ogdf/basic/Math.h>
+#include <ogdf/basic/Thread.h>
+
+#include <atomic>
+#include <queue>
+
+namespace ogdf {
+
+namespace distance_matrix {
+
+//! The number of sources a thread takes at once.
+constexpr int SOURCE_BLOCK = 16;
+
+//! Returns the number of threads used for \p n sources if at most \p numberOfThreads (0 for all processors) are allowed.
+static unsigned int threadCount(int n, unsigned int numberOfThreads)
+{
+	return max(1u, min(resolveNumberOfThreads(numberOfThreads), unsigned((n + SOURCE_BLOCK - 1) / SOURCE_BLOCK)));
+}
+
+//! Computes the hop counts from \p s into \p row, which is filled with \p unreachable.
+/**
+ * The row serves as the marks of the search; \p queue has room for all nodes.
+ * @return the largest hop count.
+ */
+template<typename T>
+static T bfsRow(const CompactGraph &G, int s, T *row, T unreachable, Array<int> &queue)
+{
+	const int n = G.numberOfNodes();
+	std::fill(row, row + n, unreachable);
+
+	int head = 0, tail = 0;
+	queue[tail++] = s;
+	row[s] = T(0);
+	T d = T(0);
+
+	while (head < tail) {
+		const int w = queue[head++];
+		d = row[w];
+		const T next = d + T(1);
+		for (int i = G.offset(w); i < G.offset(w + 1); ++i) {
+			const int v = G.target(i);
+			if (row[v] == unreachable) {
+				row[v] = next;
+				queue[tail++] = v;
+			}
+		}
+	}
+
+	// the last node taken from the queue is the farthest one
+	return d;
+}
+
+//! Computes the distances from \p s into \p row using %Dijkstra's algorithm.
+/**
+ * \p distance is a buffer for all nodes.
+ * @return the largest finite distance.
+ */
+template<typename T>
+static double dijkstraRow(const CompactGraph &G, int s, const Array<double> &edgeCosts, T *row, Array<double> &distance)
+{
+	using Entry = std::pair<double, int>;
+
+	const int n = G.numberOfNodes();
+	const double infinity = std::numeric_limits<double>::infinity();
+	distance.fill(infinity);
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	distance[s] = 0.0;
+	queue.push(Entry(0.0, s));
+	double farthest = 0.0;
+
+	while (!queue.empty()) {
+		const Entry top = queue.top();
+		queue.pop();
+		const int v = top.second;
+		if (top.first > distance[v]) {
+			continue;
+		}
+		farthest = top.first;
+
+		for (int i = G.offset(v); i < G.offset(v + 1); ++i) {
+			const int w = G.target(i);
+			const double d = top.first + edgeCosts[G.edgeOf(i)];
+			OGDF_ASSERT(edgeCosts[G.edgeOf(i)] >= 0);
+
+			if (d < distance[w]) {
+				distance[w] = d;
+				queue.push(Entry(d, w));
+			}
+		}
+	}
+
+	for (int v = 0; v < n; ++v) {
+		row[v] = T(distance[v]);
+	}
+	return farthest;
+}
+
+}
+
+using namespace distance_matrix;
+
+
+void DistanceMatrix::init(const Graph &G, Storage storage)
+{
+	m_graph.init(G);
+	m_n = m_graph.numberOfNodes();
+	m_storage = storage;
+	m_unit = 1.0;
+	m_maxDistance = 0.0;
+
+	const size_t entries = size_t(m_n) * m_n;
+	std::vector<uint16_t>().swap(m_hops);
+	std::vector<float>().swap(m_float);
+	std::vector<double>().swap(m_double);
+
+	switch (storage) {
+	case Storage::Hops16:
+		m_hops.resize(entries);
+		break;
+	case Storage::Float:
+		m_float.resize(entries);
+		break;
+	case Storage::Double:
+		m_double.resize(entries);
+		break;
+	}
+}
+
+
+void DistanceMatrix::computeHops(const Graph &G, double edgeCosts, unsigned int numberOfThreads)
+{
+	// the largest hop count is n - 1, which has to differ from UNREACHABLE_HOPS
+	init(G, G.numberOfNodes() < UNREACHABLE_HOPS ? Storage::Hops16 : Storage::Float);
+	m_unit = edgeCosts;
+
+	const unsigned int nThreads = threadCount(m_n, numberOfThreads);
+	std::atomic<int> nextSource(0);
+	Array<double> maxHops(0, nThreads - 1, 0.0);
+
+	runThreads(nThreads, [&](unsigned int t) {
+		Array<int> queue(m_n);
+		for (int begin; (begin = nextSource.fetch_add(SOURCE_BLOCK)) < m_n; ) {
+			for (int s = begin; s < min(begin + SOURCE_BLOCK, m_n); ++s) {
+				double hops;
+				if (m_storage == Storage::Hops16) {
+					hops = bfsRow(m_graph, s, &m_hops[size_t(s) * m_n], UNREACHABLE_HOPS, queue);
+				} else {
+					hops = bfsRow(m_graph, s, &m_float[size_t(s) * m_n], std::numeric_limits<float>::infinity(), queue);
+				}
+				Math::updateMax(maxHops[t], hops);
+			}
+		}
+	});
+
+	for (double hops : maxHops) {
+		Math::updateMax(m_maxDistance, hops * m_unit);
+	}
+}
+
+
+void DistanceMatrix::compute(const Graph &G, const EdgeArray<double> &edgeCosts, Storage storage, unsigned int numberOfThreads)
+{
+	OGDF_ASSERT(storage != Storage::Hops16);
+	init(G, storage);
+
+	Array<double> denseCosts;
+	m_graph.gatherEdges(edgeCosts, denseCosts);
+
+	const unsigned int nThreads = threadCount(m_n, numberOfThreads);
+	std::atomic<int> nextSource(0);
+	Array<double> maxDistance(0, nThreads - 1, 0.0);
+
+	runThreads(nThreads, [&](unsigned int t) {
+		Array<double> distance(m_n);
+		for (int begin; (begin = nextSource.fetch_add(SOURCE_BLOCK)) < m_n; ) {
+			for (int s = begin; s < min(begin + SOURCE_BLOCK, m_n); ++s) {
+				double farthest;
+				if (m_storage == Storage::Float) {
+					farthest = dijkstraRow(m_graph, s, denseCosts, &m_float[size_t(s) * m_n], distance);
+				} else {
+					farthest = dijkstraRow(m_graph, s, denseCosts, &m_double[size_t(s) * m_n], distance);
+				}
+				Math::updateMax(maxDistance[t], farthest);
+			}
+		}
+	});
+
+	for (double d : maxDistance) {
+		Math::updateMax(m_maxDistance, d);
+	}
+}
+
+}
@@ -31,6 +31,12 @@
 
 
 #include <ogdf/graphalg/PageRank.h>
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Math.h>
+#include <ogdf/basic/Thread.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace ogdf {
 
@@ -121,4 +127,623 @@ void BasicPageRank::call(
 	// result is now between 0 and 1
 }
 
+
+void BasicPageRank::call(
+	const CompactGraph& graph,
+	const Array<double>& edgeWeight,
+	Array<double>& pageRankResult)
+{
+	const int n = graph.numberOfNodes();
+	const double initialPageRank = 1.0 / (double)n;
+	const double maxPageRankDeltaBound = initialPageRank * m_threshold;
+
+	// the two ping pong buffer
+	Array<double> pageRankPing(0, n - 1, initialPageRank);
+	Array<double> pageRankPong(0, n - 1, 0.0);
+
+	Array<double>* pCurrPageRank = &pageRankPing;
+	Array<double>* pNextPageRank = &pageRankPong;
+
+	// the weight of each entry, normalized by the total weight of its node
+	Array<double> entryWeight(graph.numberOfEntries());
+	for (int v = 0; v < n; ++v)
+	{
+		double sum = 0.0;
+		for (int i = graph.offset(v); i < graph.offset(v + 1); ++i)
+		{
+			sum += edgeWeight[graph.edgeOf(i)];
+		}
+		const double norm = 1.0 / sum;
+		for (int i = graph.offset(v); i < graph.offset(v + 1); ++i)
+		{
+			entryWeight[graph.twin(i)] = edgeWeight[graph.edgeOf(i)] * norm;
+		}
+	}
+
+	// main iteration loop
+	int numIterations = 0;
+	bool converged = false;
+	while ( !converged && (numIterations < m_maxNumIterations) )
+	{
+		const double* curr = pCurrPageRank->begin();
+		double* next = pNextPageRank->begin();
+
+		// every node pulls the transfer from its neighbours, then damping and calculating change
+		double maxPageRankDelta = 0.0;
+		for (int v = 0; v < n; ++v)
+		{
+			double rank = 0.0;
+			for (int i = graph.offset(v); i < graph.offset(v + 1); ++i)
+			{
+				rank += entryWeight[i] * curr[graph.target(i)];
+			}
+			next[v] = m_dampingFactor * ((1.0 - m_dampingFactor) / (double)n + rank);
+			maxPageRankDelta = std::max(maxPageRankDelta, fabs(next[v] - curr[v]));
+		}
+
+		std::swap(pNextPageRank, pCurrPageRank);
+		numIterations++;
+
+		// check if the change is small enough
+		converged = (maxPageRankDelta < maxPageRankDeltaBound);
+	}
+
+	// normalization
+	pageRankResult.init(n);
+	if (n == 0)
+	{
+		return;
+	}
+
+	double maxPageRank = (*pCurrPageRank)[0];
+	double minPageRank = (*pCurrPageRank)[0];
+	for (int v = 0; v < n; ++v)
+	{
+		maxPageRank = std::max(maxPageRank, (*pCurrPageRank)[v]);
+		minPageRank = std::min(minPageRank, (*pCurrPageRank)[v]);
+	}
+
+	for (int v = 0; v < n; ++v)
+	{
+		pageRankResult[v] = ((*pCurrPageRank)[v] - minPageRank) / (maxPageRank - minPageRank);
+	}
+	// result is now between 0 and 1
+}
+
+
+namespace pagerank {
+
+//! The minimal work (adjacency entries plus nodes) per thread.
+constexpr long long MIN_WORK_PER_THREAD = 1 << 16;
+
+//! The number of rank vectors interleaved by the personalized iteration.
+constexpr int BATCH_SIZE = 8;
+
+//! The transition matrix of the random surfer on a graph snapshot.
+/**
+ * A node pulls along the entries [pullBegin(v), pullEnd(v)) from their targets, and
+ * pushes along the entries [pushBegin(u), pushEnd(u)) to their targets. The surfer
+ * moves from u to the target of such a push entry i with probability
+ * weight(i) * invWeight[u].
+ */
+class Transition {
+public:
+	Transition(const CompactGraph& C, const Array<double>* edgeWeight, bool directed, unsigned int numberOfThreads)
+		: m_graph(C), m_directed(directed), m_weighted(edgeWeight != nullptr)
+	{
+		const int n = C.numberOfNodes();
+
+		if (m_weighted) {
+			m_entryWeight.init(C.numberOfEntries());
+			for (int i = 0; i < C.numberOfEntries(); ++i) {
+				m_entryWeight[i] = (*edgeWeight)[C.edgeOf(i)];
+			}
+		}
+
+		m_invWeight.init(n);
+		for (int u = 0; u < n; ++u) {
+			double sum = 0;
+			for (int i = pushBegin(u); i < pushEnd(u); ++i) {
+				sum += weight(i);
+			}
+			m_invWeight[u] = sum > 0 ? 1 / sum : 0;
+			if (sum <= 0) {
+				m_dangling.push_back(u);
+			}
+		}
+
+		// the nodes are split into ranges of about the same numbers of entries plus nodes
+		const long long work = (long long)C.numberOfEntries() + n;
+		numberOfThreads = unsigned(max(1LL, min((long long)resolveNumberOfThreads(numberOfThreads), work / MIN_WORK_PER_THREAD)));
+
+		m_bounds.resize(numberOfThreads + 1);
+		m_bounds[0] = 0;
+		for (unsigned int t = 1; t < numberOfThreads; ++t) {
+			const long long bound = work * t / numberOfThreads;
+			int lo = m_bounds[t - 1], hi = n;
+			while (lo < hi) {
+				const int mid = lo + (hi - lo) / 2;
+				if ((long long)C.offset(mid) + mid < bound) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			m_bounds[t] = lo;
+		}
+		m_bounds[numberOfThreads] = n;
+	}
+
+	const CompactGraph& graph() const { return m_graph; }
+
+	int numberOfNodes() const { return m_graph.numberOfNodes(); }
+
+	unsigned int numberOfThreads() const { return unsigned(m_bounds.size() - 1); }
+
+	//! Returns the first node of the range of thread \p t.
+	int rangeBegin(unsigned int t) const { return m_bounds[t]; }
+
+	//! Returns the end of the range of thread \p t.
+	int rangeEnd(unsigned int t) const { return m_bounds[t + 1]; }
+
+	int pullBegin(int v) const { return m_directed ? m_graph.outEnd(v) : m_graph.offset(v); }
+	int pullEnd(int v) const { return m_graph.offset(v + 1); }
+	int pushBegin(int u) const { return m_graph.offset(u); }
+	int pushEnd(int u) const { return m_directed ? m_graph.outEnd(u) : m_graph.offset(u + 1); }
+
+	double weight(int i) const { return m_weighted ? m_entryWeight[i] : 1.0; }
+
+	//! Returns the reciprocal of the total weight leaving \p u, or 0 if there is none.
+	double invWeight(int u) const { return m_invWeight[u]; }
+
+	//! The nodes without leaving weight.
+	const std::vector<int>& dangling() const { return m_dangling; }
+
+	//! Returns the sum of \p y over the predecessors of \p v, weighted by the weights of the entries.
+	/**
+	 * \p local is read for the nodes in [\p from, \p to), \p y for all others.
+	 */
+	double pull(int v, const double* y, const double* local, int from, int to) const {
+		return m_weighted ? pullEntries<true>(v, y, local, from, to) : pullEntries<false>(v, y, local, from, to);
+	}
+
+	//! Returns the sum of \p y over the predecessors of \p v, weighted by the weights of the entries.
+	double pull(int v, const double* y) const {
+		return pull(v, y, y, 0, 0);
+	}
+
+	//! Adds the values of \p y (interleaved BATCH_SIZE per node) over the predecessors of \p v to \p sum.
+	void pullBatch(int v, const double* y, double* sum) const {
+		const int* target = m_graph.targets();
+		for (int i = pullBegin(v); i < pullEnd(v); ++i) {
+			const double w = weight(i);
+			const double* yu = y + size_t(target[i]) * BATCH_SIZE;
+			for (int b = 0; b < BATCH_SIZE; ++b) {
+				sum[b] += w * yu[b];
+			}
+		}
+	}
+
+private:
+	template<bool Weighted>
+	double pullEntries(int v, const double* y, const double* local, int from, int to) const {
+		const int* target = m_graph.targets();
+		const unsigned int size = unsigned(to - from);
+
+		// two independent sums hide the latency of the additions
+		double sum[2] = {0, 0};
+		const int end = pullEnd(v);
+		int i = pullBegin(v);
+		for (; i < end; ++i) {
+			const int u = target[i];
+			const double yu = unsigned(u - from) < size ? local[u] : y[u];
+			sum[i & 1] += Weighted ? m_entryWeight[i] * yu : yu;
+		}
+		return sum[0] + sum[1];
+	}
+
+	const CompactGraph& m_graph;
+	bool m_directed;
+	bool m_weighted;
+	Array<double> m_entryWeight; //!< The weight of every entry, if weighted.
+	Array<double> m_invWeight; //!< The reciprocal of the leaving weight of every node.
+	std::vector<int> m_dangling; //!< The nodes without leaving weight.
+	std::vector<int> m_bounds; //!< The ranges of the nodes of the threads.
+};
+
+//! Sums \p values up.
+static double sum(const Array<double>& values)
+{
+	double result = 0;
+	for (double value : values) {
+		result += value;
+	}
+	return result;
+}
+
+//! Runs the power iteration on \p rank, returns the number of iterations.
+static int powerIteration(const Transition& T, double damping, double tolerance, int maxNumIterations,
+		Array<double>& rank, double& residual)
+{
+	const int n = T.numberOfNodes();
+	Array<double> next(n), y(n), yNext(n);
+	Array<double> partial(0, int(T.numberOfThreads()) - 1, 0.0);
+
+	for (int v = 0; v < n; ++v) {
+		y[v] = rank[v] * T.invWeight(v);
+	}
+
+	int iterations = 0;
+	residual = std::numeric_limits<double>::infinity();
+	while (residual >= tolerance && iterations < maxNumIterations) {
+		double danglingRank = 0;
+		for (int u : T.dangling()) {
+			danglingRank += rank[u];
+		}
+		const double base = ((1 - damping) + damping * danglingRank) / n;
+
+		runThreads(T.numberOfThreads(), [&](unsigned int t) {
+			double change = 0;
+			for (int v = T.rangeBegin(t); v < T.rangeEnd(t); ++v) {
+				const double r = base + damping * T.pull(v, y.begin());
+				change += fabs(r - rank[v]);
+				next[v] = r;
+				yNext[v] = r * T.invWeight(v);
+			}
+			partial[int(t)] = change;
+		});
+
+		std::swap(rank, next);
+		std::swap(y, yNext);
+		residual = sum(partial);
+		++iterations;
+	}
+
+	return iterations;
+}
+
+//! Runs the Gauss-Seidel iteration on \p rank, returns the number of iterations.
+static int gaussSeidel(const Transition& T, double damping, double tolerance, int maxNumIterations,
+		Array<double>& rank, double& residual)
+{
+	const int n = T.numberOfNodes();
+	const bool parallel = T.numberOfThreads() > 1;
+	Array<double> y(n), yPrevious(parallel ? n : 0);
+	Array<double> partial(0, int(T.numberOfThreads()) - 1, 0.0);
+	Array<double> partialTotal(0, int(T.numberOfThreads()) - 1, 0.0);
+
+	for (int v = 0; v < n; ++v) {
+		y[v] = rank[v] * T.invWeight(v);
+	}
+
+	int iterations = 0;
+	residual = std::numeric_limits<double>::infinity();
+	while (residual >= tolerance && iterations < maxNumIterations) {
+		double danglingRank = 0;
+		for (int u : T.dangling()) {
+			danglingRank += rank[u];
+		}
+		const double base = ((1 - damping) + damping * danglingRank) / n;
+
+		// a thread reads the ranks of the other threads from the previous iteration
+		if (parallel) {
+			yPrevious = y;
+		}
+		const double* shared = parallel ? yPrevious.begin() : y.begin();
+
+		runThreads(T.numberOfThreads(), [&](unsigned int t) {
+			const int from = T.rangeBegin(t), to = T.rangeEnd(t);
+			double change = 0, total = 0;
+			for (int v = from; v < to; ++v) {
+				const double r = base + damping * T.pull(v, shared, y.begin(), from, to);
+				change += fabs(r - rank[v]);
+				total += r;
+				rank[v] = r;
+				y[v] = r * T.invWeight(v);
+			}
+			partial[int(t)] = change;
+			partialTotal[int(t)] = total;
+		});
+
+		// The in-place updates do not keep the sum of the ranks, and an error in the sum
+		// would only decay by the damping factor per iteration. The ranks are rescaled instead.
+		const double scale = 1 / sum(partialTotal);
+		runThreads(T.numberOfThreads(), [&](unsigned int t) {
+			for (int v = T.rangeBegin(t); v < T.rangeEnd(t); ++v) {
+				rank[v] *= scale;
+				y[v] *= scale;
+			}
+		});
+
+		residual = sum(partial);
+		++iterations;
+	}
+
+	return iterations;
+}
+
+//! Accumulates \p rank from pushed residuals, returns the number of rounds.
+static int deltaPush(const Transition& T, double damping, double tolerance, int maxNumIterations,
+		Array<double>& rank, double& residual)
+{
+	const CompactGraph& C = T.graph();
+	const int n = T.numberOfNodes();
+	const long long denseWork = C.numberOfEntries() / 20;
+	const double threshold = tolerance / (2 * n);
+
+	rank.init(0, n - 1, 0.0);
+	Array<double> remaining(0, n - 1, (1 - damping) / n);
+	Array<double> pushed(0, n - 1, 0.0);
+	Array<bool> active(0, n - 1, false);
+	std::vector<int> frontier, nextFrontier;
+
+	// The residual pushed by dangling nodes spreads over all nodes. It is collected in
+	// uniform and only added to the nodes once it is relevant for the tolerance.
+	double uniform = 0;
+
+	auto rescan = [&] {
+		frontier.clear();
+		for (int v = 0; v < n; ++v) {
+			remaining[v] += uniform;
+			active[v] = remaining[v] > threshold;
+			if (active[v]) {
+				frontier.push_back(v);
+			}
+		}
+		uniform = 0;
+	};
+	rescan();
+
+	int iterations = 0;
+	while (!frontier.empty() && iterations < maxNumIterations) {
+		long long work = 0;
+		for (int u : frontier) {
+			work += T.pushEnd(u) - T.pushBegin(u);
+		}
+
+		double danglingResidual = 0;
+		if (work > denseWork) {
+			// most nodes are active: the residuals are pulled by all nodes in parallel
+			for (int u : frontier) {
+				const double r = remaining[u];
+				rank[u] += r;
+				remaining[u] = 0;
+				pushed[u] = r * T.invWeight(u);
+				if (T.invWeight(u) == 0) {
+					danglingResidual += r;
+				}
+			}
+
+			runThreads(T.numberOfThreads(), [&](unsigned int t) {
+				for (int v = T.rangeBegin(t); v < T.rangeEnd(t); ++v) {
+					remaining[v] += damping * T.pull(v, pushed.begin());
+				}
+			});
+
+			for (int u : frontier) {
+				pushed[u] = 0;
+			}
+			uniform += damping * danglingResidual / n;
+			rescan();
+		} else {
+			// only the neighbourhoods of the active nodes are touched
+			nextFrontier.clear();
+			for (int u : frontier) {
+				const double r = remaining[u];
+				rank[u] += r;
+				remaining[u] = 0;
+				active[u] = false;
+				if (T.invWeight(u) == 0) {
+					danglingResidual += r;
+					continue;
+				}
+
+				const double factor = damping * r * T.invWeight(u);
+				for (int i = T.pushBegin(u); i < T.pushEnd(u); ++i) {
+					const int v = C.target(i);
+					remaining[v] += factor * T.weight(i);
+					if (!active[v] && remaining[v] > threshold) {
+						active[v] = true;
+						nextFrontier.push_back(v);
+					}
+				}
+			}
+
+			frontier.swap(nextFrontier);
+			uniform += damping * danglingResidual / n;
+			if (uniform * n > tolerance / 4) {
+				rescan();
+			}
+		}
+
+		++iterations;
+	}
+
+	residual = sum(remaining) + uniform * n;
+
+	const double total = sum(rank);
+	for (double& r : rank) {
+		r /= total;
+	}
+
+	return iterations;
+}
+
+//! Runs the power iteration for the personalized ranks of up to BATCH_SIZE \p seeds.
+/**
+ * @param rank is the interleaved array of the ranks (BATCH_SIZE per node).
+ */
+static int personalizedIteration(const Transition& T, double damping, double tolerance, int maxNumIterations,
+		const int* seeds, int count, std::vector<double>& rank, double& residual)
+{
+	const int n = T.numberOfNodes();
+	const size_t size = size_t(n) * BATCH_SIZE;
+	rank.assign(size, 0.0);
+	std::vector<double> next(size), y(size, 0.0), yNext(size);
+	std::vector<double> partial(T.numberOfThreads() * BATCH_SIZE);
+
+	// every surfer starts at its seed
+	for (int b = 0; b < count; ++b) {
+		rank[size_t(seeds[b]) * BATCH_SIZE + b] = 1;
+		y[size_t(seeds[b]) * BATCH_SIZE + b] = T.invWeight(seeds[b]);
+	}
+
+	int iterations = 0;
+	residual = std::numeric_limits<double>::infinity();
+	while (residual >= tolerance && iterations < maxNumIterations) {
+		double teleport[BATCH_SIZE];
+		for (int b = 0; b < BATCH_SIZE; ++b) {
+			teleport[b] = 1 - damping;
+		}
+		for (int u : T.dangling()) {
+			for (int b = 0; b < BATCH_SIZE; ++b) {
+				teleport[b] += damping * rank[size_t(u) * BATCH_SIZE + b];
+			}
+		}
+
+		runThreads(T.numberOfThreads(), [&](unsigned int t) {
+			double change[BATCH_SIZE] = {};
+			for (int v = T.rangeBegin(t); v < T.rangeEnd(t); ++v) {
+				double sum[BATCH_SIZE] = {};
+				T.pullBatch(v, y.data(), sum);
+
+				const size_t index = size_t(v) * BATCH_SIZE;
+				double r[BATCH_SIZE];
+				for (int b = 0; b < BATCH_SIZE; ++b) {
+					r[b] = damping * sum[b];
+				}
+				for (int b = 0; b < count; ++b) {
+					if (seeds[b] == v) {
+						r[b] += teleport[b];
+					}
+				}
+
+				const double invWeight = T.invWeight(v);
+				for (int b = 0; b < BATCH_SIZE; ++b) {
+					change[b] += fabs(r[b] - rank[index + b]);
+					next[index + b] = r[b];
+					yNext[index + b] = r[b] * invWeight;
+				}
+			}
+			std::copy(change, change + BATCH_SIZE, partial.begin() + t * BATCH_SIZE);
+		});
+
+		rank.swap(next);
+		y.swap(yNext);
+
+		residual = 0;
+		for (int b = 0; b < count; ++b) {
+			double change = 0;
+			for (unsigned int t = 0; t < T.numberOfThreads(); ++t) {
+				change += partial[t * BATCH_SIZE + b];
+			}
+			Math::updateMax(residual, change);
+		}
+		++iterations;
+	}
+
+	return iterations;
+}
+
+}
+
+
+void PageRank::call(const Graph& G, NodeArray<double>& rank, const EdgeArray<double>* weight)
+{
+	const CompactGraph C(G);
+	Array<double> denseWeight;
+	if (weight != nullptr) {
+		C.gatherEdges(*weight, denseWeight);
+	}
+
+	Array<double> denseRank;
+	call(C, denseRank, weight != nullptr ? &denseWeight : nullptr);
+	C.scatterNodes(denseRank, rank);
+}
+
+
+void PageRank::call(const CompactGraph& C, Array<double>& rank, const Array<double>* weight)
+{
+	using namespace pagerank;
+
+	const int n = C.numberOfNodes();
+	m_numberOfIterations = 0;
+	m_residual = 0;
+	rank.init(0, n - 1, 1.0 / n);
+	if (n == 0) {
+		return;
+	}
+
+	const Transition T(C, weight, m_directed, m_numberOfThreads);
+	switch (m_method) {
+	case Method::PowerIteration:
+		m_numberOfIterations = powerIteration(T, m_dampingFactor, m_tolerance, m_maxNumIterations, rank, m_residual);
+		break;
+	case Method::GaussSeidel:
+		m_numberOfIterations = gaussSeidel(T, m_dampingFactor, m_tolerance, m_maxNumIterations, rank, m_residual);
+		break;
+	case Method::DeltaPush:
+		m_numberOfIterations = deltaPush(T, m_dampingFactor, m_tolerance, m_maxNumIterations, rank, m_residual);
+		break;
+	}
+}
+
+
+void PageRank::callPersonalized(const Graph& G, const Array<node>& seeds, Array<NodeArray<double>>& ranks,
+	const EdgeArray<double>* weight)
+{
+	const CompactGraph C(G);
+	Array<double> denseWeight;
+	if (weight != nullptr) {
+		C.gatherEdges(*weight, denseWeight);
+	}
+
+	Array<int> denseSeeds(seeds.size());
+	for (int i = 0; i < seeds.size(); ++i) {
+		denseSeeds[i] = C.id(seeds[i]);
+	}
+
+	Array<Array<double>> denseRanks;
+	callPersonalized(C, denseSeeds, denseRanks, weight != nullptr ? &denseWeight : nullptr);
+
+	ranks.init(seeds.size());
+	for (int i = 0; i < seeds.size(); ++i) {
+		C.scatterNodes(denseRanks[i], ranks[i]);
+	}
+}
+
+
+void PageRank::callPersonalized(const CompactGraph& C, const Array<int>& seeds, Array<Array<double>>& ranks,
+	const Array<double>* weight)
+{
+	using namespace pagerank;
+
+	const int n = C.numberOfNodes();
+	m_numberOfIterations = 0;
+	m_residual = 0;
+	ranks.init(seeds.size());
+	if (seeds.empty()) {
+		return;
+	}
+
+	const Transition T(C, weight, m_directed, m_numberOfThreads);
+	std::vector<double> rank;
+	for (int first = 0; first < seeds.size(); first += BATCH_SIZE) {
+		const int count = min(BATCH_SIZE, seeds.size() - first);
+
+		double residual;
+		Math::updateMax(m_numberOfIterations, personalizedIteration(T, m_dampingFactor, m_tolerance,
+			m_maxNumIterations, &seeds[first], count, rank, residual));
+		Math::updateMax(m_residual, residual);
+
+		for (int b = 0; b < count; ++b) {
+			Array<double>& result = ranks[first + b];
+			result.init(n);
+			for (int v = 0; v < n; ++v) {
+				result[v] = rank[size_t(v) * BATCH_SIZE + b];
+			}
+		}
+	}
+}
+
 }
@@ -0,0 +1,204 @@
+/** \file
+ * \brief Tests for ogdf::CompactGraph and the algorithms working on it
+ *
+ * \author Ondřej Ondryáš
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/GraphCopy.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/graphalg/PageRank.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+
+#include <graphs.h>
+
+static void assertSnapshotOf(const CompactGraph &CG, const Graph &G) {
+	AssertThat(CG.graph(), Equals(&G));
+	AssertThat(CG.numberOfNodes(), Equals(G.numberOfNodes()));
+	AssertThat(CG.numberOfEdges(), Equals(G.numberOfEdges()));
+	AssertThat(CG.numberOfEntries(), Equals(2 * G.numberOfEdges()));
+	AssertThat(CG.offset(CG.numberOfNodes()), Equals(CG.numberOfEntries()));
+
+	for (node v : G.nodes) {
+		int id = CG.id(v);
+		AssertThat(CG.toNode(id), Equals(v));
+		AssertThat(CG.outdeg(id), Equals(v->outdeg()));
+		AssertThat(CG.indeg(id), Equals(v->indeg()));
+
+		for (int i = CG.offset(id); i < CG.offset(id + 1); ++i) {
+			edge e = CG.toEdge(CG.edgeOf(i));
+			AssertThat(CG.twin(CG.twin(i)), Equals(i));
+			AssertThat(CG.target(CG.twin(i)), Equals(id));
+			AssertThat(CG.toNode(CG.target(i)), Equals(e->opposite(v)));
+
+			if (i < CG.outEnd(id)) {
+				AssertThat(e->source(), Equals(v));
+				AssertThat(CG.sourceEntry(CG.edgeOf(i)), Equals(i));
+			} else {
+				AssertThat(e->target(), Equals(v));
+				AssertThat(CG.targetEntry(CG.edgeOf(i)), Equals(i));
+			}
+		}
+	}
+
+	for (edge e : G.edges) {
+		int id = CG.id(e);
+		AssertThat(CG.toEdge(id), Equals(e));
+		AssertThat(CG.toNode(CG.edgeSource(id)), Equals(e->source()));
+		AssertThat(CG.toNode(CG.edgeTarget(id)), Equals(e->target()));
+	}
+}
+
+go_bandit([] {
+	describe("CompactGraph", [] {
+		it("is empty by default", [] {
+			CompactGraph CG;
+			AssertThat(CG.graph(), Equals(nullptr));
+			AssertThat(CG.numberOfNodes(), Equals(0));
+			AssertThat(CG.numberOfEdges(), Equals(0));
+		});
+
+		describe("snapshot", [] {
+			forEachGraphItWorks({}, [](const Graph &G) {
+				assertSnapshotOf(CompactGraph(G), G);
+			});
+		});
+
+		it("works on a GraphCopy", [] {
+			Graph G;
+			randomGraph(G, 30, 60);
+			GraphCopy GC(G);
+			GC.delNode(GC.copy(G.firstNode()));
+
+			CompactGraph CG(GC);
+			assertSnapshotOf(CG, GC);
+			for (int v = 0; v < CG.numberOfNodes(); ++v) {
+				AssertThat(GC.copy(GC.original(CG.toNode(v))), Equals(CG.toNode(v)));
+			}
+		});
+
+		it("converts node and edge values", [] {
+			Graph G;
+			randomGraph(G, 20, 40);
+			CompactGraph CG(G);
+
+			EdgeArray<int> edgeValues(G);
+			for (edge e : G.edges) {
+				edgeValues[e] = e->index() * 3;
+			}
+			Array<int> dense;
+			CG.gatherEdges(edgeValues, dense);
+			for (edge e : G.edges) {
+				AssertThat(dense[CG.id(e)], Equals(e->index() * 3));
+			}
+
+			NodeArray<int> nodeValues;
+			Array<int> denseNodes(CG.numberOfNodes());
+			for (int v = 0; v < CG.numberOfNodes(); ++v) {
+				denseNodes[v] = v + 1;
+			}
+			CG.scatterNodes(denseNodes, nodeValues);
+			for (node v : G.nodes) {
+				AssertThat(nodeValues[v], Equals(CG.id(v) + 1));
+			}
+		});
+
+		describe("connectivity", [] {
+			forEachGraphItWorks({}, [](const Graph &G) {
+				CompactGraph CG(G);
+
+				AssertThat(isConnected(CG), Equals(isConnected(G)));
+
+				NodeArray<int> component(G);
+				Array<int> denseComponent;
+				AssertThat(connectedComponents(CG, denseComponent), Equals(connectedComponents(G, component)));
+				for (node v : G.nodes) {
+					AssertThat(denseComponent[CG.id(v)], Equals(component[v]));
+				}
+
+				AssertThat(strongComponents(CG, denseComponent), Equals(strongComponents(G, component)));
+				for (node v : G.nodes) {
+					AssertThat(denseComponent[CG.id(v)], Equals(component[v]));
+				}
+			});
+		});
+
+		describe("shortest paths", [] {
+			forEachGraphItWorks({}, [](const Graph &G) {
+				CompactGraph CG(G);
+				EdgeArray<double> cost(G);
+				for (edge e : G.edges) {
+					cost[e] = randomDouble(0.0, 10.0);
+				}
+				Array<double> denseCost;
+				CG.gatherEdges(cost, denseCost);
+
+				for (node s : G.nodes) {
+					NodeArray<int> hops(G, std::numeric_limits<int>::max());
+					Array<int> denseHops;
+					bfs_SPSS(s, G, hops, 1);
+					bfs_SPSS(CG.id(s), CG, denseHops, 1);
+
+					NodeArray<double> distance;
+					Array<double> denseDistance;
+					dijkstra_SPSS(s, G, distance, cost);
+					dijkstra_SPSS(CG.id(s), CG, denseDistance, denseCost);
+
+					for (node v : G.nodes) {
+						AssertThat(denseHops[CG.id(v)], Equals(hops[v]));
+						AssertThat(denseDistance[CG.id(v)], EqualsWithDelta(distance[v], 1e-9));
+					}
+				}
+			}, GraphSizes(), 1, 50);
+		});
+
+		describe("page rank", [] {
+			forEachGraphItWorks({GraphProperty::connected}, [](const Graph &G) {
+				CompactGraph CG(G);
+				EdgeArray<double> weight(G);
+				for (edge e : G.edges) {
+					weight[e] = randomDouble(0.5, 2.0);
+				}
+				Array<double> denseWeight;
+				CG.gatherEdges(weight, denseWeight);
+
+				BasicPageRank pageRank;
+				pageRank.setMaxNumIterations(50);
+				NodeArray<double> rank;
+				Array<double> denseRank;
+				pageRank.call(G, weight, rank);
+				pageRank.call(CG, denseWeight, denseRank);
+
+				for (node v : G.nodes) {
+					AssertThat(denseRank[CG.id(v)], EqualsWithDelta(rank[v], 1e-9));
+				}
+			// the ranks of smaller graphs are symmetric and cannot be normalized
+			}, GraphSizes(), 3);
+		});
+	});
+});
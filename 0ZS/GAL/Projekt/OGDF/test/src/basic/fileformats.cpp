@@ -40,6 +40,7 @@
 #include <ogdf/basic/graph_generators.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/fileformats/BinaryGraphFile.h>
 #include <resources.h>
 #include <graphs.h>
 
@@ -843,9 +844,257 @@ void describeGraph6() {
 	});
 }
 
+/**
+ * Writes the edges of \p G as lines "u v" with the given node ids to file \p filename.
+ */
+static void writeEdgeLines(const Graph &G, const string &filename, const string &header, int firstId) {
+	std::ofstream os(filename);
+	os << header;
+	for (edge e : G.edges) {
+		os << e->source()->index() + firstId << " " << e->target()->index() + firstId << "\n";
+	}
+}
+
+/**
+ * Asserts that \p G1 and \p G2 have the same nodes and edges in the same order.
+ */
+static void assertSameEdges(const Graph &G1, const Graph &G2) {
+	AssertThat(G1.numberOfNodes(), Equals(G2.numberOfNodes()));
+	AssertThat(G1.numberOfEdges(), Equals(G2.numberOfEdges()));
+	for (edge e1 = G1.firstEdge(), e2 = G2.firstEdge(); e1 != nullptr; e1 = e1->succ(), e2 = e2->succ()) {
+		AssertThat(e1->source()->index(), Equals(e2->source()->index()));
+		AssertThat(e1->target()->index(), Equals(e2->target()->index()));
+	}
+}
+
 void describeMatrixMarket() {
 	describe("MatrixMarket", [] {
 		describeFormat("MatrixMarket", GraphIO::readMatrixMarket, nullptr, false);
+
+		it("reads large files in parallel", [] {
+			Graph G;
+			// large enough to be split into more than four chunks of at least 1 MiB
+			randomSimpleGraph(G, 20000, 500000);
+			const string filename = "test-matrix-market.mtx";
+			writeEdgeLines(G, filename, "%%MatrixMarket matrix coordinate pattern general\n20000 20000 500000\n", 1);
+
+			Graph fromFile, fromStream;
+			AssertThat(GraphIO::readMatrixMarketFile(fromFile, filename, 4), IsTrue());
+			std::ifstream is(filename);
+			AssertThat(GraphIO::readMatrixMarket(fromStream, is), IsTrue());
+			std::remove(filename.c_str());
+
+			AssertThat(fromFile.numberOfEdges(), Equals(500000));
+			assertSameEdges(fromFile, fromStream);
+		});
+
+		it("reads a diagonal entry as a self-loop", [] {
+			Graph G;
+			std::istringstream is("%%MatrixMarket matrix coordinate pattern general\n2 2 2\n1 1\n2 1\n");
+			AssertThat(GraphIO::readMatrixMarket(G, is), IsTrue());
+			AssertThat(G.numberOfNodes(), Equals(2));
+			AssertThat(G.numberOfEdges(), Equals(2));
+			AssertThat(G.firstEdge()->isSelfLoop(), IsTrue());
+			AssertThat(G.firstEdge()->source(), Equals(G.firstNode()));
+		});
+
+		it("reads an empty file as an empty graph", [] {
+			const string filename = "test-empty.mtx";
+			std::ofstream(filename).close();
+
+			Graph fromFile, fromStream;
+			customGraph(fromFile, 2, {{0, 1}});
+			customGraph(fromStream, 2, {{0, 1}});
+			AssertThat(GraphIO::readMatrixMarketFile(fromFile, filename), IsTrue());
+			std::ifstream is(filename);
+			AssertThat(GraphIO::readMatrixMarket(fromStream, is), IsTrue());
+			std::remove(filename.c_str());
+
+			AssertThat(fromFile.empty(), IsTrue());
+			AssertThat(fromStream.empty(), IsTrue());
+		});
+
+		it("returns false if the file does not exist", [] {
+			Graph G;
+			AssertThat(GraphIO::readMatrixMarketFile(G, "does-not-exist.mtx"), IsFalse());
+		});
+	});
+}
+
+void describeEdgeList() {
+	describe("EdgeList", [] {
+		describeFormat("EdgeList", GraphIO::readEdgeList, nullptr, false);
+
+		it("creates the nodes of a DIMACS problem line in order", [] {
+			Graph G;
+			std::istringstream is("p edge 4 1\ne 4 3\n");
+			AssertThat(GraphIO::readEdgeList(G, is), IsTrue());
+			AssertThat(G.numberOfNodes(), Equals(4));
+			AssertThat(G.numberOfEdges(), Equals(1));
+			AssertThat(G.firstEdge()->source(), Equals(G.lastNode()));
+			AssertThat(G.firstEdge()->target(), Equals(G.lastNode()->pred()));
+		});
+
+		it("creates the nodes in the order of their first appearance", [] {
+			Graph G;
+			std::istringstream is("# SNAP\n1000000000 7\n7 7\n42\t1000000000 1.5\n");
+			AssertThat(GraphIO::readEdgeList(G, is), IsTrue());
+			AssertThat(G.numberOfNodes(), Equals(3));
+			AssertThat(G.numberOfEdges(), Equals(3));
+			AssertThat(G.firstEdge()->isSelfLoop(), IsFalse());
+			AssertThat(G.firstEdge()->succ()->isSelfLoop(), IsTrue());
+			AssertThat(G.lastEdge()->source(), Equals(G.lastNode()));
+			AssertThat(G.lastEdge()->target(), Equals(G.firstNode()));
+		});
+
+		it("reads an empty file as an empty graph", [] {
+			const string filename = "test-empty.edges";
+			std::ofstream(filename).close();
+
+			Graph fromFile, fromStream;
+			customGraph(fromFile, 2, {{0, 1}});
+			customGraph(fromStream, 2, {{0, 1}});
+			AssertThat(GraphIO::readEdgeListFile(fromFile, filename), IsTrue());
+			std::ifstream is(filename);
+			AssertThat(GraphIO::readEdgeList(fromStream, is), IsTrue());
+			std::remove(filename.c_str());
+
+			AssertThat(fromFile.empty(), IsTrue());
+			AssertThat(fromStream.empty(), IsTrue());
+		});
+
+		it("reads large files in parallel", [] {
+			Graph G;
+			// large enough to be split into more than four chunks of at least 1 MiB
+			randomGraph(G, 20000, 500000);
+			const string filename = "test-edge-list.edges";
+			writeEdgeLines(G, filename, "# a random graph\n", 0);
+
+			Graph fromFile, fromStream;
+			AssertThat(GraphIO::readEdgeListFile(fromFile, filename, 4), IsTrue());
+			std::ifstream is(filename);
+			AssertThat(GraphIO::readEdgeList(fromStream, is), IsTrue());
+			std::remove(filename.c_str());
+
+			AssertThat(fromFile.numberOfEdges(), Equals(500000));
+			assertSameEdges(fromFile, fromStream);
+
+			// the edges are read in the order of the file, so they induce a mapping of the nodes
+			NodeArray<node> mapping(G, nullptr);
+			auto assertMapped = [&](node v, node w) {
+				if (mapping[v] == nullptr) {
+					mapping[v] = w;
+				}
+				AssertThat(mapping[v], Equals(w));
+			};
+			for (edge e = G.firstEdge(), f = fromFile.firstEdge(); e != nullptr; e = e->succ(), f = f->succ()) {
+				assertMapped(e->source(), f->source());
+				assertMapped(e->target(), f->target());
+			}
+		});
+	});
+}
+
+void describeBinary() {
+	describe("Binary", [] {
+		describeFormat("Binary", GraphIO::readBinary, GraphIO::writeBinary, false);
+		describeGAFormat("Binary", GraphIO::readBinary, GraphIO::writeBinary, false,
+			GraphAttributes::nodeGraphics | GraphAttributes::threeD | GraphAttributes::nodeWeight
+			| GraphAttributes::nodeLabel | GraphAttributes::edgeLabel
+			| GraphAttributes::edgeIntWeight | GraphAttributes::edgeDoubleWeight);
+		describeClusterFormat(GraphIO::readBinary, GraphIO::writeBinary);
+
+		it("keeps the order of nodes and edges", [] {
+			Graph G;
+			randomGraph(G, 30, 90);
+			stringstream ss;
+			AssertThat(GraphIO::writeBinary(G, ss), IsTrue());
+
+			Graph fromFile;
+			AssertThat(GraphIO::readBinary(fromFile, ss), IsTrue());
+			AssertThat(fromFile.numberOfNodes(), Equals(G.numberOfNodes()));
+			AssertThat(fromFile.numberOfEdges(), Equals(G.numberOfEdges()));
+
+			NodeArray<int> id(G);
+			int i = 0;
+			for (node v : G.nodes) {
+				id[v] = i++;
+			}
+			Array<node> nodes(fromFile.numberOfNodes());
+			i = 0;
+			for (node v : fromFile.nodes) {
+				nodes[i++] = v;
+			}
+
+			// the edges are read grouped by their sources
+			edge f = fromFile.firstEdge();
+			for (node v : G.nodes) {
+				for (adjEntry adj : v->adjEntries) {
+					if (adj->isSource()) {
+						AssertThat(f->source(), Equals(nodes[id[v]]));
+						AssertThat(f->target(), Equals(nodes[id[adj->twinNode()]]));
+						f = f->succ();
+					}
+				}
+			}
+		});
+
+		it("rejects truncated data", [] {
+			Graph G;
+			randomGraph(G, 10, 20);
+			stringstream ss;
+			GraphIO::writeBinary(G, ss);
+			string data = ss.str();
+
+			for (size_t size : {size_t(0), size_t(7), size_t(24), data.size() / 2, data.size() - 8}) {
+				stringstream truncated{data.substr(0, size)};
+				Graph fromFile;
+				AssertThat(GraphIO::readBinary(fromFile, truncated), IsFalse());
+			}
+		});
+
+		it("maps a file into memory", [] {
+			Graph G;
+			randomGraph(G, 50, 200);
+			GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeDoubleWeight);
+			for (node v : G.nodes) {
+				GA.x(v) = v->index();
+			}
+			for (edge e : G.edges) {
+				GA.doubleWeight(e) = 0.5 * e->index();
+			}
+
+			const string filename = "test-binary-graph.ogb";
+			AssertThat(GraphIO::write(GA, filename), IsTrue());
+
+			BinaryGraphFile file(filename);
+			AssertThat(file.good(), IsTrue());
+			AssertThat(file.numberOfNodes(), Equals(G.numberOfNodes()));
+			AssertThat(file.numberOfEdges(), Equals(G.numberOfEdges()));
+			AssertThat(file.has(BinaryGraphFile::Section::NodeX), IsTrue());
+			AssertThat(file.has(BinaryGraphFile::Section::NodeLabel), IsFalse());
+
+			const int32_t *offsets = file.offsets();
+			const double *x = file.column<double>(BinaryGraphFile::Section::NodeX);
+			const double *weight = file.column<double>(BinaryGraphFile::Section::EdgeDoubleWeight);
+			int i = 0;
+			for (node v : G.nodes) {
+				AssertThat(x[i], Equals(GA.x(v)));
+				AssertThat(offsets[i + 1] - offsets[i], Equals(v->outdeg()));
+				int j = offsets[i];
+				for (adjEntry adj : v->adjEntries) {
+					if (adj->isSource()) {
+						AssertThat(weight[j++], Equals(GA.doubleWeight(adj->theEdge())));
+					}
+				}
+				++i;
+			}
+
+			Graph fromFile;
+			AssertThat(file.read(fromFile), IsTrue());
+			AssertThat(fromFile.numberOfEdges(), Equals(G.numberOfEdges()));
+			AssertThat(std::remove(filename.c_str()), Equals(0));
+		});
 	});
 }
 
@@ -1364,6 +1613,8 @@ void describeSpecificFormats() {
 	describeYGraph();
 	describeGraph6();
 	describeMatrixMarket();
+	describeEdgeList();
+	describeBinary();
 	describeRudy();
 	// TODO: BENCH (only very restrictive reader; point-based expansion of a hypergraph)
 	// TODO: PLA (only very restrictive reader; point-based expansion of a hypergraph)
@@ -30,6 +30,7 @@
  */
 
 #include <ogdf/basic/Graph.h>
+#include <ogdf/basic/AdjEntryArray.h>
 #include <ogdf/basic/graph_generators.h>
 #include <resources.h>
 
@@ -263,6 +264,99 @@ describe("Graph Class", [](){
 		delete[] visited;
 	});
 
+	it("adds nodes and edges in bulk", [](){
+		Graph graph;
+		NodeArray<int> nodeValue(graph, 1);
+		EdgeArray<int> edgeValue(graph, 2);
+		AdjEntryArray<int> adjValue(graph, 3);
+
+		Array<node> nodes;
+		graph.newNodes(1000, &nodes);
+
+		AssertThat(graph.numberOfNodes(), Equals(1000));
+		AssertThat(nodes.size(), Equals(1000));
+		int i = 0;
+		for (node v : graph.nodes) {
+			AssertThat(nodes[i++], Equals(v));
+			AssertThat(nodeValue[v], Equals(1));
+		}
+
+		Array<std::pair<node, node>> edgeList(3000);
+		for (i = 0; i < edgeList.size(); i++) {
+			edgeList[i] = std::make_pair(nodes[i % 1000], nodes[(7 * i) % 1000]);
+		}
+
+		Array<edge> edges;
+		graph.newEdges(edgeList, &edges);
+
+		AssertThat(graph.numberOfEdges(), Equals(3000));
+		AssertThat(edges.size(), Equals(3000));
+		i = 0;
+		for (edge e : graph.edges) {
+			AssertThat(edges[i], Equals(e));
+			AssertThat(e->source(), Equals(edgeList[i].first));
+			AssertThat(e->target(), Equals(edgeList[i].second));
+			AssertThat(edgeValue[e], Equals(2));
+			AssertThat(adjValue[e->adjSource()], Equals(3));
+			AssertThat(adjValue[e->adjTarget()], Equals(3));
+			i++;
+		}
+
+		graph.reserveNodes(10);
+		graph.reserveEdges(10);
+		AssertThat(graph.nodeArrayTableSize(), IsGreaterThan(graph.maxNodeIndex() + 10));
+		AssertThat(graph.edgeArrayTableSize(), IsGreaterThan(graph.maxEdgeIndex() + 10));
+		graph.newEdge(graph.newNode(), nodes[0]);
+		AssertThat(graph.numberOfNodes(), Equals(1001));
+		AssertThat(graph.numberOfEdges(), Equals(3001));
+	});
+
+	it("allocates elements in an arena", [](){
+		Graph original;
+		randomGraph(original, 200, 600);
+
+		Graph graph(Graph::ElementAllocation::arena);
+		AssertThat(graph.elementAllocation(), Equals(Graph::ElementAllocation::arena));
+		graph = original;
+		AssertThat(graph.numberOfNodes(), Equals(200));
+		AssertThat(graph.numberOfEdges(), Equals(600));
+		AssertThat(graph.elementMemory(), IsGreaterThan(size_t(0)));
+
+		Graph copy(graph);
+		AssertThat(copy.elementAllocation(), Equals(Graph::ElementAllocation::arena));
+		AssertThat(copy.numberOfEdges(), Equals(600));
+
+		// deleted elements are reused
+		size_t memory = graph.elementMemory();
+		for (int i = 0; i < 100; i++) {
+			graph.delEdge(graph.firstEdge());
+			graph.delNode(graph.firstNode());
+		}
+		for (int i = 0; i < 100; i++) {
+			graph.newEdge(graph.newNode(), graph.firstNode());
+		}
+		AssertThat(graph.elementMemory(), Equals(memory));
+
+		{
+			Graph::HiddenEdgeSet hidden(graph);
+			hidden.hide(graph.firstEdge());
+			hidden.hide(graph.lastEdge());
+			AssertThat(hidden.size(), Equals(2));
+			graph.clear();
+		}
+		AssertThat(graph.empty(), IsTrue());
+		AssertThat(graph.elementMemory(), Equals(size_t(0)));
+
+		graph.newEdge(graph.newNode(), graph.newNode());
+		AssertThat(graph.numberOfEdges(), Equals(1));
+		graph.clear();
+
+		graph.setElementAllocation(Graph::ElementAllocation::pool);
+		AssertThat(graph.elementAllocation(), Equals(Graph::ElementAllocation::pool));
+		graph.newEdge(graph.newNode(), graph.newNode());
+		AssertThat(graph.elementMemory(), Equals(2 * sizeof(NodeElement) + sizeof(EdgeElement) + 2 * sizeof(AdjElement)));
+	});
+
 	it("doesn't duplicate self-loops", [](){
 		Graph graph;
 
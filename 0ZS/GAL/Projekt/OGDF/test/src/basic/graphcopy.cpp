@@ -226,6 +226,21 @@ void describeGraphCopySimple(int numberOfNodes)
 
 			testInitGraph(graph, *graphCopy, true);
 		});
+
+		it("allocates its elements in an arena if requested", [&](){
+			AssertThat(graphCopy->elementAllocation(), Equals(Graph::ElementAllocation::pool));
+			GCType emptyCopy(Graph::ElementAllocation::arena);
+			AssertThat(emptyCopy.elementAllocation(), Equals(Graph::ElementAllocation::arena));
+
+			GCType arenaCopy(graph, Graph::ElementAllocation::arena);
+			AssertThat(arenaCopy.elementAllocation(), Equals(Graph::ElementAllocation::arena));
+			testInitGraph(graph, arenaCopy, true);
+
+			// copies keep the allocation of the copied graph copy
+			GCType copyOfArenaCopy(arenaCopy);
+			AssertThat(copyOfArenaCopy.elementAllocation(), Equals(Graph::ElementAllocation::arena));
+			testInitGraph(graph, copyOfArenaCopy, true);
+		});
 	});
 
 	it("manages copy and original",[&](){
@@ -398,8 +413,10 @@ go_bandit([](){
 			it("is initialized by arbitrary nodes",[&](){
 				eCopy = EdgeArray<edge>(graph);
 				NodeArray<bool> activeNodes(graph, false);
-				node actNode1 = graph.chooseNode();
-				node actNode2 = actNode1->lastAdj()->twin()->theNode();
+				// two distinct adjacent nodes
+				edge actEdge = graph.chooseEdge([](edge e) { return !e->isSelfLoop(); });
+				node actNode1 = actEdge->source();
+				node actNode2 = actEdge->target();
 				activeNodes[actNode1] = true;
 				activeNodes[actNode2] = true;
 				origNodes.clear();
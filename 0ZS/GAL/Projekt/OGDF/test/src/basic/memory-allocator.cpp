@@ -29,10 +29,13 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <ogdf/basic/memory.h>
 #include <ogdf/basic/System.h>
+#include <ogdf/basic/Thread.h>
 #include <testing.h>
 
 template<size_t size>
@@ -72,4 +75,71 @@ void describeMemoryManager(const std::string &name) {
 go_bandit([] {
 	describeMemoryManager<OGDFObject>("OGDF");
 	describeMemoryManager<MallocObject>("Malloc");
+
+	describe("OGDF allocator", [] {
+		it("serves reserved allocations without allocating new memory", [] {
+			const size_t count = 2000;
+			OGDF_ALLOCATOR::reserve(sizeof(OGDFObject<200>), count);
+			size_t allocated = System::memoryAllocatedByMemoryManager();
+
+			std::vector<OGDFObject<200>*> objects(count);
+			for (auto &object : objects) {
+				object = new OGDFObject<200>;
+			}
+			AssertThat(System::memoryAllocatedByMemoryManager(), Equals(allocated));
+
+			for (auto object : objects) {
+				delete object;
+			}
+		});
+
+		it("counts the thread's free memory without changing it", [] {
+			delete new OGDFObject<40>;
+			size_t free = System::memoryInThreadFreeListOfMemoryManager();
+			AssertThat(free, IsGreaterThan(size_t(0)));
+			AssertThat(System::memoryInThreadFreeListOfMemoryManager(), Equals(free));
+		});
+
+		it("passes memory freed by other threads on to new allocations", [] {
+			const int numberOfThreads = 4;
+			const size_t count = 5000;
+
+			// all threads hold their objects at the same time, so none of them reuses the memory of another one
+			std::atomic<int> allocatingThreads(numberOfThreads);
+			// Thread refers to this function while it runs, so it has to outlive the threads
+			auto allocateAndFree = [count, &allocatingThreads] {
+				std::vector<OGDFObject<96>*> objects(count);
+				for (auto &object : objects) {
+					object = new OGDFObject<96>;
+				}
+				allocatingThreads--;
+				while (allocatingThreads > 0) {
+					std::this_thread::yield();
+				}
+				for (auto object : objects) {
+					delete object;
+				}
+			};
+			std::vector<Thread> threads;
+			for (int i = 0; i < numberOfThreads; i++) {
+				threads.emplace_back(allocateAndFree);
+			}
+			for (Thread &thread : threads) {
+				thread.join();
+			}
+
+			AssertThat(System::memoryInGlobalFreeListOfMemoryManager(), IsGreaterThanOrEqualTo(numberOfThreads * count * 96));
+			size_t allocated = System::memoryAllocatedByMemoryManager();
+
+			std::vector<OGDFObject<96>*> objects(numberOfThreads * count);
+			for (auto &object : objects) {
+				object = new OGDFObject<96>;
+			}
+			AssertThat(System::memoryAllocatedByMemoryManager(), Equals(allocated));
+
+			for (auto object : objects) {
+				delete object;
+			}
+		});
+	});
 });
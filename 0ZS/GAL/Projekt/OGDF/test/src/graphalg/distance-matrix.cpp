@@ -0,0 +1,123 @@
+/** \file
+ * \brief Tests for ogdf::DistanceMatrix
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+
+#include <graphs.h>
+
+//! Asserts that \p D holds the distances computed by \p singleSource for every node of \p G.
+static void assertDistances(const DistanceMatrix &D, const Graph &G,
+		std::function<void(node, NodeArray<double>&)> singleSource, double delta) {
+	AssertThat(D.numberOfNodes(), Equals(G.numberOfNodes()));
+
+	double maxDistance = 0;
+	for (node s : G.nodes) {
+		NodeArray<double> distance(G, std::numeric_limits<double>::infinity());
+		singleSource(s, distance);
+
+		for (node v : G.nodes) {
+			if (distance[v] == std::numeric_limits<double>::infinity()
+			 || distance[v] == std::numeric_limits<double>::max()) {
+				AssertThat(D.reachable(D.graph().id(s), D.graph().id(v)), IsFalse());
+				AssertThat(D(s, v), Equals(D.unreachableDistance()));
+			} else {
+				AssertThat(D.reachable(D.graph().id(s), D.graph().id(v)), IsTrue());
+				AssertThat(D(s, v), EqualsWithDelta(distance[v], delta));
+				Math::updateMax(maxDistance, distance[v]);
+			}
+		}
+	}
+	AssertThat(D.maxDistance(), EqualsWithDelta(maxDistance, delta));
+}
+
+go_bandit([] {
+	describe("DistanceMatrix", [] {
+		it("is empty by default", [] {
+			DistanceMatrix D;
+			AssertThat(D.numberOfNodes(), Equals(0));
+			AssertThat(D.memoryUsage(), Equals(size_t(0)));
+		});
+
+		for (unsigned int threads : {1u, 4u}) {
+			describe("with " + to_string(threads) + " threads", [threads] {
+				describe("hop distances", [threads] {
+					forEachGraphItWorks({}, [threads](const Graph &G) {
+						DistanceMatrix D;
+						D.computeHops(G, 2.5, threads);
+						AssertThat(D.storage(), Equals(DistanceMatrix::Storage::Hops16));
+						AssertThat(D.memoryUsage(), Equals(size_t(G.numberOfNodes()) * G.numberOfNodes() * sizeof(uint16_t)));
+
+						assertDistances(D, G, [&](node s, NodeArray<double> &distance) {
+							bfs_SPSS(s, G, distance, 2.5);
+						}, 0);
+					});
+				});
+
+				describe("weighted distances", [threads] {
+					for (auto storage : {DistanceMatrix::Storage::Float, DistanceMatrix::Storage::Double}) {
+						forEachGraphItWorks({}, [threads, storage](const Graph &G) {
+							EdgeArray<double> cost(G);
+							for (edge e : G.edges) {
+								cost[e] = randomDouble(0.0, 10.0);
+							}
+
+							DistanceMatrix D;
+							D.compute(G, cost, storage, threads);
+							AssertThat(D.storage(), Equals(storage));
+
+							assertDistances(D, G, [&](node s, NodeArray<double> &distance) {
+								dijkstra_SPSS(s, G, distance, cost);
+							}, storage == DistanceMatrix::Storage::Float ? 1e-3 : 1e-9);
+						}, GraphSizes(), 1, 50);
+					}
+				});
+			});
+		}
+
+		it("reports unreachable pairs", [] {
+			Graph G;
+			customGraph(G, 4, {{0, 1}, {2, 3}});
+
+			DistanceMatrix D;
+			D.computeHops(G);
+			AssertThat(D(0, 1), Equals(1.0));
+			AssertThat(D(0, 2), Equals(std::numeric_limits<double>::infinity()));
+			AssertThat(D.maxDistance(), Equals(1.0));
+
+			D.setUnreachableDistance(42);
+			AssertThat(D(0, 2), Equals(42.0));
+			AssertThat(D(1, 1), Equals(0.0));
+		});
+	});
+});
@@ -0,0 +1,219 @@
+/** \file
+ * \brief Tests for ogdf::PageRank
+ *
+ * \author Ondřej Ondryáš
+ *
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/graphalg/PageRank.h>
+
+#include <testing.h>
+
+//! Computes the ranks by a plain power iteration over the edges of \p G.
+/**
+ * The surfer teleports to \p seed, or to a uniformly chosen node if \p seed is nullptr.
+ */
+static void referenceRanks(const Graph &G, const EdgeArray<double> *weight, bool directed, node seed,
+		double damping, NodeArray<double> &rank) {
+	const int n = G.numberOfNodes();
+	auto w = [&](edge e) { return weight != nullptr ? (*weight)[e] : 1.0; };
+
+	NodeArray<double> out(G, 0.0);
+	for (edge e : G.edges) {
+		out[e->source()] += w(e);
+		if (!directed) {
+			out[e->target()] += w(e);
+		}
+	}
+
+	rank.init(G, seed == nullptr ? 1.0 / n : 0.0);
+	if (seed != nullptr) {
+		rank[seed] = 1;
+	}
+
+	for (int iteration = 0; iteration < 2000; ++iteration) {
+		NodeArray<double> next(G, 0.0);
+		double teleport = 1 - damping;
+		for (node v : G.nodes) {
+			if (out[v] == 0) {
+				teleport += damping * rank[v];
+			}
+		}
+		for (node v : G.nodes) {
+			if (seed == nullptr) {
+				next[v] = teleport / n;
+			} else if (v == seed) {
+				next[v] = teleport;
+			}
+		}
+		for (edge e : G.edges) {
+			next[e->target()] += damping * w(e) * rank[e->source()] / out[e->source()];
+			if (!directed) {
+				next[e->source()] += damping * w(e) * rank[e->target()] / out[e->target()];
+			}
+		}
+		rank = next;
+	}
+}
+
+static void assertRanks(const Graph &G, const NodeArray<double> &rank, const NodeArray<double> &expected, double delta) {
+	double sum = 0;
+	for (node v : G.nodes) {
+		AssertThat(rank[v], EqualsWithDelta(expected[v], delta));
+		sum += rank[v];
+	}
+	AssertThat(sum, EqualsWithDelta(1.0, 1e-6));
+}
+
+static const char *methodName(PageRank::Method method) {
+	switch (method) {
+	case PageRank::Method::PowerIteration:
+		return "power iteration";
+	case PageRank::Method::GaussSeidel:
+		return "Gauss-Seidel iteration";
+	default:
+		return "delta push";
+	}
+}
+
+go_bandit([] {
+describe("PageRank", [] {
+	it("assigns the same rank to all nodes of a directed cycle", [] {
+		Graph G;
+		Array<node> nodes;
+		G.newNodes(7, &nodes);
+		for (int i = 0; i < 7; ++i) {
+			G.newEdge(nodes[i], nodes[(i + 1) % 7]);
+		}
+
+		PageRank pageRank;
+		NodeArray<double> rank;
+		pageRank.call(G, rank);
+		for (node v : G.nodes) {
+			AssertThat(rank[v], EqualsWithDelta(1.0 / 7, 1e-12));
+		}
+		AssertThat(pageRank.residual(), IsLessThan(pageRank.tolerance()));
+		AssertThat(pageRank.numberOfIterations(), IsLessThan(pageRank.maxNumIterations()));
+	});
+
+	for (PageRank::Method method : {PageRank::Method::PowerIteration,
+			PageRank::Method::GaussSeidel, PageRank::Method::DeltaPush}) {
+		describe(string("with ") + methodName(method), [&] {
+			for (bool directed : {true, false}) {
+				for (bool weighted : {false, true}) {
+					it(string("computes the ranks of ") + (directed ? "directed" : "undirected")
+							+ (weighted ? " weighted" : "") + " graphs", [&] {
+						for (int n : {1, 2, 30, 200}) {
+							Graph G;
+							randomGraph(G, n, 3 * n);
+							EdgeArray<double> weight(G);
+							for (edge e : G.edges) {
+								weight[e] = randomDouble(0.5, 5);
+							}
+
+							PageRank pageRank;
+							pageRank.setMethod(method);
+							pageRank.setDirected(directed);
+							pageRank.setTolerance(1e-12);
+							NodeArray<double> rank, expected;
+							pageRank.call(G, rank, weighted ? &weight : nullptr);
+							referenceRanks(G, weighted ? &weight : nullptr, directed, nullptr, 0.85, expected);
+
+							assertRanks(G, rank, expected, 1e-9);
+							AssertThat(pageRank.residual(), IsLessThan(1e-12));
+						}
+					});
+				}
+			}
+
+			it("computes the same ranks with several threads", [&] {
+				Graph G;
+				randomGraph(G, 40000, 120000);
+
+				PageRank pageRank;
+				pageRank.setMethod(method);
+				pageRank.setTolerance(1e-12);
+				NodeArray<double> rank, parallelRank;
+				pageRank.setNumberOfThreads(1);
+				pageRank.call(G, rank);
+				pageRank.setNumberOfThreads(4);
+				pageRank.call(G, parallelRank);
+
+				assertRanks(G, parallelRank, rank, 1e-12);
+			});
+		});
+	}
+
+	it("stops after the maximum number of iterations", [] {
+		Graph G;
+		randomGraph(G, 100, 300);
+
+		PageRank pageRank;
+		pageRank.setTolerance(0);
+		pageRank.setMaxNumIterations(10);
+		NodeArray<double> rank;
+		pageRank.call(G, rank);
+		AssertThat(pageRank.numberOfIterations(), Equals(10));
+		AssertThat(pageRank.residual(), IsGreaterThan(0.0));
+	});
+
+	for (bool directed : {true, false}) {
+		it(string("computes personalized ranks of ") + (directed ? "directed" : "undirected") + " graphs", [&] {
+			Graph G;
+			randomGraph(G, 150, 450);
+			EdgeArray<double> weight(G);
+			for (edge e : G.edges) {
+				weight[e] = randomDouble(0.5, 5);
+			}
+
+			// more seeds than a batch, and one of them twice
+			Array<node> seeds(11);
+			int i = 0;
+			for (node v = G.firstNode(); i < seeds.size(); v = v->succ()->succ()) {
+				seeds[i++] = v;
+			}
+			seeds[10] = seeds[3];
+
+			PageRank pageRank;
+			pageRank.setDirected(directed);
+			pageRank.setTolerance(1e-12);
+			Array<NodeArray<double>> ranks;
+			pageRank.callPersonalized(G, seeds, ranks, &weight);
+
+			AssertThat(ranks.size(), Equals(seeds.size()));
+			for (i = 0; i < seeds.size(); ++i) {
+				NodeArray<double> expected;
+				referenceRanks(G, &weight, directed, seeds[i], 0.85, expected);
+				assertRanks(G, ranks[i], expected, 1e-9);
+			}
+			AssertThat(pageRank.residual(), IsLessThan(1e-12));
+		});
+	}
+});
+});
@@ -29,13 +29,20 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+#include <functional>
 #include <ogdf/basic/graph_generators/randomized.h>
 #include <ogdf/energybased/DavidsonHarelLayout.h>
 #include <ogdf/energybased/DTreeMultilevelEmbedder.h>
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEKernel.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearQuadtreeExpansion.h>
 #include <ogdf/energybased/FMMMLayout.h>
 #include <ogdf/energybased/GEMLayout.h>
 #include <ogdf/energybased/MultilevelLayout.h>
+#include <ogdf/energybased/multilevel_mixer/BarycenterPlacer.h>
+#include <ogdf/energybased/multilevel_mixer/MatchingMerger.h>
+#include <ogdf/energybased/multilevel_mixer/SolarMerger.h>
+#include <ogdf/energybased/multilevel_mixer/SolarPlacer.h>
 #include <ogdf/energybased/NodeRespecterLayout.h>
 #include <ogdf/energybased/PivotMDS.h>
 #include <ogdf/energybased/SpringEmbedderFRExact.h>
@@ -107,6 +114,48 @@ void describeEnergyBasedLayout(const string &name, int extraAttr, std::initializ
 	describeLayout(name, layout, extraAttr, requirements);
 }
 
+/**
+ * Describes that \p layout computes the same layout twice with several threads,
+ * and one of similar quality with a single thread.
+ *
+ * @param layout is the layout module, configured except for its number of threads.
+ * @param setNumberOfThreads sets the number of threads used by \p layout.
+ * @param n is the number of nodes of the random test graph.
+ * @param m is the number of edges of the random test graph.
+ */
+void describeParallelLayoutQuality(LayoutModule &layout, std::function<void(unsigned int)> setNumberOfThreads, int n, int m) {
+	it("computes a deterministic layout of similar quality with several threads", [&layout, setNumberOfThreads, n, m]() {
+		Graph G;
+		randomSimpleConnectedGraph(G, n, m);
+		GraphAttributes single(G), parallel(G), again(G);
+
+		// the initial layout of some modules is random
+		setNumberOfThreads(1);
+		setSeed(42);
+		layout.call(single);
+		setNumberOfThreads(3);
+		setSeed(42);
+		layout.call(parallel);
+		setSeed(42);
+		layout.call(again);
+
+		auto meanEdgeLength = [&](const GraphAttributes &GA) {
+			double sum = 0;
+			for (edge e : G.edges) {
+				sum += (GA.point(e->source()) - GA.point(e->target())).norm();
+			}
+			return sum / G.numberOfEdges();
+		};
+
+		for (node v : G.nodes) {
+			AssertThat(std::isfinite(parallel.x(v)) && std::isfinite(parallel.y(v)), IsTrue());
+			AssertThat(again.x(v), Equals(parallel.x(v)));
+			AssertThat(again.y(v), Equals(parallel.y(v)));
+		}
+		AssertThat(meanEdgeLength(parallel), EqualsWithDelta(meanEdgeLength(single), 0.1 * meanEdgeLength(single)));
+	});
+}
+
 void describeFMMM() {
 	TEST_ENERGY_BASED_LAYOUT(FMMMLayout, 0);
 
@@ -160,34 +209,347 @@ void describeFMMM() {
 		fmmm.call(GA);
 		AssertThat(fmmm.allowedPositions(), Equals(FMMMOptions::AllowedPositions::All));
 	});
+
+	FMMMLayout parallelFMMM;
+	init(parallelFMMM);
+	parallelFMMM.setNumberOfThreads(3);
+	describeLayout("FMMMLayout with several threads", parallelFMMM);
+
+	FMMMLayout threadedFMMM;
+	threadedFMMM.useHighLevelOptions(false);
+	threadedFMMM.fixedIterations(20);
+	describeParallelLayoutQuality(threadedFMMM, [&](unsigned int numberOfThreads) {
+		threadedFMMM.setNumberOfThreads(numberOfThreads);
+	}, 5000, 10000);
 }
 
-go_bandit([] { describe("Energy-based layouts", [] {
-	TEST_ENERGY_BASED_LAYOUT(DavidsonHarelLayout, 0);
+template<int Dim>
+void describeDTreeForce() {
+	it(string("computes the same forces with several threads in ") + to_string(Dim) + "D", []() {
+		using namespace energybased::dtree;
+		using ForceFunc = void (*)(double, double&, double&);
+		const int n = 3 * DTreeForce<Dim>::MinNumPointsPerThread;
+
+		DTreeForce<Dim> single(n);
+		DTreeForce<Dim> parallel(n);
+		parallel.setNumberOfThreads(3);
+		AssertThat(parallel.numberOfThreads(), Equals(3u));
+
+		for (int i = 0; i < n; i++) {
+			for (int d = 0; d < Dim; d++) {
+				const double c = randomDouble(-100, 100);
+				single.setPosition(i, d, c);
+				parallel.setPosition(i, d, c);
+			}
+			const double m = randomDouble(1, 2);
+			single.setMass(i, m);
+			parallel.setMass(i, m);
+		}
+
+		// the tree is built on a randomly enlarged bounding box
+		setSeed(42);
+		single.template computeForces<ForceFunc, true>(RepForceFunctionNewton<Dim, 2>);
+		setSeed(42);
+		parallel.template computeForces<ForceFunc, true>(RepForceFunctionNewton<Dim, 2>);
+
+		for (int i = 0; i < n; i++) {
+			for (int d = 0; d < Dim; d++) {
+				AssertThat(parallel.force(i, d), EqualsWithDelta(single.force(i, d), 1e-9 * (1 + std::abs(single.force(i, d)))));
+			}
+			AssertThat(parallel.force_prime(i), EqualsWithDelta(single.force_prime(i), 1e-9 * (1 + std::abs(single.force_prime(i)))));
+		}
+	});
+}
 
+void describeDTreeMultilevelEmbedder() {
 	TEST_ENERGY_BASED_LAYOUT(DTreeMultilevelEmbedder2D, 0, GraphProperty::connected);
 	TEST_ENERGY_BASED_LAYOUT(DTreeMultilevelEmbedder3D, GraphAttributes::threeD, GraphProperty::connected);
 
+	it("interleaves the bits of 3D morton numbers", []() {
+		for (int k = 0; k < 1000; k++) {
+			unsigned int coords[3], mnr[3], expected[3] = { 0, 0, 0 };
+			for (unsigned int &c : coords) {
+				c = (unsigned(randomNumber(0, 0xffff)) << 16) | unsigned(randomNumber(0, 0xffff));
+			}
+
+			energybased::dtree::interleaveBits<unsigned int, 3>(coords, mnr);
+			for (int i = 0; i < 32; i++) {
+				for (int d = 0; d < 3; d++) {
+					const int bit = 3 * i + d;
+					expected[bit / 32] |= ((coords[d] >> i) & 0x1) << (bit % 32);
+				}
+			}
+
+			for (int d = 0; d < 3; d++) {
+				AssertThat(mnr[d], Equals(expected[d]));
+			}
+		}
+	});
+
+	describeDTreeForce<2>();
+	describeDTreeForce<3>();
+}
+
+void describeFastMultipoleEmbedder() {
 	TEST_ENERGY_BASED_LAYOUT(FastMultipoleEmbedder, 0, GraphProperty::connected);
 	TEST_ENERGY_BASED_LAYOUT(FastMultipoleMultilevelEmbedder, 0, GraphProperty::connected);
 
+	it("computes the same direct forces with the vectorized kernels", []() {
+		using namespace fast_multipole_embedder;
+		struct DirectKernel {
+			void (*self)(float*, float*, float*, float*, float*, size_t);
+			void (*pair)(float*, float*, float*, float*, float*, size_t,
+			             float*, float*, float*, float*, float*, size_t);
+		};
+
+		// the kernel chosen at runtime and every vectorized kernel the CPU supports
+		std::vector<DirectKernel> kernels = {{eval_direct_fast, eval_direct_fast}};
+#if defined(OGDF_FME_KERNEL_USE_AVX) && !defined(OGDF_FME_KERNEL_USE_SSE_DIRECT)
+		if (System::cpuSupports(CPUFeature::AVX2) && System::cpuSupports(CPUFeature::FMA)) {
+			kernels.push_back({eval_direct_avx2, eval_direct_avx2});
+		}
+		if (System::cpuSupports(CPUFeature::AVX512F)) {
+			kernels.push_back({eval_direct_avx512, eval_direct_avx512});
+		}
+#endif
+
+		const size_t n = 61;
+		std::vector<float> x(n), y(n), s(n);
+		for (size_t i = 0; i < n; i++) {
+			x[i] = float(randomDouble(-100, 100));
+			y[i] = float(randomDouble(-100, 100));
+			s[i] = float(randomDouble(1, 2));
+		}
+
+		// sets of several sizes below and above the vector width, starting at unaligned points
+		for (const DirectKernel &kernel : kernels) {
+			for (size_t n1 : {3, 8, 17, 30}) {
+				const size_t n2 = n - 1 - n1;
+				std::vector<float> fx(n, 0), fy(n, 0), fxExpected(n, 0), fyExpected(n, 0);
+
+				kernel.self(&x[1], &y[1], &s[1], &fx[1], &fy[1], n1);
+				eval_direct(&x[1], &y[1], &s[1], &fxExpected[1], &fyExpected[1], n1);
+				kernel.pair(&x[1], &y[1], &s[1], &fx[1], &fy[1], n1,
+				            &x[1 + n1], &y[1 + n1], &s[1 + n1], &fx[1 + n1], &fy[1 + n1], n2);
+				eval_direct(&x[1], &y[1], &s[1], &fxExpected[1], &fyExpected[1], n1,
+				            &x[1 + n1], &y[1 + n1], &s[1 + n1], &fxExpected[1 + n1], &fyExpected[1 + n1], n2);
+
+				for (size_t i = 0; i < n; i++) {
+					AssertThat(fx[i], EqualsWithDelta(fxExpected[i], 1e-4f * (1 + std::abs(fxExpected[i]))));
+					AssertThat(fy[i], EqualsWithDelta(fyExpected[i], 1e-4f * (1 + std::abs(fyExpected[i]))));
+				}
+			}
+		}
+	});
+
+	it("computes the same expansions with the vectorized kernels", []() {
+		using namespace fast_multipole_embedder;
+		const uint32_t n = 40;
+		LinearQuadtree tree(n, nullptr, nullptr, nullptr);
+
+		// the first half of the points lies around node 0, the second half around node 1
+		tree.setNodeX(0, 0);
+		tree.setNodeY(0, 0);
+		tree.setNodeX(1, 10);
+		tree.setNodeY(1, 5);
+		for (uint32_t i = 0; i < n; i++) {
+			const uint32_t center = i < n / 2 ? 0 : 1;
+			tree.setPoint(i, tree.nodeX(center) + float(randomDouble(-1, 1)), tree.nodeY(center) + float(randomDouble(-1, 1)),
+			              float(randomDouble(1, 2)));
+		}
+
+		auto assertSameCoefficients = [](const double* coeff, const double* expected, uint32_t numCoeff) {
+			for (uint32_t k = 0; k < 2 * numCoeff; k++) {
+				AssertThat(coeff[k], EqualsWithDelta(expected[k], 1e-9 * (1 + std::abs(expected[k]))));
+			}
+		};
+
+		// the vectorized kernels handle two coefficients at once, so odd numbers of coefficients are covered, too
+		for (uint32_t precision : {2, 5, 8}) {
+			LinearQuadtreeExpansion scalar(precision, tree);
+			LinearQuadtreeExpansion vectorized(precision, tree);
+			scalar.useAVX2(false);
+			const size_t size = 2 * precision * scalar.m_numExp;
+			for (LinearQuadtreeExpansion* expansion : {&scalar, &vectorized}) {
+				std::fill_n(expansion->multiExp(), size, 0.0);
+				std::fill_n(expansion->localExp(), size, 0.0);
+			}
+
+			for (uint32_t i = 0; i < n / 2; i++) {
+				scalar.P2M(i, 0);
+				vectorized.P2M(i, 0);
+			}
+			assertSameCoefficients(vectorized.multiExp(), scalar.multiExp(), precision);
+
+			// each kernel gets the same input
+			std::copy_n(scalar.multiExp(), size, vectorized.multiExp());
+			scalar.M2L(0, 1);
+			vectorized.M2L(0, 1);
+			assertSameCoefficients(vectorized.localExp() + 2 * precision, scalar.localExp() + 2 * precision, precision);
+
+			std::copy_n(scalar.localExp(), size, vectorized.localExp());
+			for (uint32_t i = n / 2; i < n; i++) {
+				float fx = 0, fy = 0, fxExpected = 0, fyExpected = 0;
+				vectorized.L2P(1, i, fx, fy);
+				scalar.L2P(1, i, fxExpected, fyExpected);
+				AssertThat(fx, EqualsWithDelta(fxExpected, 1e-4f * (1 + std::abs(fxExpected))));
+				AssertThat(fy, EqualsWithDelta(fyExpected, 1e-4f * (1 + std::abs(fyExpected))));
+			}
+		}
+	});
+}
+
+void describeMultilevelLayout() {
+	TEST_ENERGY_BASED_LAYOUT(MultilevelLayout, 0);
+
+	MultilevelLayout matchingLayout;
+	MatchingMerger *matching = new MatchingMerger;
+	matching->setNumberOfThreads(3);
+	matchingLayout.setMultilevelBuilder(matching);
+	BarycenterPlacer *barycenter = new BarycenterPlacer;
+	barycenter->setNumberOfThreads(3);
+	matchingLayout.setPlacer(barycenter);
+	describeLayout("MultilevelLayout with parallel matching", matchingLayout);
+
+	MultilevelLayout solarLayout;
+	SolarMerger *solar = new SolarMerger;
+	solar->setNumberOfThreads(3);
+	solarLayout.setMultilevelBuilder(solar);
+	SolarPlacer *solarPlacer = new SolarPlacer;
+	solarPlacer->setNumberOfThreads(3);
+	solarLayout.setPlacer(solarPlacer);
+	describeLayout("MultilevelLayout with parallel solar merging", solarLayout);
+
+	for (bool useSolarMerger : {true, false}) {
+		it(string("builds the same levels with any number of threads using the ")
+				+ (useSolarMerger ? "SolarMerger" : "MatchingMerger"), [&]() {
+			int numberOfLevels[2], numberOfNodes[2];
+			for (int k = 0; k < 2; k++) {
+				setSeed(42);
+				Graph G;
+				randomSimpleConnectedGraph(G, 2000, 6000);
+				MultilevelGraph MLG(G);
+
+				std::unique_ptr<MultilevelBuilder> builder;
+				if (useSolarMerger) {
+					builder.reset(new SolarMerger);
+				} else {
+					builder.reset(new MatchingMerger);
+				}
+				builder->setNumberOfThreads(k + 2);
+				builder->buildAllLevels(MLG);
+
+				numberOfLevels[k] = builder->getNumLevels();
+				numberOfNodes[k] = MLG.getGraph().numberOfNodes();
+			}
+
+			AssertThat(numberOfLevels[0], IsGreaterThan(1));
+			AssertThat(numberOfNodes[0], IsLessThan(2000));
+			AssertThat(numberOfLevels[1], Equals(numberOfLevels[0]));
+			AssertThat(numberOfNodes[1], Equals(numberOfNodes[0]));
+		});
+	}
+}
+
+void describePivotMDS() {
+	TEST_ENERGY_BASED_LAYOUT(PivotMDS, 0, GraphProperty::connected);
+
+	for (bool smallDiameter : {true, false}) {
+		it(string("computes the same layout with several threads for a graph of ")
+				+ (smallDiameter ? "small" : "large") + " diameter", [&]() {
+			Graph G;
+			if (smallDiameter) {
+				randomSimpleConnectedGraph(G, 10000, 40000);
+			} else {
+				gridGraph(G, 10, 1000, false, false);
+			}
+			GraphAttributes single(G), parallel(G);
+
+			PivotMDS pivotMDS;
+			pivotMDS.setNumberOfThreads(1);
+			pivotMDS.call(single);
+			pivotMDS.setNumberOfThreads(3);
+			pivotMDS.call(parallel);
+
+			double extent = 0;
+			for (node v : G.nodes) {
+				Math::updateMax(extent, std::abs(single.x(v)) + std::abs(single.y(v)));
+			}
+			for (node v : G.nodes) {
+				AssertThat(parallel.x(v), EqualsWithDelta(single.x(v), 1e-6 * extent));
+				AssertThat(parallel.y(v), EqualsWithDelta(single.y(v), 1e-6 * extent));
+			}
+		});
+	}
+}
+
+void describeSpringEmbedderGridVariant() {
+	TEST_ENERGY_BASED_LAYOUT(SpringEmbedderGridVariant, 0);
+
+	SpringEmbedderGridVariant threadedLayout;
+	init(threadedLayout);
+	threadedLayout.noise(false);
+	describeParallelLayoutQuality(threadedLayout, [&](unsigned int numberOfThreads) {
+		threadedLayout.maxThreads(numberOfThreads);
+	}, 3000, 6000);
+}
+
+void describeStressMinimization() {
+	TEST_ENERGY_BASED_LAYOUT(StressMinimization, 0);
+
+	StressMinimization stress;
+	init(stress);
+	stress.useSparseStress(true);
+	stress.setSparseNumberOfPivots(10);
+	describeLayout("StressMinimization with sparse stress", stress);
+
+	stress.setSparseNeighborhoodRadius(2);
+	stress.setNumberOfThreads(2);
+	stress.convergenceCriterion(StressMinimization::TerminationCriterion::Stress);
+	describeLayout("StressMinimization with sparse stress in 3D", stress, GraphAttributes::threeD);
+
+	it("keeps fixed coordinates in sparse mode", [&]() {
+		Graph G;
+		randomSimpleConnectedGraph(G, 60, 120);
+		GraphAttributes GA(G);
+		for (node v : G.nodes) {
+			GA.x(v) = v->index();
+			GA.y(v) = 0;
+		}
+
+		stress.hasInitialLayout(true);
+		stress.fixXCoordinates(true);
+		stress.call(GA);
+		for (node v : G.nodes) {
+			AssertThat(GA.x(v), Equals(double(v->index())));
+		}
+	});
+}
+
+go_bandit([] { describe("Energy-based layouts", [] {
+	TEST_ENERGY_BASED_LAYOUT(DavidsonHarelLayout, 0);
+
+	describeDTreeMultilevelEmbedder();
+
+	describeFastMultipoleEmbedder();
+
 	describeFMMM();
 
 	TEST_ENERGY_BASED_LAYOUT(GEMLayout, 0);
 
-	TEST_ENERGY_BASED_LAYOUT(MultilevelLayout, 0);
+	describeMultilevelLayout();
 
 	TEST_ENERGY_BASED_LAYOUT(NodeRespecterLayout, 0);
 
-	TEST_ENERGY_BASED_LAYOUT(PivotMDS, 0, GraphProperty::connected);
+	describePivotMDS();
 
 	TEST_ENERGY_BASED_LAYOUT(SpringEmbedderFRExact, 0);
 
-	TEST_ENERGY_BASED_LAYOUT(SpringEmbedderGridVariant, 0);
+	describeSpringEmbedderGridVariant();
 
 	TEST_ENERGY_BASED_LAYOUT(SpringEmbedderKK, 0, GraphProperty::connected);
 
-	TEST_ENERGY_BASED_LAYOUT(StressMinimization, 0);
+	describeStressMinimization();
 
 	TEST_ENERGY_BASED_LAYOUT(TutteLayout, 0, GraphProperty::triconnected, GraphProperty::planar, GraphProperty::simple);
 });
@@ -9,142 +9,133 @@
 
 #include "RamseySolver.h"
 
-RamseySolver::RamseySolver()
+RamseySolver::RamseySolver(unsigned num_threads, uint64_t seed) : m_num_threads(num_threads), m_seed(seed)
 {
-    random_engine = std::default_random_engine { std::random_device{}() };
 }
     
-MISSolver::node_set RamseySolver::solve(const ogdf::Graph& graph)
+MISSolver::node_set RamseySolver::solve(const CompactGraph& graph)
 {
-    MISSolver::node_set nodes(node_comparator);
-    for(auto node: graph.nodes)
+    WorkStealingPool pool(m_num_threads);
+    NodeBitset result;
+    
+    if(pool.size() > 1)
+        m_pool = &pool;
+    
+    pool.run([&]
     {
-        nodes.insert(node);
-    }
+        result = clique_removal(graph, graph.full_set()).second;
+    });
     
-    return clique_removal(nodes).second;
+    m_pool = nullptr;
+    
+    return to_node_set(graph, result);
 }
 
-ogdf::node RamseySolver::choose_random_node(const MISSolver::node_set& nodes)
+RamseySolver::vertex RamseySolver::choose_random_node(const NodeBitset& nodes, uint64_t seed)
 {
-    auto it = nodes.begin();
-    std::advance(it, random_engine() % nodes.size());
-    return *it;
+    return nodes.nth(seed % nodes.count());
 }
 
-MISSolver::node_set RamseySolver::get_neighbors(const MISSolver::node_set& established_nodes, 
-                                                ogdf::node node)
+NodeBitset RamseySolver::get_neighbors(const CompactGraph& graph, const NodeBitset& established_nodes, 
+                                       vertex node)
 {
-    MISSolver::node_set result1(node_comparator);
-    MISSolver::node_set result2(node_comparator);
-    ogdf::List<ogdf::edge> neighbors;
-    node->adjEdges(neighbors);
+    //N(node) ∩ established_nodes
+    NodeBitset result = established_nodes;
+    graph.keep_neighbors(result, node);
     
-    for(auto edge: neighbors)
-    {
-        result1.insert(edge->nodes()[0]);
-        result1.insert(edge->nodes()[1]);
-    }
-    
-    result1.erase(node);
-    
-    for(auto node: result1)
-    {
-        if(established_nodes.find(node) != established_nodes.end())
-        {
-            result2.insert(node);
-        }
-    }
-    
-    return result2;
+    return result;
 }
     
-MISSolver::node_set RamseySolver::get_neighbors_complement(const MISSolver::node_set& established_nodes, 
-                                                           ogdf::node node)
+NodeBitset RamseySolver::get_neighbors_complement(const CompactGraph& graph, const NodeBitset& established_nodes, 
+                                                  vertex node)
 {
-    MISSolver::node_set result(node_comparator);
-    
-    RamseySolver::set_copy(result, established_nodes);
-    
-    result.erase(node);
-    
-    auto neighbors = RamseySolver::get_neighbors(established_nodes, node);
-    
-    for(auto neighbor : neighbors)
-    {
-        result.erase(neighbor);
-    }
+    //established_nodes \ (N(node) ∪ { node })
+    NodeBitset result = established_nodes;
+    result.reset(node);
+    graph.remove_neighbors(result, node);
     
     return result;
 }
 
-std::pair<MISSolver::node_set, MISSolver::node_set> RamseySolver::ramsey(MISSolver::node_set nodes)
+std::pair<NodeBitset, NodeBitset> RamseySolver::ramsey(const CompactGraph& graph, const NodeBitset& nodes, uint64_t seed)
 {
     //recursion end condition
     if(nodes.empty())
-        return std::make_pair<MISSolver::node_set, MISSolver::node_set>({}, {});
+        return std::make_pair(graph.empty_set(), graph.empty_set());
     
-    auto node = choose_random_node(nodes);
+    auto node = choose_random_node(nodes, seed);
+    auto neighbors = get_neighbors(graph, nodes, node);
+    auto neighbors_complement = get_neighbors_complement(graph, nodes, node);
     
-    //partition the algorithm for neighbors for currently chosen node
-    //this will calculate the independent set + clique used in later portion of the algorithm
-    MISSolver::node_set c1(node_comparator);
-    MISSolver::node_set i1(node_comparator);
-    auto temp1 = ramsey(get_neighbors(nodes, node));
-    RamseySolver::set_copy(c1, temp1.first);
-    RamseySolver::set_copy(i1, temp1.second);
-    c1.insert(node);
+    std::pair<NodeBitset, NodeBitset> second;
+    std::atomic<bool> second_done { false };
+    const bool parallel = m_pool && neighbors_complement.count() >= spawn_cutoff;
     
     //partition the algorithm for everything but neighbors of currently chosen node
     //this will calculate the independent set + clique used in later portion of the algorithm
-    MISSolver::node_set c2(node_comparator); 
-    MISSolver::node_set i2(node_comparator); 
-    auto temp2 = ramsey(get_neighbors_complement(nodes, node));
-    RamseySolver::set_copy(c2, temp2.first);
-    RamseySolver::set_copy(i2, temp2.second);
-    i2.insert(node);
+    //when it is big enough, leave it to the pool so that an idle thread can steal it
+    if(parallel)
+    {
+        m_pool->spawn([&]
+        {
+            second = ramsey(graph, neighbors_complement, split_seed(seed, 1));
+            second_done.store(true, std::memory_order_release);
+        });
+    }
+    
+    //partition the algorithm for neighbors for currently chosen node
+    //this will calculate the independent set + clique used in later portion of the algorithm
+    auto [c1, i1] = ramsey(graph, neighbors, split_seed(seed, 0));
+    c1.set(node);
+    
+    //join the second partition or calculate it right here
+    if(parallel)
+        m_pool->help_until([&] { return second_done.load(std::memory_order_acquire); });
+    else
+        second = ramsey(graph, neighbors_complement, split_seed(seed, 1));
+    
+    auto& [c2, i2] = second;
+    i2.set(node);
     
     //choose the bigger partitions of independent set + clique
-    auto c = c1.size() > c2.size() ? std::move(c1) : std::move(c2);
-    auto i = i1.size() > i2.size() ? std::move(i1) : std::move(i2);
+    auto c = c1.count() > c2.count() ? std::move(c1) : std::move(c2);
+    auto i = i1.count() > i2.count() ? std::move(i1) : std::move(i2);
     
-    return std::make_pair(c, i);
+    return std::make_pair(std::move(c), std::move(i));
 }
     
-std::pair<std::vector<MISSolver::node_set>, MISSolver::node_set> RamseySolver::clique_removal(MISSolver::node_set nodes)
+std::pair<std::vector<NodeBitset>, NodeBitset> RamseySolver::clique_removal(const CompactGraph& graph, NodeBitset nodes)
 {
     //calculate initial guess using ramsey
-    auto iterator = ramsey(nodes);
+    uint64_t round = 0;
+    auto iterator = ramsey(graph, nodes, split_seed(m_seed, round++));
     
     //store the result in convinient data structure
-    std::vector<MISSolver::node_set> cliques;
+    std::vector<NodeBitset> cliques;
     
-    MISSolver::node_set c(node_comparator);
-    RamseySolver::set_copy(c, iterator.first);
-    
-    MISSolver::node_set i(node_comparator);
-    RamseySolver::set_copy(i, iterator.second);
+    NodeBitset i = iterator.second;
+    size_t i_size = i.count();
     
     //iterate through every node
     while(!nodes.empty())
     {
         //remove currently calculated clique
-        MISSolver::node_set new_nodes(node_comparator);
-        std::set_difference(nodes.begin(), nodes.end(), iterator.first.begin(), iterator.first.end(), std::inserter(new_nodes, new_nodes.begin()));
-        
-        nodes = std::move(new_nodes);
+        nodes -= iterator.first;
         
         //calculate next guess
-        iterator = ramsey(nodes);
+        iterator = ramsey(graph, nodes, split_seed(m_seed, round++));
         
         //if we have found better result for max. independent set -> save it
-        if(iterator.second.size() > i.size())
-            RamseySolver::set_copy(i, iterator.second);
+        auto size = iterator.second.count();
+        if(size > i_size)
+        {
+            i = iterator.second;
+            i_size = size;
+        }
         
         //save clique
-        RamseySolver::set_copy(c, iterator.first);
-        cliques.push_back(c);
+        cliques.push_back(iterator.first);
     }
     
-    return std::make_pair(cliques, i);
+    return std::make_pair(std::move(cliques), std::move(i));
 }
@@ -10,46 +10,46 @@
 #pragma once
 
 #include "MISSolver.h"
+#include "WorkStealingPool.h"
 
 #include <ogdf/basic/simple_graph_alg.h>
 
+#include <random>
+
 class RamseySolver : public MISSolver 
 {
 public:
 
-    RamseySolver();
+    /**
+     * With more than one thread, the two subtrees of the recursion are explored in parallel
+     * on a work-stealing pool. The random choices are seeded by the position in the recursion tree,
+     * so the result only depends on the seed.
+     */
+    RamseySolver(unsigned num_threads = 1, uint64_t seed = std::random_device{}());
     
     virtual const char* name() override
     {
         return "Ramsey Solver";
     }
     
-    virtual node_set solve(const ogdf::Graph& graph) override;
+    using MISSolver::solve;
+    virtual node_set solve(const CompactGraph& graph) override;
     
 private:
 
-    std::default_random_engine random_engine;
-    
-    /**
-     * the reason why this function is here is because c++17 is dumb...
-     * you cannot copy sets with custom comparers using '='
-     * well... you can, but then the comparator function doesn't work
-     * because the comparator function won't be copied into the new set :/
-     */
-    static void set_copy(node_set& dest, const node_set& source)
-    {
-        dest.clear();
-        
-        for(auto node : source)
-        {
-            dest.insert(node);
-        }
-    }
+    using vertex = CompactGraph::vertex;
+
+    //subproblems with fewer nodes are not worth a separate task
+    static constexpr size_t spawn_cutoff = 64;
+
+    unsigned m_num_threads { 1 };
+    uint64_t m_seed { 0 };
+    WorkStealingPool* m_pool { nullptr };
 
-    ogdf::node choose_random_node(const node_set& nodes);
-    node_set get_neighbors(const node_set& established_nodes, ogdf::node node);
-    node_set get_neighbors_complement(const node_set& established_nodes, ogdf::node node);
-    std::pair<node_set, node_set> ramsey(node_set nodes);
-    std::pair<std::vector<node_set>, node_set> clique_removal(node_set nodes);
+    vertex choose_random_node(const NodeBitset& nodes, uint64_t seed);
+    NodeBitset get_neighbors(const CompactGraph& graph, const NodeBitset& established_nodes, vertex node);
+    NodeBitset get_neighbors_complement(const CompactGraph& graph, const NodeBitset& established_nodes, vertex node);
+    std::pair<NodeBitset, NodeBitset> ramsey(const CompactGraph& graph, const NodeBitset& nodes, uint64_t seed);
+    std::pair<std::vector<NodeBitset>, NodeBitset> clique_removal(const CompactGraph& graph, NodeBitset nodes);
     
 };
\ No newline at end of file
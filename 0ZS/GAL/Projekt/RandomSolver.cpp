@@ -9,76 +9,96 @@
 
 #include "RandomSolver.h"
 
-MISSolver::node_set RandomSolver::solve(const ogdf::Graph& input)
+//how many nodes are picked between two checks of the shared best size
+constexpr size_t pruneCheckInterval = 64;
+
+MISSolver::node_set RandomSolver::solve(const CompactGraph& graph)
 {
-    MISSolver::node_set result(node_comparator);
+    WorkStealingPool pool(m_num_threads);
+    
+    //best result of every thread, ties are broken by the lower iteration so that
+    //the result doesn't depend on the scheduling
+    struct Best {
+        NodeBitset set;
+        size_t size { 0 };
+        size_t iteration { 0 };
+    };
+    std::vector<Best> thread_best(pool.size());
+    std::atomic<size_t> best_size { 0 };
     
     //generate random distribution of nodes in the graph
     //get their independent set and choose result with max nodes
-    for(size_t i = 0; i < m_num_iter; i++)
+    pool.run([&]
     {
-        auto temp = random_independent_set(input);
-        
-        if(temp.size() > result.size())
+        for(size_t i = 0; i < m_num_iter; i++)
         {
-            result = temp;
+            pool.spawn([&, i]
+            {
+                auto rng = std::default_random_engine { split_seed(m_seed, i) };
+                NodeBitset temp = graph.empty_set();
+                
+                if(!random_independent_set(graph, rng, best_size, temp))
+                    return;
+                
+                auto temp_size = temp.count();
+                auto& best = thread_best[WorkStealingPool::current_worker()];
+                
+                if(temp_size > best.size || (temp_size == best.size && i < best.iteration))
+                {
+                    best.set = std::move(temp);
+                    best.size = temp_size;
+                    best.iteration = i;
+                }
+                
+                atomic_max(best_size, temp_size);
+            });
         }
-    }
+    });
+    
+    auto result = std::min_element(thread_best.begin(), thread_best.end(), [](const Best& a, const Best& b)
+    {
+        return a.size > b.size || (a.size == b.size && a.iteration < b.iteration);
+    });
+    
+    if(result->size == 0)
+        return node_set(node_comparator);
     
-    return result;
+    return to_node_set(graph, result->set);
 };
 
-MISSolver::node_set RandomSolver::random_independent_set(const ogdf::Graph& input_graph)
+bool RandomSolver::random_independent_set(const CompactGraph& graph, std::default_random_engine& rng,
+                                          const std::atomic<size_t>& best_size, NodeBitset& output_set)
 {
-    //collect input nodes into a set 
-    MISSolver::node_set original_set(node_comparator);
-    for(auto node = input_graph.firstNode(); node != nullptr; node = node->succ())
-    {
-        original_set.insert(node);
-    }
+    //set of explorable nodes, initially the whole graph
+    NodeBitset original_set = graph.full_set();
+    size_t output_size = 0;
     
-    //create output maximal indipendent set of nodes
-    MISSolver::node_set output_set(node_comparator);
-    
-    std::vector<size_t> shuffle(input_graph.numberOfNodes());
+    std::vector<CompactGraph::vertex> shuffle(graph.node_count());
     std::iota(shuffle.begin(), shuffle.end(), 0);
-    auto random_device = std::random_device {};
-    auto rng = std::default_random_engine { random_device() };
     std::shuffle(shuffle.begin(), shuffle.end(), rng);
     
-    for(auto index = 0; index < shuffle.size(); index++)
+    for(auto node : shuffle)
     {
-        ogdf::node node = nullptr;
-        for(auto n : input_graph.nodes)
-        {
-            if(n->index() == shuffle[index])
-            {
-                node = n;
-                break;
-            }
-        }
-        
-        auto inspected_node = original_set.find(node);
-        
         //if currently selected node is still in our input set, we can explore it
-        if(inspected_node != original_set.end())
+        if(original_set.test(node))
         {
             //insert it into the output set
-            output_set.insert(*inspected_node);
+            output_set.set(node);
+            output_size++;
             //remove it from input set
-            original_set.erase(inspected_node);
+            original_set.reset(node);
             
             //remove every adjaced node from the input set
-            ogdf::List<ogdf::edge> neighbors;
-            (*inspected_node)->adjEdges(neighbors);
+            graph.remove_neighbors(original_set, node);
             
-            for(auto e : neighbors)
+            //give up when even taking all the remaining nodes couldn't match the best set
+            if(output_size % pruneCheckInterval == 0 &&
+               output_size + original_set.count() < best_size.load(std::memory_order_relaxed))
             {
-                original_set.erase(e->nodes()[0]);
-                original_set.erase(e->nodes()[1]);
+                return false;
             }
         }
     }
     
-    return output_set;
-}
\ No newline at end of file
+    return true;
+}
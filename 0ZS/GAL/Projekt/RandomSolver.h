@@ -10,15 +10,22 @@
 #pragma once
 
 #include "MISSolver.h"
+#include "WorkStealingPool.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 
 class RandomSolver : public MISSolver {
     
 public:
 
-    RandomSolver(size_t num_iter = 5) : m_num_iter(num_iter)
+    /**
+     * The iterations are distributed among num_threads threads. Every iteration draws from its own
+     * random stream derived from seed, so the result only depends on the seed.
+     */
+    RandomSolver(size_t num_iter = 5, unsigned num_threads = 1, uint64_t seed = std::random_device{}())
+            : m_num_iter(num_iter), m_num_threads(num_threads), m_seed(seed)
     {
         
     }
@@ -28,11 +35,16 @@ public:
         return "Random Solver";
     }
 
-    virtual node_set solve(const ogdf::Graph& input) override;
+    using MISSolver::solve;
+    virtual node_set solve(const CompactGraph& graph) override;
     
 private:
     
     size_t m_num_iter { 0 };
+    unsigned m_num_threads { 1 };
+    uint64_t m_seed { 0 };
     
-    node_set random_independent_set(const ogdf::Graph& input_graph);
-};
\ No newline at end of file
+    //returns false when the set can't reach best_size and was abandoned
+    bool random_independent_set(const CompactGraph& graph, std::default_random_engine& rng,
+                                const std::atomic<size_t>& best_size, NodeBitset& output_set);
+};
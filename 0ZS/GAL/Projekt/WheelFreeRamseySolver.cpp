@@ -14,117 +14,110 @@ WheelFreeRamseySolver::WheelFreeRamseySolver()
     random_engine = std::default_random_engine { std::random_device{}() };
 }
 
-MISSolver::node_set WheelFreeRamseySolver::solve(const ogdf::Graph& graph)
+MISSolver::node_set WheelFreeRamseySolver::solve(const CompactGraph& graph)
 {
+    bfs_queue.reserve(graph.node_count());
+    colors.assign(graph.node_count(), -1);
     
-    MISSolver::node_set nodes(node_comparator);
-    for(auto node: graph.nodes)
-    {
-        nodes.insert(node);
-    }
-    
-    return wheel_free_ramsey(graph, nodes);
+    return to_node_set(graph, wheel_free_ramsey(graph, graph.full_set()));
 }
 
-ogdf::node WheelFreeRamseySolver::choose_random_node(const MISSolver::node_set& nodes)
-{
-    auto it = nodes.begin();
-    std::advance(it, random_engine() % nodes.size());
-    return *it;
-}
-    
-MISSolver::node_set WheelFreeRamseySolver::get_neighbors(const MISSolver::node_set& established_nodes, 
-                                                         ogdf::node node)
+bool WheelFreeRamseySolver::is_bipartite(const CompactGraph& graph, const NodeBitset& nodes, NodeBitset& first_color)
 {
-    MISSolver::node_set result1(node_comparator);
-    MISSolver::node_set result2(node_comparator);
-    ogdf::List<ogdf::edge> neighbors;
-    node->adjEdges(neighbors);
-    
-    for(auto edge: neighbors)
-    {
-        result1.insert(edge->nodes()[0]);
-        result1.insert(edge->nodes()[1]);
-    }
-    
-    result1.erase(node);
+    //two-color the subgraph induced by nodes using BFS
+    bool bipartite = true;
     
-    for(auto node: result1)
+    for(auto root = nodes.first(); root < nodes.capacity() && bipartite; root = nodes.next(root + 1))
     {
-        if(established_nodes.find(node) != established_nodes.end())
+        if(colors[root] != -1)
+            continue;
+        
+        bfs_queue.clear();
+        bfs_queue.push_back(root);
+        colors[root] = 1;
+        
+        for(size_t head = 0; head < bfs_queue.size() && bipartite; head++)
         {
-            result2.insert(node);
+            auto u = bfs_queue[head];
+            for(auto it = graph.neighbors_begin(u); it != graph.neighbors_end(u); it++)
+            {
+                if(!nodes.test(*it))
+                    continue;
+                
+                if(colors[*it] == -1)
+                {
+                    colors[*it] = !colors[u];
+                    bfs_queue.push_back(*it);
+                }
+                else if(colors[*it] == colors[u])
+                {
+                    bipartite = false;
+                    break;
+                }
+            }
         }
     }
     
-    return result2;
-}
+    //collect the first color and reset the colors for the next call
+    nodes.for_each([&](size_t v)
+    {
+        if(colors[v] == 1)
+            first_color.set(v);
+        colors[v] = -1;
+    });
     
-MISSolver::node_set WheelFreeRamseySolver::get_neighbors_complement(const MISSolver::node_set& established_nodes, 
-                                                                    ogdf::node node)
+    return bipartite;
+}
+
+WheelFreeRamseySolver::vertex WheelFreeRamseySolver::choose_random_node(const NodeBitset& nodes)
 {
-    MISSolver::node_set result(node_comparator);
-    
-    WheelFreeRamseySolver::set_copy(result, established_nodes);
+    return nodes.nth(random_engine() % nodes.count());
+}
     
-    result.erase(node);
+NodeBitset WheelFreeRamseySolver::get_neighbors(const CompactGraph& graph, const NodeBitset& established_nodes, 
+                                                vertex node)
+{
+    //N(node) ∩ established_nodes
+    NodeBitset result = established_nodes;
+    graph.keep_neighbors(result, node);
     
-    auto neighbors = get_neighbors(established_nodes, node);
+    return result;
+}
     
-    for(auto neighbor : neighbors)
-    {
-        result.erase(neighbor);
-    }
+NodeBitset WheelFreeRamseySolver::get_neighbors_complement(const CompactGraph& graph, const NodeBitset& established_nodes, 
+                                                           vertex node)
+{
+    //established_nodes \ (N(node) ∪ { node })
+    NodeBitset result = established_nodes;
+    result.reset(node);
+    graph.remove_neighbors(result, node);
     
     return result;
 }
     
-MISSolver::node_set WheelFreeRamseySolver::wheel_free_ramsey(const ogdf::Graph& graph, MISSolver::node_set nodes)
+NodeBitset WheelFreeRamseySolver::wheel_free_ramsey(const CompactGraph& graph, const NodeBitset& nodes)
 {
     //check if currently selected node form a bipartite graph
-    auto reduced_graph = WheelFreeRamseySolver::graph_and_nodes_union(graph, nodes);
-    ogdf::NodeArray<bool> colors(reduced_graph);
-    if(ogdf::isBipartite(reduced_graph, colors))
+    NodeBitset first_set = graph.empty_set();
+    if(is_bipartite(graph, nodes, first_set))
     {
         //if graph is bipartite, that means there are 2 independent sets
-        MISSolver::node_set first_set(node_comparator);
-        MISSolver::node_set second_set(node_comparator);
-        
-        for(auto reduced_node : reduced_graph.nodes)
-        {
-            for(auto node : graph.nodes)
-            {
-                if(node->index() == reduced_node->index())
-                {
-                    if(colors[reduced_node])
-                    {
-                        first_set.insert(node);
-                    }
-                    else
-                    {
-                        second_set.insert(node);
-                    }
-                }
-            }
-        }
+        NodeBitset second_set = nodes;
+        second_set -= first_set;
         
         //choose the bigger independent set
-        return first_set.size() > second_set.size() ? first_set : second_set;
+        return first_set.count() > second_set.count() ? first_set : second_set;
     }
     
     auto node = choose_random_node(nodes);
     
     //partition the algorithm for neighbors of currently chosen node
-    MISSolver::node_set i1(node_comparator);
-    auto temp1 = wheel_free_ramsey(graph, get_neighbors(nodes, node));
-    WheelFreeRamseySolver::set_copy(i1, temp1);
+    auto i1 = wheel_free_ramsey(graph, get_neighbors(graph, nodes, node));
     
     //partition the algorithm for everything but neighbors of currently chosen node
-    MISSolver::node_set i2(node_comparator);
-    auto temp2 = wheel_free_ramsey(graph, get_neighbors_complement(nodes, node));
-    WheelFreeRamseySolver::set_copy(i2, temp2);
-    i2.insert(node);
+    auto i2 = wheel_free_ramsey(graph, get_neighbors_complement(graph, nodes, node));
+    i2.set(node);
     
     //choose the bigger partition
-    return i1.size() > i2.size() ? i1 : i2;
-}
\ No newline at end of file
+    return i1.count() > i2.count() ? i1 : i2;
+}
@@ -11,7 +11,8 @@
 
 #include "MISSolver.h"
 
-#include <ogdf/basic/simple_graph_alg.h>
+#include <cstdint>
+#include <random>
 
 class WheelFreeRamseySolver : public MISSolver 
 {
@@ -24,51 +25,24 @@ public:
         return "Wheel Free Ramsey Solver";
     }
     
-    virtual node_set solve(const ogdf::Graph& graph) override;
+    using MISSolver::solve;
+    virtual node_set solve(const CompactGraph& graph) override;
     
 private:
 
+    using vertex = CompactGraph::vertex;
+
     std::default_random_engine random_engine;
-    
-    /**
-     * the reason why this function is here is because c++17 is dumb...
-     * you cannot copy sets with custom comparers using '='
-     * well... you can, but then the comparator function doesn't work
-     * because the comparator function won't be copied into the new set :/
-     */
-    static void set_copy(node_set& dest, const node_set& source)
-    {
-        dest.clear();
-        
-        for(auto node : source)
-        {
-            dest.insert(node);
-        }
-    }
 
-    static ogdf::Graph graph_and_nodes_union(const ogdf::Graph& graph, const node_set& nodes)
-    {
-        ogdf::Graph result = graph;
-        for(auto node : graph.nodes)
-        {
-            if(nodes.find(node) == nodes.end())
-            {
-                for(auto res_node : result.nodes)
-                {
-                    if(res_node->index() == node->index())
-                    {
-                        result.delNode(res_node);
-                        break;
-                    }
-                }
-            }
-        }
-        return result;
-    }
+    //BFS queue and colors reused by the bipartiteness test
+    std::vector<vertex> bfs_queue;
+    std::vector<int8_t> colors;
+
+    bool is_bipartite(const CompactGraph& graph, const NodeBitset& nodes, NodeBitset& first_color);
     
-    ogdf::node choose_random_node(const node_set& nodes);
-    node_set get_neighbors(const node_set& established_nodes, ogdf::node node);
-    node_set get_neighbors_complement(const node_set& established_nodes, ogdf::node node);
-    node_set wheel_free_ramsey(const ogdf::Graph& graph, node_set nodes);
+    vertex choose_random_node(const NodeBitset& nodes);
+    NodeBitset get_neighbors(const CompactGraph& graph, const NodeBitset& established_nodes, vertex node);
+    NodeBitset get_neighbors_complement(const CompactGraph& graph, const NodeBitset& established_nodes, vertex node);
+    NodeBitset wheel_free_ramsey(const CompactGraph& graph, const NodeBitset& nodes);
     
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#include "WorkStealingPool.h"
+
+static thread_local unsigned currentWorker = 0;
+
+WorkStealingPool::WorkStealingPool(unsigned num_threads)
+{
+    if (num_threads == 0)
+        num_threads = 1;
+
+    for (unsigned i = 0; i < num_threads; i++)
+        m_workers.push_back(std::make_unique<Worker>());
+}
+
+unsigned WorkStealingPool::current_worker()
+{
+    return currentWorker;
+}
+
+void WorkStealingPool::run(task root)
+{
+    m_pending.store(1);
+
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < size(); i++)
+        helpers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+
+    const unsigned previous = currentWorker;
+    currentWorker = 0;
+    root();
+    m_pending.fetch_sub(1);
+    worker_loop(0);
+    currentWorker = previous;
+
+    for (auto& thread: helpers)
+        thread.join();
+}
+
+void WorkStealingPool::spawn(task t)
+{
+    m_pending.fetch_add(1);
+
+    auto& worker = *m_workers[current_worker()];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    worker.tasks.push_back(std::move(t));
+}
+
+bool WorkStealingPool::try_execute(unsigned worker)
+{
+    task t;
+
+    //newest task of our own deque first
+    {
+        auto& own = *m_workers[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty())
+        {
+            t = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    //then the oldest task of the others
+    for (unsigned i = 1; !t && i < size(); i++)
+    {
+        auto& victim = *m_workers[(worker + i) % size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            t = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!t)
+        return false;
+
+    t();
+    m_pending.fetch_sub(1);
+    return true;
+}
+
+void WorkStealingPool::worker_loop(unsigned worker)
+{
+    currentWorker = worker;
+
+    while (m_pending.load() != 0)
+    {
+        if (!try_execute(worker))
+            std::this_thread::yield();
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * GAL project - maximum independent set solvers
+ *
+ * authors: Bc. Ondřej Ondryáš
+ *          Bc. Filip Stupka
+ *
+ * 14. 12. 2022
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Derives an independent seed for a sub-stream of a random computation (SplitMix64 finalizer).
+ * Seeding every task by its position in the computation instead of by the thread that happens
+ * to run it keeps the parallel solvers reproducible for a given seed.
+ */
+inline uint64_t split_seed(uint64_t seed, uint64_t stream)
+{
+    uint64_t z = seed + (stream + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Raises an atomic counter to value if it is lower, lock-free.
+ */
+inline void atomic_max(std::atomic<size_t>& target, size_t value)
+{
+    size_t current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * Fork-join pool with one task deque per worker. A worker pops the newest task from its own deque
+ * and, when it runs out of work, steals the oldest task of another worker (which is usually the
+ * biggest remaining subtree of a recursive search).
+ */
+class WorkStealingPool {
+public:
+
+    using task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned num_threads);
+
+    unsigned size() const
+    { return m_workers.size(); }
+
+    //index of the worker running the calling task (0 outside of run())
+    static unsigned current_worker();
+
+    //executes root on the calling thread together with size() - 1 helper threads
+    //and returns when root and all the tasks it spawned have finished
+    void run(task root);
+
+    //schedules a task from inside a running task
+    void spawn(task t);
+
+    //executes other tasks until done() returns true, used to join spawned tasks
+    template<class Pred>
+    void help_until(Pred&& done)
+    {
+        while (!done())
+        {
+            if (!try_execute(current_worker()))
+                std::this_thread::yield();
+        }
+    }
+
+private:
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    //number of spawned tasks that haven't finished yet
+    std::atomic<size_t> m_pending { 0 };
+
+    bool try_execute(unsigned worker);
+    void worker_loop(unsigned worker);
+};
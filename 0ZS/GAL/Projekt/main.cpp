@@ -12,6 +12,7 @@
 #include <memory>
 #include <filesystem>
 #include <chrono>
+#include <thread>
 
 #include <ogdf/basic/graph_generators.h>
 #include <ogdf/fileformats/GraphIO.h>
@@ -22,38 +23,37 @@
 #include "RamseySolver.h"
 #include "WheelFreeRamseySolver.h"
 #include "BMASolver.h"
+#include "BBMCSolver.h"
 
 #define STAT_OUT 1
 
-bool test_independency(const ogdf::Graph& graph, const MISSolver::node_set& nodes)
+// Time budget of the exact solver for a single graph, the best set found so far is reported after that
+#define EXACT_TIME_LIMIT std::chrono::seconds(60)
+
+// Number of threads used by the parallel solvers (Random, Ramsey, BMA)
+#define SOLVER_THREADS std::thread::hardware_concurrency()
+#define RANDOM_ITERATIONS 5
+
+// Directory where the complements of the benchmark graphs are cached between runs
+#define COMPLEMENT_CACHE_PATH "../complement_cache"
+
+bool test_independency(const CompactGraph& graph, const MISSolver::node_set& nodes)
 {
-    for (auto first_node: nodes)
+    NodeBitset set = graph.empty_set();
+    for (auto node: nodes)
     {
-        for (auto second_node: nodes)
-        {
-            if (first_node != second_node)
-            {
-                for (auto edge: graph.edges)
-                {
-                    if ((edge->nodes()[0] == first_node && edge->nodes()[1] == second_node) ||
-                        (edge->nodes()[0] == second_node && edge->nodes()[1] == first_node))
-                    {
-                        return false;
-                    }
-                }
-            }
-        }
+        set.set(graph.id(node));
     }
 
-    return true;
+    return graph.is_independent(set);
 }
 
-template<class Solver, bool isLast = false>
-void solve(const ogdf::Graph& graph)
+template<class Solver, bool isLast = false, class... Args>
+void solve(const CompactGraph& graph, Args&& ... args)
 {
     using namespace std::chrono;
 
-    auto solver = std::make_unique<Solver>();
+    auto solver = std::make_unique<Solver>(std::forward<Args>(args)...);
 
     auto start = high_resolution_clock::now();
     auto result = solver->solve(graph);
@@ -63,6 +63,8 @@ void solve(const ogdf::Graph& graph)
 #if STAT_OUT
     std::cout << result.size() << ',' << (test_independency(graph, result) ? "1," : "0,")
               << timeDelta;
+    if constexpr (std::is_same_v<Solver, BBMCSolver>)
+        std::cout << ',' << (solver->is_optimal() ? '1' : '0');
     if (isLast)
         std::cout << std::endl;
     else
@@ -70,52 +72,50 @@ void solve(const ogdf::Graph& graph)
 #else
     std::cout << "    " << solver->name() << ": " << result.size() << " - "
               << (test_independency(graph, result) ? "success" : "fail") <<
-              " in " << timeDelta << " ms" << std::endl;
+              " in " << timeDelta << " ms";
+    if constexpr (std::is_same_v<Solver, BBMCSolver>)
+        std::cout << (solver->is_optimal() ? " (optimal)" : " (time limit reached)");
+    std::cout << std::endl;
 #endif
 }
 
 void test_random_graph(size_t num_nodes, size_t num_edges)
 {
-    ogdf::Graph graph;
-    ogdf::randomSimpleGraph(graph, num_nodes, num_edges);
-    solve<RandomSolver>(graph);
+    ogdf::Graph random_graph;
+    ogdf::randomSimpleGraph(random_graph, num_nodes, num_edges);
+    CompactGraph graph(random_graph);
+
+    solve<RandomSolver>(graph, RANDOM_ITERATIONS, SOLVER_THREADS);
     solve<GreedySolver>(graph);
     solve<Greedy2Solver>(graph);
-    solve<RamseySolver>(graph);
+    solve<RamseySolver>(graph, SOLVER_THREADS);
     solve<WheelFreeRamseySolver>(graph);
+    solve<BBMCSolver, true>(graph, EXACT_TIME_LIMIT);
 }
 
-ogdf::Graph graph_complement(const ogdf::Graph& graph)
+CompactGraph load_complement(const ogdf::Graph& graph, const std::string& path, const std::string& name)
 {
-    ogdf::Graph result = graph;
-    while (result.numberOfEdges() != 0)
-    {
-        result.delEdge(result.firstEdge());
-    }
+    namespace fs = std::filesystem;
 
-    for (auto first_node: graph.nodes)
+    // The cached complement is only used when it is newer than the benchmark file
+    std::error_code ec;
+    const fs::path cache_path = fs::path(COMPLEMENT_CACHE_PATH) / (name + ".bin");
+    if (fs::exists(cache_path, ec) && fs::last_write_time(cache_path, ec) >= fs::last_write_time(path, ec))
     {
-        for (auto second_node: graph.nodes)
-        {
-            auto edge = graph.searchEdge(first_node, second_node);
-
-            if (!edge)
-            {
-                for (auto res_first_node: result.nodes)
-                {
-                    for (auto res_second_node: result.nodes)
-                    {
-                        if (res_first_node->index() == first_node->index() &&
-                            res_second_node->index() == second_node->index())
-                        {
-                            result.newEdge(res_first_node, res_second_node);
-                        }
-                    }
-                }
-            }
-        }
+        std::ifstream cache(cache_path, std::ios::in | std::ios::binary);
+        auto cached = CompactGraph::load(cache, graph);
+        if (cached)
+            return std::move(*cached);
     }
 
+    std::cerr << "Generating graph complement for '" << path << "'..." << std::endl;
+    auto result = CompactGraph(graph).complement();
+
+    fs::create_directories(COMPLEMENT_CACHE_PATH, ec);
+    std::ofstream cache(cache_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (cache.is_open())
+        result.save(cache);
+
     return result;
 }
 
@@ -129,22 +129,22 @@ void test_benchmark_graph(const std::string& path, const std::string& name)
     if (!ogdf::GraphIO::readMatrixMarket(clique_benchmark_graph, file))
         return;
 
-    std::cerr << "Generating graph complement for '" << path << "'..." << std::endl;
-    auto mis_benchmark_graph = graph_complement(clique_benchmark_graph);
+    auto mis_benchmark_graph = load_complement(clique_benchmark_graph, path, name);
 
 #if STAT_OUT
-    std::cout << '"' << name << "\"," << mis_benchmark_graph.numberOfNodes() << ','
-              << mis_benchmark_graph.numberOfEdges() << ',';
+    std::cout << '"' << name << "\"," << mis_benchmark_graph.node_count() << ','
+              << mis_benchmark_graph.edge_count() << ',';
 #else
-    std::cout << "Testing: '" << path << "' - <nodes: " << mis_benchmark_graph.numberOfNodes() << ", edges: "
-              << mis_benchmark_graph.numberOfEdges() << ">" << std::endl;
+    std::cout << "Testing: '" << path << "' - <nodes: " << mis_benchmark_graph.node_count() << ", edges: "
+              << mis_benchmark_graph.edge_count() << ">" << std::endl;
 #endif
-    solve<RandomSolver>(mis_benchmark_graph);
+    solve<RandomSolver>(mis_benchmark_graph, RANDOM_ITERATIONS, SOLVER_THREADS);
     solve<GreedySolver>(mis_benchmark_graph);
     solve<Greedy2Solver>(mis_benchmark_graph);
-    solve<RamseySolver>(mis_benchmark_graph);
+    solve<RamseySolver>(mis_benchmark_graph, SOLVER_THREADS);
     solve<WheelFreeRamseySolver>(mis_benchmark_graph);
-    solve<BMASolver, true>(mis_benchmark_graph);
+    solve<BMASolver>(mis_benchmark_graph, BMAEngine::Dense, SOLVER_THREADS);
+    solve<BBMCSolver, true>(mis_benchmark_graph, EXACT_TIME_LIMIT);
 
 }
 
@@ -154,7 +154,7 @@ int main(int argc, char* argv[])
 
 #if STAT_OUT
     std::cout
-            << "name,nodes,edges,rnd_i,rnd_ok,rnd_time,gr1_i,gr1_ok,gr1_time,gr2_i,gr2_ok,gr2_time,ram_i,ram_ok,ram_time,wfram_i,wfram_ok,wfram_time,bma_i,bma_ok,bma_time"
+            << "name,nodes,edges,rnd_i,rnd_ok,rnd_time,gr1_i,gr1_ok,gr1_time,gr2_i,gr2_ok,gr2_time,ram_i,ram_ok,ram_time,wfram_i,wfram_ok,wfram_time,bma_i,bma_ok,bma_time,bb_i,bb_ok,bb_time,bb_opt"
             << std::endl;
 #endif
     for (const auto& entry: std::filesystem::directory_iterator(benchmark_path))